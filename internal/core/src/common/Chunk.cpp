@@ -10,11 +10,180 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <cstdint>
+#include <limits>
+#include <type_traits>
 
 #include "common/Chunk.h"
 
 namespace milvus {
 
+namespace {
+
+// Calls fn with the codes of a packed chunk as int8_t, int16_t or int32_t.
+template <typename Fn>
+void
+VisitPackedCodes(const char* codes, uint32_t code_bytes, Fn&& fn) {
+    switch (code_bytes) {
+        case sizeof(int8_t):
+            fn(reinterpret_cast<const int8_t*>(codes));
+            break;
+        case sizeof(int16_t):
+            fn(reinterpret_cast<const int16_t*>(codes));
+            break;
+        case sizeof(int32_t):
+            fn(reinterpret_cast<const int32_t*>(codes));
+            break;
+        default:
+            ThrowInfo(UnexpectedError, "invalid code bytes {}", code_bytes);
+    }
+}
+
+// Where a value lies relative to the codes of a packed chunk.
+enum class CodeBound { kBelow, kWithin, kAbove };
+
+template <typename Code>
+CodeBound
+ToCode(__int128 delta, Code& code) {
+    if (delta < std::numeric_limits<Code>::min()) {
+        return CodeBound::kBelow;
+    }
+    if (delta > std::numeric_limits<Code>::max()) {
+        return CodeBound::kAbove;
+    }
+    code = static_cast<Code>(delta);
+    return CodeBound::kWithin;
+}
+
+}  // namespace
+
+void
+FixedWidthChunk::DecodePacked(int64_t offset, int64_t len, char* out) const {
+    AssertInfo(IsPacked(), "fixed width chunk is not packed");
+    AssertInfo(offset >= 0 && offset + len <= row_nums_,
+               "decode packed with out-of-bound offset:{}, len:{}",
+               offset,
+               len);
+    // Wraps like the writer, the decoded values always fit.
+    auto base = static_cast<uint64_t>(packed_min_) +
+                (uint64_t{1} << (8 * code_bytes_ - 1));
+    VisitPackedCodes(codes_, code_bytes_, [&](const auto* codes) {
+        for (int64_t i = 0; i < len; i++) {
+            auto value = static_cast<int64_t>(
+                base + static_cast<uint64_t>(int64_t{codes[offset + i]}));
+            if (element_size_ == sizeof(int32_t)) {
+                reinterpret_cast<int32_t*>(out)[i] =
+                    static_cast<int32_t>(value);
+            } else {
+                reinterpret_cast<int64_t*>(out)[i] = value;
+            }
+        }
+    });
+}
+
+std::shared_ptr<char[]>
+FixedWidthChunk::DecodePacked() const {
+    std::shared_ptr<char[]> values(new char[row_nums_ * element_size_]);
+    DecodePacked(0, row_nums_, values.get());
+    return values;
+}
+
+void
+FixedWidthChunk::PackedCompare(bitset::CompareOpType op,
+                               int64_t value,
+                               int64_t offset,
+                               int64_t len,
+                               TargetBitmapView res) const {
+    AssertInfo(IsPacked(), "fixed width chunk is not packed");
+    AssertInfo(offset >= 0 && offset + len <= row_nums_,
+               "packed compare with out-of-bound offset:{}, len:{}",
+               offset,
+               len);
+    __int128 base =
+        __int128{packed_min_} + (__int128{1} << (8 * code_bytes_ - 1));
+    VisitPackedCodes(codes_, code_bytes_, [&](const auto* codes) {
+        using Code = std::remove_const_t<std::remove_pointer_t<
+            std::remove_reference_t<decltype(codes)>>>;
+        Code code;
+        switch (ToCode<Code>(value - base, code)) {
+            case CodeBound::kWithin:
+                res.inplace_compare_val<Code>(codes + offset, len, code, op);
+                return;
+            case CodeBound::kBelow:
+                // Every row is greater than the value.
+                if (op == bitset::CompareOpType::GT ||
+                    op == bitset::CompareOpType::GE ||
+                    op == bitset::CompareOpType::NE) {
+                    res.set(0, len);
+                } else {
+                    res.reset(0, len);
+                }
+                return;
+            case CodeBound::kAbove:
+                // Every row is less than the value.
+                if (op == bitset::CompareOpType::LT ||
+                    op == bitset::CompareOpType::LE ||
+                    op == bitset::CompareOpType::NE) {
+                    res.set(0, len);
+                } else {
+                    res.reset(0, len);
+                }
+                return;
+        }
+    });
+}
+
+void
+FixedWidthChunk::PackedWithinRange(bitset::RangeType range,
+                                   int64_t lower,
+                                   int64_t upper,
+                                   int64_t offset,
+                                   int64_t len,
+                                   TargetBitmapView res) const {
+    AssertInfo(IsPacked(), "fixed width chunk is not packed");
+    AssertInfo(offset >= 0 && offset + len <= row_nums_,
+               "packed range with out-of-bound offset:{}, len:{}",
+               offset,
+               len);
+    const bool lower_inclusive = range == bitset::RangeType::IncInc ||
+                                 range == bitset::RangeType::IncExc;
+    const bool upper_inclusive = range == bitset::RangeType::IncInc ||
+                                 range == bitset::RangeType::ExcInc;
+    __int128 base =
+        __int128{packed_min_} + (__int128{1} << (8 * code_bytes_ - 1));
+    VisitPackedCodes(codes_, code_bytes_, [&](const auto* codes) {
+        using Code = std::remove_const_t<std::remove_pointer_t<
+            std::remove_reference_t<decltype(codes)>>>;
+        Code lower_code;
+        Code upper_code;
+        auto lower_bound = ToCode<Code>(lower - base, lower_code);
+        auto upper_bound = ToCode<Code>(upper - base, upper_code);
+        if (lower_bound == CodeBound::kAbove ||
+            upper_bound == CodeBound::kBelow) {
+            res.reset(0, len);
+        } else if (lower_bound == CodeBound::kBelow &&
+                   upper_bound == CodeBound::kAbove) {
+            res.set(0, len);
+        } else if (lower_bound == CodeBound::kBelow) {
+            res.inplace_compare_val<Code>(codes + offset,
+                                          len,
+                                          upper_code,
+                                          upper_inclusive
+                                              ? bitset::CompareOpType::LE
+                                              : bitset::CompareOpType::LT);
+        } else if (upper_bound == CodeBound::kAbove) {
+            res.inplace_compare_val<Code>(codes + offset,
+                                          len,
+                                          lower_code,
+                                          lower_inclusive
+                                              ? bitset::CompareOpType::GE
+                                              : bitset::CompareOpType::GT);
+        } else {
+            res.inplace_within_range_val<Code>(
+                lower_code, upper_code, codes + offset, len, range);
+        }
+    });
+}
+
 std::pair<std::vector<std::string_view>, FixedVector<bool>>
 StringChunk::StringViews(
     std::optional<std::pair<int64_t, int64_t>> offset_len = std::nullopt) {
@@ -44,7 +213,9 @@ StringChunk::StringViews(
     ret.reserve(len);
     auto end_offset = start_offset + len;
     for (auto i = start_offset; i < end_offset; i++) {
-        ret.emplace_back(data_ + offsets_[i], offsets_[i + 1] - offsets_[i]);
+        auto entry = EntryOf(i);
+        ret.emplace_back(data_ + offsets_[entry],
+                         offsets_[entry + 1] - offsets_[entry]);
     }
     if (nullable_) {
         FixedVector<bool> res_valid(valid_.begin() + start_offset,
@@ -63,11 +234,96 @@ StringChunk::ViewsByOffsets(const FixedVector<int32_t>& offsets) {
     valid_res.reserve(size);
     for (auto i = 0; i < size; ++i) {
         auto idx = offsets[i];
-        auto start = offsets_[idx];
-        ret.emplace_back(data_ + start, offsets_[idx + 1] - start);
+        auto entry = EntryOf(idx);
+        auto start = offsets_[entry];
+        ret.emplace_back(data_ + start, offsets_[entry + 1] - start);
         valid_res.emplace_back(isValid(idx));
     }
     return {ret, valid_res};
 }
 
+StringDictionaryMatches
+StringChunk::MatchDictionary(const DictionaryPredicate& predicate) const {
+    AssertInfo(IsDictionaryEncoded(), "string chunk is not dictionary encoded");
+    std::vector<std::string_view> values;
+    values.reserve(dict_size_);
+    for (int64_t code = 0; code < dict_size_; code++) {
+        values.emplace_back(data_ + offsets_[code],
+                            offsets_[code + 1] - offsets_[code]);
+    }
+    TargetBitmap bitmap(dict_size_, false);
+    predicate(values.data(),
+              dict_size_,
+              TargetBitmapView(bitmap.data(), dict_size_));
+
+    StringDictionaryMatches result;
+    result.matches.resize(dict_size_, false);
+    int64_t first = -1;
+    int64_t last = -1;
+    int64_t count = 0;
+    for (int64_t code = 0; code < dict_size_; code++) {
+        if (!bitmap[code]) {
+            continue;
+        }
+        result.matches[code] = true;
+        if (first < 0) {
+            first = code;
+        }
+        last = code;
+        count++;
+    }
+    if (count == 0) {
+        result.range.emplace(0, 0);
+    } else if (count == last - first + 1) {
+        result.range.emplace(first, last + 1);
+    }
+    return result;
+}
+
+namespace {
+
+template <typename Code>
+void
+MatchTypedCodes(const Code* codes,
+                const StringDictionaryMatches& matches,
+                int64_t len,
+                TargetBitmapView res) {
+    if (matches.range.has_value()) {
+        res.inplace_within_range_val<Code, bitset::RangeType::IncExc>(
+            static_cast<Code>(matches.range->first),
+            static_cast<Code>(matches.range->second),
+            codes,
+            len);
+        return;
+    }
+    for (int64_t i = 0; i < len; i++) {
+        res[i] = matches.matches[codes[i]];
+    }
+}
+
+}  // namespace
+
+void
+StringChunk::MatchCodes(const StringDictionaryMatches& matches,
+                        int64_t offset,
+                        int64_t len,
+                        TargetBitmapView res) const {
+    AssertInfo(IsDictionaryEncoded(), "string chunk is not dictionary encoded");
+    AssertInfo(offset >= 0 && offset + len <= row_nums_,
+               "match codes with out-of-bound offset:{}, len:{}",
+               offset,
+               len);
+    if (code_bytes_ == sizeof(int8_t)) {
+        MatchTypedCodes(reinterpret_cast<const int8_t*>(codes_) + offset,
+                        matches,
+                        len,
+                        res);
+    } else {
+        MatchTypedCodes(reinterpret_cast<const int16_t*>(codes_) + offset,
+                        matches,
+                        len,
+                        res);
+    }
+}
+
 }  // namespace milvus
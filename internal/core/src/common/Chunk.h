@@ -15,6 +15,9 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -197,45 +200,134 @@ class Chunk {
 };
 
 // for fixed size data, includes fixed size array
+//
+// INT32 and INT64 chunks may instead be written frame-of-reference packed by
+// the ChunkWriter:
+//
+// [null_bitmap][min, code_bytes][codes]
+//
+// where each row stores value - min - 2^(8 * code_bytes - 1) as a signed 1,
+// 2 or 4 byte code. Filters compare on the codes directly. Packed chunks
+// have no plain values to point at, so Span(), Data() and ValueAt() are only
+// for plain chunks; readers decode the rows they need with DecodePacked().
 class FixedWidthChunk : public Chunk {
  public:
+    // Bytes of the packed header before the codes.
+    static constexpr size_t kPackedHeaderSize =
+        sizeof(int64_t) + 2 * sizeof(uint32_t);
+
     FixedWidthChunk(int32_t row_nums,
                     int32_t dim,
                     char* data,
                     uint64_t size,
                     uint64_t element_size,
                     bool nullable,
-                    std::shared_ptr<ChunkMmapGuard> chunk_mmap_guard)
+                    std::shared_ptr<ChunkMmapGuard> chunk_mmap_guard,
+                    bool packed = false)
         : Chunk(row_nums, data, size, nullable, chunk_mmap_guard),
           dim_(dim),
           element_size_(element_size) {
         auto null_bitmap_bytes_num = nullable_ ? (row_nums_ + 7) / 8 : 0;
         data_start_ = data_ + null_bitmap_bytes_num;
+        if (packed) {
+            AssertInfo(dim_ == 1 && (element_size_ == sizeof(int32_t) ||
+                                     element_size_ == sizeof(int64_t)),
+                       "packed chunk of element size {} and dim {}",
+                       element_size_,
+                       dim_);
+            std::memcpy(&packed_min_, data_start_, sizeof(int64_t));
+            std::memcpy(&code_bytes_,
+                        data_start_ + sizeof(int64_t),
+                        sizeof(uint32_t));
+            codes_ = data_start_ + kPackedHeaderSize;
+        }
     };
 
     milvus::SpanBase
     Span() const {
-        return milvus::SpanBase(data_start_,
-                                nullable_ ? valid_.data() : nullptr,
-                                row_nums_,
-                                element_size_ * dim_);
+        AssertInfo(!IsPacked(), "packed chunk has no plain values");
+        return Span(data_start_);
+    }
+
+    // Span over 'values', the decoded rows of this chunk, with its validity.
+    milvus::SpanBase
+    Span(const char* values) const {
+        return milvus::SpanBase(
+            values, ValidData(), row_nums_, element_size_ * dim_);
+    }
+
+    const bool*
+    ValidData() const {
+        return nullable_ ? valid_.data() : nullptr;
     }
 
     const char*
     ValueAt(int64_t idx) const override {
+        AssertInfo(!IsPacked(), "packed chunk has no plain values");
         return data_start_ + idx * element_size_ * dim_;
     }
 
     const char*
     Data() const override {
+        AssertInfo(!IsPacked(), "packed chunk has no plain values");
         return data_start_;
     }
 
+    bool
+    IsPacked() const {
+        return codes_ != nullptr;
+    }
+
+    // Decodes the values of rows [offset, offset + len) of a packed chunk
+    // into 'out', without keeping them in the chunk.
+    void
+    DecodePacked(int64_t offset, int64_t len, char* out) const;
+
+    // Decodes all rows of a packed chunk into a buffer owned by the caller.
+    std::shared_ptr<char[]>
+    DecodePacked() const;
+
+    // Sets res[i] to whether the value of row offset + i compares 'op' to
+    // 'value', for i < len. Only for packed chunks; null rows are not
+    // masked.
+    void
+    PackedCompare(bitset::CompareOpType op,
+                  int64_t value,
+                  int64_t offset,
+                  int64_t len,
+                  TargetBitmapView res) const;
+
+    // Sets res[i] to whether the value of row offset + i is between 'lower'
+    // and 'upper' as given by 'range', for i < len. Only for packed chunks;
+    // null rows are not masked.
+    void
+    PackedWithinRange(bitset::RangeType range,
+                      int64_t lower,
+                      int64_t upper,
+                      int64_t offset,
+                      int64_t len,
+                      TargetBitmapView res) const;
+
  private:
     int dim_;
     int element_size_;
     const char* data_start_;
+
+    const char* codes_{nullptr};
+    int64_t packed_min_{0};
+    uint32_t code_bytes_{0};
 };
+
+// Returns 'chunk' as a packed FixedWidthChunk when it is one, or nullptr.
+// Only INT32 and INT64 chunks can be packed.
+inline const FixedWidthChunk*
+AsPackedChunk(DataType data_type, const Chunk* chunk) {
+    if (data_type != DataType::INT32 && data_type != DataType::INT64) {
+        return nullptr;
+    }
+    auto fixed_chunk = static_cast<const FixedWidthChunk*>(chunk);
+    return fixed_chunk->IsPacked() ? fixed_chunk : nullptr;
+}
 // A StringChunk is a class that represents a collection of strings stored in a contiguous memory block.
 // It is initialized with the number of rows, a pointer to the data, the size of the data, and a boolean
 // indicating whether the data can contain null values. The data is accessed using offsets, which are
@@ -257,9 +349,31 @@ class FixedWidthChunk : public Chunk {
 //
 // In this example, 'exampleChunk' is a StringChunk with 3 rows, a pointer to the data stored in 'dataPointer',
 // a total data size of 'dataSize', and it does not support nullability.
+//
+// Low-cardinality chunks may instead be dictionary encoded by the StringChunkWriter:
+//
+// [null_bitmap][kDictionaryMarker, dict_size, code_bytes, codes_offset][dict_offsets][dict_data][codes]
+//
+// The dictionary holds the distinct strings in sorted order, and each row stores the 1 or 2 byte signed
+// code of its string. The marker takes the place of the first plain offset, which can never be equal to it.
+
+// Which dictionary entries of a StringChunk satisfy a predicate.
+struct StringDictionaryMatches {
+    FixedVector<bool> matches;
+    // Set when the matching codes are exactly [first, second), as for
+    // equality, range and prefix predicates over the sorted dictionary.
+    std::optional<std::pair<int32_t, int32_t>> range;
+};
 
 class StringChunk : public Chunk {
  public:
+    static constexpr uint32_t kDictionaryMarker =
+        std::numeric_limits<uint32_t>::max();
+
+    // Evaluates a predicate on 'size' strings, setting res[i] for values[i].
+    using DictionaryPredicate = std::function<void(
+        const std::string_view* values, int64_t size, TargetBitmapView res)>;
+
     StringChunk() = default;
     StringChunk(int32_t row_nums,
                 char* data,
@@ -268,7 +382,15 @@ class StringChunk : public Chunk {
                 std::shared_ptr<ChunkMmapGuard> chunk_mmap_guard)
         : Chunk(row_nums, data, size, nullable, chunk_mmap_guard) {
         auto null_bitmap_bytes_num = nullable_ ? (row_nums_ + 7) / 8 : 0;
-        offsets_ = reinterpret_cast<uint32_t*>(data + null_bitmap_bytes_num);
+        auto header = reinterpret_cast<uint32_t*>(data + null_bitmap_bytes_num);
+        if (header[0] != kDictionaryMarker) {
+            offsets_ = header;
+            return;
+        }
+        dict_size_ = header[1];
+        code_bytes_ = header[2];
+        codes_ = data + header[3];
+        offsets_ = header + 4;
     }
 
     std::string_view
@@ -280,9 +402,35 @@ class StringChunk : public Chunk {
                       row_nums_);
         }
 
-        return {data_ + offsets_[i], offsets_[i + 1] - offsets_[i]};
+        auto entry = EntryOf(i);
+        return {data_ + offsets_[entry],
+                offsets_[entry + 1] - offsets_[entry]};
     }
 
+    bool
+    IsDictionaryEncoded() const {
+        return codes_ != nullptr;
+    }
+
+    int64_t
+    DictionarySize() const {
+        return dict_size_;
+    }
+
+    // Evaluates 'predicate' once per dictionary entry. Only for dictionary
+    // encoded chunks.
+    StringDictionaryMatches
+    MatchDictionary(const DictionaryPredicate& predicate) const;
+
+    // Sets res[i] to whether the code of row offset + i is one of 'matches',
+    // for i < len. Contiguous matches are found by a SIMD range compare of
+    // the codes. Null rows are not masked.
+    void
+    MatchCodes(const StringDictionaryMatches& matches,
+               int64_t offset,
+               int64_t len,
+               TargetBitmapView res) const;
+
     std::pair<std::vector<std::string_view>, FixedVector<bool>>
     StringViews(std::optional<std::pair<int64_t, int64_t>> offset_len);
 
@@ -354,13 +502,30 @@ class StringChunk : public Chunk {
         return (*this)[idx].data();
     }
 
+    // Per-row offsets, or the dictionary entry offsets when dictionary
+    // encoded.
     uint32_t*
     Offsets() {
         return offsets_;
     }
 
  protected:
+    // Index of row i in offsets_: the row itself, or its dictionary code.
+    int64_t
+    EntryOf(int64_t i) const {
+        if (codes_ == nullptr) {
+            return i;
+        }
+        if (code_bytes_ == sizeof(int8_t)) {
+            return reinterpret_cast<const int8_t*>(codes_)[i];
+        }
+        return reinterpret_cast<const int16_t*>(codes_)[i];
+    }
+
     uint32_t* offsets_;
+    const char* codes_{nullptr};
+    int64_t dict_size_{0};
+    uint32_t code_bytes_{0};
 };
 
 using JSONChunk = StringChunk;
@@ -11,6 +11,7 @@
 
 #include "common/ChunkWriter.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -19,12 +20,15 @@
 #include <vector>
 
 #include "NamedType/underlying_functionalities.hpp"
+#include "ankerl/unordered_dense.h"
 #include "arrow/array/array_binary.h"
 #include "arrow/array/array_nested.h"
 #include "arrow/record_batch.h"
 #include "arrow/result.h"
 #include "common/Array.h"
 #include "common/Chunk.h"
+#include "common/Common.h"
+#include "common/Consts.h"
 #include "common/EasyAssert.h"
 #include "common/FieldMeta.h"
 #include "common/Types.h"
@@ -72,9 +76,101 @@ StringChunkWriter::calculate_size(const arrow::ArrayVector& array_vec) {
     offsets_.push_back(static_cast<uint32_t>(cursor));
 
     size_t size = cursor + MMAP_STRING_PADDING;
+    if (auto dictionary_size = BuildDictionary(array_vec, size)) {
+        offsets_.clear();
+        offsets_.shrink_to_fit();
+        return {dictionary_size, row_nums_};
+    }
     return {size, row_nums_};
 }
 
+size_t
+StringChunkWriter::BuildDictionary(const arrow::ArrayVector& array_vec,
+                                   size_t plain_size) {
+    dictionary_header_.clear();
+    dictionary_.clear();
+    codes_.clear();
+
+    ankerl::unordered_dense::map<std::string_view, int32_t> codes;
+    size_t dictionary_bytes = 0;
+    for (const auto& data : array_vec) {
+        auto array = std::static_pointer_cast<arrow::BinaryArray>(data);
+        for (int64_t i = 0; i < array->length(); i++) {
+            if (array->IsNull(i)) {
+                continue;
+            }
+            auto [it, inserted] = codes.try_emplace(array->GetView(i), 0);
+            if (!inserted) {
+                continue;
+            }
+            if (codes.size() > kMaxDictionarySize) {
+                return 0;
+            }
+            dictionary_bytes += it->first.size();
+        }
+    }
+    if (codes.empty()) {
+        return 0;
+    }
+
+    const size_t code_bytes =
+        codes.size() <= std::numeric_limits<int8_t>::max() ? sizeof(int8_t)
+                                                           : sizeof(int16_t);
+    const size_t null_bitmap_bytes = nullable_ ? (row_nums_ + 7) / 8 : 0;
+    const size_t header_num = 4 + codes.size() + 1;
+    const size_t dictionary_end =
+        null_bitmap_bytes + sizeof(uint32_t) * header_num + dictionary_bytes;
+    const size_t codes_offset =
+        (dictionary_end + code_bytes - 1) / code_bytes * code_bytes;
+    const size_t size =
+        codes_offset + row_nums_ * code_bytes + MMAP_STRING_PADDING;
+    if (size > plain_size / 2) {
+        return 0;
+    }
+
+    // Codes follow the sorted order of the strings, so ordered and prefix
+    // predicates match contiguous codes.
+    dictionary_.reserve(codes.size());
+    for (const auto& [value, code] : codes) {
+        dictionary_.push_back(value);
+    }
+    std::sort(dictionary_.begin(), dictionary_.end());
+    dictionary_header_.reserve(header_num);
+    dictionary_header_.push_back(StringChunk::kDictionaryMarker);
+    dictionary_header_.push_back(static_cast<uint32_t>(dictionary_.size()));
+    dictionary_header_.push_back(static_cast<uint32_t>(code_bytes));
+    dictionary_header_.push_back(static_cast<uint32_t>(codes_offset));
+    size_t cursor = null_bitmap_bytes + sizeof(uint32_t) * header_num;
+    for (size_t code = 0; code < dictionary_.size(); code++) {
+        codes[dictionary_[code]] = static_cast<int32_t>(code);
+        dictionary_header_.push_back(static_cast<uint32_t>(cursor));
+        cursor += dictionary_[code].size();
+    }
+    dictionary_header_.push_back(static_cast<uint32_t>(cursor));
+    codes_padding_ = codes_offset - dictionary_end;
+
+    // Null rows keep code 0.
+    codes_.resize(row_nums_ * code_bytes, 0);
+    size_t row = 0;
+    for (const auto& data : array_vec) {
+        auto array = std::static_pointer_cast<arrow::BinaryArray>(data);
+        for (int64_t i = 0; i < array->length(); i++, row++) {
+            if (array->IsNull(i)) {
+                continue;
+            }
+            auto code = codes.at(array->GetView(i));
+            if (code_bytes == sizeof(int8_t)) {
+                reinterpret_cast<int8_t*>(codes_.data())[row] =
+                    static_cast<int8_t>(code);
+            } else {
+                reinterpret_cast<int16_t*>(codes_.data())[row] =
+                    static_cast<int16_t>(code);
+            }
+        }
+    }
+    return size;
+}
+
 void
 StringChunkWriter::write_to_target(const arrow::ArrayVector& array_vec,
                                    const std::shared_ptr<ChunkTarget>& target) {
@@ -89,6 +185,30 @@ StringChunkWriter::write_to_target(const arrow::ArrayVector& array_vec,
         write_null_bit_maps(null_bitmaps, target);
     }
 
+    char padding[sizeof(int16_t) + MMAP_STRING_PADDING] = {};
+    if (!dictionary_.empty()) {
+        // dictionary layout: null bitmap, header with dictionary offsets,
+        // dictionary strings, codes aligned to their width, padding
+        target->write(dictionary_header_.data(),
+                      dictionary_header_.size() * sizeof(uint32_t));
+        for (const auto& value : dictionary_) {
+            target->write(value.data(), value.size());
+        }
+        if (codes_padding_ > 0) {
+            target->write(padding, codes_padding_);
+        }
+        target->write(codes_.data(), codes_.size());
+        target->write(padding, MMAP_STRING_PADDING);
+
+        dictionary_header_.clear();
+        dictionary_header_.shrink_to_fit();
+        dictionary_.clear();
+        dictionary_.shrink_to_fit();
+        codes_.clear();
+        codes_.shrink_to_fit();
+        return;
+    }
+
     target->write(offsets_.data(), offsets_.size() * sizeof(uint32_t));
 
     for (const auto& data : array_vec) {
@@ -103,7 +223,6 @@ StringChunkWriter::write_to_target(const arrow::ArrayVector& array_vec,
         }
     }
 
-    char padding[MMAP_STRING_PADDING] = {};
     target->write(padding, MMAP_STRING_PADDING);
 
     offsets_.clear();
@@ -548,6 +667,11 @@ create_chunk_writer(const FieldMeta& field_meta) {
                   ? field_meta.get_dim()
                   : 1;
     bool nullable = field_meta.is_nullable();
+    // System fields and the primary key, which sealed segments sort by,
+    // are read as plain arrays.
+    bool pack = ENABLE_PACKED_INT_CHUNK.load() &&
+                field_meta.get_id().get() >= START_USER_FIELDID &&
+                !field_meta.is_primary_key();
     switch (field_meta.get_data_type()) {
         case milvus::DataType::BOOL:
             return std::make_shared<ChunkWriter<arrow::BooleanArray, bool>>(
@@ -560,10 +684,10 @@ create_chunk_writer(const FieldMeta& field_meta) {
                 dim, nullable);
         case milvus::DataType::INT32:
             return std::make_shared<ChunkWriter<arrow::Int32Array, int32_t>>(
-                dim, nullable);
+                dim, nullable, pack);
         case milvus::DataType::INT64:
             return std::make_shared<ChunkWriter<arrow::Int64Array, int64_t>>(
-                dim, nullable);
+                dim, nullable, pack);
         case milvus::DataType::FLOAT:
             return std::make_shared<ChunkWriter<arrow::FloatArray, float>>(
                 dim, nullable);
@@ -641,7 +765,8 @@ make_chunk(const FieldMeta& field_meta,
            size_t row_nums,
            char* data,
            size_t size,
-           std::shared_ptr<ChunkMmapGuard> chunk_mmap_guard) {
+           std::shared_ptr<ChunkMmapGuard> chunk_mmap_guard,
+           bool packed = false) {
     int dim = IsVectorDataType(field_meta.get_data_type()) &&
                       !IsSparseFloatVectorDataType(field_meta.get_data_type())
                   ? field_meta.get_dim()
@@ -679,7 +804,8 @@ make_chunk(const FieldMeta& field_meta,
                                                      size,
                                                      sizeof(int32_t),
                                                      nullable,
-                                                     chunk_mmap_guard);
+                                                     chunk_mmap_guard,
+                                                     packed);
         case milvus::DataType::INT64:
             return std::make_unique<FixedWidthChunk>(row_nums,
                                                      dim,
@@ -687,7 +813,8 @@ make_chunk(const FieldMeta& field_meta,
                                                      size,
                                                      sizeof(int64_t),
                                                      nullable,
-                                                     chunk_mmap_guard);
+                                                     chunk_mmap_guard,
+                                                     packed);
         case milvus::DataType::FLOAT:
             return std::make_unique<FixedWidthChunk>(row_nums,
                                                      dim,
@@ -819,6 +946,7 @@ create_chunk_buffer(const FieldMeta& field_meta,
     buffer.data = data;
     buffer.size = size;
     buffer.row_nums = row_nums;
+    buffer.packed = cw->IsPacked();
     buffer.guard = std::move(chunk_mmap_guard);
     return buffer;
 }
@@ -829,8 +957,12 @@ make_chunk_from_buffer(const FieldMeta& field_meta,
                        size_t row_nums_override) {
     auto row_nums =
         row_nums_override == 0 ? buffer.row_nums : row_nums_override;
-    return make_chunk(
-        field_meta, row_nums, buffer.data, buffer.size, buffer.guard);
+    return make_chunk(field_meta,
+                      row_nums,
+                      buffer.data,
+                      buffer.size,
+                      buffer.guard,
+                      buffer.packed);
 }
 
 std::unique_ptr<Chunk>
@@ -936,7 +1068,8 @@ create_group_chunk(const std::vector<FieldId>& field_ids,
                                           final_row_nums,
                                           data + chunk_offsets[i],
                                           chunk_sizes[i],
-                                          chunk_mmap_guard);
+                                          chunk_mmap_guard,
+                                          cws[i]->IsPacked());
         LOG_INFO(
             "created chunk for field {} with chunk offset: {}, chunk "
             "size: {}, file path: {}",
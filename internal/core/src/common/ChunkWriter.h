@@ -13,10 +13,13 @@
 #include <simdjson.h>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -48,6 +51,12 @@ class ChunkWriterBase {
     write_to_target(const arrow::ArrayVector& array_vec,
                     const std::shared_ptr<ChunkTarget>& target) = 0;
 
+    // Whether calculate_size chose the packed layout of FixedWidthChunk.
+    bool
+    IsPacked() const {
+        return packed_;
+    }
+
  protected:
     void
     write_null_bit_maps(
@@ -90,12 +99,16 @@ class ChunkWriterBase {
  protected:
     size_t row_nums_ = 0;
     bool nullable_ = false;
+    bool packed_ = false;
 };
 
 template <typename ArrowType, typename T>
 class ChunkWriter final : public ChunkWriterBase {
  public:
-    ChunkWriter(int dim, bool nullable) : ChunkWriterBase(nullable), dim_(dim) {
+    // 'pack' allows the frame-of-reference layout of FixedWidthChunk for
+    // INT32 and INT64 data.
+    ChunkWriter(int dim, bool nullable, bool pack = false)
+        : ChunkWriterBase(nullable), dim_(dim), pack_(pack) {
     }
 
     std::pair<size_t, size_t>
@@ -111,6 +124,18 @@ class ChunkWriter final : public ChunkWriterBase {
             size += (row_nums + 7) / 8;
         }
         row_nums_ = row_nums;
+        packed_ = false;
+        if constexpr (std::is_same_v<T, int32_t> ||
+                      std::is_same_v<T, int64_t>) {
+            if (pack_ && dim_ == 1) {
+                code_bytes_ = PackedCodeBytes(array_vec);
+                packed_ = code_bytes_ != 0;
+            }
+        }
+        if (packed_) {
+            size = (nullable_ ? (row_nums + 7) / 8 : 0) +
+                   FixedWidthChunk::kPackedHeaderSize + row_nums * code_bytes_;
+        }
         return {size, row_nums};
     }
 
@@ -121,6 +146,7 @@ class ChunkWriter final : public ChunkWriterBase {
         // 1. Null bitmap (if nullable_=true): Indicates which values are null
         // 2. Data values: Contiguous storage of data elements in the order:
         //    data1, data2, ..., dataN where each data element has size dim_*sizeof(T)
+        //    or, when packed, the header and codes described in FixedWidthChunk
         if (nullable_) {
             // tuple <data, size, offset>
             std::vector<std::tuple<const uint8_t*, int64_t, int64_t>>
@@ -132,6 +158,23 @@ class ChunkWriter final : public ChunkWriterBase {
             write_null_bit_maps(null_bitmaps, target);
         }
 
+        if constexpr (std::is_same_v<T, int32_t> ||
+                      std::is_same_v<T, int64_t>) {
+            if (packed_) {
+                switch (code_bytes_) {
+                    case sizeof(int8_t):
+                        WritePacked<int8_t>(array_vec, target);
+                        return;
+                    case sizeof(int16_t):
+                        WritePacked<int16_t>(array_vec, target);
+                        return;
+                    default:
+                        WritePacked<int32_t>(array_vec, target);
+                        return;
+                }
+            }
+        }
+
         for (const auto& data : array_vec) {
             auto array = std::static_pointer_cast<ArrowType>(data);
             auto data_ptr = array->raw_values();
@@ -140,7 +183,83 @@ class ChunkWriter final : public ChunkWriterBase {
     }
 
  private:
+    // The narrowest code width that holds max - min of the valid values, or
+    // 0 if no width is narrower than T.
+    size_t
+    PackedCodeBytes(const arrow::ArrayVector& array_vec) {
+        bool has_value = false;
+        T min = 0;
+        T max = 0;
+        for (const auto& data : array_vec) {
+            auto array = std::static_pointer_cast<ArrowType>(data);
+            auto values = array->raw_values();
+            for (int64_t i = 0; i < array->length(); i++) {
+                if (array->IsNull(i)) {
+                    continue;
+                }
+                if (!has_value || values[i] < min) {
+                    min = values[i];
+                }
+                if (!has_value || values[i] > max) {
+                    max = values[i];
+                }
+                has_value = true;
+            }
+        }
+        if (!has_value) {
+            return 0;
+        }
+        min_ = min;
+        // Wrapping subtraction gives max - min exactly, it is non-negative.
+        auto span = static_cast<uint64_t>(static_cast<int64_t>(max)) -
+                    static_cast<uint64_t>(static_cast<int64_t>(min));
+        for (size_t code_bytes : {sizeof(int8_t), sizeof(int16_t)}) {
+            if (span < (uint64_t{1} << (8 * code_bytes))) {
+                return code_bytes;
+            }
+        }
+        if (sizeof(T) > sizeof(int32_t) &&
+            span <= std::numeric_limits<uint32_t>::max()) {
+            return sizeof(int32_t);
+        }
+        return 0;
+    }
+
+    template <typename Code>
+    void
+    WritePacked(const arrow::ArrayVector& array_vec,
+                const std::shared_ptr<ChunkTarget>& target) {
+        char header[FixedWidthChunk::kPackedHeaderSize] = {};
+        auto code_bytes = static_cast<uint32_t>(sizeof(Code));
+        std::memcpy(header, &min_, sizeof(int64_t));
+        std::memcpy(header + sizeof(int64_t), &code_bytes, sizeof(uint32_t));
+        target->write(header, sizeof(header));
+
+        // Null rows keep the code of min.
+        constexpr uint64_t bias = uint64_t{1} << (8 * sizeof(Code) - 1);
+        std::vector<Code> codes;
+        for (const auto& data : array_vec) {
+            auto array = std::static_pointer_cast<ArrowType>(data);
+            auto values = array->raw_values();
+            codes.assign(array->length(),
+                         static_cast<Code>(-static_cast<int64_t>(bias)));
+            for (int64_t i = 0; i < array->length(); i++) {
+                if (array->IsNull(i)) {
+                    continue;
+                }
+                auto delta = static_cast<uint64_t>(int64_t{values[i]}) -
+                             static_cast<uint64_t>(min_);
+                codes[i] = static_cast<Code>(static_cast<int64_t>(delta) -
+                                             static_cast<int64_t>(bias));
+            }
+            target->write(codes.data(), codes.size() * sizeof(Code));
+        }
+    }
+
     const int64_t dim_;
+    const bool pack_;
+    size_t code_bytes_{0};
+    int64_t min_{0};
 };
 
 template <typename T>
@@ -229,12 +348,29 @@ class StringChunkWriter : public ChunkWriterBase {
     write_to_target(const arrow::ArrayVector& array_vec,
                     const std::shared_ptr<ChunkTarget>& target) override;
 
+    // Largest dictionary of a dictionary-encoded chunk, bounded by the 2 byte
+    // codes.
+    static constexpr size_t kMaxDictionarySize =
+        std::numeric_limits<int16_t>::max();
+
  private:
+    // Prepares the dictionary layout and returns its size when it is at most
+    // half of 'plain_size', otherwise returns 0 and keeps the plain layout.
+    size_t
+    BuildDictionary(const arrow::ArrayVector& array_vec, size_t plain_size);
+
     // Pre-computed absolute offsets (offsets_[i] = byte offset of row i from
     // chunk start, offsets_[row_nums_] = end offset). Populated in
     // calculate_size, consumed in write_to_target to avoid a second pass over
     // Arrow for sizing.
     std::vector<uint32_t> offsets_;
+
+    // Dictionary layout, see StringChunk. The header holds the marker fields
+    // and the dictionary offsets, and the views point into the Arrow arrays.
+    std::vector<uint32_t> dictionary_header_;
+    std::vector<std::string_view> dictionary_;
+    size_t codes_padding_ = 0;
+    std::vector<char> codes_;
 };
 
 class JSONChunkWriter : public ChunkWriterBase {
@@ -332,6 +468,8 @@ struct ChunkBuffer {
     char* data{nullptr};
     size_t size{0};
     size_t row_nums{0};
+    // Whether the data uses the packed layout of FixedWidthChunk.
+    bool packed{false};
     std::shared_ptr<ChunkMmapGuard> guard;
 };
 
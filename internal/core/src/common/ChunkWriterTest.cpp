@@ -21,6 +21,8 @@
 #include <gtest/gtest.h>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <random>
@@ -37,9 +39,16 @@
 #include "common/Types.h"
 #include "gtest/gtest.h"
 
+using milvus::ChunkWriter;
 using milvus::DataType;
+using milvus::FixedWidthChunk;
 using milvus::MemChunkTarget;
 using milvus::MMAP_ARRAY_PADDING;
+using milvus::StringChunk;
+using milvus::StringChunkWriter;
+using milvus::StringDictionaryMatches;
+using milvus::TargetBitmap;
+using milvus::TargetBitmapView;
 using milvus::VectorArrayChunk;
 using milvus::VectorArrayChunkWriter;
 
@@ -454,6 +463,227 @@ TEST(VectorArrayChunkWriterTest, NullableRowsRoundTripThroughChunkViews) {
     EXPECT_EQ(chunk.View(2).length(), 0);
 }
 
+TEST(StringChunkWriterTest, DictionaryEncodesLowCardinality) {
+    const std::vector<std::string> dictionary = {"delta", "alpha", "beta"};
+    arrow::BinaryBuilder builder;
+    std::vector<std::optional<std::string>> rows;
+    for (int i = 0; i < 1000; i++) {
+        if (i % 10 == 3) {
+            rows.emplace_back(std::nullopt);
+            EXPECT_TRUE(builder.AppendNull().ok());
+        } else {
+            rows.emplace_back(dictionary[i % dictionary.size()]);
+            EXPECT_TRUE(builder.Append(*rows.back()).ok());
+        }
+    }
+    std::shared_ptr<arrow::Array> array;
+    EXPECT_TRUE(builder.Finish(&array).ok());
+
+    // Split the rows over two arrays, as for a chunk of several batches.
+    arrow::ArrayVector vec{array->Slice(0, 600), array->Slice(600)};
+    StringChunkWriter writer(true);
+    auto [size, row_count] = writer.calculate_size(vec);
+    ASSERT_EQ(row_count, rows.size());
+    auto target = std::make_shared<MemChunkTarget>(size);
+    writer.write_to_target(vec, target);
+    StringChunk chunk(row_count, target->release(), size, true, nullptr);
+
+    ASSERT_TRUE(chunk.IsDictionaryEncoded());
+    EXPECT_EQ(chunk.DictionarySize(), 3);
+    auto [views, valid] = chunk.StringViews(std::make_pair(100, 200));
+    for (int i = 0; i < static_cast<int>(rows.size()); i++) {
+        ASSERT_EQ(chunk.isValid(i), rows[i].has_value());
+        if (rows[i].has_value()) {
+            ASSERT_EQ(chunk[i], *rows[i]);
+        }
+        if (i >= 100 && i < 300 && rows[i].has_value()) {
+            ASSERT_EQ(views[i - 100], *rows[i]);
+        }
+    }
+
+    auto check = [&](const std::function<bool(std::string_view)>& pred,
+                     bool contiguous) {
+        auto matches = chunk.MatchDictionary(
+            [&](const std::string_view* values,
+                int64_t n,
+                TargetBitmapView res) {
+                for (int64_t i = 0; i < n; i++) {
+                    res[i] = pred(values[i]);
+                }
+            });
+        EXPECT_EQ(matches.range.has_value(), contiguous);
+        TargetBitmap bitmap(500, false);
+        chunk.MatchCodes(
+            matches, 250, 500, TargetBitmapView(bitmap.data(), 500));
+        for (int i = 0; i < 500; i++) {
+            auto& row = rows[i + 250];
+            if (row.has_value()) {
+                ASSERT_EQ(bitmap[i], pred(*row)) << i;
+            }
+        }
+    };
+    check([](std::string_view v) { return v == "beta"; }, true);
+    check([](std::string_view v) { return v < "c"; }, true);
+    check([](std::string_view v) { return v == "zeta"; }, true);
+    // alpha and delta are not adjacent in sorted code order.
+    check([](std::string_view v) { return v != "beta"; }, false);
+}
+
+TEST(StringChunkWriterTest, HighCardinalityStaysPlain) {
+    arrow::BinaryBuilder builder;
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_TRUE(builder.Append("value_" + std::to_string(i)).ok());
+    }
+    std::shared_ptr<arrow::Array> array;
+    EXPECT_TRUE(builder.Finish(&array).ok());
+
+    arrow::ArrayVector vec{array};
+    StringChunkWriter writer(false);
+    auto [size, row_count] = writer.calculate_size(vec);
+    auto target = std::make_shared<MemChunkTarget>(size);
+    writer.write_to_target(vec, target);
+    StringChunk chunk(row_count, target->release(), size, false, nullptr);
+
+    EXPECT_FALSE(chunk.IsDictionaryEncoded());
+    for (int i = 0; i < row_count; i++) {
+        ASSERT_EQ(chunk[i], "value_" + std::to_string(i));
+    }
+}
+
+TEST(PackedIntChunkTest, CompareOnCodes) {
+    using milvus::bitset::CompareOpType;
+    using milvus::bitset::RangeType;
+    // Spans that fit 1, 2 and 4 byte codes, one of them at the int64 limit.
+    for (auto [min, span] : std::vector<std::pair<int64_t, int64_t>>{
+             {-100, 200},
+             {1000000, 60000},
+             {std::numeric_limits<int64_t>::max() - 3000000000, 3000000000}}) {
+        std::default_random_engine gen(42);
+        std::uniform_int_distribution<int64_t> dist(0, span);
+        std::vector<std::optional<int64_t>> rows;
+        for (int i = 0; i < 1000; i++) {
+            if (i % 7 == 0) {
+                rows.emplace_back(std::nullopt);
+            } else {
+                rows.emplace_back(min + dist(gen));
+            }
+        }
+        rows[1] = min;
+        rows[2] = min + span;
+        arrow::Int64Builder builder;
+        for (const auto& row : rows) {
+            EXPECT_TRUE(row.has_value() ? builder.Append(*row).ok()
+                                        : builder.AppendNull().ok());
+        }
+        std::shared_ptr<arrow::Array> array;
+        EXPECT_TRUE(builder.Finish(&array).ok());
+
+        arrow::ArrayVector vec{array->Slice(0, 400), array->Slice(400)};
+        ChunkWriter<arrow::Int64Array, int64_t> writer(1, true, true);
+        auto [size, row_count] = writer.calculate_size(vec);
+        ASSERT_TRUE(writer.IsPacked());
+        ASSERT_LE(size, rows.size() * sizeof(int64_t) / 2 + 256);
+        auto target = std::make_shared<MemChunkTarget>(size);
+        writer.write_to_target(vec, target);
+        FixedWidthChunk chunk(row_count,
+                              1,
+                              target->release(),
+                              size,
+                              sizeof(int64_t),
+                              true,
+                              nullptr,
+                              true);
+        ASSERT_TRUE(chunk.IsPacked());
+
+        // packed chunks only hand out decoded copies
+        EXPECT_ANY_THROW(chunk.Data());
+        auto decoded = chunk.DecodePacked();
+        auto values = reinterpret_cast<const int64_t*>(decoded.get());
+        for (int i = 0; i < static_cast<int>(rows.size()); i++) {
+            ASSERT_EQ(chunk.isValid(i), rows[i].has_value());
+            if (rows[i].has_value()) {
+                ASSERT_EQ(values[i], *rows[i]);
+            }
+        }
+        std::vector<int64_t> range(100);
+        chunk.DecodePacked(
+            350, range.size(), reinterpret_cast<char*>(range.data()));
+        for (int i = 0; i < static_cast<int>(range.size()); i++) {
+            if (rows[350 + i].has_value()) {
+                ASSERT_EQ(range[i], *rows[350 + i]);
+            }
+        }
+
+        // Evaluates rows [200, 800) and compares with 'pred' on the rows.
+        auto check = [&](auto pred, auto eval) {
+            TargetBitmap bitmap(600, false);
+            eval(TargetBitmapView(bitmap.data(), 600));
+            for (int i = 0; i < 600; i++) {
+                auto& row = rows[i + 200];
+                if (row.has_value()) {
+                    ASSERT_EQ(bitmap[i], pred(*row)) << i;
+                }
+            }
+        };
+        auto compare = [&](CompareOpType op, int64_t value, auto pred) {
+            check(pred, [&](TargetBitmapView res) {
+                chunk.PackedCompare(op, value, 200, 600, res);
+            });
+        };
+        auto within = [&](RangeType range, int64_t lower, int64_t upper) {
+            check(
+                [&](int64_t v) {
+                    bool lower_inclusive = range == RangeType::IncInc ||
+                                           range == RangeType::IncExc;
+                    bool upper_inclusive = range == RangeType::IncInc ||
+                                           range == RangeType::ExcInc;
+                    return (lower_inclusive ? v >= lower : v > lower) &&
+                           (upper_inclusive ? v <= upper : v < upper);
+                },
+                [&](TargetBitmapView res) {
+                    chunk.PackedWithinRange(range, lower, upper, 200, 600, res);
+                });
+        };
+        for (int64_t value : {std::numeric_limits<int64_t>::min(),
+                              min - 1,
+                              min,
+                              min + span / 2,
+                              min + span,
+                              std::numeric_limits<int64_t>::max()}) {
+            compare(CompareOpType::LT, value, [&](int64_t v) {
+                return v < value;
+            });
+            compare(CompareOpType::GE, value, [&](int64_t v) {
+                return v >= value;
+            });
+            compare(CompareOpType::EQ, value, [&](int64_t v) {
+                return v == value;
+            });
+            compare(CompareOpType::NE, value, [&](int64_t v) {
+                return v != value;
+            });
+            within(RangeType::IncExc, value, min + span / 3);
+            within(RangeType::ExcInc, min, value);
+            within(RangeType::IncInc, value, value);
+        }
+    }
+}
+
+TEST(PackedIntChunkTest, WideSpanStaysPlain) {
+    arrow::Int32Builder builder;
+    for (int32_t i = 0; i < 1000; i++) {
+        EXPECT_TRUE(builder.Append(i * 1000).ok());
+    }
+    std::shared_ptr<arrow::Array> array;
+    EXPECT_TRUE(builder.Finish(&array).ok());
+
+    // A span over 65535 would need 4 byte codes, which saves nothing on int32.
+    ChunkWriter<arrow::Int32Array, int32_t> writer(1, false, true);
+    auto [size, row_count] = writer.calculate_size({array});
+    EXPECT_FALSE(writer.IsPacked());
+    EXPECT_EQ(size, row_count * sizeof(int32_t));
+}
+
 // Instantiate parameterized tests for all vector types
 INSTANTIATE_TEST_SUITE_P(
     VectorTypes,
@@ -31,6 +31,12 @@ std::atomic<int64_t> FILE_SLICE_SIZE(DEFAULT_INDEX_FILE_SLICE_SIZE);
 std::atomic<int64_t> EXEC_EVAL_EXPR_BATCH_SIZE(
     DEFAULT_EXEC_EVAL_EXPR_BATCH_SIZE);
 std::atomic<int64_t> DELETE_DUMP_BATCH_SIZE(DEFAULT_DELETE_DUMP_BATCH_SIZE);
+std::atomic<int64_t> SEARCH_BATCH_WINDOW_US(DEFAULT_SEARCH_BATCH_WINDOW_US);
+std::atomic<int64_t> SEARCH_BATCH_MAX_NQ(DEFAULT_SEARCH_BATCH_MAX_NQ);
+std::atomic<int64_t> GROWING_SEARCH_PARALLELISM(
+    DEFAULT_GROWING_SEARCH_PARALLELISM);
+std::atomic<int64_t> READ_RANGES_MAX_GAP(DEFAULT_READ_RANGES_MAX_GAP);
+std::atomic<int64_t> READ_RANGES_PARALLELISM(DEFAULT_READ_RANGES_PARALLELISM);
 std::atomic<bool> ENABLE_LATEST_DELETE_SNAPSHOT_OPTIMIZATION(
     DEFAULT_ENABLE_LATEST_DELETE_SNAPSHOT_OPTIMIZATION);
 std::atomic<bool> OPTIMIZE_EXPR_ENABLED(DEFAULT_OPTIMIZE_EXPR_ENABLED);
@@ -44,6 +50,7 @@ std::atomic<bool> CONFIG_PARAM_TYPE_CHECK_ENABLED(
     DEFAULT_CONFIG_PARAM_TYPE_CHECK_ENABLED);
 std::atomic<bool> ENABLE_PARQUET_STATS_SKIP_INDEX(
     DEFAULT_ENABLE_PARQUET_STATS_SKIP_INDEX);
+std::atomic<bool> ENABLE_PACKED_INT_CHUNK(DEFAULT_ENABLE_PACKED_INT_CHUNK);
 
 void
 SetIndexSliceSize(const int64_t size) {
@@ -76,6 +83,41 @@ SetDefaultDeleteDumpBatchSize(int64_t val) {
              DELETE_DUMP_BATCH_SIZE.load());
 }
 
+void
+SetDefaultSearchBatchWindow(int64_t window_us) {
+    SEARCH_BATCH_WINDOW_US.store(window_us);
+    LOG_INFO("set default search batch window: {}us",
+             SEARCH_BATCH_WINDOW_US.load());
+}
+
+void
+SetDefaultSearchBatchMaxNq(int64_t val) {
+    SEARCH_BATCH_MAX_NQ.store(val);
+    LOG_INFO("set default search batch max nq: {}",
+             SEARCH_BATCH_MAX_NQ.load());
+}
+
+void
+SetDefaultGrowingSearchParallelism(int64_t val) {
+    GROWING_SEARCH_PARALLELISM.store(val);
+    LOG_INFO("set default growing search parallelism: {}",
+             GROWING_SEARCH_PARALLELISM.load());
+}
+
+void
+SetDefaultReadRangesMaxGap(int64_t val) {
+    READ_RANGES_MAX_GAP.store(val);
+    LOG_INFO("set default read ranges max gap: {}",
+             READ_RANGES_MAX_GAP.load());
+}
+
+void
+SetDefaultReadRangesParallelism(int64_t val) {
+    READ_RANGES_PARALLELISM.store(val);
+    LOG_INFO("set default read ranges parallelism: {}",
+             READ_RANGES_PARALLELISM.load());
+}
+
 void
 SetDefaultOptimizeExprEnable(bool val) {
     OPTIMIZE_EXPR_ENABLED.store(val);
@@ -118,6 +160,13 @@ SetDefaultEnableParquetStatsSkipIndex(bool val) {
              ENABLE_PARQUET_STATS_SKIP_INDEX.load());
 }
 
+void
+SetDefaultPackedIntChunkEnable(bool val) {
+    ENABLE_PACKED_INT_CHUNK.store(val);
+    LOG_INFO("set default packed int chunk enable: {}",
+             ENABLE_PACKED_INT_CHUNK.load());
+}
+
 void
 SetEnableLatestDeleteSnapshotOptimization(bool val) {
     ENABLE_LATEST_DELETE_SNAPSHOT_OPTIMIZATION.store(val);
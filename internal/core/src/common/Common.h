@@ -28,6 +28,18 @@ namespace milvus {
 extern std::atomic<int64_t> FILE_SLICE_SIZE;
 extern std::atomic<int64_t> EXEC_EVAL_EXPR_BATCH_SIZE;
 extern std::atomic<int64_t> DELETE_DUMP_BATCH_SIZE;
+// How long a search waits for compatible searches on the same segment to
+// share its execution with, 0 to disable batching.
+extern std::atomic<int64_t> SEARCH_BATCH_WINDOW_US;
+// Maximum total nq of a shared search.
+extern std::atomic<int64_t> SEARCH_BATCH_MAX_NQ;
+// Maximum threads a growing segment brute-force search runs its chunks on.
+extern std::atomic<int64_t> GROWING_SEARCH_PARALLELISM;
+// ChunkManager::ReadRanges fetches ranges at most this many bytes apart with
+// one request.
+extern std::atomic<int64_t> READ_RANGES_MAX_GAP;
+// Maximum requests one ChunkManager::ReadRanges call runs concurrently.
+extern std::atomic<int64_t> READ_RANGES_PARALLELISM;
 extern std::atomic<bool> ENABLE_LATEST_DELETE_SNAPSHOT_OPTIMIZATION;
 extern std::atomic<bool> OPTIMIZE_EXPR_ENABLED;
 extern std::atomic<bool> ENABLE_DRIVER_PREFETCH;
@@ -35,6 +47,8 @@ extern std::atomic<bool> JSON_KEY_STATS_ENABLED;
 extern std::atomic<bool> GROWING_JSON_KEY_STATS_ENABLED;
 extern std::atomic<bool> CONFIG_PARAM_TYPE_CHECK_ENABLED;
 extern std::atomic<bool> ENABLE_PARQUET_STATS_SKIP_INDEX;
+// Whether sealed INT32/INT64 chunks may be frame-of-reference packed.
+extern std::atomic<bool> ENABLE_PACKED_INT_CHUNK;
 
 void
 SetIndexSliceSize(const int64_t size);
@@ -48,6 +62,21 @@ SetDefaultExecEvalExprBatchSize(int64_t val);
 void
 SetDefaultDeleteDumpBatchSize(int64_t val);
 
+void
+SetDefaultSearchBatchWindow(int64_t window_us);
+
+void
+SetDefaultSearchBatchMaxNq(int64_t val);
+
+void
+SetDefaultGrowingSearchParallelism(int64_t val);
+
+void
+SetDefaultReadRangesMaxGap(int64_t val);
+
+void
+SetDefaultReadRangesParallelism(int64_t val);
+
 void
 SetDefaultOptimizeExprEnable(bool val);
 
@@ -66,6 +95,9 @@ SetDefaultConfigParamTypeCheck(bool val);
 void
 SetDefaultEnableParquetStatsSkipIndex(bool val);
 
+void
+SetDefaultPackedIntChunkEnable(bool val);
+
 void
 SetEnableLatestDeleteSnapshotOptimization(bool val);
 
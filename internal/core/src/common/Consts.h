@@ -91,6 +91,21 @@ const int64_t DEFAULT_EXEC_EVAL_EXPR_BATCH_SIZE = 8192;
 
 const int64_t DEFAULT_DELETE_DUMP_BATCH_SIZE = 10000;
 
+const int64_t DEFAULT_SEARCH_BATCH_WINDOW_US = 0;
+
+const int64_t DEFAULT_SEARCH_BATCH_MAX_NQ = 64;
+
+const int64_t DEFAULT_GROWING_SEARCH_PARALLELISM = 1;
+
+const int64_t DEFAULT_READ_RANGES_MAX_GAP = 1 << 20;  // bytes
+
+const int64_t DEFAULT_READ_RANGES_MAX_MERGED_SIZE = 64 << 20;  // bytes
+
+const int64_t DEFAULT_READ_RANGES_PARALLELISM = 8;
+
+// memory budget of extracted JSON path values, 0 disables the cache
+const int64_t DEFAULT_JSON_PATH_CACHE_CAPACITY = 0;  // bytes
+
 const bool DEFAULT_ENABLE_LATEST_DELETE_SNAPSHOT_OPTIMIZATION = true;
 
 constexpr const char* COLLECTION_TTL_FIELD_KEY = "ttl_field";
@@ -119,10 +134,13 @@ const bool DEFAULT_JSON_KEY_STATS_ENABLED = true;
 const bool DEFAULT_GROWING_JSON_KEY_STATS_ENABLED = false;
 const bool DEFAULT_CONFIG_PARAM_TYPE_CHECK_ENABLED = true;
 const bool DEFAULT_ENABLE_PARQUET_STATS_SKIP_INDEX = false;
+const bool DEFAULT_ENABLE_PACKED_INT_CHUNK = false;
 
 // skipindex stats related
 const double DEFAULT_BLOOM_FILTER_FALSE_POSITIVE_RATE = 0.01;
 const int64_t DEFAULT_SKIPINDEX_MIN_NGRAM_LENGTH = 3;
+// rows per page-level zone map inside a sealed chunk, 0 disables pages
+const int64_t DEFAULT_SKIPINDEX_PAGE_ROWS = 2048;
 
 // index config related
 const std::string SEGMENT_INSERT_FILES_KEY = "segment_insert_files";
@@ -275,6 +275,17 @@ class FieldMeta {
         return nullable_;
     }
 
+    // Set by the schema on its primary key field.
+    bool
+    is_primary_key() const {
+        return is_primary_key_;
+    }
+
+    void
+    set_primary_key(bool is_primary_key) {
+        is_primary_key_ = is_primary_key;
+    }
+
     bool
     NeedLoad() const {
         return external_field_mapping_.empty();
@@ -361,6 +372,7 @@ class FieldMeta {
     DataType type_ = DataType::NONE;
     DataType element_type_ = DataType::NONE;
     bool nullable_;
+    bool is_primary_key_ = false;
     std::optional<DefaultValueType> default_value_;
     std::optional<VectorInfo> vector_info_;
     std::optional<StringInfo> string_info_;
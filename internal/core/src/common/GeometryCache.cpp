@@ -0,0 +1,328 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "common/GeometryCache.h"
+
+#include <boost/geometry/index/rtree.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+#include "boost/geometry/core/cs.hpp"
+#include "boost/geometry/geometries/box.hpp"
+#include "boost/geometry/geometries/point.hpp"
+#include "boost/geometry/index/parameters.hpp"
+#include "boost/iterator/function_output_iterator.hpp"
+
+namespace milvus {
+namespace exec {
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+namespace {
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+constexpr double kPi = 3.14159265358979323846;
+// Must match Geometry::dwithin.
+constexpr double kEarthRadiusMeters = 6371000.0;
+constexpr double kMetersPerDegreeLat = 111320.0;
+
+// Widens a box half size computed with trigonometry, so that rounding can
+// not prune a row right at the distance limit.
+double
+Pad(double half_size) {
+    return half_size * (1 + 1e-9) + 1e-9;
+}
+
+// Box of the rows that may be within 'distance' meters of the point
+// (lon, lat) under Geometry::dwithin: by haversine distance for points and
+// by GEOS distance in degrees, scaled at the query latitude, for others.
+// Rows outside the lon/lat domain are left to BoxFilter::geodesic.
+std::optional<BoxFilter>
+MakeDWithinBoxFilter(double lon, double lat, double distance) {
+    if (!(distance >= 0) || !std::isfinite(lon) || std::abs(lat) > 90.0) {
+        return std::nullopt;
+    }
+    // GEOS distance: degrees * meters_per_degree <= distance
+    double lat_rad = lat * kPi / 180.0;
+    double meters_per_degree =
+        kMetersPerDegreeLat *
+        std::sqrt((1.0 + std::cos(lat_rad) * std::cos(lat_rad)) / 2.0);
+    double planar = Pad(distance / meters_per_degree);
+
+    // Haversine: a great circle of angle c spans at most c in latitude, and
+    // sin(c / 2) >= cos(lat_max) * sin(dlon / 2) for rows whose latitude is
+    // within the band left by the latitude bound.
+    double angle = distance / kEarthRadiusMeters;
+    if (angle >= kPi) {
+        return std::nullopt;
+    }
+    double dlat = Pad(angle * 180.0 / kPi);
+    double dlon = kInf;
+    double lat_max = std::abs(lat) + dlat;
+    if (lat_max < 90.0) {
+        double s = std::sin(angle / 2) / std::cos(lat_max * kPi / 180.0);
+        if (s < 1.0) {
+            dlon = Pad(2 * std::asin(s) * 180.0 / kPi);
+        }
+    }
+
+    BoxFilter filter;
+    filter.geodesic = true;
+    double half_x = std::max(planar, dlon);
+    double half_y = std::max(planar, dlat);
+    filter.box.min_y = lat - half_y;
+    filter.box.max_y = lat + half_y;
+    if (lon - half_x >= -180.0 && lon + half_x <= 180.0) {
+        filter.box.min_x = lon - half_x;
+        filter.box.max_x = lon + half_x;
+    } else {
+        // the longitude range wraps around, only prune by latitude
+        filter.box.min_x = -kInf;
+        filter.box.max_x = kInf;
+    }
+    return filter;
+}
+
+}  // namespace
+
+BoundingBox
+BoundingBox::Of(GEOSContextHandle_t ctx, const GEOSGeometry* geometry) {
+    BoundingBox box;
+    if (geometry == nullptr || GEOSisEmpty_r(ctx, geometry) != 0) {
+        return box;
+    }
+    BoundingBox out;
+    if (GEOSGeom_getXMin_r(ctx, geometry, &out.min_x) != 1 ||
+        GEOSGeom_getYMin_r(ctx, geometry, &out.min_y) != 1 ||
+        GEOSGeom_getXMax_r(ctx, geometry, &out.max_x) != 1 ||
+        GEOSGeom_getYMax_r(ctx, geometry, &out.max_y) != 1) {
+        return box;
+    }
+    return out;
+}
+
+std::optional<BoxFilter>
+MakeBoxFilter(proto::plan::GISFunctionFilterExpr_GISOp op,
+              const Geometry& query,
+              double distance) {
+    auto ctx = GetThreadLocalGEOSContext();
+    auto box = BoundingBox::Of(ctx, query.GetGeometry());
+    if (box.IsEmpty()) {
+        return std::nullopt;
+    }
+    BoxFilter filter;
+    filter.box = box;
+    switch (op) {
+        case proto::plan::GISFunctionFilterExpr_GISOp_Equals:
+        case proto::plan::GISFunctionFilterExpr_GISOp_Touches:
+        case proto::plan::GISFunctionFilterExpr_GISOp_Overlaps:
+        case proto::plan::GISFunctionFilterExpr_GISOp_Crosses:
+        case proto::plan::GISFunctionFilterExpr_GISOp_Intersects:
+            filter.relation = BoxFilter::Relation::kIntersects;
+            return filter;
+        case proto::plan::GISFunctionFilterExpr_GISOp_Within:
+            filter.relation = BoxFilter::Relation::kWithin;
+            return filter;
+        case proto::plan::GISFunctionFilterExpr_GISOp_Contains:
+            filter.relation = BoxFilter::Relation::kContains;
+            return filter;
+        case proto::plan::GISFunctionFilterExpr_GISOp_DWithin: {
+            if (GEOSGeomTypeId_r(ctx, query.GetGeometry()) != GEOS_POINT) {
+                return std::nullopt;
+            }
+            return MakeDWithinBoxFilter(box.min_x, box.min_y, distance);
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
+struct SimpleGeometryCache::SpatialIndex {
+    using Point = bg::model::point<double, 2, bg::cs::cartesian>;
+    using Box = bg::model::box<Point>;
+    using Value = std::pair<Box, int64_t>;  // (MBR, row_offset)
+    // quadratic split keeps incremental inserts cheap on ingest
+    using RTree = bgi::rtree<Value, bgi::quadratic<16>>;
+
+    void
+    Insert(const BoundingBox& box, int64_t offset) {
+        // null and empty geometries satisfy no predicate
+        if (box.IsEmpty()) {
+            return;
+        }
+        rtree.insert(Value(Box(Point(box.min_x, box.min_y),
+                               Point(box.max_x, box.max_y)),
+                           offset));
+        if (box.min_x < -180.0 || box.max_x > 180.0 || box.min_y < -90.0 ||
+            box.max_y > 90.0) {
+            off_domain_rows.push_back(offset);
+        }
+    }
+
+    RTree rtree;
+    // rows outside the lon/lat domain, see BoxFilter::geodesic
+    std::vector<int64_t> off_domain_rows;
+};
+
+SimpleGeometryCache::SimpleGeometryCache() = default;
+
+SimpleGeometryCache::~SimpleGeometryCache() = default;
+
+void
+SimpleGeometryCache::AppendData(GEOSContextHandle_t ctx,
+                                const char* wkb_data,
+                                size_t size) {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+
+    if (size == 0 || wkb_data == nullptr) {
+        // Handle null/empty geometry - add invalid geometry
+        geometries_.emplace_back();
+        AppendBoxLocked(BoundingBox());
+    } else {
+        try {
+            // Create geometry with cache's context
+            geometries_.emplace_back(ctx, wkb_data, size);
+        } catch (const std::exception& e) {
+            ThrowInfo(UnexpectedError,
+                      "Failed to construct geometry from WKB data: {}",
+                      e.what());
+        }
+        AppendBoxLocked(
+            BoundingBox::Of(ctx, geometries_.back().GetGeometry()));
+    }
+}
+
+void
+SimpleGeometryCache::EnableSpatialIndex() {
+    std::lock_guard<std::shared_mutex> lock(mutex_);
+    if (spatial_index_ != nullptr) {
+        return;
+    }
+    spatial_index_ = std::make_unique<SpatialIndex>();
+    for (size_t i = 0; i < min_x_.size(); ++i) {
+        spatial_index_->Insert({min_x_[i], min_y_[i], max_x_[i], max_y_[i]},
+                               static_cast<int64_t>(i));
+    }
+}
+
+void
+SimpleGeometryCache::AppendBoxLocked(const BoundingBox& box) {
+    auto offset = static_cast<int64_t>(min_x_.size());
+    min_x_.push_back(box.min_x);
+    min_y_.push_back(box.min_y);
+    max_x_.push_back(box.max_x);
+    max_y_.push_back(box.max_y);
+    if (spatial_index_ != nullptr) {
+        spatial_index_->Insert(box, offset);
+    }
+}
+
+void
+SimpleGeometryCache::FilterByBoxUnsafe(const BoxFilter& filter,
+                                       size_t offset,
+                                       size_t size,
+                                       uint8_t* out) const {
+    AssertInfo(offset + size <= min_x_.size(),
+               "box filter range [{}, {}) is out of range: {}",
+               offset,
+               offset + size,
+               min_x_.size());
+    const double* min_x = min_x_.data() + offset;
+    const double* min_y = min_y_.data() + offset;
+    const double* max_x = max_x_.data() + offset;
+    const double* max_y = max_y_.data() + offset;
+    const auto& b = filter.box;
+    // Branch free loops over the flat columns, so that they vectorize.
+    switch (filter.relation) {
+        case BoxFilter::Relation::kIntersects: {
+            if (filter.geodesic) {
+                for (size_t i = 0; i < size; ++i) {
+                    bool x = (min_x[i] <= b.max_x) & (max_x[i] >= b.min_x);
+                    bool y = (min_y[i] <= b.max_y) & (max_y[i] >= b.min_y);
+                    bool off_domain = (min_x[i] < -180.0) | (max_x[i] > 180.0) |
+                                      (min_y[i] < -90.0) | (max_y[i] > 90.0);
+                    out[i] = (x & y) | off_domain;
+                }
+            } else {
+                for (size_t i = 0; i < size; ++i) {
+                    bool x = (min_x[i] <= b.max_x) & (max_x[i] >= b.min_x);
+                    bool y = (min_y[i] <= b.max_y) & (max_y[i] >= b.min_y);
+                    out[i] = x & y;
+                }
+            }
+            break;
+        }
+        case BoxFilter::Relation::kWithin: {
+            for (size_t i = 0; i < size; ++i) {
+                bool x = (min_x[i] >= b.min_x) & (max_x[i] <= b.max_x);
+                bool y = (min_y[i] >= b.min_y) & (max_y[i] <= b.max_y);
+                out[i] = x & y;
+            }
+            break;
+        }
+        case BoxFilter::Relation::kContains: {
+            for (size_t i = 0; i < size; ++i) {
+                bool x = (min_x[i] <= b.min_x) & (max_x[i] >= b.max_x);
+                bool y = (min_y[i] <= b.min_y) & (max_y[i] >= b.max_y);
+                out[i] = x & y;
+            }
+            break;
+        }
+    }
+}
+
+bool
+SimpleGeometryCache::QueryCandidatesUnsafe(const BoxFilter& filter,
+                                           TargetBitmap& candidates) const {
+    if (spatial_index_ == nullptr) {
+        return false;
+    }
+    candidates.clear();
+    candidates.resize(min_x_.size(), false);
+    using Point = SpatialIndex::Point;
+    using Box = SpatialIndex::Box;
+    using Value = SpatialIndex::Value;
+    // boost boxes take no infinite bounds
+    auto clamp = [](double v) {
+        return std::clamp(v,
+                          std::numeric_limits<double>::lowest(),
+                          std::numeric_limits<double>::max());
+    };
+    const auto& b = filter.box;
+    Box box(Point(clamp(b.min_x), clamp(b.min_y)),
+            Point(clamp(b.max_x), clamp(b.max_y)));
+    auto mark = boost::make_function_output_iterator(
+        [&](const Value& v) { candidates.set(v.second); });
+    const auto& rtree = spatial_index_->rtree;
+    switch (filter.relation) {
+        case BoxFilter::Relation::kIntersects:
+            rtree.query(bgi::intersects(box), mark);
+            if (filter.geodesic) {
+                for (auto offset : spatial_index_->off_domain_rows) {
+                    candidates.set(offset);
+                }
+            }
+            break;
+        case BoxFilter::Relation::kWithin:
+            rtree.query(bgi::covered_by(box), mark);
+            break;
+        case BoxFilter::Relation::kContains:
+            rtree.query(bgi::covers(box), mark);
+            break;
+    }
+    return true;
+}
+
+}  // namespace exec
+}  // namespace milvus
@@ -11,8 +11,11 @@
 
 #pragma once
 
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
@@ -23,6 +26,7 @@
 #include "common/Types.h"
 #include "geos_c.h"
 #include "log/Log.h"
+#include "pb/plan.pb.h"
 
 namespace milvus {
 namespace exec {
@@ -33,28 +37,62 @@ MakeCacheKey(int64_t segment_id, FieldId field_id) {
     return std::to_string(segment_id) + "_" + std::to_string(field_id.get());
 }
 
-// Vector-based Geometry cache that maintains original field data order
+// Axis-aligned bounding box of a geometry. Null and empty geometries get
+// an empty box, which intersects nothing.
+struct BoundingBox {
+    double min_x = std::numeric_limits<double>::infinity();
+    double min_y = std::numeric_limits<double>::infinity();
+    double max_x = -std::numeric_limits<double>::infinity();
+    double max_y = -std::numeric_limits<double>::infinity();
+
+    bool
+    IsEmpty() const {
+        return !(min_x <= max_x && min_y <= max_y);
+    }
+
+    static BoundingBox
+    Of(GEOSContextHandle_t ctx, const GEOSGeometry* geometry);
+};
+
+// A bounding box test passed by every row that satisfies a GIS predicate,
+// so that rows failing it skip the GEOS evaluation.
+struct BoxFilter {
+    enum class Relation {
+        kIntersects,  // the row box intersects 'box'
+        kWithin,      // the row box is inside 'box'
+        kContains,    // the row box covers 'box'
+    };
+
+    Relation relation = Relation::kIntersects;
+    BoundingBox box;
+    // Rows outside the lon/lat domain [-180, 180] x [-90, 90] pass too. Set
+    // for haversine distances, which are not monotonic in their coordinates.
+    bool geodesic = false;
+};
+
+// Returns the box filter of 'op' against 'query', or nullopt when the
+// predicate can not be pruned by bounding boxes.
+std::optional<BoxFilter>
+MakeBoxFilter(proto::plan::GISFunctionFilterExpr_GISOp op,
+              const Geometry& query,
+              double distance);
+
+// Vector-based Geometry cache that maintains original field data order.
+// Next to the geometries it keeps their bounding boxes as flat min/max
+// columns for vectorized box tests, and optionally an R-tree over them.
 class SimpleGeometryCache {
  public:
+    SimpleGeometryCache();
+    ~SimpleGeometryCache();
+
     // Append WKB data during field loading
     void
-    AppendData(GEOSContextHandle_t ctx, const char* wkb_data, size_t size) {
-        std::lock_guard<std::shared_mutex> lock(mutex_);
-
-        if (size == 0 || wkb_data == nullptr) {
-            // Handle null/empty geometry - add invalid geometry
-            geometries_.emplace_back();
-        } else {
-            try {
-                // Create geometry with cache's context
-                geometries_.emplace_back(ctx, wkb_data, size);
-            } catch (const std::exception& e) {
-                ThrowInfo(UnexpectedError,
-                          "Failed to construct geometry from WKB data: {}",
-                          e.what());
-            }
-        }
-    }
+    AppendData(GEOSContextHandle_t ctx, const char* wkb_data, size_t size);
+
+    // Maintain an R-tree over the bounding boxes from now on, for growing
+    // segments whose rows are appended while they are queried. Idempotent.
+    void
+    EnableSpatialIndex();
 
     // Get shared lock for batch operations (RAII)
     std::shared_lock<std::shared_mutex>
@@ -97,9 +135,35 @@ class SimpleGeometryCache {
         return !geometries_.empty();
     }
 
+    // Sets out[i] to 1 if row offset + i may pass 'filter' and to 0 if it
+    // can not, for i in [0, size). Use with AcquireReadLock.
+    void
+    FilterByBoxUnsafe(const BoxFilter& filter,
+                      size_t offset,
+                      size_t size,
+                      uint8_t* out) const;
+
+    // Sets the bits of the rows that may pass 'filter' in 'candidates',
+    // resized to the current row count, using the R-tree. Returns false
+    // when there is no R-tree. Use with AcquireReadLock.
+    bool
+    QueryCandidatesUnsafe(const BoxFilter& filter,
+                          TargetBitmap& candidates) const;
+
  private:
+    struct SpatialIndex;
+
+    void
+    AppendBoxLocked(const BoundingBox& box);
+
     mutable std::shared_mutex mutex_;   // For read/write operations
     std::vector<Geometry> geometries_;  // Direct storage of Geometry objects
+    // bounding box of row i
+    std::vector<double> min_x_;
+    std::vector<double> min_y_;
+    std::vector<double> max_x_;
+    std::vector<double> max_y_;
+    std::unique_ptr<SpatialIndex> spatial_index_;
 };
 
 // Global cache instance per segment+field
@@ -0,0 +1,237 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/Geometry.h"
+#include "common/GeometryCache.h"
+#include "common/Types.h"
+#include "fmt/core.h"
+#include "geos_c.h"
+#include "pb/plan.pb.h"
+
+namespace milvus {
+namespace exec {
+namespace {
+
+using GISOp = proto::plan::GISFunctionFilterExpr_GISOp;
+
+class GeometryCacheTest : public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        ctx_ = GEOS_init_r();
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> lon(-179.0, 179.0);
+        std::uniform_real_distribution<double> lat(-89.0, 89.0);
+        std::uniform_real_distribution<double> side(0.01, 20.0);
+        for (int i = 0; i < kRows; ++i) {
+            auto x = lon(rng);
+            auto y = lat(rng);
+            switch (i % 4) {
+                case 0:
+                case 1:
+                    wkts_.push_back(fmt::format("POINT({} {})", x, y));
+                    break;
+                case 2: {
+                    auto d = side(rng);
+                    wkts_.push_back(
+                        fmt::format("POLYGON(({0} {1}, {2} {1}, {2} {3}, "
+                                    "{0} {3}, {0} {1}))",
+                                    x,
+                                    y,
+                                    x + d,
+                                    y + d / 2));
+                    break;
+                }
+                default:
+                    if (i % 40 == 3) {
+                        // null row
+                        wkts_.emplace_back();
+                    } else {
+                        wkts_.push_back(fmt::format("LINESTRING({} {}, {} {})",
+                                                    x,
+                                                    y,
+                                                    x + side(rng),
+                                                    y - side(rng) / 4));
+                    }
+            }
+        }
+    }
+
+    void
+    TearDown() override {
+        GEOS_finish_r(ctx_);
+    }
+
+    // Appends rows [begin, end) to 'cache'.
+    void
+    Fill(SimpleGeometryCache& cache, int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            if (wkts_[i].empty()) {
+                cache.AppendData(ctx_, nullptr, 0);
+                continue;
+            }
+            auto wkb = Geometry(ctx_, wkts_[i].c_str()).to_wkb_string();
+            cache.AppendData(ctx_, wkb.data(), wkb.size());
+        }
+    }
+
+    static bool
+    Evaluate(GISOp op,
+             const Geometry& row,
+             const Geometry& query,
+             double distance) {
+        switch (op) {
+            case proto::plan::GISFunctionFilterExpr_GISOp_Equals:
+                return row.equals(query);
+            case proto::plan::GISFunctionFilterExpr_GISOp_Touches:
+                return row.touches(query);
+            case proto::plan::GISFunctionFilterExpr_GISOp_Overlaps:
+                return row.overlaps(query);
+            case proto::plan::GISFunctionFilterExpr_GISOp_Crosses:
+                return row.crosses(query);
+            case proto::plan::GISFunctionFilterExpr_GISOp_Contains:
+                return row.contains(query);
+            case proto::plan::GISFunctionFilterExpr_GISOp_Intersects:
+                return row.intersects(query);
+            case proto::plan::GISFunctionFilterExpr_GISOp_Within:
+                return row.within(query);
+            case proto::plan::GISFunctionFilterExpr_GISOp_DWithin:
+                return row.dwithin(query, distance);
+            default:
+                return false;
+        }
+    }
+
+    static constexpr int kRows = 2000;
+    GEOSContextHandle_t ctx_;
+    std::vector<std::string> wkts_;
+};
+
+TEST_F(GeometryCacheTest, BoundingBox) {
+    Geometry polygon(ctx_, "POLYGON((0 1, 4 1, 4 3, 0 3, 0 1))");
+    auto box = BoundingBox::Of(ctx_, polygon.GetGeometry());
+    EXPECT_FALSE(box.IsEmpty());
+    EXPECT_DOUBLE_EQ(box.min_x, 0);
+    EXPECT_DOUBLE_EQ(box.min_y, 1);
+    EXPECT_DOUBLE_EQ(box.max_x, 4);
+    EXPECT_DOUBLE_EQ(box.max_y, 3);
+
+    Geometry empty(ctx_, "POLYGON EMPTY");
+    EXPECT_TRUE(BoundingBox::Of(ctx_, empty.GetGeometry()).IsEmpty());
+    EXPECT_TRUE(BoundingBox::Of(ctx_, nullptr).IsEmpty());
+}
+
+TEST_F(GeometryCacheTest, NotPrunable) {
+    Geometry point(ctx_, "POINT(1 1)");
+    EXPECT_FALSE(MakeBoxFilter(
+        proto::plan::GISFunctionFilterExpr_GISOp_DWithin, point, -1));
+    EXPECT_FALSE(MakeBoxFilter(
+        proto::plan::GISFunctionFilterExpr_GISOp_STIsValid, point, 0));
+}
+
+// Box candidates, from the flat columns and from the R-tree, must keep
+// every row that the GEOS predicate accepts.
+TEST_F(GeometryCacheTest, CandidatesCoverMatches) {
+    SimpleGeometryCache flat;
+    Fill(flat, 0, kRows);
+    // index half the rows at once and insert the rest one by one
+    SimpleGeometryCache indexed;
+    Fill(indexed, 0, kRows / 2);
+    indexed.EnableSpatialIndex();
+    Fill(indexed, kRows / 2, kRows);
+    ASSERT_EQ(indexed.Size(), kRows);
+
+    struct Case {
+        GISOp op;
+        std::string query;
+        double distance;
+    };
+    std::vector<Case> cases = {
+        {proto::plan::GISFunctionFilterExpr_GISOp_Intersects,
+         "POLYGON((-30 -20, 40 -20, 40 30, -30 30, -30 -20))",
+         0},
+        {proto::plan::GISFunctionFilterExpr_GISOp_Within,
+         "POLYGON((-60 -40, 70 -40, 70 50, -60 50, -60 -40))",
+         0},
+        {proto::plan::GISFunctionFilterExpr_GISOp_Contains,
+         "POINT(10 10)",
+         0},
+        {proto::plan::GISFunctionFilterExpr_GISOp_Touches,
+         "LINESTRING(-100 0, 100 0)",
+         0},
+        {proto::plan::GISFunctionFilterExpr_GISOp_DWithin,
+         "POINT(5 5)",
+         2000000},
+        {proto::plan::GISFunctionFilterExpr_GISOp_DWithin,
+         "POINT(175 80)",
+         1500000},
+    };
+
+    for (const auto& c : cases) {
+        Geometry query(ctx_, c.query.c_str());
+        auto filter = MakeBoxFilter(c.op, query, c.distance);
+        ASSERT_TRUE(filter.has_value()) << c.query;
+
+        std::vector<uint8_t> flat_candidates(kRows);
+        {
+            auto lock = flat.AcquireReadLock();
+            TargetBitmap unused;
+            EXPECT_FALSE(flat.QueryCandidatesUnsafe(*filter, unused));
+            // split in two batches to cover offsets
+            flat.FilterByBoxUnsafe(
+                *filter, 0, kRows / 3, flat_candidates.data());
+            flat.FilterByBoxUnsafe(*filter,
+                                   kRows / 3,
+                                   kRows - kRows / 3,
+                                   flat_candidates.data() + kRows / 3);
+        }
+        TargetBitmap rtree_candidates;
+        {
+            auto lock = indexed.AcquireReadLock();
+            ASSERT_TRUE(
+                indexed.QueryCandidatesUnsafe(*filter, rtree_candidates));
+        }
+        ASSERT_EQ(rtree_candidates.size(), kRows);
+
+        int matches = 0;
+        int candidates = 0;
+        for (int i = 0; i < kRows; ++i) {
+            auto row = flat.GetByOffset(i);
+            if (row == nullptr) {
+                EXPECT_FALSE(rtree_candidates[i]) << i;
+                continue;
+            }
+            candidates += flat_candidates[i];
+            if (Evaluate(c.op, *row, query, c.distance)) {
+                ++matches;
+                ASSERT_TRUE(flat_candidates[i])
+                    << c.query << " row " << wkts_[i];
+                ASSERT_TRUE(rtree_candidates[i])
+                    << c.query << " row " << wkts_[i];
+            }
+        }
+        // the boxes must actually prune
+        EXPECT_LT(candidates, kRows / 2) << c.query;
+        EXPECT_LE(matches, candidates) << c.query;
+    }
+}
+
+}  // namespace
+}  // namespace exec
+}  // namespace milvus
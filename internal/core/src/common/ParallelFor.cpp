@@ -0,0 +1,81 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace milvus {
+
+void
+ParallelFor(int64_t n,
+            int64_t parallelism,
+            const std::function<void(int64_t)>& fn,
+            const std::function<void(std::function<void()>)>& submit) {
+    auto helpers = std::min(parallelism, n) - 1;
+    if (helpers <= 0) {
+        for (int64_t i = 0; i < n; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    struct State {
+        std::function<void(int64_t)> fn;
+        int64_t n;
+        std::atomic<int64_t> next{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        int64_t done{0};
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+    state->fn = fn;
+    state->n = n;
+    auto work = [](State& s) {
+        for (auto i = s.next++; i < s.n; i = s.next++) {
+            std::exception_ptr error;
+            try {
+                s.fn(i);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lck(s.mutex);
+            if (error != nullptr && s.error == nullptr) {
+                s.error = error;
+            }
+            if (++s.done == s.n) {
+                s.cv.notify_all();
+            }
+        }
+    };
+    for (int64_t i = 0; i < helpers; ++i) {
+        submit([state, work]() { work(*state); });
+    }
+    work(*state);
+    std::unique_lock<std::mutex> lck(state->mutex);
+    state->cv.wait(lck, [&]() { return state->done == state->n; });
+    if (state->error != nullptr) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+}  // namespace milvus
@@ -0,0 +1,40 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace milvus {
+
+/**
+ * @brief Runs fn(i) for every i in [0, n) on the calling thread and up to
+ * parallelism - 1 helpers handed to submit.
+ *
+ * The caller takes part and only waits for the calls already claimed, so
+ * it never blocks on a helper still queued behind other work on a busy
+ * pool. A helper starting after ParallelFor returned claims nothing and
+ * never calls fn. The first exception thrown by fn is rethrown once every
+ * claimed call has finished.
+ */
+void
+ParallelFor(int64_t n,
+            int64_t parallelism,
+            const std::function<void(int64_t)>& fn,
+            const std::function<void(std::function<void()>)>& submit);
+
+}  // namespace milvus
@@ -0,0 +1,81 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "common/ParallelFor.h"
+
+using namespace milvus;
+
+TEST(ParallelFor, RunsEveryIndexOnce) {
+    std::vector<std::atomic<int>> calls(100);
+    std::vector<std::thread> helpers;
+    ParallelFor(
+        calls.size(),
+        4,
+        [&](int64_t i) { calls[i]++; },
+        [&](std::function<void()> task) {
+            helpers.emplace_back(std::move(task));
+        });
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+    EXPECT_EQ(helpers.size(), 3);
+    for (const auto& count : calls) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+TEST(ParallelFor, CallerDoesNotWaitForQueuedHelpers) {
+    // Helpers only run once ParallelFor returned, like on a busy pool.
+    std::vector<std::function<void()>> queued;
+    int calls = 0;
+    ParallelFor(
+        10,
+        4,
+        [&](int64_t) { calls++; },
+        [&](std::function<void()> task) { queued.push_back(std::move(task)); });
+    EXPECT_EQ(calls, 10);
+    ASSERT_EQ(queued.size(), 3);
+    for (auto& task : queued) {
+        task();
+    }
+    EXPECT_EQ(calls, 10);
+}
+
+TEST(ParallelFor, RethrowsFirstError) {
+    std::vector<std::thread> helpers;
+    std::atomic<int> calls{0};
+    EXPECT_THROW(ParallelFor(
+                     20,
+                     3,
+                     [&](int64_t i) {
+                         calls++;
+                         if (i == 5) {
+                             throw std::runtime_error("fetch failed");
+                         }
+                     },
+                     [&](std::function<void()> task) {
+                         helpers.emplace_back(std::move(task));
+                     }),
+                 std::runtime_error);
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+    // The other calls still ran.
+    EXPECT_EQ(calls.load(), 20);
+}
@@ -303,7 +303,17 @@ class Schema {
 
     void
     set_primary_field_id(FieldId field_id) {
+        if (primary_field_id_opt_.has_value()) {
+            auto it = fields_.find(primary_field_id_opt_.value());
+            if (it != fields_.end()) {
+                it->second.set_primary_key(false);
+            }
+        }
         this->primary_field_id_opt_ = field_id;
+        auto it = fields_.find(field_id);
+        if (it != fields_.end()) {
+            it->second.set_primary_key(true);
+        }
     }
 
     void
@@ -568,6 +578,7 @@ class Schema {
             }
         }
 
+        field_meta.set_primary_key(primary_field_id_opt_ == field_id);
         fields_.emplace(field_id, std::move(field_meta));
         field_ids_.emplace_back(field_id);
     }
@@ -494,6 +494,59 @@ inline const char* const KMin = "min";
 inline const char* const KMax = "max";
 inline const char* const KCount = "count";
 inline const char* const KAvg = "avg";
+inline const char* const KApproxCountDistinct = "approx_count_distinct";
+
+// Approximate percentile aggregates and the fraction each one estimates.
+inline const std::vector<std::pair<std::string, double>>&
+ApproxPercentileFunctions() {
+    static const std::vector<std::pair<std::string, double>> functions = {
+        {"approx_p50", 0.5},
+        {"approx_p90", 0.9},
+        {"approx_p95", 0.95},
+        {"approx_p99", 0.99},
+    };
+    return functions;
+}
+
+inline bool
+IsApproxPercentileFunction(const std::string& func_name) {
+    for (const auto& [name, fraction] : ApproxPercentileFunctions()) {
+        if (name == func_name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Sketch aggregates come with "_partial" and "_merge" companions producing
+// the serialized sketch as VARCHAR, and a "_merge_extract" companion
+// producing the final value from serialized sketches. Returns NONE for
+// other functions.
+inline DataType
+GetSketchAggResultType(const std::string& func_name) {
+    const std::pair<std::string_view, bool> suffixes[] = {
+        {"_merge_extract", true},
+        {"_partial", false},
+        {"_merge", false},
+        {"", true},
+    };
+    for (const auto& [suffix, final_output] : suffixes) {
+        if (func_name.size() < suffix.size() ||
+            std::string_view(func_name).substr(func_name.size() -
+                                               suffix.size()) != suffix) {
+            continue;
+        }
+        auto base_name =
+            func_name.substr(0, func_name.size() - suffix.size());
+        if (base_name == KApproxCountDistinct) {
+            return final_output ? DataType::INT64 : DataType::VARCHAR;
+        }
+        if (IsApproxPercentileFunction(base_name)) {
+            return final_output ? DataType::DOUBLE : DataType::VARCHAR;
+        }
+    }
+    return DataType::NONE;
+}
 
 inline DataType
 GetAggResultType(std::string func_name, DataType input_type) {
@@ -565,6 +618,10 @@ GetAggResultType(std::string func_name, DataType input_type) {
     if (func_name == KCount) {
         return DataType::INT64;
     }
+    if (auto sketch_type = GetSketchAggResultType(func_name);
+        sketch_type != DataType::NONE) {
+        return sketch_type;
+    }
     ThrowInfo(OpTypeInvalid, "Unsupported func type:{}", func_name);
 }
 
@@ -31,6 +31,7 @@
 #include "log/Log.h"
 #include "storage/ThreadPool.h"
 #include "exec/expression/ExprCache.h"
+#include "exec/expression/JsonPathCache.h"
 #include "log/Log.h"
 #include "segcore/memory_planner.h"
 #include "segcore/storagev2translator/GroupCTMeta.h"
@@ -86,6 +87,31 @@ SetDefaultDeleteDumpBatchSize(int64_t val) {
     milvus::SetDefaultDeleteDumpBatchSize(val);
 }
 
+void
+SetDefaultSearchBatchWindow(int64_t window_us) {
+    milvus::SetDefaultSearchBatchWindow(window_us);
+}
+
+void
+SetDefaultSearchBatchMaxNq(int64_t val) {
+    milvus::SetDefaultSearchBatchMaxNq(val);
+}
+
+void
+SetDefaultGrowingSearchParallelism(int64_t val) {
+    milvus::SetDefaultGrowingSearchParallelism(val);
+}
+
+void
+SetDefaultReadRangesMaxGap(int64_t val) {
+    milvus::SetDefaultReadRangesMaxGap(val);
+}
+
+void
+SetDefaultReadRangesParallelism(int64_t val) {
+    milvus::SetDefaultReadRangesParallelism(val);
+}
+
 void
 SetDefaultOptimizeExprEnable(bool val) {
     milvus::SetDefaultOptimizeExprEnable(val);
@@ -116,6 +142,11 @@ SetDefaultEnableParquetStatsSkipIndex(bool val) {
     milvus::SetDefaultEnableParquetStatsSkipIndex(val);
 }
 
+void
+SetDefaultPackedIntChunkEnable(bool val) {
+    milvus::SetDefaultPackedIntChunkEnable(val);
+}
+
 void
 SetEnableLatestDeleteSnapshotOptimization(bool val) {
     milvus::SetEnableLatestDeleteSnapshotOptimization(val);
@@ -185,6 +216,15 @@ SetExprResCacheConfig(const char* mode,
     milvus::exec::ExprResCacheManager::SetEnabled(applied);
 }
 
+void
+SetJsonPathCacheCapacity(int64_t bytes) {
+    if (bytes < 0) {
+        LOG_WARN("invalid json path cache capacity {}, ignored", bytes);
+        return;
+    }
+    milvus::exec::JsonPathCacheManager::Instance().SetCapacityBytes(bytes);
+}
+
 void
 SetArrowIOThreadPoolCapacity(int threads) {
     if (threads <= 0) {
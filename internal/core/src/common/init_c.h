@@ -52,6 +52,21 @@ SetDefaultExprEvalBatchSize(int64_t val);
 void
 SetDefaultDeleteDumpBatchSize(int64_t val);
 
+void
+SetDefaultSearchBatchWindow(int64_t window_us);
+
+void
+SetDefaultSearchBatchMaxNq(int64_t val);
+
+void
+SetDefaultGrowingSearchParallelism(int64_t val);
+
+void
+SetDefaultReadRangesMaxGap(int64_t val);
+
+void
+SetDefaultReadRangesParallelism(int64_t val);
+
 void
 SetDefaultOptimizeExprEnable(bool val);
 
@@ -70,6 +85,9 @@ SetDefaultConfigParamTypeCheck(bool val);
 void
 SetDefaultEnableParquetStatsSkipIndex(bool val);
 
+void
+SetDefaultPackedIntChunkEnable(bool val);
+
 void
 SetEnableLatestDeleteSnapshotOptimization(bool val);
 
@@ -102,6 +120,12 @@ SetExprResCacheConfig(const char* mode,            // "memory" or "disk"
                       int64_t disk_max_file_size,
                       int64_t disk_min_eval_duration_us);
 
+// Memory budget in bytes of the JSON path value cache used by JSON filters
+// on sealed segments. 0, the default, disables it; negative values are
+// ignored.
+void
+SetJsonPathCacheCapacity(int64_t bytes);
+
 // Set the capacity of arrow's internal IO thread pool. This pool runs
 // async range reads (ReadRangeCache) that issue actual S3 GetObject
 // requests, so it's the true ceiling on parallel object-storage reads —
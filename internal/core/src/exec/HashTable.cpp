@@ -16,6 +16,7 @@
 
 #include "HashTable.h"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <new>
@@ -23,6 +24,7 @@
 #include "common/SimdUtil.h"
 #include "exec/VectorHasher.h"
 #include "fmt/format.h"
+#include "folly/hash/Hash.h"
 
 namespace milvus {
 namespace exec {
@@ -31,27 +33,38 @@ BaseHashTable::prepareForGroupProbe(HashLookup& lookup,
                                     const RowVectorPtr& input) {
     auto& hashers = lookup.hashers_;
     int numKeys = hashers.size();
-    // set up column vector to each column
+    std::vector<ColumnVectorPtr> keys;
+    keys.reserve(numKeys);
     for (auto i = 0; i < numKeys; i++) {
-        auto& hasher = hashers[i];
-        auto column_idx = hasher->ChannelIndex();
+        auto column_idx = hashers[i]->ChannelIndex();
         ColumnVectorPtr column_ptr =
             std::dynamic_pointer_cast<ColumnVector>(input->child(column_idx));
         AssertInfo(column_ptr != nullptr,
                    "Failed to get column vector from row vector input");
-        hasher->setColumnData(column_ptr);
+        keys.emplace_back(std::move(column_ptr));
     }
-    lookup.reset(input->size());
+    prepareForGroupProbe(lookup, keys, input->size());
+}
 
-    const auto mode = hashMode();
+void
+BaseHashTable::prepareForGroupProbe(HashLookup& lookup,
+                                    const std::vector<ColumnVectorPtr>& keys,
+                                    vector_size_t numRows) {
+    auto& hashers = lookup.hashers_;
+    AssertInfo(keys.size() == hashers.size(),
+               "Key column count {} does not match hasher count {}",
+               keys.size(),
+               hashers.size());
+    // set up column vector to each column
     for (auto i = 0; i < hashers.size(); i++) {
-        if (mode == BaseHashTable::HashMode::kHash) {
-            hashers[i]->hash(i > 0, lookup.hashes_);
-        } else {
-            ThrowInfo(
-                milvus::OpTypeInvalid,
-                "Not support target hashMode, only support kHash for now");
-        }
+        hashers[i]->setColumnData(keys[i]);
+    }
+    lookup.reset(numRows);
+    if (computeValueIds(lookup)) {
+        return;
+    }
+    for (auto i = 0; i < hashers.size(); i++) {
+        hashers[i]->hash(i > 0, lookup.hashes_);
     }
 }
 
@@ -222,9 +235,8 @@ HashTable::storeRowPointer(uint64_t index, uint64_t hash, char* row) {
 }
 
 char*
-HashTable::insertEntry(milvus::exec::HashLookup& lookup,
-                       uint64_t index,
-                       milvus::vector_size_t row) {
+HashTable::newGroup(milvus::exec::HashLookup& lookup,
+                    milvus::vector_size_t row) {
     if (numDistinct_ >= maxNumGroups_) {
         ThrowInfo(
             UnexpectedError,
@@ -237,16 +249,41 @@ HashTable::insertEntry(milvus::exec::HashLookup& lookup,
     char* group = rows_->newRow();
     lookup.hits_[row] = group;
     storeKeys(lookup, row);
-    storeRowPointer(index, lookup.hashes_[row], group);
     rowHashes_.push_back(lookup.hashes_[row]);
     numDistinct_++;
     lookup.newGroups_.push_back(row);
     return group;
 }
 
+char*
+HashTable::insertEntry(milvus::exec::HashLookup& lookup,
+                       uint64_t index,
+                       milvus::vector_size_t row) {
+    char* group = newGroup(lookup, row);
+    if (hashMode_ == HashMode::kNormalizedKey) {
+        rows_->setNormalizedKey(group, lookup.normalizedKeys_[row]);
+    }
+    storeRowPointer(index, lookup.hashes_[row], group);
+    return group;
+}
+
 FOLLY_ALWAYS_INLINE void
 HashTable::fullProbe(HashLookup& lookup, ProbeState& state) {
     constexpr ProbeState::Operation op = ProbeState::Operation::kInsert;
+    if (hashMode_ == HashMode::kNormalizedKey) {
+        // The packed key identifies the group, so one integer compare
+        // replaces the per-column key comparison.
+        lookup.hits_[state.row()] = state.fullProbe<op>(
+            *this,
+            [&](char* group, int32_t row) {
+                return rows_->normalizedKey(group) ==
+                       lookup.normalizedKeys_[row];
+            },
+            [&](int32_t row, uint64_t index) {
+                return insertEntry(lookup, index, row);
+            });
+        return;
+    }
     lookup.hits_[state.row()] = state.fullProbe<op>(
         *this,
         [&](char* group, int32_t row) {
@@ -259,7 +296,10 @@ HashTable::fullProbe(HashLookup& lookup, ProbeState& state) {
 
 void
 HashTable::groupProbe(milvus::exec::HashLookup& lookup) {
-    AssertInfo(hashMode_ == HashMode::kHash, "Only support kHash mode for now");
+    if (hashMode_ == HashMode::kArray) {
+        arrayGroupProbe(lookup);
+        return;
+    }
     checkSizeAndAllocateTable(0);
     ProbeState state;
     for (int32_t idx = 0; idx < lookup.hashes_.size(); idx++) {
@@ -272,9 +312,167 @@ HashTable::groupProbe(milvus::exec::HashLookup& lookup) {
     }
 }
 
+void
+HashTable::arrayGroupProbe(milvus::exec::HashLookup& lookup) {
+    for (int32_t idx = 0; idx < lookup.hashes_.size(); idx++) {
+        auto& slot = arrayTable_[lookup.hashes_[idx]];
+        if (slot == nullptr) {
+            slot = newGroup(lookup, idx);
+        }
+        lookup.hits_[idx] = slot;
+    }
+}
+
+uint64_t
+HashTable::normalizedKeyHash(uint64_t key) {
+    return folly::hasher<uint64_t>()(key);
+}
+
+bool
+HashTable::packValueIds(milvus::exec::HashLookup& lookup) {
+    auto& ids = hashMode_ == HashMode::kArray ? lookup.hashes_
+                                              : lookup.normalizedKeys_;
+    for (auto i = 0; i < hashers_.size(); i++) {
+        if (!hashers_[i]->computeValueIds(i > 0, ids)) {
+            return false;
+        }
+    }
+    if (hashMode_ == HashMode::kNormalizedKey) {
+        for (auto i = 0; i < ids.size(); i++) {
+            lookup.hashes_[i] = normalizedKeyHash(ids[i]);
+        }
+    }
+    return true;
+}
+
+bool
+HashTable::computeValueIds(milvus::exec::HashLookup& lookup) {
+    if (hashMode_ != HashMode::kHash && packValueIds(lookup)) {
+        return true;
+    }
+    if (!valueIdsAllowed_) {
+        return false;
+    }
+    // First batch, or a key outside the current ranges: widen the ranges
+    // and rebuild, possibly falling back to kHash.
+    decideHashMode();
+    if (hashMode_ == HashMode::kHash) {
+        return false;
+    }
+    AssertInfo(packValueIds(lookup),
+               "Keys must fit the value ranges just derived from them");
+    return true;
+}
+
+void
+HashTable::decideHashMode() {
+    for (auto& hasher : hashers_) {
+        hasher->analyzeValueRange();
+    }
+    // Prefer padded ranges so that nearby new keys do not force another
+    // rebuild, and fall back to the exact ranges before giving up.
+    for (bool padded : {true, false}) {
+        uint64_t numSlots = 1;
+        bool fits = true;
+        for (auto& hasher : hashers_) {
+            auto size = hasher->valueIdRangeSize(padded);
+            if (size == 0 ||
+                __builtin_mul_overflow(numSlots, size, &numSlots)) {
+                fits = false;
+                break;
+            }
+        }
+        if (!fits) {
+            continue;
+        }
+        uint64_t multiplier = 1;
+        for (auto& hasher : hashers_) {
+            multiplier = hasher->setValueIdRange(padded, multiplier);
+        }
+        if (numSlots <= kArrayHashMaxSize) {
+            arrayTable_.assign(numSlots, nullptr);
+            rebuildTable(HashMode::kArray);
+        } else {
+            arrayTable_ = {};
+            rebuildTable(HashMode::kNormalizedKey);
+        }
+        return;
+    }
+    setHashMode(HashMode::kHash, 0);
+}
+
 void
 HashTable::setHashMode(HashMode mode, int32_t numNew) {
-    // TODO set hash mode kArray/kHash/kNormalizedKey
+    AssertInfo(mode == HashMode::kHash || valueIdsAllowed_,
+               "Hash mode {} needs integer or bool keys",
+               static_cast<int>(mode));
+    if (mode == HashMode::kHash) {
+        valueIdsAllowed_ = false;
+        arrayTable_ = {};
+    }
+    if (mode != hashMode_ || mode != HashMode::kHash) {
+        rebuildTable(mode);
+    }
+}
+
+void
+HashTable::rebuildTable(HashMode mode) {
+    const auto& allRows = rows_->allRows();
+    const auto numRows = static_cast<vector_size_t>(allRows.size());
+    std::vector<uint64_t> ids(numRows);
+    if (numRows > 0) {
+        // Borrow the hashers to recompute ids from the stored keys, then
+        // give them back the batch being probed.
+        std::vector<ColumnVectorPtr> batch;
+        batch.reserve(hashers_.size());
+        for (auto i = 0; i < hashers_.size(); i++) {
+            batch.push_back(hashers_[i]->columnData());
+            hashers_[i]->setColumnData(
+                rows_->extractColumnVector(allRows.data(), numRows, i));
+        }
+        for (auto i = 0; i < hashers_.size(); i++) {
+            if (mode == HashMode::kHash) {
+                hashers_[i]->hash(i > 0, ids);
+            } else {
+                AssertInfo(hashers_[i]->computeValueIds(i > 0, ids),
+                           "Stored keys must fit the new value ranges");
+            }
+        }
+        for (auto i = 0; i < hashers_.size(); i++) {
+            hashers_[i]->setColumnData(batch[i]);
+        }
+    }
+
+    if (table_) {
+        ::operator delete(table_, std::align_val_t(64));
+        table_ = nullptr;
+    }
+    capacity_ = 0;
+    numBuckets_ = 0;
+    sizeMask_ = 0;
+    bucketOffsetMask_ = 0;
+    hashMode_ = mode;
+    if (mode == HashMode::kArray) {
+        AssertInfo(!arrayTable_.empty(), "kArray mode needs value id ranges");
+        for (auto i = 0; i < numRows; i++) {
+            arrayTable_[ids[i]] = allRows[i];
+        }
+        rowHashes_ = std::move(ids);
+        return;
+    }
+    if (mode == HashMode::kNormalizedKey) {
+        for (auto i = 0; i < numRows; i++) {
+            rows_->setNormalizedKey(allRows[i], ids[i]);
+            ids[i] = normalizedKeyHash(ids[i]);
+        }
+    }
+    rowHashes_ = std::move(ids);
+    if (numRows > 0) {
+        allocateTables(newHashTableEntriesNumber(numRows, 0));
+        for (auto i = 0; i < numRows; i++) {
+            insertForRehash(allRows[i], rowHashes_[i]);
+        }
+    }
 }
 
 void
@@ -289,6 +487,7 @@ HashTable::clear(bool freeTable) {
     sizeMask_ = 0;
     bucketOffsetMask_ = 0;
     rowHashes_.clear();
+    std::fill(arrayTable_.begin(), arrayTable_.end(), nullptr);
 }
 
 void
@@ -52,6 +52,7 @@ struct HashLookup {
         rows_.resize(size);
         hashes_.resize(size);
         hits_.resize(size);
+        normalizedKeys_.resize(size);
         newGroups_.clear();
     }
 
@@ -65,6 +66,10 @@ struct HashLookup {
     /// the row number.
     std::vector<uint64_t> hashes_;
 
+    /// In kNormalizedKey mode, the packed value ids of each row, while
+    /// 'hashes_' holds their hash. Index is the row number.
+    std::vector<uint64_t> normalizedKeys_;
+
     /// Contains one entry for each row in 'rows'. Index is the row number.
     /// For groupProbe, a pointer to an existing or new row with matching grouping
     /// keys.
@@ -159,6 +164,14 @@ class BaseHashTable {
     void
     prepareForGroupProbe(HashLookup& lookup, const RowVectorPtr& input);
 
+    /// Same as above with the grouping key columns given directly, one per
+    /// hasher in hasher order. Used to re-probe groups that do not come from
+    /// an operator input, e.g. groups read back from a spill file.
+    void
+    prepareForGroupProbe(HashLookup& lookup,
+                         const std::vector<ColumnVectorPtr>& keys,
+                         vector_size_t numRows);
+
     /// Finds or creates a group for each key in 'lookup'. The keys are
     /// returned in 'lookup.hits'.
     virtual void
@@ -167,7 +180,19 @@ class BaseHashTable {
     virtual void
     clear(bool freeTable = false) = 0;
 
+    /// Number of groups in the table.
+    virtual int64_t
+    numDistinct() const = 0;
+
  protected:
+    /// Fills 'lookup' with value ids instead of hashes if the table runs in
+    /// kArray or kNormalizedKey mode, possibly switching modes to fit the new
+    /// keys. Returns false if the keys must be hashed (kHash).
+    virtual bool
+    computeValueIds(HashLookup& lookup) {
+        return false;
+    }
+
     std::vector<std::unique_ptr<VectorHasher>> hashers_;
     std::unique_ptr<RowContainer> rows_;
 };
@@ -186,7 +211,13 @@ class HashTable : public BaseHashTable {
             keyTypes.push_back(hasher->ChannelDataType());
         }
         hashMode_ = HashMode::kHash;
-        rows_ = std::make_unique<RowContainer>(keyTypes, accumulators);
+        valueIdsAllowed_ = !hashers_.empty();
+        for (auto& hasher : hashers_) {
+            valueIdsAllowed_ &= VectorHasher::typeSupportsValueRange(
+                hasher->ChannelDataType());
+        }
+        rows_ = std::make_unique<RowContainer>(
+            keyTypes, accumulators, valueIdsAllowed_);
     };
 
     ~HashTable() override {
@@ -199,6 +230,20 @@ class HashTable : public BaseHashTable {
     void
     groupProbe(HashLookup& lookup) override;
 
+    int64_t
+    numDistinct() const override {
+        return numDistinct_;
+    }
+
+    HashMode
+    hashMode() const override {
+        return hashMode_;
+    }
+
+    // Largest kArray table, in slots. Key ranges needing more slots but still
+    // fitting in 64 bits use kNormalizedKey.
+    static constexpr uint64_t kArrayHashMaxSize = 1 << 20;
+
     // The table in non-kArray mode has a power of two number of buckets each with
     // 16 slots. Each slot has a 1 byte tag (a field of hash number) and a 48 bit
     // pointer. All the tags are in a 16 byte SIMD word followed by the 6 byte
@@ -303,6 +348,35 @@ class HashTable : public BaseHashTable {
     void
     fullProbe(HashLookup& lookup, ProbeState& state);
 
+    // kArray probe: the value id is the slot, so no tags or key compares.
+    void
+    arrayGroupProbe(HashLookup& lookup);
+
+    // Creates the group for 'row' of 'lookup'.
+    char*
+    newGroup(HashLookup& lookup, vector_size_t row);
+
+    bool
+    computeValueIds(HashLookup& lookup) override;
+
+    // Packs the value ids of all keys of 'lookup' for the current mode.
+    // Returns false if a key is outside the ranges the table was built for.
+    bool
+    packValueIds(HashLookup& lookup);
+
+    // Picks the mode for the key ranges seen so far, including the batch
+    // currently set on the hashers, and rebuilds the table in that mode.
+    void
+    decideHashMode();
+
+    // Re-inserts all groups under 'mode', recomputing their hashes or value
+    // ids from the keys stored in the rows.
+    void
+    rebuildTable(HashMode mode);
+
+    static uint64_t
+    normalizedKeyHash(uint64_t key);
+
     void
     clear(bool freeTable = false) override;
 
@@ -354,13 +428,16 @@ class HashTable : public BaseHashTable {
 
     [[maybe_unused]] int64_t numRehashes_{0};
     char* table_ = nullptr;
+    // Hash of each row in rows_->allRows(); the value id in kArray mode.
     std::vector<uint64_t> rowHashes_;
     int64_t maxNumGroups_;
 
-    HashMode
-    hashMode() const override {
-        return hashMode_;
-    }
+    // False once the keys are known not to fit kArray or kNormalizedKey, or
+    // if some key type has no value range.
+    bool valueIdsAllowed_{false};
+    // kArray mode: group pointer per value id.
+    std::vector<char*> arrayTable_;
+
     friend class ProbeState;
 };
 
@@ -122,6 +122,13 @@ class QueryConfig : public MemConfig {
     static constexpr const char* kExprEvalBatchSize =
         "expression.eval_batch_size";
 
+    // Minimum number of input rows each partial aggregation gets before an
+    // aggregation input batch is split across threads.
+    static constexpr const char* kAggregationPartialMinRows =
+        "aggregation.partial_min_rows";
+
+    static constexpr int64_t kDefaultAggregationPartialMinRows = 64 * 1024;
+
     explicit QueryConfig(
         const std::unordered_map<std::string, std::string>& values)
         : MemConfig(values) {
@@ -139,6 +146,12 @@ class QueryConfig : public MemConfig {
         return BaseConfig::Get<int64_t>(kExprEvalBatchSize,
                                         EXEC_EVAL_EXPR_BATCH_SIZE.load());
     }
+
+    int64_t
+    get_aggregation_partial_min_rows() const {
+        return BaseConfig::Get<int64_t>(kAggregationPartialMinRows,
+                                        kDefaultAggregationPartialMinRows);
+    }
 };
 
 class Context {
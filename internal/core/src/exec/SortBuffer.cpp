@@ -17,7 +17,13 @@
 #include "exec/SortBuffer.h"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
 #include <functional>
+#include <limits>
+#include <string>
+#include <utility>
 
 #include "common/EasyAssert.h"
 #include "log/Log.h"
@@ -25,10 +31,173 @@
 namespace milvus {
 namespace exec {
 
+namespace {
+
+// Rows decoded per spilled run at a time during the k-way merge
+constexpr size_t kMergeBlockRows = 1024;
+
+// Normalized-key sorting handles up to this many fixed-width sort keys
+constexpr size_t kMaxNormalizedKeys = 2;
+
+// Below this many rows, pdqsort-style std::sort on the normalized entries
+// beats the fixed cost of the radix passes
+constexpr size_t kRadixSortMinRows = 1024;
+
+constexpr uint64_t kSignBit = uint64_t{1} << 63;
+
+bool
+IsNormalizableType(DataType type) {
+    switch (type) {
+        case DataType::BOOL:
+        case DataType::INT8:
+        case DataType::INT16:
+        case DataType::INT32:
+        case DataType::INT64:
+        case DataType::TIMESTAMPTZ:
+        case DataType::FLOAT:
+        case DataType::DOUBLE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Maps a value to an unsigned integer whose natural order matches
+// comparePrimitiveAsc(): the sign bit is flipped for integers, IEEE bits are
+// flipped for floats, -0.0 collapses to 0.0 and NaN sorts above +inf.
+template <typename T>
+inline uint64_t
+NormalizeKey(T value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        return value ? 1 : 0;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        double d = static_cast<double>(value);
+        if (std::isnan(d)) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        if (d == 0) {
+            d = 0.0;
+        }
+        uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        return (bits & kSignBit) ? ~bits : bits | kSignBit;
+    } else {
+        return static_cast<uint64_t>(static_cast<int64_t>(value)) ^ kSignBit;
+    }
+}
+
+// Byte-comparable image of a row's sort keys. Direction is folded into the
+// key bits and NULLS FIRST/LAST into null_ranks, so ordering entries needs
+// neither type dispatch nor a dereference of the row pointer.
+template <size_t K>
+struct NormalizedEntry {
+    uint64_t keys[K];
+    uint8_t null_ranks[K];
+    char* row;
+};
+
+template <size_t K>
+inline bool
+NormalizedLess(const NormalizedEntry<K>& lhs, const NormalizedEntry<K>& rhs) {
+    for (size_t k = 0; k < K; ++k) {
+        if (lhs.null_ranks[k] != rhs.null_ranks[k]) {
+            return lhs.null_ranks[k] < rhs.null_ranks[k];
+        }
+        if (lhs.keys[k] != rhs.keys[k]) {
+            return lhs.keys[k] < rhs.keys[k];
+        }
+    }
+    return false;
+}
+
+template <typename T, size_t K>
+void
+EncodeKeyColumn(std::vector<NormalizedEntry<K>>& entries,
+                size_t k,
+                const RowColumn& column,
+                const SortKeyInfo& sort_key) {
+    const uint8_t null_rank = sort_key.nulls_first ? 0 : 1;
+    const uint64_t flip = sort_key.ascending ? 0 : ~uint64_t{0};
+    for (auto& entry : entries) {
+        if (RowContainer::isNullAt(
+                entry.row, column.nullByte(), column.nullMask())) {
+            entry.null_ranks[k] = null_rank;
+            entry.keys[k] = 0;
+        } else {
+            entry.null_ranks[k] = 1 - null_rank;
+            entry.keys[k] = NormalizeKey(RowContainer::valueAt<T>(
+                                entry.row, column.offset())) ^
+                            flip;
+        }
+    }
+}
+
+// One stable counting-sort pass over the byte selected by byte_of. Returns
+// false, leaving dst untouched, when all entries share the same byte.
+template <typename Entry, typename ByteFn>
+bool
+RadixPass(const std::vector<Entry>& src,
+          std::vector<Entry>& dst,
+          ByteFn byte_of) {
+    std::array<size_t, 256> offsets{};
+    for (const auto& entry : src) {
+        offsets[byte_of(entry)]++;
+    }
+    for (auto count : offsets) {
+        if (count == src.size()) {
+            return false;
+        }
+    }
+    size_t sum = 0;
+    for (auto& offset : offsets) {
+        auto count = offset;
+        offset = sum;
+        sum += count;
+    }
+    for (const auto& entry : src) {
+        dst[offsets[byte_of(entry)]++] = entry;
+    }
+    return true;
+}
+
+// LSD radix sort from the last key's low byte up to the first key's null
+// rank. Passes where every entry has the same byte are skipped, which makes
+// narrow types and clustered values cheap.
+template <size_t K>
+void
+RadixSort(std::vector<NormalizedEntry<K>>& entries) {
+    std::vector<NormalizedEntry<K>> buffer(entries.size());
+    auto* src = &entries;
+    auto* dst = &buffer;
+    for (size_t k = K; k-- > 0;) {
+        for (int shift = 0; shift < 64; shift += 8) {
+            if (RadixPass(*src, *dst, [k, shift](const auto& entry) {
+                    return (entry.keys[k] >> shift) & 0xff;
+                })) {
+                std::swap(src, dst);
+            }
+        }
+        if (RadixPass(*src, *dst, [k](const auto& entry) {
+                return entry.null_ranks[k];
+            })) {
+            std::swap(src, dst);
+        }
+    }
+    if (src != &entries) {
+        entries.swap(buffer);
+    }
+}
+
+}  // namespace
+
 SortBuffer::SortBuffer(const std::vector<DataType>& column_types,
                        const std::vector<SortKeyInfo>& sort_keys,
-                       int64_t limit)
-    : column_types_(column_types), sort_keys_(sort_keys), limit_(limit) {
+                       int64_t limit,
+                       SortSpillConfig spill_config)
+    : column_types_(column_types),
+      sort_keys_(sort_keys),
+      limit_(limit),
+      spill_config_(std::move(spill_config)) {
     AssertInfo(!sort_keys_.empty(),
                "SortBuffer requires at least one sort key");
     AssertInfo(!column_types_.empty(),
@@ -44,6 +213,13 @@ SortBuffer::SortBuffer(const std::vector<DataType>& column_types,
                    column_types_.size());
     }
 
+    // Fixed-width sort keys can be sorted as normalized integer keys
+    use_normalized_keys_ = sort_keys_.size() <= kMaxNormalizedKeys;
+    for (const auto& sort_key : sort_keys_) {
+        use_normalized_keys_ &=
+            IsNormalizableType(column_types_[sort_key.column_index]);
+    }
+
     // Create RowContainer with no accumulators (pure data storage)
     std::vector<Accumulator> empty_accumulators;
     data_ = std::make_unique<RowContainer>(column_types_, empty_accumulators);
@@ -67,6 +243,8 @@ SortBuffer::AddRow(const std::vector<ColumnVectorPtr>& columns,
     }
 
     num_input_rows_++;
+    buffered_bytes_ += data_->rowMemoryBytes(row);
+    MaybeSpill();
 }
 
 void
@@ -95,9 +273,53 @@ SortBuffer::AddRows(const std::vector<ColumnVectorPtr>& columns,
             data_->store(
                 columns[col], i, new_rows[i], static_cast<int32_t>(col));
         }
+        buffered_bytes_ += data_->rowMemoryBytes(new_rows[i]);
     }
 
     num_input_rows_ += num_rows;
+    MaybeSpill();
+}
+
+void
+SortBuffer::MaybeSpill() {
+    if (spill_config_.Enabled() &&
+        buffered_bytes_ >= spill_config_.memory_budget_bytes) {
+        SpillRun();
+    }
+}
+
+void
+SortBuffer::SpillRun() {
+    if (data_->allRows().empty()) {
+        return;
+    }
+    auto spilled_bytes = buffered_bytes_;
+    SortAndTruncate();
+
+    auto file = std::make_unique<SpillFile>(spill_config_.spill_directory);
+    std::string record;
+    for (const char* row : sorted_rows_) {
+        record.clear();
+        data_->serializeRow(row, record);
+        file->AppendRecord(record);
+    }
+    file->FinishWrite();
+
+    num_spilled_rows_ += static_cast<int64_t>(sorted_rows_.size());
+    num_spilled_runs_++;
+    LOG_INFO(
+        "SortBuffer: spilled run {} with {} rows ({} bytes in memory, {} bytes "
+        "on disk) to {}",
+        num_spilled_runs_,
+        sorted_rows_.size(),
+        spilled_bytes,
+        file->SizeBytes(),
+        file->Path());
+
+    spilled_runs_.push_back(std::move(file));
+    sorted_rows_.clear();
+    data_->clear();
+    buffered_bytes_ = 0;
 }
 
 void
@@ -111,8 +333,33 @@ SortBuffer::NoMoreInput() {
         return;
     }
 
+    if (spilled_runs_.empty()) {
+        SortAndTruncate();
+        sorted_ = true;
+        LOG_DEBUG("SortBuffer: sorted {} rows, keeping {} after limit",
+                  num_input_rows_,
+                  sorted_rows_.size());
+        return;
+    }
+
+    // The in-memory remainder becomes one more run of the merge
+    if (!data_->allRows().empty()) {
+        SortAndTruncate();
+    }
+    PrepareMerge();
+    sorted_ = true;
+
+    LOG_DEBUG("SortBuffer: merging {} runs, {} of {} input rows spilled",
+              merge_runs_.size(),
+              num_spilled_rows_,
+              num_input_rows_);
+}
+
+void
+SortBuffer::SortAndTruncate() {
     // Collect all row pointers from RowContainer
     const auto& all_rows = data_->allRows();
+    sorted_rows_.clear();
     sorted_rows_.reserve(all_rows.size());
     for (char* row : all_rows) {
         sorted_rows_.push_back(row);
@@ -127,12 +374,106 @@ SortBuffer::NoMoreInput() {
             std::min(static_cast<int64_t>(sorted_rows_.size()), limit_);
         sorted_rows_.resize(keep);
     }
+}
 
-    sorted_ = true;
+void
+SortBuffer::PrepareMerge() {
+    for (auto& file : spilled_runs_) {
+        auto run = std::make_unique<MergeRun>();
+        run->file = std::move(file);
+        if (LoadBlock(*run)) {
+            merge_runs_.push_back(std::move(run));
+        }
+    }
+    spilled_runs_.clear();
 
-    LOG_DEBUG("SortBuffer: sorted {} rows, keeping {} after limit",
-              num_input_rows_,
-              sorted_rows_.size());
+    if (!sorted_rows_.empty()) {
+        auto run = std::make_unique<MergeRun>();
+        run->rows = std::move(sorted_rows_);
+        sorted_rows_.clear();
+        merge_runs_.push_back(std::move(run));
+    }
+
+    merge_heap_.clear();
+    for (size_t i = 0; i < merge_runs_.size(); ++i) {
+        merge_heap_.push_back(i);
+    }
+    std::make_heap(
+        merge_heap_.begin(), merge_heap_.end(), [this](size_t a, size_t b) {
+            return HeadGreater(a, b);
+        });
+}
+
+bool
+SortBuffer::LoadBlock(MergeRun& run) {
+    if (run.block != nullptr) {
+        // merged_rows_ may still reference rows of the previous block
+        retired_blocks_.push_back(std::move(run.block));
+    }
+    run.block = std::make_unique<RowContainer>(column_types_,
+                                               std::vector<Accumulator>{});
+    run.rows.clear();
+    run.pos = 0;
+
+    std::string record;
+    while (run.rows.size() < kMergeBlockRows && run.file->ReadRecord(record)) {
+        char* row = nullptr;
+        run.block->deserializeRow(record.data(), record.size(), row);
+        run.rows.push_back(row);
+    }
+    return !run.rows.empty();
+}
+
+bool
+SortBuffer::AdvanceRun(MergeRun& run) {
+    ++run.pos;
+    if (run.pos < run.rows.size()) {
+        return true;
+    }
+    if (run.file == nullptr) {
+        return false;
+    }
+    return LoadBlock(run);
+}
+
+bool
+SortBuffer::HeadGreater(size_t a, size_t b) const {
+    const auto& lhs = *merge_runs_[a];
+    const auto& rhs = *merge_runs_[b];
+    return Compare(lhs.rows[lhs.pos], rhs.rows[rhs.pos]) > 0;
+}
+
+std::vector<VectorPtr>
+SortBuffer::GetMergedOutput(int64_t num_rows) {
+    auto heap_cmp = [this](size_t a, size_t b) { return HeadGreater(a, b); };
+
+    merged_rows_.clear();
+    while (static_cast<int64_t>(merged_rows_.size()) < num_rows &&
+           !merge_heap_.empty()) {
+        std::pop_heap(merge_heap_.begin(), merge_heap_.end(), heap_cmp);
+        auto& run = *merge_runs_[merge_heap_.back()];
+        merged_rows_.push_back(run.rows[run.pos]);
+        if (AdvanceRun(run)) {
+            std::push_heap(merge_heap_.begin(), merge_heap_.end(), heap_cmp);
+        } else {
+            merge_heap_.pop_back();
+        }
+    }
+
+    std::vector<VectorPtr> result;
+    if (merged_rows_.empty()) {
+        return result;
+    }
+    result.reserve(column_types_.size());
+    for (size_t col = 0; col < column_types_.size(); ++col) {
+        result.push_back(data_->extractColumnVector(
+            merged_rows_.data(),
+            static_cast<int32_t>(merged_rows_.size()),
+            static_cast<int32_t>(col)));
+    }
+    // Blocks exhausted while assembling this batch are no longer referenced
+    retired_blocks_.clear();
+    return result;
 }
 
 void
@@ -141,6 +482,15 @@ SortBuffer::Sort() {
         return;
     }
 
+    if (use_normalized_keys_) {
+        if (sort_keys_.size() == 1) {
+            SortNormalized<1>();
+        } else {
+            SortNormalized<2>();
+        }
+        return;
+    }
+
     // Comparator lambda that calls our Compare method
     auto comparator = [this](const char* lhs, const char* rhs) {
         return Compare(lhs, rhs) < 0;
@@ -172,11 +522,74 @@ SortBuffer::Sort() {
     }
 }
 
-// TODO(performance): The switch-case on data_type runs on every comparison
-// (O(N log K) times). Since sort key types are fixed at construction time,
-// we could pre-bind typed comparators to eliminate the runtime dispatch.
-// In practice, branch prediction handles this well (type never changes),
-// so this is low-priority unless profiling shows it as a bottleneck.
+template <size_t K>
+void
+SortBuffer::SortNormalized() {
+    const size_t n = sorted_rows_.size();
+    std::vector<NormalizedEntry<K>> entries(n);
+    for (size_t i = 0; i < n; ++i) {
+        entries[i].row = sorted_rows_[i];
+    }
+
+    // Type dispatch happens once per key column, not once per comparison
+    for (size_t k = 0; k < K; ++k) {
+        const auto& sort_key = sort_keys_[k];
+        const auto& column = data_->columnAt(sort_key.column_index);
+        switch (column_types_[sort_key.column_index]) {
+            case DataType::BOOL:
+                EncodeKeyColumn<bool>(entries, k, column, sort_key);
+                break;
+            case DataType::INT8:
+                EncodeKeyColumn<int8_t>(entries, k, column, sort_key);
+                break;
+            case DataType::INT16:
+                EncodeKeyColumn<int16_t>(entries, k, column, sort_key);
+                break;
+            case DataType::INT32:
+                EncodeKeyColumn<int32_t>(entries, k, column, sort_key);
+                break;
+            case DataType::INT64:
+            case DataType::TIMESTAMPTZ:
+                EncodeKeyColumn<int64_t>(entries, k, column, sort_key);
+                break;
+            case DataType::FLOAT:
+                EncodeKeyColumn<float>(entries, k, column, sort_key);
+                break;
+            case DataType::DOUBLE:
+                EncodeKeyColumn<double>(entries, k, column, sort_key);
+                break;
+            default:
+                ThrowInfo(DataTypeInvalid,
+                          "Unsupported data type for normalized ORDER BY: {}",
+                          static_cast<int>(
+                              column_types_[sort_key.column_index]));
+        }
+    }
+
+    // Same top-K threshold as the comparator path
+    if (limit_ > 0 && limit_ < static_cast<int64_t>(n) / 2) {
+        std::partial_sort(entries.begin(),
+                          entries.begin() + limit_,
+                          entries.end(),
+                          NormalizedLess<K>);
+        LOG_DEBUG("SortBuffer: used normalized partial_sort for top-{}",
+                  limit_);
+    } else if (n >= kRadixSortMinRows) {
+        RadixSort(entries);
+        LOG_DEBUG("SortBuffer: used normalized radix sort for {} rows", n);
+    } else {
+        std::sort(entries.begin(), entries.end(), NormalizedLess<K>);
+        LOG_DEBUG("SortBuffer: used normalized sort for {} rows", n);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        sorted_rows_[i] = entries[i].row;
+    }
+}
+
+// Used for string keys, more than kMaxNormalizedKeys keys, and by the k-way
+// merge of spilled runs. The switch-case on data_type runs on every
+// comparison; fixed-width keys avoid it via SortNormalized().
 int
 SortBuffer::Compare(const char* lhs, const char* rhs) const {
     for (const auto& sort_key : sort_keys_) {
@@ -301,6 +714,9 @@ SortBuffer::HasOutput() const {
     if (!sorted_) {
         return false;
     }
+    if (!merge_runs_.empty()) {
+        return !merge_heap_.empty() && (limit_ <= 0 || num_output_rows_ < limit_);
+    }
     if (sorted_rows_.empty()) {
         return false;
     }
@@ -312,6 +728,19 @@ std::vector<VectorPtr>
 SortBuffer::GetOutput(int64_t max_rows) {
     AssertInfo(sorted_, "Must call NoMoreInput() before GetOutput()");
 
+    if (!merge_runs_.empty()) {
+        int64_t batch_size = max_rows;
+        if (limit_ > 0) {
+            batch_size = std::min(batch_size, limit_ - num_output_rows_);
+        }
+        if (batch_size <= 0) {
+            return {};
+        }
+        auto output = GetMergedOutput(batch_size);
+        num_output_rows_ += static_cast<int64_t>(merged_rows_.size());
+        return output;
+    }
+
     if (sorted_rows_.empty()) {
         return {};
     }
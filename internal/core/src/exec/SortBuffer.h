@@ -19,12 +19,14 @@
 #include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <vector>
 
 #include "common/EasyAssert.h"
 #include "common/Types.h"
 #include "common/Vector.h"
+#include "exec/SpillFile.h"
 #include "exec/operator/query-agg/RowContainer.h"
 
 namespace milvus {
@@ -42,6 +44,18 @@ struct SortKeyInfo {
     }
 };
 
+/// Spill settings for SortBuffer. Spilling is disabled when
+/// memory_budget_bytes <= 0 or spill_directory is empty.
+struct SortSpillConfig {
+    int64_t memory_budget_bytes = 0;
+    std::string spill_directory;
+
+    bool
+    Enabled() const {
+        return memory_budget_bytes > 0 && !spill_directory.empty();
+    }
+};
+
 /**
  * @brief SortBuffer - A self-contained sorting component for ORDER BY operations
  *
@@ -53,6 +67,8 @@ struct SortKeyInfo {
  * - Multi-field sorting: Supports compound ORDER BY (field1 ASC, field2 DESC)
  * - NULL handling: Configurable NULLS FIRST/LAST per sort key
  * - TopK optimization: Uses partial_sort when limit is small relative to input
+ * - Normalized keys: Up to two fixed-width numeric keys are radix-sorted as
+ *   byte-comparable integers instead of through the generic comparator
  * - Batched output: Returns results in configurable batch sizes
  *
  * Usage pattern:
@@ -62,8 +78,12 @@ struct SortKeyInfo {
  *   4. Call GetOutput() repeatedly until HasOutput() returns false
  *
  * Memory model:
- *   - Current implementation is memory-only (no disk spilling)
  *   - Memory usage: O(rows * row_size) for data + O(rows * 8) for pointers
+ *   - With a SortSpillConfig, once buffered rows exceed the memory budget the
+ *     current rows are sorted into a run and written to a local spill file
+ *     (truncated to limit when set). NoMoreInput() then k-way merges the
+ *     spilled runs with the in-memory remainder, streaming rows back in
+ *     blocks, so memory stays bounded by the budget plus one block per run.
  *
  * @note This class is NOT thread-safe. External synchronization is required
  *       if used from multiple threads.
@@ -78,6 +98,7 @@ class SortBuffer {
      *                  direction, nulls handling). Only these columns are used
      *                  for sorting; other columns are just stored and returned.
      * @param limit Maximum rows to output (-1 for unlimited)
+     * @param spill_config Optional memory budget and spill directory
      *
      * @note Offset is NOT supported at segment level. In distributed queries,
      *       offset must be applied at the proxy reduce level after k-way merge.
@@ -85,7 +106,8 @@ class SortBuffer {
      */
     SortBuffer(const std::vector<DataType>& column_types,
                const std::vector<SortKeyInfo>& sort_keys,
-               int64_t limit = -1);
+               int64_t limit = -1,
+               SortSpillConfig spill_config = {});
 
     ~SortBuffer() = default;
 
@@ -191,6 +213,18 @@ class SortBuffer {
         return column_types_.size();
     }
 
+    /// Number of sorted runs written to spill files
+    int64_t
+    NumSpilledRuns() const {
+        return num_spilled_runs_;
+    }
+
+    /// Number of rows written to spill files
+    int64_t
+    NumSpilledRows() const {
+        return num_spilled_rows_;
+    }
+
  private:
     //=========================================================================
     // Internal Methods
@@ -204,6 +238,45 @@ class SortBuffer {
     void
     Sort();
 
+    /**
+     * @brief Sort row pointers by normalized, byte-comparable keys
+     *
+     * For up to two fixed-width numeric sort keys, each row's keys are
+     * encoded once into unsigned integers with direction and null placement
+     * folded in. The encoded entries are then ordered with an LSD radix sort
+     * (or std::sort / std::partial_sort for small inputs and TopK) without
+     * per-comparison type dispatch or null checks.
+     *
+     * @tparam K Number of sort keys
+     */
+    template <size_t K>
+    void
+    SortNormalized();
+
+    /**
+     * @brief Sort buffered rows into a run and write it to a spill file
+     *
+     * Releases all rows held by data_ afterwards.
+     */
+    void
+    SpillRun();
+
+    /// Spill if the buffered rows exceed the configured memory budget
+    void
+    MaybeSpill();
+
+    /// Sort the row pointers and keep at most limit_ of them
+    void
+    SortAndTruncate();
+
+    /// Set up the k-way merge over spilled runs and the in-memory remainder
+    void
+    PrepareMerge();
+
+    /// Pop up to num_rows rows from the merge heap into merged_rows_
+    std::vector<VectorPtr>
+    GetMergedOutput(int64_t num_rows);
+
     /**
      * @brief Compare two rows by sort keys
      *
@@ -255,6 +328,8 @@ class SortBuffer {
     std::vector<DataType> column_types_;
     std::vector<SortKeyInfo> sort_keys_;
     int64_t limit_;
+    // Whether all sort keys can be sorted as normalized integer keys
+    bool use_normalized_keys_ = false;
 
     // Data storage (contiguous row storage)
     std::unique_ptr<RowContainer> data_;
@@ -263,6 +338,42 @@ class SortBuffer {
     // After Sort(), these point to rows in data_ in sorted order
     std::vector<char*> sorted_rows_;
 
+    // Spilling
+    // One sorted run feeding the k-way merge. The in-memory run points into
+    // data_; a spilled run holds one decoded block of rows at a time.
+    struct MergeRun {
+        std::unique_ptr<SpillFile> file;     // null for the in-memory run
+        std::unique_ptr<RowContainer> block;  // rows decoded from file
+        std::vector<char*> rows;
+        size_t pos = 0;
+    };
+
+    /// Advance run to its next row, loading the next block if needed.
+    /// Returns false once the run is exhausted.
+    bool
+    AdvanceRun(MergeRun& run);
+
+    /// Decode the next block of rows from a spilled run
+    bool
+    LoadBlock(MergeRun& run);
+
+    /// Heap order: true if run a's head row sorts after run b's
+    bool
+    HeadGreater(size_t a, size_t b) const;
+
+    SortSpillConfig spill_config_;
+    int64_t buffered_bytes_ = 0;
+    int64_t num_spilled_rows_ = 0;
+    int64_t num_spilled_runs_ = 0;
+    std::vector<std::unique_ptr<SpillFile>> spilled_runs_;
+    std::vector<std::unique_ptr<MergeRun>> merge_runs_;
+    // Min-heap of indexes into merge_runs_, ordered by each run's head row
+    std::vector<size_t> merge_heap_;
+    // Row pointers of the batch being assembled by GetMergedOutput()
+    std::vector<char*> merged_rows_;
+    // Exhausted spill blocks that merged_rows_ may still point into
+    std::vector<std::unique_ptr<RowContainer>> retired_blocks_;
+
     // State tracking
     bool sorted_ = false;
     int64_t num_input_rows_ = 0;
@@ -0,0 +1,158 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/SpillFile.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+
+namespace milvus {
+namespace exec {
+
+SpillFile::SpillFile(const std::string& directory, size_t buffer_size)
+    : path_(BuildPath(directory)), buffer_size_(buffer_size) {
+    AssertInfo(buffer_size_ > 0, "Spill buffer size must be positive");
+    std::filesystem::create_directories(
+        std::filesystem::path(path_).parent_path());
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    AssertInfo(
+        fd_ >= 0, "Failed to create spill file: {} (errno={})", path_, errno);
+    write_buffer_.reserve(buffer_size_);
+}
+
+SpillFile::~SpillFile() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+    if (ec) {
+        LOG_WARN("Failed to remove spill file {}: {}", path_, ec.message());
+    }
+}
+
+void
+SpillFile::AppendRecord(std::string_view record) {
+    AssertInfo(writing_, "Cannot append to spill file after FinishWrite()");
+    auto len = static_cast<uint32_t>(record.size());
+    AssertInfo(len == record.size(),
+               "Spill record too large: {} bytes",
+               record.size());
+    write_buffer_.append(reinterpret_cast<const char*>(&len), sizeof(len));
+    write_buffer_.append(record.data(), record.size());
+    ++num_records_;
+    if (write_buffer_.size() >= buffer_size_) {
+        FlushWriteBuffer();
+    }
+}
+
+void
+SpillFile::FlushWriteBuffer() {
+    size_t written = 0;
+    while (written < write_buffer_.size()) {
+        ssize_t n = ::pwrite(fd_,
+                             write_buffer_.data() + written,
+                             write_buffer_.size() - written,
+                             write_offset_ + written);
+        AssertInfo(n > 0,
+                   "Failed to write spill file: {} at offset {} (errno={})",
+                   path_,
+                   write_offset_ + written,
+                   errno);
+        written += n;
+    }
+    write_offset_ += written;
+    write_buffer_.clear();
+}
+
+void
+SpillFile::FinishWrite() {
+    if (!writing_) {
+        return;
+    }
+    FlushWriteBuffer();
+    write_buffer_.shrink_to_fit();
+    writing_ = false;
+}
+
+bool
+SpillFile::FillReadBuffer(size_t size) {
+    if (read_buffer_.size() - read_pos_ >= size) {
+        return true;
+    }
+    read_buffer_.erase(0, read_pos_);
+    read_pos_ = 0;
+    auto want = std::max(size, buffer_size_);
+    while (read_buffer_.size() < want && read_offset_ < write_offset_) {
+        auto old_size = read_buffer_.size();
+        auto chunk = std::min<uint64_t>(want - old_size,
+                                        write_offset_ - read_offset_);
+        read_buffer_.resize(old_size + chunk);
+        ssize_t n =
+            ::pread(fd_, read_buffer_.data() + old_size, chunk, read_offset_);
+        AssertInfo(n > 0,
+                   "Failed to read spill file: {} at offset {} (errno={})",
+                   path_,
+                   read_offset_,
+                   errno);
+        read_buffer_.resize(old_size + n);
+        read_offset_ += n;
+    }
+    return read_buffer_.size() >= size;
+}
+
+bool
+SpillFile::ReadRecord(std::string& record) {
+    AssertInfo(!writing_, "Must call FinishWrite() before reading spill file");
+    uint32_t len = 0;
+    if (!FillReadBuffer(sizeof(len))) {
+        AssertInfo(read_buffer_.size() == read_pos_,
+                   "Truncated record header in spill file {}",
+                   path_);
+        return false;
+    }
+    std::memcpy(&len, read_buffer_.data() + read_pos_, sizeof(len));
+    read_pos_ += sizeof(len);
+    AssertInfo(FillReadBuffer(len),
+               "Truncated record of {} bytes in spill file {}",
+               len,
+               path_);
+    record.assign(read_buffer_.data() + read_pos_, len);
+    read_pos_ += len;
+    return true;
+}
+
+std::string
+SpillFile::BuildPath(const std::string& directory) {
+    static std::atomic<uint64_t> counter{0};
+    auto seq = counter.fetch_add(1, std::memory_order_relaxed);
+    std::filesystem::path p(directory);
+    p /= "spill_" + std::to_string(::getpid()) + "_" + std::to_string(seq) +
+         ".tmp";
+    return p.string();
+}
+
+}  // namespace exec
+}  // namespace milvus
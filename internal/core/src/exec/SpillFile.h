@@ -0,0 +1,101 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace milvus {
+namespace exec {
+
+// Temporary local file holding length-prefixed records spilled by blocking
+// operators (ORDER BY, GROUP BY) once they exceed their memory budget.
+//
+// The file is written sequentially through an in-memory buffer, then read
+// back sequentially after FinishWrite(). It is unlinked on destruction.
+//
+// File layout:
+//   [len_0 (uint32)][record_0][len_1 (uint32)][record_1]...
+//
+// Not thread-safe: a spill file belongs to a single operator.
+class SpillFile {
+ public:
+    static constexpr size_t kDefaultBufferSize = 1 << 20;
+
+    explicit SpillFile(const std::string& directory,
+                       size_t buffer_size = kDefaultBufferSize);
+
+    ~SpillFile();
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile&
+    operator=(const SpillFile&) = delete;
+
+    void
+    AppendRecord(std::string_view record);
+
+    // Flush buffered records and switch the file to read mode.
+    void
+    FinishWrite();
+
+    // Read the next record into 'record'. Returns false at end of file.
+    bool
+    ReadRecord(std::string& record);
+
+    uint64_t
+    NumRecords() const {
+        return num_records_;
+    }
+
+    uint64_t
+    SizeBytes() const {
+        return write_offset_ + write_buffer_.size();
+    }
+
+    const std::string&
+    Path() const {
+        return path_;
+    }
+
+ private:
+    void
+    FlushWriteBuffer();
+
+    // Make sure at least 'size' bytes are buffered. Returns false at EOF.
+    bool
+    FillReadBuffer(size_t size);
+
+    static std::string
+    BuildPath(const std::string& directory);
+
+    std::string path_;
+    int fd_{-1};
+    size_t buffer_size_;
+    bool writing_{true};
+    uint64_t num_records_{0};
+
+    std::string write_buffer_;
+    uint64_t write_offset_{0};
+
+    std::string read_buffer_;
+    size_t read_pos_{0};
+    uint64_t read_offset_{0};
+};
+
+}  // namespace exec
+}  // namespace milvus
@@ -16,7 +16,10 @@
 
 #include "VectorHasher.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <limits>
+#include <tuple>
 
 #include "common/BitUtil.h"
 #include "common/EasyAssert.h"
@@ -77,5 +80,165 @@ VectorHasher::hash(bool mix, std::vector<uint64_t>& result) {
         hashValues, element_data_type, columnData(), mix, result.data());
 }
 
+namespace {
+template <typename T>
+std::pair<int64_t, int64_t>
+typeLimits() {
+    return {static_cast<int64_t>(std::numeric_limits<T>::min()),
+            static_cast<int64_t>(std::numeric_limits<T>::max())};
+}
+
+std::pair<int64_t, int64_t>
+valueRangeLimits(DataType type) {
+    switch (type) {
+        case DataType::BOOL:
+            return {0, 1};
+        case DataType::INT8:
+            return typeLimits<int8_t>();
+        case DataType::INT16:
+            return typeLimits<int16_t>();
+        case DataType::INT32:
+            return typeLimits<int32_t>();
+        default:
+            return typeLimits<int64_t>();
+    }
+}
+
+template <typename T>
+void
+updateValueRange(const ColumnVectorPtr& column,
+                 bool& hasValues,
+                 int64_t& minValue,
+                 int64_t& maxValue) {
+    const auto* values = reinterpret_cast<const T*>(column->GetRawData());
+    for (size_t i = 0; i < column->size(); ++i) {
+        if (!column->ValidAt(i)) {
+            continue;
+        }
+        auto value = static_cast<int64_t>(values[i]);
+        if (!hasValues) {
+            minValue = maxValue = value;
+            hasValues = true;
+        } else {
+            minValue = std::min(minValue, value);
+            maxValue = std::max(maxValue, value);
+        }
+    }
+}
+}  // namespace
+
+void
+VectorHasher::analyzeValueRange() {
+    switch (channel_type_) {
+        case DataType::BOOL:
+            updateValueRange<bool>(
+                column_data_, hasObservedValues_, observedMin_, observedMax_);
+            break;
+        case DataType::INT8:
+            updateValueRange<int8_t>(
+                column_data_, hasObservedValues_, observedMin_, observedMax_);
+            break;
+        case DataType::INT16:
+            updateValueRange<int16_t>(
+                column_data_, hasObservedValues_, observedMin_, observedMax_);
+            break;
+        case DataType::INT32:
+            updateValueRange<int32_t>(
+                column_data_, hasObservedValues_, observedMin_, observedMax_);
+            break;
+        case DataType::INT64:
+            updateValueRange<int64_t>(
+                column_data_, hasObservedValues_, observedMin_, observedMax_);
+            break;
+        default:
+            ThrowInfo(DataTypeInvalid,
+                      "value range not supported for type: {}",
+                      channel_type_);
+    }
+}
+
+std::pair<int64_t, int64_t>
+VectorHasher::valueRange(bool padded) const {
+    int64_t lo = hasObservedValues_ ? observedMin_ : 0;
+    int64_t hi = hasObservedValues_ ? observedMax_ : 0;
+    if (hasValueIdRange_) {
+        // Keys already stored under the current range must stay covered.
+        lo = std::min(lo, rangeMin_);
+        hi = std::max(hi, rangeMax_);
+    }
+    if (!padded) {
+        return {lo, hi};
+    }
+    auto [typeMin, typeMax] = valueRangeLimits(channel_type_);
+    const __int128 pad = (static_cast<__int128>(hi) - lo) / 2 + 1;
+    return {static_cast<int64_t>(std::max<__int128>(lo - pad, typeMin)),
+            static_cast<int64_t>(std::min<__int128>(hi + pad, typeMax))};
+}
+
+uint64_t
+VectorHasher::valueIdRangeSize(bool padded) const {
+    auto [lo, hi] = valueRange(padded);
+    const auto span = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+    if (span >= std::numeric_limits<uint64_t>::max() - 1) {
+        return 0;
+    }
+    // One id per value plus the null id.
+    return span + 2;
+}
+
+uint64_t
+VectorHasher::setValueIdRange(bool padded, uint64_t multiplier) {
+    auto size = valueIdRangeSize(padded);
+    AssertInfo(size > 0, "value id range of type {} too large", channel_type_);
+    std::tie(rangeMin_, rangeMax_) = valueRange(padded);
+    hasValueIdRange_ = true;
+    multiplier_ = multiplier;
+    return multiplier * size;
+}
+
+template <typename T>
+bool
+VectorHasher::computeValueIdsTyped(bool mix, std::vector<uint64_t>& result) {
+    const auto* values =
+        reinterpret_cast<const T*>(column_data_->GetRawData());
+    const auto span =
+        static_cast<uint64_t>(rangeMax_) - static_cast<uint64_t>(rangeMin_);
+    for (size_t i = 0; i < column_data_->size(); ++i) {
+        uint64_t id = 0;
+        if (column_data_->ValidAt(i)) {
+            // Values below rangeMin_ wrap around to a large offset.
+            auto value = static_cast<int64_t>(values[i]);
+            auto offset = static_cast<uint64_t>(value) -
+                          static_cast<uint64_t>(rangeMin_);
+            if (offset > span) {
+                return false;
+            }
+            id = offset + 1;
+        }
+        result[i] = mix ? result[i] + id * multiplier_ : id * multiplier_;
+    }
+    return true;
+}
+
+bool
+VectorHasher::computeValueIds(bool mix, std::vector<uint64_t>& result) {
+    switch (channel_type_) {
+        case DataType::BOOL:
+            return computeValueIdsTyped<bool>(mix, result);
+        case DataType::INT8:
+            return computeValueIdsTyped<int8_t>(mix, result);
+        case DataType::INT16:
+            return computeValueIdsTyped<int16_t>(mix, result);
+        case DataType::INT32:
+            return computeValueIdsTyped<int32_t>(mix, result);
+        case DataType::INT64:
+            return computeValueIdsTyped<int64_t>(mix, result);
+        default:
+            ThrowInfo(DataTypeInvalid,
+                      "value ids not supported for type: {}",
+                      channel_type_);
+    }
+}
+
 }  // namespace exec
 }  // namespace milvus
@@ -18,6 +18,7 @@
 
 #include <stdint.h>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "common/Types.h"
@@ -72,6 +73,46 @@ class VectorHasher {
     void
     hashValues(const ColumnVectorPtr& column_data, bool mix, uint64_t* result);
 
+    // Value ids map each key to a dense number instead of a hash: 0 for
+    // null and 1 + (value - min) inside the range set by setValueIdRange().
+    // They let the hash table index groups directly (kArray) or pack all
+    // keys into one 64-bit normalized key (kNormalizedKey).
+    static bool
+    typeSupportsValueRange(DataType type) {
+        switch (type) {
+            case DataType::BOOL:
+            case DataType::INT8:
+            case DataType::INT16:
+            case DataType::INT32:
+            case DataType::INT64:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Widens the observed min/max with the non-null values of the column.
+    void
+    analyzeValueRange();
+
+    // Number of value ids, including the null id, needed to cover the
+    // observed range. With 'padded' the range is widened by half its span on
+    // each side (within the type limits) to absorb nearby future keys.
+    // Returns 0 if the count does not fit in 64 bits.
+    uint64_t
+    valueIdRangeSize(bool padded) const;
+
+    // Fixes the value id range and the multiplier applied to the ids when
+    // several keys are packed together. Returns the multiplier for the next
+    // key.
+    uint64_t
+    setValueIdRange(bool padded, uint64_t multiplier);
+
+    // Stores (or adds, if 'mix') value id * multiplier for each row into
+    // 'result'. Returns false if some value falls outside the range.
+    bool
+    computeValueIds(bool mix, std::vector<uint64_t>& result);
+
     void
     setColumnData(const ColumnVectorPtr& column_data) {
         column_data_ = column_data;
@@ -83,9 +124,25 @@ class VectorHasher {
     }
 
  private:
+    template <typename T>
+    bool
+    computeValueIdsTyped(bool mix, std::vector<uint64_t>& result);
+
+    // Observed value range, or padded to the type limits, as [first, second].
+    std::pair<int64_t, int64_t>
+    valueRange(bool padded) const;
+
     const column_index_t channel_idx_;
     const DataType channel_type_;
     ColumnVectorPtr column_data_;
+
+    bool hasObservedValues_{false};
+    int64_t observedMin_{0};
+    int64_t observedMax_{0};
+    bool hasValueIdRange_{false};
+    int64_t rangeMin_{0};
+    int64_t rangeMax_{0};
+    uint64_t multiplier_{1};
 };
 
 std::vector<std::unique_ptr<VectorHasher>>
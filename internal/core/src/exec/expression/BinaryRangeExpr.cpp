@@ -33,6 +33,7 @@
 #include "exec/expression/Utils.h"
 #include "fmt/core.h"
 #include "folly/FBVector.h"
+#include "folly/ScopeGuard.h"
 #include "glog/logging.h"
 #include "index/SkipIndex.h"
 #include "monitor/Monitor.h"
@@ -595,6 +596,28 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForData(EvalCtx& context) {
             processed_size = ProcessDataChunksForElementLevel<T>(
                 execute_sub_batch, skip_index_func, res, valid_res, val1, val2);
         } else {
+            if constexpr (std::is_same_v<T, int32_t> ||
+                          std::is_same_v<T, int64_t>) {
+                if (bitmap_input.empty()) {
+                    using milvus::bitset::RangeType;
+                    auto range =
+                        lower_inclusive
+                            ? (upper_inclusive ? RangeType::IncInc
+                                               : RangeType::IncExc)
+                            : (upper_inclusive ? RangeType::ExcInc
+                                               : RangeType::ExcExc);
+                    packed_eval_ = [range, val1, val2](
+                                       const FixedWidthChunk& chunk,
+                                       int64_t offset,
+                                       int64_t size,
+                                       TargetBitmapView res) {
+                        chunk.PackedWithinRange(
+                            range, val1, val2, offset, size, res);
+                    };
+                }
+            }
+            auto guard =
+                folly::makeGuard([this]() { packed_eval_ = nullptr; });
             processed_size = ProcessDataChunks<T>(
                 execute_sub_batch, skip_index_func, res, valid_res, val1, val2);
         }
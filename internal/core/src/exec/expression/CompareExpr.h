@@ -356,28 +356,33 @@ class PhyCompareFilterExpr : public Expr {
                 auto [right_chunk_id, right_chunk_offset] =
                     get_chunk_id_and_offset(right_field_);
 
-                auto pw_left = segment_chunk_reader_.segment_->chunk_data<T>(
-                    op_ctx_, left_field_, left_chunk_id);
+                auto pw_left = segment_chunk_reader_.segment_->chunk_rows<T>(
+                    op_ctx_, left_field_, left_chunk_id, left_chunk_offset, 1);
                 auto left_chunk = pw_left.get();
-                auto pw_right = segment_chunk_reader_.segment_->chunk_data<U>(
-                    op_ctx_, right_field_, right_chunk_id);
+                auto pw_right =
+                    segment_chunk_reader_.segment_->chunk_rows<U>(
+                        op_ctx_,
+                        right_field_,
+                        right_chunk_id,
+                        right_chunk_offset,
+                        1);
                 auto right_chunk = pw_right.get();
                 const bool* left_valid_data = left_chunk.valid_data();
                 const bool* right_valid_data = right_chunk.valid_data();
-                if (left_valid_data && !left_valid_data[left_chunk_offset]) {
+                if (left_valid_data && !left_valid_data[0]) {
                     res[processed_size] = false;
                     valid_res[processed_size] = false;
                     processed_size++;
                     continue;
                 }
-                if (right_valid_data && !right_valid_data[right_chunk_offset]) {
+                if (right_valid_data && !right_valid_data[0]) {
                     res[processed_size] = false;
                     valid_res[processed_size] = false;
                     processed_size++;
                     continue;
                 }
-                const T* left_data = left_chunk.data() + left_chunk_offset;
-                const U* right_data = right_chunk.data() + right_chunk_offset;
+                const T* left_data = left_chunk.data();
+                const U* right_data = right_chunk.data();
                 func.template operator()<FilterType::random>(
                     left_data,
                     right_data,
@@ -510,12 +515,6 @@ class PhyCompareFilterExpr : public Expr {
 
         // only call this function when left and right are not indexed, so they have the same number of chunks
         for (size_t i = left_current_chunk_id_; i < left_num_chunk_; i++) {
-            auto pw_left = segment_chunk_reader_.segment_->chunk_data<T>(
-                op_ctx_, left_field_, i);
-            auto left_chunk = pw_left.get();
-            auto pw_right = segment_chunk_reader_.segment_->chunk_data<U>(
-                op_ctx_, right_field_, i);
-            auto right_chunk = pw_right.get();
             auto data_pos =
                 (i == left_current_chunk_id_) ? left_current_chunk_pos_ : 0;
             auto size = 0;
@@ -541,8 +540,14 @@ class PhyCompareFilterExpr : public Expr {
                 size = batch_size_ - processed_size;
             }
 
-            const T* left_data = left_chunk.data() + data_pos;
-            const U* right_data = right_chunk.data() + data_pos;
+            auto pw_left = segment_chunk_reader_.segment_->chunk_rows<T>(
+                op_ctx_, left_field_, i, data_pos, size);
+            auto left_chunk = pw_left.get();
+            auto pw_right = segment_chunk_reader_.segment_->chunk_rows<U>(
+                op_ctx_, right_field_, i, data_pos, size);
+            auto right_chunk = pw_right.get();
+            const T* left_data = left_chunk.data();
+            const U* right_data = right_chunk.data();
             func(left_data,
                  right_data,
                  nullptr,
@@ -553,12 +558,12 @@ class PhyCompareFilterExpr : public Expr {
             const bool* right_valid_data = right_chunk.valid_data();
             // mask with valid_data
             for (int i = 0; i < size; ++i) {
-                if (left_valid_data && !left_valid_data[i + data_pos]) {
+                if (left_valid_data && !left_valid_data[i]) {
                     res[processed_size + i] = false;
                     valid_res[processed_size + i] = false;
                     continue;
                 }
-                if (right_valid_data && !right_valid_data[i + data_pos]) {
+                if (right_valid_data && !right_valid_data[i]) {
                     res[processed_size + i] = false;
                     valid_res[processed_size + i] = false;
                 }
@@ -17,6 +17,7 @@
 #include "ConjunctExpr.h"
 
 #include <algorithm>
+#include <chrono>
 
 #include "LikeConjunctExpr.h"
 #include "UnaryExpr.h"
@@ -26,6 +27,8 @@
 #include "exec/QueryContext.h"
 #include "exec/expression/Utils.h"
 #include "fmt/core.h"
+#include "fmt/ranges.h"
+#include "log/Log.h"
 #include "opentelemetry/trace/span.h"
 
 namespace milvus {
@@ -87,6 +90,49 @@ PhyConjunctFilterExpr::SkipFollowingExprs(int start) {
     }
 }
 
+void
+PhyConjunctFilterExpr::AdaptInputOrder() {
+    // Rank = cost per incoming row / fraction of rows it deactivates, the
+    // classic order for short-circuiting filters: an input that is cheap
+    // but keeps every row active ranks behind a selective one. Inputs never
+    // reached during sampling (always behind an early exit) keep their
+    // relative order at the end, as do the batch-ngram entries, which are
+    // evaluated apart. Pinned entries stay in front.
+    constexpr double kMinDropRate = 1e-3;
+    std::vector<std::pair<double, size_t>> ranked;
+    std::vector<size_t> unranked;
+    for (size_t pos = pinned_inputs_; pos < input_order_.size(); ++pos) {
+        auto idx = input_order_[pos];
+        const auto& stats = input_stats_[idx];
+        if (batch_ngram_indices_.count(idx) || stats.rows_in == 0) {
+            unranked.push_back(idx);
+            continue;
+        }
+        double cost = static_cast<double>(stats.nanos) / stats.rows_in;
+        double drop_rate =
+            1.0 - static_cast<double>(stats.rows_kept) / stats.rows_in;
+        ranked.emplace_back(cost / std::max(drop_rate, kMinDropRate), idx);
+    }
+    std::stable_sort(
+        ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+
+    std::vector<size_t> order(input_order_.begin(),
+                              input_order_.begin() + pinned_inputs_);
+    order.reserve(input_order_.size());
+    for (const auto& [rank, idx] : ranked) {
+        order.push_back(idx);
+    }
+    order.insert(order.end(), unranked.begin(), unranked.end());
+    if (order != input_order_) {
+        LOG_DEBUG("adapt conjunct order from {} to {}",
+                  fmt::join(input_order_, ","),
+                  fmt::join(order, ","));
+        input_order_ = std::move(order);
+    }
+}
+
 void
 PhyConjunctFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
     tracer::AutoSpan span(
@@ -160,6 +206,22 @@ PhyConjunctFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
         }
     }
 
+    const bool sampling = sampled_batches_ < kAdaptiveSampleBatches + 1 &&
+                          input_order_.size() > pinned_inputs_ + 1;
+    if (sampling) {
+        input_stats_.resize(inputs_.size());
+    }
+    // Sampling bookkeeping for this batch, done on every exit path.
+    auto finish_sampling = [&]() {
+        if (sampling && ++sampled_batches_ == kAdaptiveSampleBatches + 1) {
+            AdaptInputOrder();
+        }
+    };
+    // Active rows before the next input, -1 until the first one sets it.
+    int64_t active_count = context.get_bitmap_input().empty()
+                               ? -1
+                               : context.get_bitmap_input().count();
+
     bool has_result = false;
     for (size_t i = 0; i < input_order_.size(); ++i) {
         size_t idx = input_order_[i];
@@ -170,7 +232,17 @@ PhyConjunctFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
         }
 
         VectorPtr input_result;
+        std::chrono::steady_clock::time_point eval_start;
+        if (sampling) {
+            eval_start = std::chrono::steady_clock::now();
+        }
         inputs_[idx]->Eval(context, input_result);
+        int64_t eval_nanos = 0;
+        if (sampling) {
+            eval_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - eval_start)
+                             .count();
+        }
 
         ColumnVectorPtr all_flat_result;
         if (!has_result) {
@@ -189,9 +261,19 @@ PhyConjunctFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
             }
         }
 
+        if (active_count < 0) {
+            active_count = all_flat_result->size();
+        }
+
         // The last evaluated expression needs neither a skip decision nor a
         // bitmap input for a successor.
         if (i == last_eval_pos) {
+            if (sampling && input_stats_[idx].evals++ > 0) {
+                auto& stats = input_stats_[idx];
+                stats.nanos += eval_nanos;
+                stats.rows_in += active_count;
+                stats.rows_kept += BuildActiveBitmap(all_flat_result).count();
+            }
             break;
         }
 
@@ -199,14 +281,28 @@ PhyConjunctFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
         // batch-level early exit, and the same bitmap becomes the row-level
         // input of the next expression.
         auto active_rows = BuildActiveBitmap(all_flat_result);
+        if (sampling) {
+            // AND/OR only ever shrink the active set, so the rows dropped
+            // here are those this input deactivated.
+            auto kept = static_cast<int64_t>(active_rows.count());
+            auto& stats = input_stats_[idx];
+            if (stats.evals++ > 0) {
+                stats.nanos += eval_nanos;
+                stats.rows_in += active_count;
+                stats.rows_kept += kept;
+            }
+            active_count = kept;
+        }
         if (active_rows.none()) {
             SkipFollowingExprs(i + 1);
             ClearBitmapInput(context);
+            finish_sampling();
             return;
         }
         context.set_bitmap_input(std::move(active_rows));
     }
     ClearBitmapInput(context);
+    finish_sampling();
 }
 
 }  //namespace exec
@@ -42,6 +42,13 @@ namespace exec {
 
 class PhyConjunctFilterExpr : public Expr {
  public:
+    // Batches over which the cost and pass rate of each input are sampled
+    // before the inputs are reordered by them. The first evaluation of an
+    // input is not sampled, since it may build a whole-segment index or
+    // cache result that later batches only read, so sampling spans one
+    // more batch.
+    static constexpr int kAdaptiveSampleBatches = 4;
+
     PhyConjunctFilterExpr(std::vector<ExprPtr>&& inputs,
                           bool is_and,
                           milvus::OpContext* op_ctx)
@@ -140,9 +147,12 @@ class PhyConjunctFilterExpr : public Expr {
         }
     }
 
+    // 'pinned' leading entries of the order keep their place when the
+    // order is adapted to sampled costs.
     void
-    Reorder(const std::vector<size_t>& exprs_order) {
+    Reorder(const std::vector<size_t>& exprs_order, size_t pinned = 0) {
         input_order_ = exprs_order;
+        pinned_inputs_ = std::min(pinned, exprs_order.size());
     }
 
     std::vector<size_t>
@@ -214,6 +224,11 @@ class PhyConjunctFilterExpr : public Expr {
     static DataType
     ResolveType(const std::vector<DataType>& inputs);
 
+    // Reorders the evaluated inputs by their sampled rank, once the sample
+    // batches are done.
+    void
+    AdaptInputOrder();
+
     void
     SkipFollowingExprs(int start);
     // true if conjunction (and), false if disjunction (or).
@@ -228,6 +243,26 @@ class PhyConjunctFilterExpr : public Expr {
     bool like_batch_initialized_{false};
     // Indices of expressions executed via batch ngram (to skip in normal iteration)
     std::set<size_t> batch_ngram_indices_;
+
+    // Runtime cost and pass rate of an input, sampled over the batches
+    // after its first evaluation. The static order from
+    // ReorderConjunctExpr only knows column and expression kinds; these
+    // let a selective but costlier input move ahead of a cheap one that
+    // filters nothing.
+    struct InputStats {
+        // Evaluations seen, the first of which is not sampled.
+        int64_t evals{0};
+        int64_t nanos{0};
+        // Rows still active when the input was evaluated.
+        int64_t rows_in{0};
+        // Of those, rows still active after it.
+        int64_t rows_kept{0};
+    };
+    std::vector<InputStats> input_stats_;
+    int sampled_batches_{0};
+    // Leading input_order_ entries placed first on purpose by
+    // ReorderConjunctExpr, e.g. the namespace filter.
+    size_t pinned_inputs_{0};
 };
 }  //namespace exec
 }  // namespace milvus
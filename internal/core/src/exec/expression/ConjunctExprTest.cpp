@@ -16,9 +16,11 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -41,6 +43,8 @@ class FixedBitmapExpr : public Expr {
 
     void
     Eval(EvalCtx&, VectorPtr& result) override {
+        std::this_thread::sleep_for(eval_count_ == 0 ? first_eval_delay_
+                                                     : eval_delay_);
         ++eval_count_;
         result = std::make_shared<ColumnVector>(data_.clone(), valid_.clone());
     }
@@ -62,6 +66,9 @@ class FixedBitmapExpr : public Expr {
 
     int eval_count_ = 0;
     int move_count_ = 0;
+    // Simulated cost of the first and of later evaluations.
+    std::chrono::milliseconds first_eval_delay_{0};
+    std::chrono::milliseconds eval_delay_{0};
 
  private:
     TargetBitmap data_;
@@ -336,4 +343,98 @@ TEST(ConjunctExprTest, MarkNullRejectingStopsAtNonConjunctNodes) {
     EXPECT_FALSE(hidden_and->IsNullRejecting());
 }
 
+TEST(ConjunctExprTest, AdaptsOrderToSampledSelectivity) {
+    // The static order puts an input that keeps every row first, ahead of
+    // one that rejects them all.
+    constexpr size_t kRows = 64;
+    auto keep_all = std::make_shared<FixedBitmapExpr>(
+        TargetBitmap(kRows, true), TargetBitmap(kRows, true));
+    auto reject_all = std::make_shared<FixedBitmapExpr>(
+        TargetBitmap(kRows, false), TargetBitmap(kRows, true));
+    std::vector<ExprPtr> inputs{keep_all, reject_all};
+    PhyConjunctFilterExpr conjunct(std::move(inputs), true, nullptr);
+
+    QueryContext query_context("conjunct_test", nullptr, 1, 0);
+    ExecContext exec_context(&query_context);
+    EvalCtx eval_context(&exec_context);
+
+    auto eval = [&]() {
+        VectorPtr result;
+        conjunct.Eval(eval_context, result);
+        auto output = std::dynamic_pointer_cast<ColumnVector>(result);
+        ASSERT_NE(output, nullptr);
+        ASSERT_EQ(output->size(), kRows);
+        TargetBitmapView data(output->GetRawData(), output->size());
+        EXPECT_TRUE(data.none());
+    };
+
+    // The first batch is not sampled.
+    constexpr int kBatches = PhyConjunctFilterExpr::kAdaptiveSampleBatches + 1;
+    eval();
+    EXPECT_EQ(conjunct.GetReorder(), (std::vector<size_t>{0, 1}));
+    for (int i = 1; i < kBatches; ++i) {
+        eval();
+    }
+    EXPECT_EQ(conjunct.GetReorder(), (std::vector<size_t>{1, 0}));
+    EXPECT_EQ(keep_all->eval_count_, kBatches);
+
+    // The selective input now runs first and short-circuits the other.
+    eval();
+    EXPECT_EQ(keep_all->eval_count_, kBatches);
+    EXPECT_EQ(keep_all->move_count_, 1);
+    EXPECT_EQ(reject_all->eval_count_, kBatches + 1);
+}
+
+TEST(ConjunctExprTest, AdaptiveOrderIgnoresFirstEvalCost) {
+    // An indexed input pays a whole-segment build on its first evaluation
+    // and then rejects every row almost for free; a scan input keeps half
+    // the rows at a steady cost. Sampling the build would rank the scan
+    // first.
+    constexpr size_t kRows = 64;
+    TargetBitmap half(kRows, false);
+    for (size_t i = 0; i < kRows; i += 2) {
+        half[i] = true;
+    }
+    auto scan = std::make_shared<FixedBitmapExpr>(std::move(half),
+                                                  TargetBitmap(kRows, true));
+    scan->eval_delay_ = std::chrono::milliseconds(1);
+    auto indexed = std::make_shared<FixedBitmapExpr>(
+        TargetBitmap(kRows, false), TargetBitmap(kRows, true));
+    indexed->first_eval_delay_ = std::chrono::milliseconds(200);
+    std::vector<ExprPtr> inputs{scan, indexed};
+    PhyConjunctFilterExpr conjunct(std::move(inputs), true, nullptr);
+
+    QueryContext query_context("conjunct_test", nullptr, 1, 0);
+    ExecContext exec_context(&query_context);
+    EvalCtx eval_context(&exec_context);
+    for (int i = 0; i <= PhyConjunctFilterExpr::kAdaptiveSampleBatches; ++i) {
+        VectorPtr result;
+        conjunct.Eval(eval_context, result);
+    }
+    EXPECT_EQ(conjunct.GetReorder(), (std::vector<size_t>{1, 0}));
+}
+
+TEST(ConjunctExprTest, AdaptiveOrderKeepsPinnedInputs) {
+    // The pinned first input keeps every row, yet stays first.
+    constexpr size_t kRows = 64;
+    auto keep_all = std::make_shared<FixedBitmapExpr>(
+        TargetBitmap(kRows, true), TargetBitmap(kRows, true));
+    auto keep_all_2 = std::make_shared<FixedBitmapExpr>(
+        TargetBitmap(kRows, true), TargetBitmap(kRows, true));
+    auto reject_all = std::make_shared<FixedBitmapExpr>(
+        TargetBitmap(kRows, false), TargetBitmap(kRows, true));
+    std::vector<ExprPtr> inputs{keep_all, keep_all_2, reject_all};
+    PhyConjunctFilterExpr conjunct(std::move(inputs), true, nullptr);
+    conjunct.Reorder({0, 1, 2}, 1);
+
+    QueryContext query_context("conjunct_test", nullptr, 1, 0);
+    ExecContext exec_context(&query_context);
+    EvalCtx eval_context(&exec_context);
+    for (int i = 0; i <= PhyConjunctFilterExpr::kAdaptiveSampleBatches; ++i) {
+        VectorPtr result;
+        conjunct.Eval(eval_context, result);
+    }
+    EXPECT_EQ(conjunct.GetReorder(), (std::vector<size_t>{0, 2, 1}));
+}
+
 }  // namespace milvus::exec
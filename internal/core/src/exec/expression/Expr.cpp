@@ -651,7 +651,9 @@ ReorderConjunctExpr(std::shared_ptr<milvus::exec::PhyConjunctFilterExpr>& expr,
                reorder.size(),
                expected_size);
 
-    expr->Reorder(reorder);
+    // The namespace filter stays first even when sampled costs would move
+    // it.
+    expr->Reorder(reorder, namespace_expr_idx.has_value() ? 1 : 0);
 }
 
 inline void
@@ -438,6 +438,61 @@ class SegmentExpr : public Expr {
         ApplyValidMask(valid_data, res, valid_res, size);
     }
 
+    // Evaluates dictionary_eval_ on the codes of rows [pos, pos + size) of a
+    // dictionary-encoded sealed string chunk, so that each distinct value is
+    // compared once per chunk. Returns false if the chunk is not encoded.
+    bool
+    MatchDictionaryCodes(int64_t chunk_id,
+                         int64_t pos,
+                         int64_t size,
+                         TargetBitmapView res,
+                         TargetBitmapView valid_res) {
+        if (!dictionary_eval_ || segment_->type() != SegmentType::Sealed) {
+            return false;
+        }
+        auto pw =
+            segment_->dictionary_string_chunk(op_ctx_, field_id_, chunk_id);
+        auto chunk = pw.get();
+        if (chunk == nullptr) {
+            return false;
+        }
+        if (dictionary_chunk_id_ != chunk_id) {
+            dictionary_matches_ = chunk->MatchDictionary(dictionary_eval_);
+            dictionary_chunk_id_ = chunk_id;
+        }
+        chunk->MatchCodes(dictionary_matches_, pos, size, res);
+        const auto& valid = chunk->Valid();
+        ApplyValidData(
+            valid.empty() ? nullptr : valid.data() + pos, res, valid_res, size);
+        return true;
+    }
+
+    // Evaluates packed_eval_ on rows [pos, pos + size) of a packed sealed
+    // integer chunk without decoding it. Returns false if the chunk is not
+    // packed.
+    bool
+    MatchPackedValues(int64_t chunk_id,
+                      int64_t pos,
+                      int64_t size,
+                      TargetBitmapView res,
+                      TargetBitmapView valid_res) {
+        if (!packed_eval_ || segment_->type() != SegmentType::Sealed) {
+            return false;
+        }
+        auto pw = segment_->packed_int_chunk(op_ctx_, field_id_, chunk_id);
+        auto chunk = pw.get();
+        if (chunk == nullptr) {
+            return false;
+        }
+        packed_eval_(*chunk, pos, size, res);
+        auto valid_data = chunk->ValidData();
+        ApplyValidData(valid_data == nullptr ? nullptr : valid_data + pos,
+                       res,
+                       valid_res,
+                       size);
+        return true;
+    }
+
     // Try to load the full bitset from ExprResCache.
     // Returns true if cache hit (cached_index_chunk_res_ populated).
     // Call at the top of ByStats / ByIndex methods to skip computation.
@@ -793,13 +848,11 @@ class SegmentExpr : public Expr {
                 int64_t offset = (*input)[i];
                 auto [chunk_id, chunk_offset] =
                     segment_->get_chunk_by_offset(field_id_, offset);
-                auto pw = segment_->chunk_data<T>(op_ctx_, field_id_, chunk_id);
+                auto pw = segment_->chunk_rows<T>(
+                    op_ctx_, field_id_, chunk_id, chunk_offset, 1);
                 auto chunk = pw.get();
-                const T* data = chunk.data() + chunk_offset;
+                const T* data = chunk.data();
                 const bool* valid_data = chunk.valid_data();
-                if (valid_data != nullptr) {
-                    valid_data += chunk_offset;
-                }
                 if (!skip_func ||
                     !skip_func(*skip_index, field_id_, chunk_id)) {
                     evaluate_batch.template operator()<FilterType::random>(
@@ -1479,127 +1532,158 @@ class SegmentExpr : public Expr {
                 int64_t offset = start_offset + j;
                 segment_offsets_array[j] = static_cast<int32_t>(offset);
             }
-            auto skip_index = segment_->GetSkipIndex();
-            if (!skip_func || !skip_func(*skip_index, field_id_, i)) {
-                bool is_seal = false;
-                if constexpr (std::is_same_v<T, std::string_view> ||
-                              std::is_same_v<T, Json> ||
-                              std::is_same_v<T, ArrayView> ||
-                              std::is_same_v<T, VectorArrayView>) {
-                    if (segment_->type() == SegmentType::Sealed) {
-                        // first is the raw data, second is valid_data
-                        // use valid_data to see if raw data is null
-                        auto pw = segment_->get_batch_views<T>(
-                            op_ctx_, field_id_, i, data_pos, size);
-                        const auto& [data_vec, valid_data] = pw.get();
-
-                        if constexpr (NeedSegmentOffsets) {
-                            func(data_vec.data(),
-                                 valid_data.data(),
-                                 nullptr,
-                                 segment_offsets_array.data(),
-                                 size,
-                                 res + processed_size,
-                                 valid_res + processed_size,
-                                 values...);
-                        } else {
-                            func(data_vec.data(),
-                                 valid_data.data(),
-                                 nullptr,
-                                 size,
-                                 res + processed_size,
-                                 valid_res + processed_size,
-                                 values...);
-                        }
-
-                        is_seal = true;
+            // Evaluates rows [pos, pos + len) of the chunk into res + out,
+            // or only applies their valid data when they are skipped.
+            auto process = [&](int64_t pos, int64_t len, bool skipped) {
+                auto out = processed_size + (pos - data_pos);
+                [[maybe_unused]] auto offsets =
+                    segment_offsets_array.data() + (pos - data_pos);
+                // Calls func with nullptr to update internal cursors
+                // (e.g., processed_cursor for bitmap_input indexing).
+                auto advance = [&]() {
+                    if constexpr (NeedSegmentOffsets) {
+                        func(nullptr,
+                             nullptr,
+                             nullptr,
+                             offsets,
+                             len,
+                             res + out,
+                             valid_res + out,
+                             values...);
+                    } else {
+                        func(nullptr,
+                             nullptr,
+                             nullptr,
+                             len,
+                             res + out,
+                             valid_res + out,
+                             values...);
+                    }
+                };
+                if constexpr (std::is_same_v<T, std::string_view>) {
+                    if (!skipped &&
+                        MatchDictionaryCodes(
+                            i, pos, len, res + out, valid_res + out)) {
+                        advance();
+                        return;
+                    }
+                } else if constexpr (std::is_same_v<T, int32_t> ||
+                                     std::is_same_v<T, int64_t>) {
+                    if (!skipped &&
+                        MatchPackedValues(
+                            i, pos, len, res + out, valid_res + out)) {
+                        advance();
+                        return;
                     }
                 }
-                if constexpr (std::is_same_v<T, VectorArrayView>) {
-                    AssertInfo(is_seal,
-                               "VectorArrayView must be read through chunk "
-                               "views");
-                } else {
-                    if (!is_seal) {
-                        auto pw =
-                            segment_->chunk_data<T>(op_ctx_, field_id_, i);
-                        auto chunk = pw.get();
-                        const T* data = chunk.data() + data_pos;
-                        const bool* valid_data = chunk.valid_data();
-                        if (valid_data != nullptr) {
-                            valid_data += data_pos;
-                        }
+                if (!skipped) {
+                    bool is_seal = false;
+                    if constexpr (std::is_same_v<T, std::string_view> ||
+                                  std::is_same_v<T, Json> ||
+                                  std::is_same_v<T, ArrayView> ||
+                                  std::is_same_v<T, VectorArrayView>) {
+                        if (segment_->type() == SegmentType::Sealed) {
+                            // first is the raw data, second is valid_data
+                            // use valid_data to see if raw data is null
+                            auto pw = segment_->get_batch_views<T>(
+                                op_ctx_, field_id_, i, pos, len);
+                            const auto& [data_vec, valid_data] = pw.get();
+
+                            if constexpr (NeedSegmentOffsets) {
+                                func(data_vec.data(),
+                                     valid_data.data(),
+                                     nullptr,
+                                     offsets,
+                                     len,
+                                     res + out,
+                                     valid_res + out,
+                                     values...);
+                            } else {
+                                func(data_vec.data(),
+                                     valid_data.data(),
+                                     nullptr,
+                                     len,
+                                     res + out,
+                                     valid_res + out,
+                                     values...);
+                            }
 
-                        if constexpr (NeedSegmentOffsets) {
-                            // For GIS functions: construct segment offsets array
-                            func(data,
-                                 valid_data,
-                                 nullptr,
-                                 segment_offsets_array.data(),
-                                 size,
-                                 res + processed_size,
-                                 valid_res + processed_size,
-                                 values...);
-                        } else {
-                            func(data,
-                                 valid_data,
-                                 nullptr,
-                                 size,
-                                 res + processed_size,
-                                 valid_res + processed_size,
-                                 values...);
+                            is_seal = true;
                         }
                     }
-                }
-            } else {
-                // Chunk is skipped by SkipIndex.
-                // We still need to:
-                // 1. Apply valid_data to handle nullable fields
-                // 2. Call func with nullptr to update internal cursors
-                //    (e.g., processed_cursor for bitmap_input indexing)
-                const bool* valid_data;
-                if constexpr (std::is_same_v<T, std::string_view> ||
-                              std::is_same_v<T, Json> ||
-                              std::is_same_v<T, ArrayView> ||
-                              std::is_same_v<T, VectorArrayView>) {
-                    auto pw = segment_->get_batch_views<T>(
-                        op_ctx_, field_id_, i, data_pos, size);
-                    valid_data = pw.get().second.data();
-                    ApplyValidData(valid_data,
-                                   res + processed_size,
-                                   valid_res + processed_size,
-                                   size);
-                } else {
-                    auto pw = segment_->chunk_data<T>(op_ctx_, field_id_, i);
-                    auto chunk = pw.get();
-                    valid_data = chunk.valid_data();
-                    if (valid_data != nullptr) {
-                        valid_data += data_pos;
+                    if constexpr (std::is_same_v<T, VectorArrayView>) {
+                        AssertInfo(is_seal,
+                                   "VectorArrayView must be read through chunk "
+                                   "views");
+                    } else {
+                        if (!is_seal) {
+                            auto pw = segment_->chunk_rows<T>(
+                                op_ctx_, field_id_, i, pos, len);
+                            auto chunk = pw.get();
+                            const T* data = chunk.data();
+                            const bool* valid_data = chunk.valid_data();
+
+                            if constexpr (NeedSegmentOffsets) {
+                                // For GIS functions: construct segment offsets
+                                // array
+                                func(data,
+                                     valid_data,
+                                     nullptr,
+                                     offsets,
+                                     len,
+                                     res + out,
+                                     valid_res + out,
+                                     values...);
+                            } else {
+                                func(data,
+                                     valid_data,
+                                     nullptr,
+                                     len,
+                                     res + out,
+                                     valid_res + out,
+                                     values...);
+                            }
+                        }
                     }
-                    ApplyValidData(valid_data,
-                                   res + processed_size,
-                                   valid_res + processed_size,
-                                   size);
-                }
-                // Call func with nullptr to update internal cursors
-                if constexpr (NeedSegmentOffsets) {
-                    func(nullptr,
-                         nullptr,
-                         nullptr,
-                         segment_offsets_array.data(),
-                         size,
-                         res + processed_size,
-                         valid_res + processed_size,
-                         values...);
                 } else {
-                    func(nullptr,
-                         nullptr,
-                         nullptr,
-                         size,
-                         res + processed_size,
-                         valid_res + processed_size,
-                         values...);
+                    // Rows are skipped by SkipIndex.
+                    // We still need to:
+                    // 1. Apply valid_data to handle nullable fields
+                    // 2. Call func with nullptr to update internal cursors
+                    //    (e.g., processed_cursor for bitmap_input indexing)
+                    const bool* valid_data;
+                    if constexpr (std::is_same_v<T, std::string_view> ||
+                                  std::is_same_v<T, Json> ||
+                                  std::is_same_v<T, ArrayView> ||
+                                  std::is_same_v<T, VectorArrayView>) {
+                        auto pw = segment_->get_batch_views<T>(
+                            op_ctx_, field_id_, i, pos, len);
+                        valid_data = pw.get().second.data();
+                        ApplyValidData(valid_data,
+                                       res + out,
+                                       valid_res + out,
+                                       len);
+                    } else {
+                        auto pw = segment_->chunk_rows<T>(
+                            op_ctx_, field_id_, i, pos, len);
+                        valid_data = pw.get().valid_data();
+                        ApplyValidData(valid_data,
+                                       res + out,
+                                       valid_res + out,
+                                       len);
+                    }
+                    advance();
                 }
+            };
+            auto skip_index = segment_->GetSkipIndex();
+            if (!skip_func) {
+                process(data_pos, size, false);
+            } else if (skip_func(*skip_index, field_id_, i)) {
+                process(data_pos, size, true);
+            } else {
+                // Pages of a kept chunk may still be skipped on their own.
+                skip_index->ForEachPageRun(
+                    op_ctx_, field_id_, i, data_pos, size, skip_func, process);
             }
 
             processed_size += size;
@@ -2537,6 +2621,19 @@ class SegmentExpr : public Expr {
     bool execute_all_at_once_{false};
     // used for reducing cache miss latency in tiered storage
     bool prefetched_{false};
+    // Set by string expressions while they scan raw data, to evaluate them
+    // on dictionary-encoded chunks; the matches of the last chunk are kept
+    // across batches.
+    StringChunk::DictionaryPredicate dictionary_eval_;
+    int64_t dictionary_chunk_id_{-1};
+    StringDictionaryMatches dictionary_matches_;
+    // Set by integer compare and range expressions while they scan raw data,
+    // to evaluate them on packed chunks.
+    std::function<void(const FixedWidthChunk& chunk,
+                       int64_t offset,
+                       int64_t size,
+                       TargetBitmapView res)>
+        packed_eval_;
     // Scalar index is pinned lazily by EnsurePinnedIndex(). Pre-pin
     // existence checks (HasCompatibleScalarIndex) query segment metadata
     // directly, so expressions on short-circuit paths (TextIndex, PkIndex,
@@ -431,6 +431,51 @@ ExprResCacheManager::Put(const Key& key, const Value& value) {
     }
 }
 
+std::shared_future<ExprResCacheManager::Value>
+ExprResCacheManager::BeginEval(const Key& key,
+                               int64_t active_count,
+                               bool& owner) {
+    std::lock_guard lock(inflight_mutex_);
+    auto [it, inserted] = inflight_.try_emplace(InflightKey{key, active_count});
+    owner = inserted;
+    if (inserted) {
+        it->second = std::make_shared<Inflight>();
+        return {};
+    }
+    if (it->second->owner == std::this_thread::get_id()) {
+        return {};
+    }
+    ++it->second->waiters;
+    return it->second->future;
+}
+
+void
+ExprResCacheManager::EndEval(const Key& key,
+                             int64_t active_count,
+                             const TargetBitmap* result,
+                             const TargetBitmap* valid_result) {
+    std::shared_ptr<Inflight> inflight;
+    {
+        std::lock_guard lock(inflight_mutex_);
+        auto it = inflight_.find(InflightKey{key, active_count});
+        if (it == inflight_.end()) {
+            return;
+        }
+        inflight = std::move(it->second);
+        inflight_.erase(it);
+    }
+    // No caller can join once the entry is erased, so the owner's bitmaps
+    // are only copied when someone is waiting for them.
+    Value value;
+    if (inflight->waiters > 0 && result != nullptr) {
+        value.result = std::make_shared<TargetBitmap>(result->clone());
+        value.valid_result =
+            std::make_shared<TargetBitmap>(valid_result->clone());
+        value.active_count = active_count;
+    }
+    inflight->promise.set_value(std::move(value));
+}
+
 void
 ExprResCacheManager::Clear() {
     std::unique_lock state_lock(state_mutex_);
@@ -19,12 +19,15 @@
 #include <cstddef>
 #include <cstdint>
 #include <atomic>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "common/Types.h"
@@ -193,8 +196,51 @@ class ExprResCacheManager {
     EraseSegment(int64_t segment_id);
 
  private:
+    friend class InflightEval;
+
+    // An evaluation in progress, shared by the callers evaluating the same
+    // key at the same active count.
+    struct Inflight {
+        std::promise<Value> promise;
+        std::shared_future<Value> future{promise.get_future().share()};
+        std::thread::id owner{std::this_thread::get_id()};
+        size_t waiters{0};
+    };
+
+    struct InflightKey {
+        Key key;
+        int64_t active_count{0};
+
+        bool
+        operator==(const InflightKey& other) const {
+            return active_count == other.active_count && key == other.key;
+        }
+    };
+
+    struct InflightKeyHasher {
+        size_t
+        operator()(const InflightKey& k) const noexcept {
+            return KeyHasher()(k.key) ^ std::hash<int64_t>()(k.active_count);
+        }
+    };
+
     ExprResCacheManager() = default;
 
+    // Returns the result future of the evaluation of 'key' already in
+    // flight. Otherwise returns an invalid future and sets 'owner' when the
+    // caller starts the evaluation and must finish it with EndEval. A nested
+    // evaluation of the key on the owner's thread is neither.
+    std::shared_future<Value>
+    BeginEval(const Key& key, int64_t active_count, bool& owner);
+
+    // Publishes the result of an evaluation started by BeginEval. Null
+    // bitmaps mark a failed evaluation.
+    void
+    EndEval(const Key& key,
+            int64_t active_count,
+            const TargetBitmap* result,
+            const TargetBitmap* valid_result);
+
     size_t
     GetDiskCurrentBytesLocked() const;
 
@@ -237,6 +283,75 @@ class ExprResCacheManager {
     FrequencyTracker frequency_tracker_;
     std::atomic<size_t> reported_memory_bytes_{0};
     std::atomic<size_t> reported_disk_bytes_{0};
+
+    std::mutex inflight_mutex_;
+    std::unordered_map<InflightKey,
+                       std::shared_ptr<Inflight>,
+                       InflightKeyHasher>
+        inflight_;
+};
+
+// Deduplicates concurrent evaluations of one expression on one segment
+// snapshot, independent of cache admission. The first caller for a
+// (segment_id, signature, active_count) evaluates and publishes; identical
+// callers arriving meanwhile wait for its result instead of evaluating.
+// An owner destroyed without publishing releases the waiters to evaluate
+// on their own.
+class InflightEval {
+ public:
+    InflightEval(ExprResCacheManager::Key key, int64_t active_count)
+        : key_(std::move(key)), active_count_(active_count) {
+        future_ = ExprResCacheManager::Instance().BeginEval(
+            key_, active_count_, owner_);
+    }
+
+    InflightEval(const InflightEval&) = delete;
+    InflightEval&
+    operator=(const InflightEval&) = delete;
+
+    ~InflightEval() {
+        if (owner_ && !published_) {
+            ExprResCacheManager::Instance().EndEval(
+                key_, active_count_, nullptr, nullptr);
+        }
+    }
+
+    // Whether another caller owns the evaluation.
+    bool
+    IsWaiter() const {
+        return future_.valid();
+    }
+
+    // Waits for the owner and returns private copies of its bitmaps, or
+    // false when the owner failed.
+    bool
+    Wait(TargetBitmap& result, TargetBitmap& valid_result) const {
+        const auto& value = future_.get();
+        if (value.result == nullptr) {
+            return false;
+        }
+        result = value.result->clone();
+        valid_result = value.valid_result->clone();
+        return true;
+    }
+
+    // Publishes the owner's bitmaps to the waiters.
+    void
+    Publish(const TargetBitmap& result, const TargetBitmap& valid_result) {
+        if (!owner_ || published_) {
+            return;
+        }
+        ExprResCacheManager::Instance().EndEval(
+            key_, active_count_, &result, &valid_result);
+        published_ = true;
+    }
+
+ private:
+    ExprResCacheManager::Key key_;
+    int64_t active_count_;
+    std::shared_future<ExprResCacheManager::Value> future_;
+    bool owner_{false};
+    bool published_{false};
 };
 
 // Helper API: erase all cache for a given segment id, returns erased entry count
@@ -18,6 +18,7 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -111,9 +112,29 @@ class ExprCacheHelper {
             }
         }
 
+        // Identical requests arriving together share one evaluation.
+        std::optional<InflightEval> inflight;
+        if (cache_eligible) {
+            inflight.emplace(
+                ExprResCacheManager::Key{segment->get_segment_id(),
+                                         expr_signature},
+                active_count);
+            if (inflight->IsWaiter()) {
+                TargetBitmap result(0), valid(0);
+                if (inflight->Wait(result, valid)) {
+                    return {std::make_shared<TargetBitmap>(std::move(result)),
+                            std::make_shared<TargetBitmap>(std::move(valid))};
+                }
+                inflight.reset();
+            }
+        }
+
         const bool cache_can_write = cache_eligible && enable_cache_write;
         if (!cache_can_write) {
             ComputeResult out = compute();
+            if (inflight) {
+                inflight->Publish(out.result, out.valid);
+            }
             auto result = std::make_shared<TargetBitmap>(std::move(out.result));
             auto valid = std::make_shared<TargetBitmap>(std::move(out.valid));
             return {result, valid};
@@ -125,6 +146,9 @@ class ExprCacheHelper {
         auto eval_us = std::chrono::duration_cast<std::chrono::microseconds>(
                            std::chrono::steady_clock::now() - t0)
                            .count();
+        if (inflight) {
+            inflight->Publish(out.result, out.valid);
+        }
 
         auto result = std::make_shared<TargetBitmap>(std::move(out.result));
         auto valid = std::make_shared<TargetBitmap>(std::move(out.valid));
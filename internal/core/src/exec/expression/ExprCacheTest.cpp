@@ -2688,6 +2688,49 @@ TEST(ExprResCacheManagerV2Test, ConcurrentSetConfigAndGetPut) {
     ExprResCacheManager::SetEnabled(false);
 }
 
+TEST(ExprResCacheManagerV2Test, InflightEvalSharesOwnerResult) {
+    using milvus::exec::InflightEval;
+    ExprResCacheManager::Key key{800, "inflight_sig"};
+    auto expected = MakeBits(256, false);
+    expected.set(3);
+    expected.set(200);
+
+    for (bool publish : {true, false}) {
+        auto owner = std::make_unique<InflightEval>(key, 256);
+        ASSERT_FALSE(owner->IsWaiter());
+        // A nested evaluation on the owner's thread does not wait on itself,
+        // and another active count is another evaluation.
+        ASSERT_FALSE(InflightEval(key, 256).IsWaiter());
+        ASSERT_FALSE(InflightEval(key, 128).IsWaiter());
+
+        std::atomic<bool> joined{false};
+        bool waited = false;
+        milvus::TargetBitmap result(0), valid(0);
+        std::thread waiter([&]() {
+            InflightEval eval(key, 256);
+            EXPECT_TRUE(eval.IsWaiter());
+            joined.store(true);
+            waited = eval.Wait(result, valid);
+        });
+        while (!joined.load()) {
+            std::this_thread::yield();
+        }
+        if (publish) {
+            owner->Publish(expected, MakeBits(256));
+        }
+        owner.reset();
+        waiter.join();
+
+        ASSERT_EQ(waited, publish);
+        if (publish) {
+            ASSERT_TRUE(result == expected);
+            ASSERT_EQ(valid.count(), 256);
+        }
+        // The evaluation is over, so the next caller owns a new one.
+        ASSERT_FALSE(InflightEval(key, 256).IsWaiter());
+    }
+}
+
 // ---- V2 E2E Performance Benchmark: Memory vs Disk across densities ----
 
 TEST(ExprResCacheV2PerfTest, EndToEndBothModes) {
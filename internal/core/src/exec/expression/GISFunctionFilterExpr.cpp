@@ -56,11 +56,16 @@ namespace exec {
                 this->segment_->get_segment_id(), field_id_);               \
         if (geometry_cache) {                                               \
             auto cache_lock = geometry_cache->AcquireReadLock();            \
+            this->FilterByBox(*geometry_cache, segment_offsets[0], size);   \
             for (int i = 0; i < size; ++i) {                                \
                 if (valid_data != nullptr && !valid_data[i]) {              \
                     res[i] = valid_res[i] = false;                          \
                     continue;                                               \
                 }                                                           \
+                if (!box_candidates_.empty() && !box_candidates_[i]) {      \
+                    res[i] = false;                                         \
+                    continue;                                               \
+                }                                                           \
                 auto absolute_offset = segment_offsets[i];                  \
                 auto cached_geometry =                                      \
                     geometry_cache->GetByOffsetUnsafe(absolute_offset);     \
@@ -106,11 +111,16 @@ namespace exec {
                 this->segment_->get_segment_id(), field_id_);                  \
         if (geometry_cache) {                                                  \
             auto cache_lock = geometry_cache->AcquireReadLock();               \
+            this->FilterByBox(*geometry_cache, segment_offsets[0], size);      \
             for (int i = 0; i < size; ++i) {                                   \
                 if (valid_data != nullptr && !valid_data[i]) {                 \
                     res[i] = valid_res[i] = false;                             \
                     continue;                                                  \
                 }                                                              \
+                if (!box_candidates_.empty() && !box_candidates_[i]) {         \
+                    res[i] = false;                                            \
+                    continue;                                                  \
+                }                                                              \
                 auto absolute_offset = segment_offsets[i];                     \
                 auto cached_geometry =                                         \
                     geometry_cache->GetByOffsetUnsafe(absolute_offset);        \
@@ -216,6 +226,42 @@ PhyGISFunctionFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
     }
 }
 
+void
+PhyGISFunctionFilterExpr::FilterByBox(const SimpleGeometryCache& cache,
+                                      int64_t offset,
+                                      int size) {
+    if (!box_filter_inited_) {
+        auto query = Geometry(GetThreadLocalGEOSContext(),
+                              expr_->geometry_wkt_.c_str());
+        box_filter_ = MakeBoxFilter(expr_->op_, query, expr_->distance_);
+        TargetBitmap candidates;
+        if (box_filter_.has_value() &&
+            cache.QueryCandidatesUnsafe(*box_filter_, candidates)) {
+            rtree_candidates_ = std::move(candidates);
+        }
+        box_filter_inited_ = true;
+    }
+    box_candidates_.clear();
+    if (!box_filter_.has_value()) {
+        return;
+    }
+    box_candidates_.resize(size);
+    int64_t from_rtree = 0;
+    if (rtree_candidates_.has_value()) {
+        auto rtree_rows = static_cast<int64_t>(rtree_candidates_->size());
+        from_rtree = std::clamp<int64_t>(rtree_rows - offset, 0, size);
+        for (int64_t i = 0; i < from_rtree; ++i) {
+            box_candidates_[i] = (*rtree_candidates_)[offset + i];
+        }
+    }
+    if (from_rtree < size) {
+        cache.FilterByBoxUnsafe(*box_filter_,
+                                offset + from_rtree,
+                                size - from_rtree,
+                                box_candidates_.data() + from_rtree);
+    }
+}
+
 VectorPtr
 PhyGISFunctionFilterExpr::EvalForDataSegment() {
     auto real_batch_size = GetNextBatchSize();
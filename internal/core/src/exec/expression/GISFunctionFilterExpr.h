@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 
+#include "common/GeometryCache.h"
 #include "common/OpContext.h"
 #include "common/Types.h"
 #include "common/Vector.h"
@@ -88,6 +89,13 @@ class PhyGISFunctionFilterExpr : public SegmentExpr {
     VectorPtr
     EvalForDataSegment();
 
+    // Sets box_candidates_[i] for the cached rows [offset, offset + size)
+    // to whether their bounding boxes may satisfy the predicate, or clears
+    // it when the predicate can not be pruned by boxes. Call with the cache
+    // read lock held.
+    void
+    FilterByBox(const SimpleGeometryCache& cache, int64_t offset, int size);
+
  private:
     std::shared_ptr<const milvus::expr::GISFunctionFilterExpr> expr_;
 
@@ -102,6 +110,15 @@ class PhyGISFunctionFilterExpr : public SegmentExpr {
     TargetBitmap coarse_global_;
     // global not-null bitmap (segment-level)
     TargetBitmap coarse_valid_global_;
+
+    // Bounding box prefilter of the data path, set up on the first batch.
+    bool box_filter_inited_ = false;
+    std::optional<BoxFilter> box_filter_;
+    // R-tree candidates of a growing segment, over the rows its geometry
+    // cache had on the first batch. Later rows use the box columns.
+    std::optional<TargetBitmap> rtree_candidates_;
+    // box test result of the current sub batch
+    std::vector<uint8_t> box_candidates_;
 };
 }  //namespace exec
 }  // namespace milvus
@@ -0,0 +1,303 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/expression/JsonPathCache.h"
+
+#include <iterator>
+#include <utility>
+
+#include "common/Consts.h"
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+#include "segcore/SegmentInterface.h"
+
+namespace milvus {
+namespace exec {
+
+std::shared_ptr<const JsonPathColumn>
+JsonPathColumn::Build(Kind kind,
+                      const std::string& pointer,
+                      const milvus::Json* data,
+                      const bool* valid_data,
+                      int64_t size) {
+    std::shared_ptr<JsonPathColumn> column(new JsonPathColumn(kind));
+    column->states_.resize(size, RowState::kMissing);
+    if (kind == Kind::kString) {
+        column->offsets_.resize(size + 1, 0);
+    } else {
+        column->values_.resize(size, Value{0});
+    }
+    auto& states = column->states_;
+    auto& values = column->values_;
+    for (int64_t i = 0; i < size; ++i) {
+        if (kind == Kind::kString) {
+            column->offsets_[i] = column->bytes_.size();
+        }
+        if (valid_data != nullptr && !valid_data[i]) {
+            states[i] = RowState::kNull;
+            continue;
+        }
+        switch (kind) {
+            case Kind::kBool: {
+                auto x = data[i].at<bool>(pointer);
+                if (!x.error()) {
+                    states[i] = RowState::kBool;
+                    values[i].i = x.value() ? 1 : 0;
+                }
+                break;
+            }
+            case Kind::kNumber: {
+                auto x = data[i].at_numeric(pointer);
+                if (x.error()) {
+                    break;
+                }
+                auto n = x.value();
+                if (n.is_int64()) {
+                    states[i] = RowState::kInt64;
+                    values[i].i = n.get_int64();
+                } else {
+                    states[i] = RowState::kDouble;
+                    values[i].d = n.is_uint64()
+                                      ? static_cast<double>(n.get_uint64())
+                                      : n.get_double();
+                }
+                break;
+            }
+            case Kind::kDouble: {
+                auto x = data[i].at<double>(pointer);
+                if (!x.error()) {
+                    states[i] = RowState::kDouble;
+                    values[i].d = x.value();
+                }
+                break;
+            }
+            case Kind::kString: {
+                auto x = data[i].at<std::string_view>(pointer);
+                if (!x.error()) {
+                    states[i] = RowState::kString;
+                    column->bytes_.append(x.value());
+                }
+                break;
+            }
+        }
+    }
+    if (kind == Kind::kString) {
+        column->offsets_[size] = column->bytes_.size();
+        column->bytes_.shrink_to_fit();
+    }
+    return column;
+}
+
+JsonPathCacheManager::JsonPathCacheManager()
+    : capacity_bytes_(DEFAULT_JSON_PATH_CACHE_CAPACITY) {
+}
+
+JsonPathCacheManager&
+JsonPathCacheManager::Instance() {
+    static JsonPathCacheManager instance;
+    return instance;
+}
+
+void
+JsonPathCacheManager::SetCapacityBytes(size_t capacity_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_bytes_.store(capacity_bytes, std::memory_order_relaxed);
+    EvictLocked(capacity_bytes);
+    LOG_INFO("set json path cache capacity: {} bytes", capacity_bytes);
+}
+
+size_t
+JsonPathCacheManager::GetCapacityBytes() const {
+    return capacity_bytes_.load(std::memory_order_relaxed);
+}
+
+size_t
+JsonPathCacheManager::GetCurrentBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_bytes_;
+}
+
+size_t
+JsonPathCacheManager::GetEntryCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+std::shared_ptr<const JsonPathColumn>
+JsonPathCacheManager::Get(const Key& key, int64_t num_rows) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return GetLocked(key, num_rows);
+}
+
+std::shared_ptr<const JsonPathColumn>
+JsonPathCacheManager::GetLocked(const Key& key, int64_t num_rows) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return nullptr;
+    }
+    if (it->second.column->Size() != num_rows) {
+        EraseLocked(it);
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+    return it->second.column;
+}
+
+void
+JsonPathCacheManager::Put(const Key& key,
+                          std::shared_ptr<const JsonPathColumn> column) {
+    AssertInfo(column != nullptr, "json path cache column must not be null");
+    auto bytes = column->ByteSize();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto capacity_bytes = capacity_bytes_.load(std::memory_order_relaxed);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        EraseLocked(it);
+    }
+    if (bytes > capacity_bytes) {
+        return;
+    }
+    EvictLocked(capacity_bytes - bytes);
+    lru_.push_front(key);
+    entries_.emplace(key, Entry{std::move(column), bytes, lru_.begin()});
+    current_bytes_ += bytes;
+}
+
+std::shared_ptr<const JsonPathColumn>
+JsonPathCacheManager::GetOrBuild(
+    const segcore::SegmentInternalInterface* segment,
+    milvus::OpContext* op_ctx,
+    const Key& key) {
+    auto field_id = FieldId(key.field_id);
+    auto num_rows = segment->chunk_size(field_id, key.chunk_id);
+    std::shared_ptr<InflightBuild> build;
+    bool owner = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto column = GetLocked(key, num_rows)) {
+            return column;
+        }
+        auto [it, inserted] = builds_.try_emplace(key);
+        if (inserted) {
+            it->second = std::make_shared<InflightBuild>();
+        }
+        build = it->second;
+        owner = inserted;
+    }
+    if (!owner) {
+        auto column = build->future.get();
+        if (column != nullptr && column->Size() == num_rows) {
+            return column;
+        }
+        // The owner failed, or built another chunk layout; extract it here
+        // without caching.
+    }
+
+    std::shared_ptr<const JsonPathColumn> column;
+    build_count_.fetch_add(1, std::memory_order_relaxed);
+    try {
+        auto pw = segment->get_batch_views<milvus::Json>(
+            op_ctx, field_id, key.chunk_id, 0, num_rows);
+        const auto& [data, valid_data] = pw.get();
+        column = JsonPathColumn::Build(
+            key.kind,
+            key.pointer,
+            data.data(),
+            valid_data.empty() ? nullptr : valid_data.data(),
+            num_rows);
+    } catch (...) {
+        if (owner) {
+            EndBuild(key, nullptr);
+        }
+        throw;
+    }
+    if (owner) {
+        Put(key, column);
+        EndBuild(key, column);
+    }
+    return column;
+}
+
+void
+JsonPathCacheManager::EndBuild(const Key& key,
+                               std::shared_ptr<const JsonPathColumn> column) {
+    std::shared_ptr<InflightBuild> build;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = builds_.find(key);
+        if (it == builds_.end()) {
+            return;
+        }
+        build = std::move(it->second);
+        builds_.erase(it);
+    }
+    build->promise.set_value(std::move(column));
+}
+
+template <typename Pred>
+size_t
+JsonPathCacheManager::EraseIf(Pred&& pred) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t erased = 0;
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        auto next = std::next(it);
+        if (pred(it->first)) {
+            EraseLocked(it);
+            ++erased;
+        }
+        it = next;
+    }
+    return erased;
+}
+
+size_t
+JsonPathCacheManager::EraseSegment(int64_t segment_id) {
+    return EraseIf(
+        [&](const Key& key) { return key.segment_id == segment_id; });
+}
+
+size_t
+JsonPathCacheManager::EraseField(int64_t segment_id, int64_t field_id) {
+    return EraseIf([&](const Key& key) {
+        return key.segment_id == segment_id && key.field_id == field_id;
+    });
+}
+
+void
+JsonPathCacheManager::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lru_.clear();
+    current_bytes_ = 0;
+}
+
+void
+JsonPathCacheManager::EraseLocked(
+    std::unordered_map<Key, Entry, KeyHasher>::iterator it) {
+    current_bytes_ -= it->second.bytes;
+    lru_.erase(it->second.lru_it);
+    entries_.erase(it);
+}
+
+void
+JsonPathCacheManager::EvictLocked(size_t capacity_bytes) {
+    while (current_bytes_ > capacity_bytes && !lru_.empty()) {
+        EraseLocked(entries_.find(lru_.back()));
+    }
+}
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,292 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "common/Json.h"
+#include "common/OpContext.h"
+#include "common/Types.h"
+
+namespace milvus {
+namespace segcore {
+class SegmentInternalInterface;
+}  // namespace segcore
+
+namespace exec {
+
+// The values of one JSON pointer path extracted from every row of a sealed
+// JSON chunk, so that repeated predicates on a hot path do not parse the
+// rows again. Extraction matches milvus::Json: a row whose path is missing
+// or holds a value of another type is missing, as a failed at() would be.
+class JsonPathColumn {
+ public:
+    // How values are extracted, one per value type of JSON unary range
+    // filters.
+    enum class Kind : uint8_t {
+        kBool,    // at<bool>
+        kNumber,  // at_numeric, int64 kept exact, other numbers as double
+        kDouble,  // at<double>
+        kString,  // at<std::string_view>
+    };
+
+    enum class RowState : uint8_t {
+        kNull,     // the JSON row itself is null
+        kMissing,  // path missing or of another type
+        kInt64,
+        kDouble,
+        kBool,
+        kString,
+    };
+
+    template <typename T>
+    static constexpr bool kCacheable = std::is_same_v<T, bool> ||
+                                       std::is_same_v<T, int64_t> ||
+                                       std::is_same_v<T, double> ||
+                                       std::is_same_v<T, std::string>;
+
+    // The kind used for filters comparing against a value of type T.
+    template <typename T>
+    static constexpr Kind
+    KindOf() {
+        static_assert(kCacheable<T>, "type is not cacheable");
+        if constexpr (std::is_same_v<T, bool>) {
+            return Kind::kBool;
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            return Kind::kNumber;
+        } else if constexpr (std::is_same_v<T, double>) {
+            return Kind::kDouble;
+        } else {
+            return Kind::kString;
+        }
+    }
+
+    // Extracts 'pointer' of data[0, size) as 'kind'. valid_data may be null
+    // when every row is valid.
+    static std::shared_ptr<const JsonPathColumn>
+    Build(Kind kind,
+          const std::string& pointer,
+          const milvus::Json* data,
+          const bool* valid_data,
+          int64_t size);
+
+    int64_t
+    Size() const {
+        return static_cast<int64_t>(states_.size());
+    }
+
+    Kind
+    GetKind() const {
+        return kind_;
+    }
+
+    RowState
+    State(int64_t row) const {
+        return states_[row];
+    }
+
+    // Returns the predicate f on the value of a row that is neither null nor
+    // missing, passed as the type the brute-force filter compares for T:
+    // int64_t or double for int64_t, std::string_view for std::string.
+    template <typename T, typename F>
+    bool
+    Visit(int64_t row, F&& f) const {
+        if constexpr (std::is_same_v<T, bool>) {
+            return f(values_[row].i != 0);
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            if (states_[row] == RowState::kInt64) {
+                return f(values_[row].i);
+            }
+            return f(values_[row].d);
+        } else if constexpr (std::is_same_v<T, double>) {
+            return f(values_[row].d);
+        } else {
+            static_assert(std::is_same_v<T, std::string>);
+            return f(std::string_view(bytes_.data() + offsets_[row],
+                                      offsets_[row + 1] - offsets_[row]));
+        }
+    }
+
+    // Approximate memory held by the column.
+    size_t
+    ByteSize() const {
+        return sizeof(*this) + states_.capacity() +
+               values_.capacity() * sizeof(Value) +
+               offsets_.capacity() * sizeof(int64_t) + bytes_.capacity();
+    }
+
+ private:
+    union Value {
+        int64_t i;
+        double d;
+    };
+
+    explicit JsonPathColumn(Kind kind) : kind_(kind) {
+    }
+
+    Kind kind_;
+    std::vector<RowState> states_;
+    // values of bool and numeric kinds, bools as 0 or 1
+    std::vector<Value> values_;
+    // strings of row i are bytes_[offsets_[i], offsets_[i + 1])
+    std::vector<int64_t> offsets_;
+    std::string bytes_;
+};
+
+// Process-level LRU cache of JsonPathColumn per sealed JSON chunk, bounded
+// by a memory budget. A capacity of 0 disables it. Entries of a segment are
+// erased when the segment releases the field or is destroyed.
+class JsonPathCacheManager {
+ public:
+    struct Key {
+        int64_t segment_id{0};
+        int64_t field_id{0};
+        int64_t chunk_id{0};
+        std::string pointer;
+        JsonPathColumn::Kind kind{JsonPathColumn::Kind::kBool};
+
+        bool
+        operator==(const Key& other) const {
+            return segment_id == other.segment_id &&
+                   field_id == other.field_id && chunk_id == other.chunk_id &&
+                   kind == other.kind && pointer == other.pointer;
+        }
+    };
+
+    struct KeyHasher {
+        size_t
+        operator()(const Key& k) const noexcept {
+            size_t h = std::hash<int64_t>()(k.segment_id);
+            h = h * 1315423911u ^ std::hash<int64_t>()(k.field_id);
+            h = h * 1315423911u ^ std::hash<int64_t>()(k.chunk_id);
+            h = h * 1315423911u ^ static_cast<size_t>(k.kind);
+            return h ^ std::hash<std::string>()(k.pointer);
+        }
+    };
+
+ public:
+    static JsonPathCacheManager&
+    Instance();
+
+    bool
+    IsEnabled() const {
+        return capacity_bytes_.load(std::memory_order_relaxed) > 0;
+    }
+
+    // Sets the memory budget, evicting entries beyond it.
+    void
+    SetCapacityBytes(size_t capacity_bytes);
+    size_t
+    GetCapacityBytes() const;
+    size_t
+    GetCurrentBytes() const;
+    size_t
+    GetEntryCount() const;
+    // Number of columns extracted from chunks so far.
+    uint64_t
+    GetBuildCount() const {
+        return build_count_.load(std::memory_order_relaxed);
+    }
+
+    // Returns the cached column, or nullptr when it is absent or does not
+    // have num_rows rows, i.e. was built from another chunk layout.
+    std::shared_ptr<const JsonPathColumn>
+    Get(const Key& key, int64_t num_rows);
+
+    // Inserts or replaces the column of 'key'. A column larger than the
+    // whole budget is not cached.
+    void
+    Put(const Key& key, std::shared_ptr<const JsonPathColumn> column);
+
+    // Returns the column of 'key' for the chunk of a sealed segment,
+    // extracting it from the chunk and caching it on a miss. The built
+    // column is returned even when it does not fit in the budget. Callers
+    // missing on a key that is being built wait for that build instead of
+    // extracting the chunk again.
+    std::shared_ptr<const JsonPathColumn>
+    GetOrBuild(const segcore::SegmentInternalInterface* segment,
+               milvus::OpContext* op_ctx,
+               const Key& key);
+
+    // Erase all entries of a segment, or of one field of it. Returns the
+    // number of erased entries.
+    size_t
+    EraseSegment(int64_t segment_id);
+    size_t
+    EraseField(int64_t segment_id, int64_t field_id);
+
+    void
+    Clear();
+
+ private:
+    struct Entry {
+        std::shared_ptr<const JsonPathColumn> column;
+        size_t bytes{0};
+        std::list<Key>::iterator lru_it;
+    };
+
+    // A column being built, shared by the callers that miss on its key.
+    struct InflightBuild {
+        std::promise<std::shared_ptr<const JsonPathColumn>> promise;
+        std::shared_future<std::shared_ptr<const JsonPathColumn>> future{
+            promise.get_future().share()};
+    };
+
+    JsonPathCacheManager();
+
+    template <typename Pred>
+    size_t
+    EraseIf(Pred&& pred);
+
+    std::shared_ptr<const JsonPathColumn>
+    GetLocked(const Key& key, int64_t num_rows);
+
+    // Publishes the column built for 'key' to its waiters, nullptr when the
+    // build failed.
+    void
+    EndBuild(const Key& key, std::shared_ptr<const JsonPathColumn> column);
+
+    void
+    EraseLocked(std::unordered_map<Key, Entry, KeyHasher>::iterator it);
+
+    void
+    EvictLocked(size_t capacity_bytes);
+
+    std::atomic<size_t> capacity_bytes_{0};
+    std::atomic<uint64_t> build_count_{0};
+
+    mutable std::mutex mutex_;
+    // most recently used first
+    std::list<Key> lru_;
+    std::unordered_map<Key, Entry, KeyHasher> entries_;
+    size_t current_bytes_{0};
+    std::unordered_map<Key, std::shared_ptr<InflightBuild>, KeyHasher> builds_;
+};
+
+}  // namespace exec
+}  // namespace milvus
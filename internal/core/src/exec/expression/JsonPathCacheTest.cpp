@@ -0,0 +1,368 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "common/Common.h"
+#include "common/Consts.h"
+#include "common/Json.h"
+#include "common/Schema.h"
+#include "common/Types.h"
+#include "exec/expression/JsonPathCache.h"
+#include "expr/ITypeExpr.h"
+#include "knowhere/comp/index_param.h"
+#include "pb/plan.pb.h"
+#include "plan/PlanNode.h"
+#include "query/ExecPlanNodeVisitor.h"
+#include "simdjson/padded_string.h"
+#include "test_utils/DataGen.h"
+#include "test_utils/storage_test_utils.h"
+
+using namespace milvus;
+using namespace milvus::exec;
+
+namespace {
+
+std::vector<Json>
+MakeJsons(const std::vector<std::string>& rows) {
+    std::vector<Json> jsons;
+    jsons.reserve(rows.size());
+    for (const auto& row : rows) {
+        jsons.emplace_back(simdjson::padded_string(row));
+    }
+    return jsons;
+}
+
+std::shared_ptr<const JsonPathColumn>
+MakeColumn(size_t rows, int64_t value) {
+    std::vector<std::string> raw(rows,
+                                 R"({"a":)" + std::to_string(value) + "}");
+    auto jsons = MakeJsons(raw);
+    return JsonPathColumn::Build(JsonPathColumn::Kind::kNumber,
+                                 "/a",
+                                 jsons.data(),
+                                 nullptr,
+                                 jsons.size());
+}
+
+}  // namespace
+
+TEST(JsonPathCacheTest, BuildMatchesJsonAccessors) {
+    auto jsons = MakeJsons({
+        R"({"a": 7, "s": "x"})",
+        R"({"a": 18446744073709551615, "s": "y\"z"})",
+        R"({"a": 1.5, "s": 3})",
+        R"({"a": "7"})",
+        R"({})",
+        R"({"a": 1})",
+    });
+    bool valid[] = {true, true, true, true, true, false};
+
+    auto numbers = JsonPathColumn::Build(
+        JsonPathColumn::Kind::kNumber, "/a", jsons.data(), valid, 6);
+    using State = JsonPathColumn::RowState;
+    ASSERT_EQ(numbers->Size(), 6);
+    EXPECT_EQ(numbers->State(0), State::kInt64);
+    EXPECT_EQ(numbers->State(1), State::kDouble);
+    EXPECT_EQ(numbers->State(2), State::kDouble);
+    EXPECT_EQ(numbers->State(3), State::kMissing);
+    EXPECT_EQ(numbers->State(4), State::kMissing);
+    EXPECT_EQ(numbers->State(5), State::kNull);
+    auto greater_than_one = [](const auto& value) { return value > 1; };
+    EXPECT_TRUE(numbers->Visit<int64_t>(0, greater_than_one));
+    EXPECT_TRUE(numbers->Visit<int64_t>(1, greater_than_one));
+    EXPECT_TRUE(numbers->Visit<int64_t>(2, greater_than_one));
+    EXPECT_TRUE(numbers->Visit<int64_t>(
+        0, [](const auto& value) { return value == int64_t{7}; }));
+
+    auto strings = JsonPathColumn::Build(
+        JsonPathColumn::Kind::kString, "/s", jsons.data(), valid, 6);
+    EXPECT_EQ(strings->State(0), State::kString);
+    EXPECT_EQ(strings->State(1), State::kString);
+    EXPECT_EQ(strings->State(2), State::kMissing);
+    EXPECT_EQ(strings->State(5), State::kNull);
+    auto value_of = [&](int64_t row) {
+        std::string out;
+        strings->Visit<std::string>(row, [&](std::string_view value) {
+            out = std::string(value);
+            return true;
+        });
+        return out;
+    };
+    EXPECT_EQ(value_of(0), "x");
+    EXPECT_EQ(value_of(1), "y\"z");
+}
+
+TEST(JsonPathCacheTest, LruWithinBudget) {
+    auto& manager = JsonPathCacheManager::Instance();
+    auto old_capacity = manager.GetCapacityBytes();
+    manager.Clear();
+
+    auto column = MakeColumn(100, 1);
+    auto bytes = column->ByteSize();
+    manager.SetCapacityBytes(bytes * 2);
+
+    JsonPathCacheManager::Key key{1, 100, 0, "/a"};
+    key.kind = JsonPathColumn::Kind::kNumber;
+    auto key1 = key;
+    key1.chunk_id = 1;
+    auto key2 = key;
+    key2.chunk_id = 2;
+
+    manager.Put(key, column);
+    manager.Put(key1, MakeColumn(100, 2));
+    ASSERT_NE(manager.Get(key, 100), nullptr);
+    // key1 is now the least recently used entry
+    manager.Put(key2, MakeColumn(100, 3));
+    EXPECT_EQ(manager.GetEntryCount(), 2);
+    EXPECT_NE(manager.Get(key, 100), nullptr);
+    EXPECT_EQ(manager.Get(key1, 100), nullptr);
+    EXPECT_LE(manager.GetCurrentBytes(), manager.GetCapacityBytes());
+
+    // an entry built from another chunk layout is dropped
+    EXPECT_EQ(manager.Get(key2, 99), nullptr);
+    EXPECT_EQ(manager.GetEntryCount(), 1);
+
+    // columns larger than the budget are not cached
+    manager.Put(key1, MakeColumn(1000, 4));
+    EXPECT_EQ(manager.Get(key1, 1000), nullptr);
+
+    auto other = key;
+    other.segment_id = 2;
+    manager.Put(other, MakeColumn(100, 5));
+    EXPECT_EQ(manager.EraseSegment(1), 1);
+    EXPECT_NE(manager.Get(other, 100), nullptr);
+
+    manager.Clear();
+    manager.SetCapacityBytes(old_capacity);
+}
+
+TEST(JsonPathCacheTest, SealedFilterMatchesBruteForce) {
+    using namespace milvus::segcore;
+    using proto::plan::OpType;
+
+    auto& manager = JsonPathCacheManager::Instance();
+    auto old_capacity = manager.GetCapacityBytes();
+    manager.Clear();
+
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON, true);
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+
+    const int64_t N = 1000;
+    auto raw_data = DataGen(schema, N, /*seed=*/42);
+    auto json_col = raw_data.raw_->mutable_fields_data()
+                        ->at(1)
+                        .mutable_scalars()
+                        ->mutable_json_data()
+                        ->mutable_data();
+    for (int64_t i = 0; i < N; i++) {
+        auto s = std::to_string(i);
+        switch (i % 5) {
+            case 0:
+                json_col->at(i) =
+                    R"({"a":)" + s + R"(,"s":"x)" + s + R"(","b":true})";
+                break;
+            case 1:
+                json_col->at(i) =
+                    R"({"a":)" + s + R"(.5,"s":)" + s + R"(,"b":false})";
+                break;
+            case 2:
+                json_col->at(i) = R"({"a":"str","b":1})";
+                break;
+            case 3:
+                json_col->at(i) = "{}";
+                break;
+            default:
+                json_col->at(i) = R"({"a":18446744073709551615,"s":"y"})";
+        }
+    }
+    auto segment = CreateSealedWithFieldDataLoaded(schema, raw_data);
+
+    auto make_value = [](auto setter) {
+        proto::plan::GenericValue value;
+        setter(value);
+        return value;
+    };
+    struct Case {
+        std::string path;
+        OpType op;
+        proto::plan::GenericValue value;
+    };
+    std::vector<Case> cases;
+    for (auto op : {OpType::GreaterThan,
+                    OpType::GreaterEqual,
+                    OpType::LessThan,
+                    OpType::LessEqual,
+                    OpType::Equal,
+                    OpType::NotEqual}) {
+        cases.push_back({"a", op, make_value([](auto& v) {
+                             v.set_int64_val(500);
+                         })});
+        cases.push_back({"a", op, make_value([](auto& v) {
+                             v.set_float_val(500.5);
+                         })});
+        cases.push_back({"s", op, make_value([](auto& v) {
+                             v.set_string_val("x500");
+                         })});
+    }
+    cases.push_back({"b", OpType::Equal, make_value([](auto& v) {
+                         v.set_bool_val(true);
+                     })});
+    cases.push_back({"s", OpType::PrefixMatch, make_value([](auto& v) {
+                         v.set_string_val("x1");
+                     })});
+    cases.push_back({"s", OpType::Match, make_value([](auto& v) {
+                         v.set_string_val("%5%");
+                     })});
+
+    auto run = [&](const Case& c) {
+        auto expr = std::make_shared<milvus::expr::UnaryRangeFilterExpr>(
+            milvus::expr::ColumnInfo(
+                json_fid, DataType::JSON, std::vector<std::string>{c.path}),
+            c.op,
+            c.value,
+            std::vector<proto::plan::GenericValue>{});
+        auto plan =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        return milvus::query::ExecuteQueryExpr(
+            plan, segment.get(), N, MAX_TIMESTAMP);
+    };
+
+    for (const auto& c : cases) {
+        manager.SetCapacityBytes(0);
+        auto expected = run(c);
+        manager.SetCapacityBytes(64 << 20);
+        // the first run builds the columns and the second one reads them
+        for (int round = 0; round < 2; ++round) {
+            auto actual = run(c);
+            ASSERT_EQ(actual.size(), expected.size());
+            for (int64_t i = 0; i < N; ++i) {
+                ASSERT_EQ(actual[i], expected[i])
+                    << "path " << c.path << " op " << c.op << " row " << i
+                    << " round " << round;
+            }
+        }
+    }
+    EXPECT_GT(manager.GetEntryCount(), 0);
+
+    segment.reset();
+    EXPECT_EQ(manager.GetEntryCount(), 0);
+    manager.SetCapacityBytes(old_capacity);
+}
+
+TEST(JsonPathCacheTest, ConcurrentMissesShareOneBuild) {
+    using namespace milvus::segcore;
+
+    auto& manager = JsonPathCacheManager::Instance();
+    auto old_capacity = manager.GetCapacityBytes();
+    manager.Clear();
+    manager.SetCapacityBytes(64 << 20);
+
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    auto raw_data = DataGen(schema, 1000, /*seed=*/42);
+    auto segment = CreateSealedWithFieldDataLoaded(schema, raw_data);
+
+    JsonPathCacheManager::Key key{
+        segment->get_segment_id(), json_fid.get(), 0, "/int"};
+    key.kind = JsonPathColumn::Kind::kNumber;
+    const int kThreads = 8;
+    std::vector<std::shared_ptr<const JsonPathColumn>> columns(kThreads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&, i] {
+            columns[i] = manager.GetOrBuild(segment.get(), nullptr, key);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    // waiters get the owner's column and later callers hit the cache
+    for (const auto& column : columns) {
+        ASSERT_NE(column, nullptr);
+        EXPECT_EQ(column, columns[0]);
+    }
+    EXPECT_EQ(manager.GetEntryCount(), 1);
+
+    segment.reset();
+    manager.SetCapacityBytes(old_capacity);
+}
+
+TEST(JsonPathCacheTest, UncachedColumnIsBuiltOncePerChunk) {
+    using namespace milvus::segcore;
+
+    auto& manager = JsonPathCacheManager::Instance();
+    auto old_capacity = manager.GetCapacityBytes();
+    auto old_batch_size = EXEC_EVAL_EXPR_BATCH_SIZE.load();
+    manager.Clear();
+
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    const int64_t N = 1000;
+    auto raw_data = DataGen(schema, N, /*seed=*/42);
+    auto segment = CreateSealedWithFieldDataLoaded(schema, raw_data);
+
+    proto::plan::GenericValue value;
+    value.set_int64_val(0);
+    auto expr = std::make_shared<milvus::expr::UnaryRangeFilterExpr>(
+        milvus::expr::ColumnInfo(
+            json_fid, DataType::JSON, std::vector<std::string>{"int"}),
+        proto::plan::OpType::GreaterThan,
+        value,
+        std::vector<proto::plan::GenericValue>{});
+    auto plan =
+        std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+    auto run = [&]() {
+        return milvus::query::ExecuteQueryExpr(
+            plan, segment.get(), N, MAX_TIMESTAMP);
+    };
+
+    // several batches per chunk
+    EXEC_EVAL_EXPR_BATCH_SIZE.store(100);
+    manager.SetCapacityBytes(0);
+    auto expected = run();
+
+    // a budget smaller than one column caches nothing, yet every chunk is
+    // extracted once per query rather than once per batch
+    manager.SetCapacityBytes(1);
+    auto builds = manager.GetBuildCount();
+    auto actual = run();
+    EXPECT_EQ(manager.GetBuildCount() - builds,
+              static_cast<uint64_t>(segment->num_chunk_data(json_fid)));
+    EXPECT_EQ(manager.GetEntryCount(), 0);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (int64_t i = 0; i < N; ++i) {
+        ASSERT_EQ(actual[i], expected[i]) << "row " << i;
+    }
+
+    segment.reset();
+    EXEC_EVAL_EXPR_BATCH_SIZE.store(old_batch_size);
+    manager.SetCapacityBytes(old_capacity);
+}
@@ -37,6 +37,7 @@
 #include "exec/expression/JsonNumberComparison.h"
 #include "exec/expression/Utils.h"
 #include "folly/FBVector.h"
+#include "folly/ScopeGuard.h"
 #include "glog/logging.h"
 #include "monitor/Monitor.h"
 #include "index/json_stats/JsonKeyStats.h"
@@ -1215,6 +1216,25 @@ PhyTermFilterExpr::ExecVisitorImplForData(EvalCtx& context) {
             processed_size = ProcessDataChunksForElementLevel<T>(
                 execute_sub_batch, skip_index_func, res, valid_res, arg_set_);
         } else {
+            if constexpr (std::is_same_v<T, std::string_view>) {
+                if (bitmap_input.empty()) {
+                    dictionary_eval_ = [&](const std::string_view* values,
+                                           int64_t size,
+                                           TargetBitmapView dict_res) {
+                        auto cursor = processed_cursor;
+                        execute_sub_batch(values,
+                                          nullptr,
+                                          nullptr,
+                                          size,
+                                          dict_res,
+                                          dict_res,
+                                          arg_set_);
+                        processed_cursor = cursor;
+                    };
+                }
+            }
+            auto guard =
+                folly::makeGuard([this]() { dictionary_eval_ = nullptr; });
             processed_size = ProcessDataChunks<T>(
                 execute_sub_batch, skip_index_func, res, valid_res, arg_set_);
         }
@@ -47,8 +47,10 @@
 #include "exec/expression/ExprCache.h"
 #include "exec/expression/ExprCacheHelper.h"
 #include "exec/expression/JsonNumberComparison.h"
+#include "exec/expression/JsonPathCache.h"
 #include "fmt/core.h"
 #include "folly/FBVector.h"
+#include "folly/ScopeGuard.h"
 #include "glog/logging.h"
 #include "index/NgramInvertedIndex.h"
 #include "index/TextMatchIndex.h"
@@ -827,6 +829,15 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJson(EvalCtx& context) {
         json_filter_bruteforce_latency_us_ += us;
     });
 
+    if constexpr (JsonPathColumn::kCacheable<ExprValueType>) {
+        if (!has_offset_input_ && bitmap_input.empty() &&
+            segment_->type() == SegmentType::Sealed &&
+            segment_->is_chunked() &&
+            JsonPathCacheManager::Instance().IsEnabled()) {
+            return ExecRangeVisitorImplJsonByPathCache<ExprValueType>();
+        }
+    }
+
     auto real_batch_size =
         has_offset_input_ ? input->size() : GetNextBatchSize();
     if (real_batch_size == 0) {
@@ -1141,6 +1152,143 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJson(EvalCtx& context) {
     return res_vec;
 }
 
+template <typename ExprValueType>
+VectorPtr
+PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJsonByPathCache() {
+    auto real_batch_size = GetNextBatchSize();
+    if (real_batch_size == 0) {
+        return nullptr;
+    }
+
+    if (!arg_inited_) {
+        value_arg_.SetValue<ExprValueType>(expr_->val_);
+        arg_inited_ = true;
+    }
+    auto res_vec =
+        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
+                                       TargetBitmap(real_batch_size, true));
+    TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
+    TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
+
+    ExprValueType val = value_arg_.GetValue<ExprValueType>();
+    auto op_type = expr_->op_type_;
+    JsonPathCacheManager::Key key;
+    key.segment_id = segment_->get_segment_id();
+    key.field_id = field_id_.get();
+    key.pointer = milvus::Json::pointer(expr_->column_.nested_path_);
+    key.kind = JsonPathColumn::KindOf<ExprValueType>();
+
+    // Evaluates rows [pos, pos + size) of a chunk's column, with the same
+    // results as ExecRangeVisitorImplJson without bitmap input: null rows,
+    // missing paths and type mismatches are UNKNOWN/NULL.
+    auto execute_sub_batch = [&](const JsonPathColumn& column,
+                                 int64_t pos,
+                                 int64_t size,
+                                 TargetBitmapView res,
+                                 TargetBitmapView valid_res) {
+        auto apply = [&](auto&& pred) {
+            for (int i = 0; i < size; ++i) {
+                auto row = pos + i;
+                auto state = column.State(row);
+                if (state == JsonPathColumn::RowState::kNull ||
+                    state == JsonPathColumn::RowState::kMissing) {
+                    res[i] = valid_res[i] = false;
+                    continue;
+                }
+                res[i] = column.template Visit<ExprValueType>(row, pred);
+            }
+        };
+        switch (op_type) {
+            case proto::plan::GreaterThan:
+                apply([&](const auto& value) { return value > val; });
+                break;
+            case proto::plan::GreaterEqual:
+                apply([&](const auto& value) { return value >= val; });
+                break;
+            case proto::plan::LessThan:
+                apply([&](const auto& value) { return value < val; });
+                break;
+            case proto::plan::LessEqual:
+                apply([&](const auto& value) { return value <= val; });
+                break;
+            case proto::plan::Equal:
+                apply([&](const auto& value) { return value == val; });
+                break;
+            case proto::plan::NotEqual:
+                apply([&](const auto& value) { return value != val; });
+                break;
+            case proto::plan::InnerMatch:
+            case proto::plan::PostfixMatch:
+            case proto::plan::PrefixMatch:
+                apply([&](const auto& value) {
+                    return milvus::query::Match(value, val, op_type);
+                });
+                break;
+            case proto::plan::Match: {
+                if constexpr (std::is_same_v<ExprValueType, std::string>) {
+                    LikePatternMatcher matcher(val);
+                    apply([&](const auto& value) { return matcher(value); });
+                } else {
+                    ThrowInfo(OpTypeInvalid,
+                              "Match operation only supports string type");
+                }
+                break;
+            }
+            case proto::plan::RegexMatch: {
+                if constexpr (std::is_same_v<ExprValueType, std::string>) {
+                    PartialRegexMatcher matcher(val);
+                    apply([&](const auto& value) { return matcher(value); });
+                } else {
+                    ThrowInfo(OpTypeInvalid,
+                              "RegexMatch operation only supports string type");
+                }
+                break;
+            }
+            default:
+                ThrowInfo(
+                    OpTypeInvalid,
+                    fmt::format("unsupported operator type for unary expr: {}",
+                                op_type));
+        }
+    };
+
+    // Walks the chunks from the cursor like ProcessDataChunks, but reads
+    // the chunk only when its column is not cached.
+    int64_t processed_size = 0;
+    for (size_t i = current_data_chunk_; i < num_data_chunk_; i++) {
+        auto data_pos = i == current_data_chunk_ ? current_data_chunk_pos_ : 0;
+        int64_t size = segment_->chunk_size(field_id_, i) - data_pos;
+        size = std::min(size, batch_size_ - processed_size);
+        if (size == 0) {
+            continue;
+        }
+        if (path_column_ == nullptr ||
+            path_column_chunk_id_ != static_cast<int64_t>(i)) {
+            key.chunk_id = i;
+            path_column_ = JsonPathCacheManager::Instance().GetOrBuild(
+                segment_, op_ctx_, key);
+            path_column_chunk_id_ = i;
+        }
+        execute_sub_batch(*path_column_,
+                          data_pos,
+                          size,
+                          res + processed_size,
+                          valid_res + processed_size);
+        processed_size += size;
+        if (processed_size >= batch_size_) {
+            current_data_chunk_ = i;
+            current_data_chunk_pos_ = data_pos + size;
+            break;
+        }
+    }
+    AssertInfo(processed_size == real_batch_size,
+               "internal error: expr processed rows {} not equal "
+               "expect batch size {}",
+               processed_size,
+               real_batch_size);
+    return res_vec;
+}
+
 std::pair<std::string, std::string>
 PhyUnaryRangeFilterExpr::SplitAtFirstSlashDigit(std::string input) {
     // Find pattern /\d+ (slash followed by ASCII digits) without regex
@@ -1967,6 +2115,61 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplForData(EvalCtx& context) {
             processed_size = ProcessDataChunksForElementLevel<T>(
                 execute_sub_batch, skip_index_func, res, valid_res, val);
         } else {
+            if constexpr (std::is_same_v<T, std::string_view>) {
+                if (bitmap_input.empty()) {
+                    dictionary_eval_ = [&](const std::string_view* values,
+                                           int64_t size,
+                                           TargetBitmapView dict_res) {
+                        auto cursor = processed_cursor;
+                        execute_sub_batch(values,
+                                          nullptr,
+                                          nullptr,
+                                          size,
+                                          dict_res,
+                                          dict_res,
+                                          val);
+                        processed_cursor = cursor;
+                    };
+                }
+            } else if constexpr (std::is_same_v<T, int32_t> ||
+                                 std::is_same_v<T, int64_t>) {
+                using milvus::bitset::CompareOpType;
+                std::optional<CompareOpType> op;
+                switch (expr_type) {
+                    case proto::plan::GreaterThan:
+                        op = CompareOpType::GT;
+                        break;
+                    case proto::plan::GreaterEqual:
+                        op = CompareOpType::GE;
+                        break;
+                    case proto::plan::LessThan:
+                        op = CompareOpType::LT;
+                        break;
+                    case proto::plan::LessEqual:
+                        op = CompareOpType::LE;
+                        break;
+                    case proto::plan::Equal:
+                        op = CompareOpType::EQ;
+                        break;
+                    case proto::plan::NotEqual:
+                        op = CompareOpType::NE;
+                        break;
+                    default:
+                        break;
+                }
+                if (op.has_value() && bitmap_input.empty()) {
+                    packed_eval_ = [op = *op, val](const FixedWidthChunk& chunk,
+                                                   int64_t offset,
+                                                   int64_t size,
+                                                   TargetBitmapView res) {
+                        chunk.PackedCompare(op, val, offset, size, res);
+                    };
+                }
+            }
+            auto guard = folly::makeGuard([this]() {
+                dictionary_eval_ = nullptr;
+                packed_eval_ = nullptr;
+            });
             processed_size = ProcessDataChunks<T>(
                 execute_sub_batch, skip_index_func, res, valid_res, val);
         }
@@ -27,6 +27,7 @@
 #include "common/Vector.h"
 #include "exec/expression/Expr.h"
 #include "exec/expression/Element.h"
+#include "exec/expression/JsonPathCache.h"
 #include "index/Meta.h"
 #include "index/ScalarIndex.h"
 #include "segcore/SegmentInterface.h"
@@ -1122,6 +1123,12 @@ class PhyUnaryRangeFilterExpr : public SegmentExpr {
     VectorPtr
     ExecRangeVisitorImplJsonByStats();
 
+    // Brute force over the JsonPathColumn of each sealed chunk, extracted
+    // once per chunk and path and shared through JsonPathCacheManager.
+    template <typename ExprValueType>
+    VectorPtr
+    ExecRangeVisitorImplJsonByPathCache();
+
     template <typename T>
     VectorPtr
     ExecRangeVisitorImplForPk(EvalCtx& context);
@@ -1178,6 +1185,11 @@ class PhyUnaryRangeFilterExpr : public SegmentExpr {
     PinWrapper<index::BsonInvertedIndex*> bson_index_{nullptr};
     bool enable_sub_expr_cache_write_{true};
 
+    // The path column of the chunk read last, reused by the next batches of
+    // that chunk even when it did not fit in the cache or was evicted.
+    int64_t path_column_chunk_id_{-1};
+    std::shared_ptr<const JsonPathColumn> path_column_;
+
     // Cached regex objects — constructed once per segment, reused across batches.
     bool regex_cache_inited_{false};
     std::unique_ptr<PartialRegexMatcher> cached_regex_matcher_;
@@ -15,17 +15,97 @@
 
 #include "AggregationNode.h"
 
+#include <algorithm>
 #include <functional>
+#include <future>
+#include <string>
 #include <utility>
 
+#include "common/EasyAssert.h"
 #include "common/Utils.h"
+#include "exec/QueryContext.h"
 #include "exec/VectorHasher.h"
 #include "exec/operator/query-agg/AggregateInfo.h"
+#include "folly/ScopeGuard.h"
 #include "plan/PlanNode.h"
+#include "segcore/SegcoreConfig.h"
+#include "storage/ThreadPools.h"
 
 namespace milvus {
 namespace exec {
 
+namespace {
+
+bool
+isSplittableType(DataType type) {
+    switch (type) {
+        case DataType::BOOL:
+        case DataType::INT8:
+        case DataType::INT16:
+        case DataType::INT32:
+        case DataType::INT64:
+        case DataType::TIMESTAMPTZ:
+        case DataType::FLOAT:
+        case DataType::DOUBLE:
+        case DataType::STRING:
+        case DataType::VARCHAR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+template <typename T>
+VectorPtr
+copyRowsTyped(const ColumnVectorPtr& column,
+              vector_size_t begin,
+              vector_size_t size) {
+    auto result = std::make_shared<ColumnVector>(column->type(), size);
+    std::copy_n(
+        column->RawAsValues<T>() + begin, size, result->RawAsValues<T>());
+    if (column->nullCount() > 0) {
+        for (vector_size_t i = 0; i < size; i++) {
+            if (!column->ValidAt(begin + i)) {
+                result->nullAt(i);
+            }
+        }
+    }
+    return result;
+}
+
+VectorPtr
+copyRows(const VectorPtr& vector, vector_size_t begin, vector_size_t size) {
+    auto column = std::dynamic_pointer_cast<ColumnVector>(vector);
+    AssertInfo(column != nullptr && !column->IsBitmap(),
+               "partial aggregation input must be a non-bitmap ColumnVector");
+    switch (column->type()) {
+        case DataType::BOOL:
+            return copyRowsTyped<bool>(column, begin, size);
+        case DataType::INT8:
+            return copyRowsTyped<int8_t>(column, begin, size);
+        case DataType::INT16:
+            return copyRowsTyped<int16_t>(column, begin, size);
+        case DataType::INT32:
+            return copyRowsTyped<int32_t>(column, begin, size);
+        case DataType::INT64:
+        case DataType::TIMESTAMPTZ:
+            return copyRowsTyped<int64_t>(column, begin, size);
+        case DataType::FLOAT:
+            return copyRowsTyped<float>(column, begin, size);
+        case DataType::DOUBLE:
+            return copyRowsTyped<double>(column, begin, size);
+        case DataType::STRING:
+        case DataType::VARCHAR:
+            return copyRowsTyped<std::string>(column, begin, size);
+        default:
+            ThrowInfo(DataTypeInvalid,
+                      "unsupported data type {} for partial aggregation",
+                      GetDataTypeName(column->type()));
+    }
+}
+
+}  // namespace
+
 PhyAggregationNode::PhyAggregationNode(
     int32_t operator_id,
     milvus::exec::DriverContext* ctx,
@@ -39,6 +119,32 @@ PhyAggregationNode::PhyAggregationNode(
 void
 PhyAggregationNode::initialize() {
     Operator::initialize();
+    grouping_set_ = createGroupingSet();
+
+    const auto& input_type = aggregationNode_->sources()[0]->output_type();
+    partialAggregationEnabled_ = true;
+    for (auto i = 0; i < input_type->column_count(); i++) {
+        if (!isSplittableType(input_type->column_type(i))) {
+            partialAggregationEnabled_ = false;
+        }
+    }
+    auto& config = segcore::SegcoreConfig::default_config();
+    if (config.get_query_spill_memory_budget() > 0 &&
+        !config.get_query_spill_dir().empty()) {
+        partialAggregationEnabled_ = false;
+    }
+    partialMinRows_ = std::max<int64_t>(
+        1,
+        operator_context_->get_exec_context()
+            ->get_query_config()
+            ->get_aggregation_partial_min_rows());
+    auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::MIDDLE);
+    maxPartialAggregations_ =
+        std::max<int32_t>(1, static_cast<int32_t>(pool.GetMaxThreadNum()));
+}
+
+std::unique_ptr<GroupingSet>
+PhyAggregationNode::createGroupingSet() const {
     // aggregation operator will always have single one source
     const auto& input_type = aggregationNode_->sources()[0]->output_type();
     auto hashers =
@@ -46,15 +152,82 @@ PhyAggregationNode::initialize() {
     auto numHashers = hashers.size();
     std::vector<AggregateInfo> aggregateInfos =
         toAggregateInfo(*aggregationNode_, *operator_context_, numHashers);
-    grouping_set_ = std::make_unique<GroupingSet>(
+    return std::make_unique<GroupingSet>(
         input_type, std::move(hashers), std::move(aggregateInfos));
-    aggregationNode_.reset();
 }
 
 void
 PhyAggregationNode::AddInput(RowVectorPtr& input) {
-    grouping_set_->addInput(input);
     numInputRows_ += input->size();
+    const auto numPartials = partialAggregationCount(input);
+    if (numPartials > 1) {
+        addPartialAggregationInput(input, numPartials);
+        return;
+    }
+    grouping_set_->addInput(input);
+}
+
+int32_t
+PhyAggregationNode::partialAggregationCount(const RowVectorPtr& input) const {
+    if (!partialAggregationEnabled_) {
+        return 1;
+    }
+    const auto byRows = input->size() / partialMinRows_;
+    return static_cast<int32_t>(std::clamp<int64_t>(
+        byRows, 1, static_cast<int64_t>(maxPartialAggregations_)));
+}
+
+void
+PhyAggregationNode::addPartialAggregationInput(const RowVectorPtr& input,
+                                               int32_t numPartials) {
+    const auto numRows = static_cast<vector_size_t>(input->size());
+    const auto numColumns = input->childrens().size();
+    std::vector<std::unique_ptr<GroupingSet>> partials;
+    partials.reserve(numPartials);
+    for (auto i = 0; i < numPartials; i++) {
+        partials.emplace_back(createGroupingSet());
+    }
+
+    auto aggregate = [&input, &partials, numRows, numPartials, numColumns](
+                         int32_t i) {
+        const auto begin = static_cast<vector_size_t>(
+            static_cast<int64_t>(numRows) * i / numPartials);
+        const auto end = static_cast<vector_size_t>(
+            static_cast<int64_t>(numRows) * (i + 1) / numPartials);
+        std::vector<VectorPtr> children;
+        children.reserve(numColumns);
+        for (size_t j = 0; j < numColumns; j++) {
+            children.emplace_back(
+                copyRows(input->child(j), begin, end - begin));
+        }
+        partials[i]->addInput(
+            std::make_shared<RowVector>(std::move(children)));
+    };
+
+    auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::MIDDLE);
+    std::vector<std::future<void>> futures;
+    futures.reserve(numPartials);
+    auto futures_guard = folly::makeGuard([&futures]() {
+        for (auto& f : futures) {
+            if (f.valid()) {
+                try {
+                    f.get();
+                } catch (...) {
+                }
+            }
+        }
+    });
+    for (auto i = 1; i < numPartials; i++) {
+        futures.emplace_back(pool.Submit([&aggregate, i]() { aggregate(i); }));
+    }
+    // The caller takes a slice too, so a busy pool only delays the rest.
+    aggregate(0);
+    for (auto& future : futures) {
+        future.get();
+    }
+    for (auto& partial : partials) {
+        grouping_set_->mergePartial(*partial);
+    }
 }
 
 RowVectorPtr
@@ -63,7 +236,8 @@ PhyAggregationNode::GetOutput() {
         input_ = nullptr;
         return nullptr;
     }
-    DeferLambda([&]() { finished_ = true; });
+    // A spilled grouping set returns its groups one partition per call.
+    DeferLambda([&]() { finished_ = !grouping_set_->hasRemainingOutput(); });
     const auto outputRowCount = isGlobal_ ? 1 : grouping_set_->outputRowCount();
     output_ = std::make_shared<RowVector>(output_type_, outputRowCount);
     const bool hasData = grouping_set_->getOutput(output_);
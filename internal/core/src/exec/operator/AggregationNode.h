@@ -78,6 +78,20 @@ class PhyAggregationNode : public Operator {
     }
 
  private:
+    std::unique_ptr<GroupingSet>
+    createGroupingSet() const;
+
+    // Number of row ranges 'input' is split into for partial aggregation,
+    // 1 when it is aggregated directly on the calling thread.
+    int32_t
+    partialAggregationCount(const RowVectorPtr& input) const;
+
+    // Aggregates each of 'numPartials' row ranges of 'input' into its own
+    // grouping set on the thread pool, then merges the partial groups into
+    // grouping_set_.
+    void
+    addPartialAggregationInput(const RowVectorPtr& input, int32_t numPartials);
+
     RowVectorPtr output_;
     std::unique_ptr<GroupingSet> grouping_set_;
     std::shared_ptr<const plan::AggregationNode> aggregationNode_;
@@ -90,6 +104,12 @@ class PhyAggregationNode : public Operator {
     // flush.
     int64_t numOutputRows_ = 0;
     bool finished_ = false;
+
+    // Partial aggregation is off when the grouping set may spill, since the
+    // partial grouping sets hold all their groups in memory.
+    bool partialAggregationEnabled_ = false;
+    int64_t partialMinRows_ = 0;
+    int32_t maxPartialAggregations_ = 1;
 };
 }  // namespace exec
 }  // namespace milvus
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <optional>
 #include <ratio>
 #include <utility>
 #include <vector>
@@ -157,6 +158,29 @@ PhyFilterBitsNode::GetOutput() {
         }
     }
 
+    // Concurrent queries with the same filter wait for the first one's
+    // bitset instead of evaluating it again. The key is kept apart from the
+    // expression keys, whose bitsets are not flipped into filtered rows.
+    std::optional<InflightEval> inflight;
+    if (can_use_cache) {
+        inflight.emplace(
+            ExprResCacheManager::Key{cache_segment->get_segment_id(),
+                                     "FilterBits|" + expr_cache_key_},
+            need_process_rows_);
+        if (inflight->IsWaiter()) {
+            TargetBitmap result(0), valid(0);
+            if (inflight->Wait(result, valid) &&
+                result.size() == need_process_rows_) {
+                num_processed_rows_ = need_process_rows_;
+                std::vector<VectorPtr> col_res;
+                col_res.push_back(std::make_shared<ColumnVector>(
+                    std::move(result), std::move(valid)));
+                return std::make_shared<RowVector>(col_res);
+            }
+            inflight.reset();
+        }
+    }
+
     tracer::AutoSpan span(
         "PhyFilterBitsNode::Execute", tracer::GetRootSpan(), true);
     tracer::AddEvent(fmt::format("input_rows: {}", need_process_rows_));
@@ -203,6 +227,9 @@ PhyFilterBitsNode::GetOutput() {
             v.result = std::make_shared<TargetBitmap>(view);
             v.valid_result = std::make_shared<TargetBitmap>(valid_view);
             v.active_count = need_process_rows_;
+            if (inflight) {
+                inflight->Publish(*v.result, *v.valid_result);
+            }
             ExprResCacheManager::Instance().Put(key, v);
         }
 
@@ -260,6 +287,9 @@ PhyFilterBitsNode::GetOutput() {
     // Cache write: clone bitset into ExprResCacheManager — Stage 1 of two-stage
     // search. Must clone before move since Stage 1 still owns the bitset for
     // the ColumnVector return value below.
+    if (inflight) {
+        inflight->Publish(bitset, valid_bitset);
+    }
     if (can_use_cache) {
         ExprResCacheManager::Key key{cache_segment->get_segment_id(),
                                      expr_cache_key_};
@@ -145,8 +145,8 @@ PhyProjectNode::GetOutput() {
     // When no fields need to be projected (e.g., count(*) only), count valid
     // logical rows directly from the bitmap.  For element-level bitmaps this is
     // the matching element count. find_first deduplicates by PK in growing
-    // segments (OffsetOrderedMap), which would undercount rows with duplicate
-    // PKs.
+    // segments (ConcurrentOffsetMap), which would undercount rows with
+    // duplicate PKs.
     if (fields_to_project_.empty()) {
         auto valid_count =
             static_cast<int64_t>(col_input->size()) - raw_data_view.count();
@@ -20,6 +20,7 @@
 
 #include "common/EasyAssert.h"
 #include "log/Log.h"
+#include "segcore/SegcoreConfig.h"
 
 namespace milvus {
 namespace exec {
@@ -84,9 +85,18 @@ PhyQueryOrderByNode::PhyQueryOrderByNode(
             order.nulls_first);
     }
 
+    // Spill sorted runs to local disk once the node-level budget is exceeded
+    const auto& segcore_config = segcore::SegcoreConfig::default_config();
+    SortSpillConfig spill_config;
+    spill_config.memory_budget_bytes =
+        segcore_config.get_query_spill_memory_budget();
+    spill_config.spill_directory = segcore_config.get_query_spill_dir();
+
     // Create SortBuffer
-    sort_buffer_ = std::make_unique<SortBuffer>(
-        column_types_, sort_key_infos, order_by_node->Limit());
+    sort_buffer_ = std::make_unique<SortBuffer>(column_types_,
+                                                sort_key_infos,
+                                                order_by_node->Limit(),
+                                                std::move(spill_config));
 
     LOG_DEBUG(
         "PhyQueryOrderByNode created with {} sort keys, {} columns, limit={}",
@@ -88,6 +88,33 @@ class Aggregate {
     virtual void
     extractValues(char** groups, int32_t numGroups, VectorPtr* result) = 0;
 
+    // Merges the accumulators of 'sources' into 'groups'. Source rows must
+    // share the layout of 'groups', e.g. spilled groups read back into a
+    // RowContainer built with the same key types and accumulators.
+    virtual void
+    addIntermediateResults(char** groups,
+                           char** sources,
+                           int32_t numGroups) = 0;
+
+    // Appends accumulator state that lives outside the group row (such as
+    // an owned string) to 'out', so that the group can be spilled.
+    virtual void
+    serializeAccumulatorExtra(char* group, std::string& out) {
+    }
+
+    // Restores state written by serializeAccumulatorExtra() into 'group' and
+    // returns the number of bytes consumed from 'data'.
+    virtual size_t
+    deserializeAccumulatorExtra(char* group, const char* data, size_t size) {
+        return 0;
+    }
+
+    // Frees accumulator state that lives outside the group rows, for groups
+    // that are dropped without going through extractValues().
+    virtual void
+    destroy(folly::Range<char**> groups) {
+    }
+
     template <typename T>
     T*
     value(char* group) const {
@@ -144,6 +171,14 @@ class Aggregate {
     // is not needed.
     uint64_t numNulls_ = 0;
 
+    // Reads the null flag without consulting numNulls_, which only tracks
+    // the groups initialized by this aggregate. Used for source rows that
+    // come from another container, e.g. spilled groups.
+    bool
+    isNullFlagSet(const char* group) const {
+        return group[nullByte_] & nullMask_;
+    }
+
     inline bool
     clearNull(char* group) {
         if (numNulls_) {
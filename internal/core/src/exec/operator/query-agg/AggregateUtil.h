@@ -15,6 +15,11 @@
 // limitations under the License.
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "common/EasyAssert.h"
 #include "common/Types.h"
 
 namespace milvus {
@@ -37,5 +42,36 @@ struct AggregateRegistrationResult {
     }
 };
 
+// Spill encoding for accumulators owning a heap string: a presence byte,
+// then uint32 length and bytes when present.
+inline void
+serializeOwnedString(const std::string* str, std::string& out) {
+    out.push_back(str != nullptr ? 1 : 0);
+    if (str == nullptr) {
+        return;
+    }
+    auto len = static_cast<uint32_t>(str->size());
+    out.append(reinterpret_cast<const char*>(&len), sizeof(len));
+    out.append(*str);
+}
+
+inline size_t
+deserializeOwnedString(const char* data, size_t size, std::string*& str) {
+    AssertInfo(size >= 1, "Truncated string accumulator in spilled group");
+    str = nullptr;
+    if (data[0] == 0) {
+        return 1;
+    }
+    uint32_t len = 0;
+    AssertInfo(size >= 1 + sizeof(len),
+               "Truncated string accumulator in spilled group");
+    std::memcpy(&len, data + 1, sizeof(len));
+    size_t pos = 1 + sizeof(len);
+    AssertInfo(size - pos >= len,
+               "Truncated string accumulator in spilled group");
+    str = new std::string(data + pos, len);
+    return pos + len;
+}
+
 }  // namespace exec
 }  // namespace milvus
@@ -0,0 +1,158 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "HyperLogLog.h"
+#include "SketchAggregate.h"
+#include "common/EasyAssert.h"
+#include "common/Types.h"
+#include "common/Utils.h"
+#include "folly/hash/Hash.h"
+#include "log/Log.h"
+
+namespace milvus {
+namespace exec {
+
+namespace {
+
+inline uint64_t
+hashValue(int64_t value) {
+    return folly::hash::twang_mix64(static_cast<uint64_t>(value));
+}
+
+inline uint64_t
+hashValue(double value) {
+    // -0.0 and 0.0 are the same value.
+    if (value == 0) {
+        value = 0;
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return folly::hash::twang_mix64(bits);
+}
+
+inline uint64_t
+hashValue(const std::string& value) {
+    return folly::hasher<std::string>()(value);
+}
+
+template <typename TInput>
+class ApproxCountDistinctAggregate final
+    : public SketchAggregate<HyperLogLog,
+                             ApproxCountDistinctAggregate<TInput>> {
+    using Base =
+        SketchAggregate<HyperLogLog, ApproxCountDistinctAggregate<TInput>>;
+
+ public:
+    explicit ApproxCountDistinctAggregate(AggregateStep step)
+        : Base(isFinalOutputStep(step) ? DataType::INT64 : DataType::VARCHAR,
+               step) {
+    }
+
+    template <typename GetSketch>
+    void
+    addRawValues(const ColumnVectorPtr& column, GetSketch getSketch) {
+        auto raw = column->RawAsValues<TInput>();
+        for (auto i = 0; i < column->size(); i++) {
+            if (!column->ValidAt(i)) {
+                continue;
+            }
+            if constexpr (std::is_floating_point_v<TInput>) {
+                getSketch(i).add(hashValue(static_cast<double>(raw[i])));
+            } else if constexpr (std::is_same_v<TInput, std::string>) {
+                getSketch(i).add(hashValue(raw[i]));
+            } else {
+                getSketch(i).add(hashValue(static_cast<int64_t>(raw[i])));
+            }
+        }
+    }
+
+    void
+    extractFinalValues(char** groups,
+                       int32_t numGroups,
+                       ColumnVectorPtr& result) {
+        // Like count, a group without non-null values counts zero.
+        for (auto i = 0; i < numGroups; i++) {
+            auto* sketch = *Base::template value<HyperLogLog*>(groups[i]);
+            result->clearNullAt(i);
+            result->SetValueAt<int64_t>(
+                i, sketch == nullptr ? 0 : sketch->cardinality());
+        }
+    }
+};
+
+}  // namespace
+
+void
+registerApproxCountDistinctAggregate() {
+    registerSketchAggregate(
+        KApproxCountDistinct,
+        [](AggregateStep step,
+           DataType inputType) -> std::unique_ptr<Aggregate> {
+            if (!isRawInputStep(step)) {
+                AssertInfo(inputType == DataType::VARCHAR,
+                           "{} merges serialized sketches, got input type {}",
+                           KApproxCountDistinct,
+                           GetDataTypeName(inputType));
+                // The raw input type does not matter once hashed.
+                return std::make_unique<ApproxCountDistinctAggregate<int64_t>>(
+                    step);
+            }
+            switch (inputType) {
+                case DataType::BOOL:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<bool>>(step);
+                case DataType::INT8:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<int8_t>>(step);
+                case DataType::INT16:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<int16_t>>(step);
+                case DataType::INT32:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<int32_t>>(step);
+                case DataType::INT64:
+                case DataType::TIMESTAMPTZ:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<int64_t>>(step);
+                case DataType::FLOAT:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<float>>(step);
+                case DataType::DOUBLE:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<double>>(step);
+                case DataType::VARCHAR:
+                case DataType::STRING:
+                case DataType::TEXT:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<std::string>>(step);
+                default:
+                    ThrowInfo(DataTypeInvalid,
+                              "Unknown input type for {} aggregation {}",
+                              KApproxCountDistinct,
+                              GetDataTypeName(inputType));
+            }
+        });
+    LOG_INFO("Registered Approx Count Distinct Aggregate Function");
+}
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,135 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "SketchAggregate.h"
+#include "TDigest.h"
+#include "common/EasyAssert.h"
+#include "common/Types.h"
+#include "common/Utils.h"
+#include "log/Log.h"
+
+namespace milvus {
+namespace exec {
+
+namespace {
+
+template <typename TInput>
+class ApproxPercentileAggregate final
+    : public SketchAggregate<TDigest, ApproxPercentileAggregate<TInput>> {
+    using Base = SketchAggregate<TDigest, ApproxPercentileAggregate<TInput>>;
+
+ public:
+    ApproxPercentileAggregate(AggregateStep step, double fraction)
+        : Base(isFinalOutputStep(step) ? DataType::DOUBLE : DataType::VARCHAR,
+               step),
+          fraction_(fraction) {
+    }
+
+    template <typename GetSketch>
+    void
+    addRawValues(const ColumnVectorPtr& column, GetSketch getSketch) {
+        auto raw = column->RawAsValues<TInput>();
+        for (auto i = 0; i < column->size(); i++) {
+            if (!column->ValidAt(i)) {
+                continue;
+            }
+            getSketch(i).add(static_cast<double>(raw[i]));
+        }
+    }
+
+    void
+    extractFinalValues(char** groups,
+                       int32_t numGroups,
+                       ColumnVectorPtr& result) {
+        for (auto i = 0; i < numGroups; i++) {
+            auto* digest = *Base::template value<TDigest*>(groups[i]);
+            if (digest == nullptr || digest->totalWeight() == 0) {
+                result->nullAt(i);
+                continue;
+            }
+            result->clearNullAt(i);
+            result->SetValueAt<double>(i, digest->quantile(fraction_));
+        }
+    }
+
+ private:
+    const double fraction_;
+};
+
+std::unique_ptr<Aggregate>
+createApproxPercentile(const std::string& name,
+                       double fraction,
+                       AggregateStep step,
+                       DataType inputType) {
+    if (!isRawInputStep(step)) {
+        AssertInfo(inputType == DataType::VARCHAR,
+                   "{} merges serialized digests, got input type {}",
+                   name,
+                   GetDataTypeName(inputType));
+        return std::make_unique<ApproxPercentileAggregate<double>>(step,
+                                                                   fraction);
+    }
+    switch (inputType) {
+        case DataType::INT8:
+            return std::make_unique<ApproxPercentileAggregate<int8_t>>(
+                step, fraction);
+        case DataType::INT16:
+            return std::make_unique<ApproxPercentileAggregate<int16_t>>(
+                step, fraction);
+        case DataType::INT32:
+            return std::make_unique<ApproxPercentileAggregate<int32_t>>(
+                step, fraction);
+        case DataType::INT64:
+        case DataType::TIMESTAMPTZ:
+            return std::make_unique<ApproxPercentileAggregate<int64_t>>(
+                step, fraction);
+        case DataType::FLOAT:
+            return std::make_unique<ApproxPercentileAggregate<float>>(
+                step, fraction);
+        case DataType::DOUBLE:
+            return std::make_unique<ApproxPercentileAggregate<double>>(
+                step, fraction);
+        default:
+            ThrowInfo(DataTypeInvalid,
+                      "Unknown input type for {} aggregation {}",
+                      name,
+                      GetDataTypeName(inputType));
+    }
+}
+
+}  // namespace
+
+void
+registerApproxPercentileAggregates() {
+    for (const auto& [name, fraction] : ApproxPercentileFunctions()) {
+        registerSketchAggregate(
+            name,
+            [name = name, fraction = fraction](AggregateStep step,
+                                               DataType inputType) {
+                return createApproxPercentile(
+                    name, fraction, step, inputType);
+            });
+    }
+    LOG_INFO("Registered Approx Percentile Aggregate Functions");
+}
+
+}  // namespace exec
+}  // namespace milvus
@@ -109,6 +109,15 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
         }
     }
 
+    void
+    addIntermediateResults(char** groups,
+                           char** sources,
+                           int32_t numGroups) override {
+        for (auto i = 0; i < numGroups; i++) {
+            addToGroup(groups[i], *value<int64_t>(sources[i]));
+        }
+    }
+
     void
     initializeNewGroupsInternal(
         char** groups, folly::Range<const vector_size_t*> indices) override {
@@ -16,7 +16,10 @@
 
 #include "GroupingSet.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <limits>
+#include <string>
 
 #include "common/BitUtil.h"
 #include "common/EasyAssert.h"
@@ -27,6 +30,7 @@
 #include "exec/operator/query-agg/AggregateInfo.h"
 #include "exec/operator/query-agg/RowContainer.h"
 #include "folly/Range.h"
+#include "log/Log.h"
 #include "segcore/SegcoreConfig.h"
 
 namespace milvus {
@@ -143,6 +147,9 @@ GroupingSet::getOutput(milvus::RowVectorPtr& result) {
     if (!hash_table_) {
         return false;
     }
+    if (numSpills_ > 0) {
+        return getSpilledOutput(result);
+    }
     const auto& all_rows = hash_table_->rows()->allRows();
     if (!all_rows.empty()) {
         extractGroups(result);
@@ -163,7 +170,212 @@ GroupingSet::accumulators() {
 
 void
 GroupingSet::ensureInputFits(const RowVectorPtr& input) {
-    //TODO memory check
+    // Every input row may open a new group, so check before probing.
+    ensureGroupsFit(input->size());
+}
+
+void
+GroupingSet::ensureGroupsFit(int64_t numNewGroups) {
+    if (!spillEnabled() || hash_table_->numDistinct() == 0) {
+        return;
+    }
+    const auto numGroupsAfter = hash_table_->numDistinct() + numNewGroups;
+    if (tableBytes_ < static_cast<uint64_t>(spillMemoryBudget_) &&
+        numGroupsAfter <= maxGroups_) {
+        return;
+    }
+    spill();
+}
+
+void
+GroupingSet::spill() {
+    auto* rows = hash_table_->rows();
+    const auto& groups = rows->allRows();
+    if (groups.empty()) {
+        return;
+    }
+    if (spillPartitions_.empty()) {
+        spillPartitions_.reserve(kNumSpillPartitions);
+        for (auto i = 0; i < kNumSpillPartitions; i++) {
+            spillPartitions_.emplace_back(std::make_unique<SpillFile>(
+                spillDirectory_, kSpillFileBufferSize));
+        }
+    }
+    // Partition on a hash of the keys rather than on the table's own row
+    // hashes, which depend on the current hash mode and so may differ between
+    // spill rounds for the same key.
+    std::vector<uint64_t> hashes(groups.size());
+    const auto& hashers = hash_table_->hashers();
+    for (auto i = 0; i < hashers.size(); i++) {
+        hashers[i]->setColumnData(
+            rows->extractColumnVector(groups.data(), groups.size(), i));
+        hashers[i]->hash(i > 0, hashes);
+    }
+    std::string record;
+    for (size_t i = 0; i < groups.size(); i++) {
+        record.clear();
+        rows->serializeRow(groups[i], record);
+        for (auto& aggregate : aggregates_) {
+            aggregate.function_->serializeAccumulatorExtra(groups[i], record);
+        }
+        // The table buckets on the low bits of the hash, so partition on the
+        // high bits of a mixed copy.
+        auto partition = (hashes[i] * 0x9E3779B97F4A7C15ULL) >>
+                         (64 - kSpillPartitionBits);
+        spillPartitions_[partition]->AppendRecord(record);
+    }
+    numSpills_++;
+    LOG_DEBUG("GroupingSet spilled {} groups ({} bytes), spill count {}",
+              groups.size(),
+              tableBytes_,
+              numSpills_);
+    resetHashTable();
+}
+
+bool
+GroupingSet::getSpilledOutput(const RowVectorPtr& result) {
+    if (!spillOutputStarted_) {
+        // Spill the groups still in memory as well, so that every partition
+        // holds all state for its keys before it is merged.
+        spill();
+        for (auto& partition : spillPartitions_) {
+            partition->FinishWrite();
+        }
+        spillOutputStarted_ = true;
+    }
+    while (nextSpillPartition_ < spillPartitions_.size()) {
+        auto partition = std::move(spillPartitions_[nextSpillPartition_++]);
+        mergeSpilledPartition(*partition);
+        if (!hash_table_->rows()->allRows().empty()) {
+            extractGroups(result);
+            resetHashTable();
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+GroupingSet::mergeSpilledPartition(SpillFile& partition) {
+    auto* rows = hash_table_->rows();
+    RowContainer spilled(
+        rows->KeyTypes(), accumulators(), rows->hasNormalizedKey());
+    AssertInfo(spilled.fixedRowSize() == rows->fixedRowSize(),
+               "Spilled group layout does not match the hash table");
+    std::vector<char*> sources;
+    sources.reserve(kSpillMergeBatchRows);
+    std::string record;
+    bool hasMore = true;
+    while (hasMore) {
+        while (sources.size() < kSpillMergeBatchRows &&
+               (hasMore = partition.ReadRecord(record))) {
+            char* row = nullptr;
+            auto pos =
+                spilled.deserializeRow(record.data(), record.size(), row);
+            for (auto& aggregate : aggregates_) {
+                pos += aggregate.function_->deserializeAccumulatorExtra(
+                    row, record.data() + pos, record.size() - pos);
+            }
+            AssertInfo(pos == record.size(),
+                       "Spilled group has {} trailing bytes",
+                       record.size() - pos);
+            sources.push_back(row);
+        }
+        if (!sources.empty()) {
+            mergeGroups(spilled, sources);
+            destroyGroups(
+                folly::Range<char**>(sources.data(), sources.size()));
+            spilled.clear();
+            sources.clear();
+        }
+    }
+}
+
+void
+GroupingSet::mergePartial(GroupingSet& partial) {
+    if (isGlobal_) {
+        if (!partial.globalAggregationInitialized_) {
+            return;
+        }
+        initializeGlobalAggregation();
+        auto* group = lookup_->hits_[0];
+        auto* source = partial.lookup_->hits_[0];
+        for (auto& aggregate : aggregates_) {
+            aggregate.function_->addIntermediateResults(&group, &source, 1);
+        }
+        partial.destroyGroups(folly::Range<char**>(&source, 1));
+        return;
+    }
+    if (!partial.hash_table_) {
+        return;
+    }
+    if (!hash_table_) {
+        createHashTable();
+    }
+    auto* partialRows = partial.hash_table_->rows();
+    AssertInfo(
+        partialRows->fixedRowSize() == hash_table_->rows()->fixedRowSize(),
+        "Partial group layout does not match the hash table");
+    const auto& groups = partialRows->allRows();
+    std::vector<char*> sources;
+    sources.reserve(std::min<size_t>(groups.size(), kSpillMergeBatchRows));
+    for (size_t start = 0; start < groups.size();
+         start += kSpillMergeBatchRows) {
+        auto end =
+            std::min<size_t>(start + kSpillMergeBatchRows, groups.size());
+        sources.assign(groups.begin() + start, groups.begin() + end);
+        ensureGroupsFit(sources.size());
+        mergeGroups(*partialRows, sources);
+    }
+    partial.resetHashTable();
+}
+
+void
+GroupingSet::mergeGroups(RowContainer& sourceRows,
+                         std::vector<char*>& sources) {
+    const auto numGroups = static_cast<int32_t>(sources.size());
+    const auto numKeys = sourceRows.KeyTypes().size();
+    std::vector<ColumnVectorPtr> keys;
+    keys.reserve(numKeys);
+    for (auto i = 0; i < numKeys; i++) {
+        keys.emplace_back(
+            sourceRows.extractColumnVector(sources.data(), numGroups, i));
+    }
+    hash_table_->prepareForGroupProbe(*lookup_, keys, numGroups);
+    hash_table_->groupProbe(*lookup_);
+    auto* groups = lookup_->hits_.data();
+    const auto& newGroups = lookup_->newGroups_;
+    if (spillEnabled()) {
+        auto* rows = hash_table_->rows();
+        for (auto row : newGroups) {
+            tableBytes_ += rows->rowMemoryBytes(groups[row]);
+        }
+    }
+    for (auto& aggregate : aggregates_) {
+        auto& function = aggregate.function_;
+        if (!newGroups.empty()) {
+            function->initializeNewGroups(groups, newGroups);
+        }
+        function->addIntermediateResults(groups, sources.data(), numGroups);
+    }
+}
+
+void
+GroupingSet::destroyGroups(folly::Range<char**> groups) {
+    for (auto& aggregate : aggregates_) {
+        aggregate.function_->destroy(groups);
+    }
+}
+
+void
+GroupingSet::resetHashTable() {
+    auto* rows = hash_table_->rows();
+    const auto& groups = rows->allRows();
+    destroyGroups(
+        folly::Range<char**>(const_cast<char**>(groups.data()), groups.size()));
+    hash_table_->clear();
+    rows->clear();
+    tableBytes_ = 0;
 }
 
 void
@@ -202,6 +414,12 @@ GroupingSet::addInputForActiveRows(const RowVectorPtr& input) {
     auto* groups = hits.data();
     auto numGroups = hits.size();
     const auto& newGroups = lookup_->newGroups_;
+    if (spillEnabled()) {
+        auto* rows = hash_table_->rows();
+        for (auto row : newGroups) {
+            tableBytes_ += rows->rowMemoryBytes(groups[row]);
+        }
+    }
     for (auto i = 0; i < aggregates_.size(); i++) {
         auto& function = aggregates_[i].function_;
         if (!newGroups.empty()) {
@@ -249,8 +467,16 @@ initializeAggregates(const std::vector<AggregateInfo>& aggregates,
 
 void
 GroupingSet::createHashTable() {
-    auto maxGroups =
-        segcore::SegcoreConfig::default_config().get_max_group_by_groups();
+    auto& config = segcore::SegcoreConfig::default_config();
+    auto maxGroups = config.get_max_group_by_groups();
+    spillMemoryBudget_ = config.get_query_spill_memory_budget();
+    spillDirectory_ = config.get_query_spill_dir();
+    if (spillEnabled()) {
+        // The table spills before reaching the cap, and a merged partition
+        // may legitimately hold more groups than one in-memory round.
+        maxGroups_ = maxGroups;
+        maxGroups = std::numeric_limits<int64_t>::max();
+    }
     hash_table_ = std::make_unique<HashTable>(
         std::move(hashers_), accumulators(), maxGroups);
     auto& rows = *(hash_table_->rows());
@@ -17,6 +17,7 @@
 #pragma once
 #include <stdint.h>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -25,7 +26,9 @@
 #include "common/Types.h"
 #include "common/Vector.h"
 #include "exec/HashTable.h"
+#include "exec/SpillFile.h"
 #include "exec/VectorHasher.h"
+#include "folly/Range.h"
 
 namespace milvus {
 namespace exec {
@@ -59,15 +62,36 @@ class GroupingSet {
     std::vector<Accumulator>
     accumulators();
 
-    // Checks if input will fit in the existing memory and increases reservation
-    // if not. If reservation cannot be increased, spills enough to make 'input'
-    // fit.
+    // Checks if input will fit in the existing memory. When query spilling is
+    // enabled and either the group cap or the memory budget would be exceeded,
+    // spills all groups to hash partitions on local disk to make 'input' fit.
     void
     ensureInputFits(const RowVectorPtr& input);
 
+    // Merges the groups accumulated by 'partial' into this grouping set and
+    // leaves 'partial' empty. 'partial' must have been created with the same
+    // keys and aggregates and fed a disjoint slice of the input, typically on
+    // another thread; see PhyAggregationNode.
+    void
+    mergePartial(GroupingSet& partial);
+
+    // Fills 'result' with the next batch of groups. Without spilling all
+    // groups are returned at once; otherwise one spilled partition is merged
+    // and returned per call until hasRemainingOutput() turns false.
     bool
     getOutput(RowVectorPtr& result);
 
+    bool
+    hasRemainingOutput() const {
+        return spillOutputStarted_ &&
+               nextSpillPartition_ < spillPartitions_.size();
+    }
+
+    int64_t
+    numSpills() const {
+        return numSpills_;
+    }
+
     void
     extractGroups(const RowVectorPtr& result);
 
@@ -81,6 +105,48 @@ class GroupingSet {
     outputRowCount() const;
 
  private:
+    static constexpr int32_t kSpillPartitionBits = 4;
+    static constexpr int32_t kNumSpillPartitions = 1 << kSpillPartitionBits;
+    static constexpr size_t kSpillFileBufferSize = 256 << 10;
+    static constexpr int32_t kSpillMergeBatchRows = 1024;
+
+    bool
+    spillEnabled() const {
+        return spillMemoryBudget_ > 0 && !spillDirectory_.empty();
+    }
+
+    // Spills if 'numNewGroups' more groups would exceed the group cap or the
+    // memory budget.
+    void
+    ensureGroupsFit(int64_t numNewGroups);
+
+    // Writes every group of the hash table to its spill partition and empties
+    // the table.
+    void
+    spill();
+
+    bool
+    getSpilledOutput(const RowVectorPtr& result);
+
+    // Reads one spill partition back and merges its groups into the emptied
+    // hash table.
+    void
+    mergeSpilledPartition(SpillFile& partition);
+
+    // Adds the accumulators of 'sources', rows of 'sourceRows' laid out like
+    // the hash table, to the matching groups of the hash table.
+    void
+    mergeGroups(RowContainer& sourceRows, std::vector<char*>& sources);
+
+    // Frees accumulator state held outside of 'groups'.
+    void
+    destroyGroups(folly::Range<char**> groups);
+
+    // Drops all groups of the hash table after they have been spilled or
+    // returned.
+    void
+    resetHashTable();
+
     bool isGlobal_;
 
     std::vector<std::unique_ptr<VectorHasher>> hashers_;
@@ -98,6 +164,19 @@ class GroupingSet {
     // Boolean indicating whether accumulators for a global aggregation (i.e. hashers_.empty()) are initialized
     // This is used to avoid segv when getting output directly without input for empty output of upstream operator
     bool globalAggregationInitialized_{false};
+
+    // Spilling state, see SegcoreConfig::get_query_spill_memory_budget().
+    // With spilling enabled, 'maxGroups_' turns from a hard error into a
+    // spill trigger.
+    int64_t spillMemoryBudget_{0};
+    std::string spillDirectory_;
+    int64_t maxGroups_{0};
+    // Estimated bytes held by the groups of the hash table.
+    uint64_t tableBytes_{0};
+    std::vector<std::unique_ptr<SpillFile>> spillPartitions_;
+    bool spillOutputStarted_{false};
+    size_t nextSpillPartition_{0};
+    int64_t numSpills_{0};
 };
 
 }  // namespace exec
@@ -0,0 +1,229 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "HyperLogLog.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "common/EasyAssert.h"
+
+namespace milvus {
+namespace exec {
+
+namespace {
+
+constexpr uint8_t kSparseFormat = 0;
+constexpr uint8_t kDenseFormat = 1;
+
+inline uint32_t
+entryIndex(uint32_t entry) {
+    return entry >> 8;
+}
+
+inline uint8_t
+entryRank(uint32_t entry) {
+    return static_cast<uint8_t>(entry & 0xFF);
+}
+
+inline uint32_t
+makeEntry(uint32_t index, uint8_t rank) {
+    return (index << 8) | rank;
+}
+
+double
+sigma(double x) {
+    if (x == 1.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double y = 1.0;
+    double z = x;
+    double previous;
+    do {
+        x *= x;
+        previous = z;
+        z += x * y;
+        y += y;
+    } while (z != previous);
+    return z;
+}
+
+double
+tau(double x) {
+    if (x == 0.0 || x == 1.0) {
+        return 0.0;
+    }
+    double y = 1.0;
+    double z = 1.0 - x;
+    double previous;
+    do {
+        x = std::sqrt(x);
+        previous = z;
+        y *= 0.5;
+        z -= (1.0 - x) * (1.0 - x) * y;
+    } while (z != previous);
+    return z / 3.0;
+}
+
+}  // namespace
+
+void
+HyperLogLog::add(uint64_t hash) {
+    const auto index = static_cast<uint32_t>(hash >> (64 - kPrecision));
+    // Rank of the first set bit among the remaining bits; the sentinel bit
+    // caps it at 64 - kPrecision + 1 when they are all zero.
+    const auto rest = (hash << kPrecision) | (1ULL << (kPrecision - 1));
+    const auto rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    addRank(index, rank);
+}
+
+void
+HyperLogLog::addRank(uint32_t index, uint8_t rank) {
+    if (!isSparse()) {
+        dense_[index] = std::max(dense_[index], rank);
+        return;
+    }
+    auto it = std::lower_bound(
+        sparse_.begin(), sparse_.end(), makeEntry(index, 0));
+    if (it != sparse_.end() && entryIndex(*it) == index) {
+        if (entryRank(*it) < rank) {
+            *it = makeEntry(index, rank);
+        }
+        return;
+    }
+    sparse_.insert(it, makeEntry(index, rank));
+    if (sparse_.size() > kMaxSparseEntries) {
+        toDense();
+    }
+}
+
+void
+HyperLogLog::toDense() {
+    dense_.assign(kNumRegisters, 0);
+    for (auto entry : sparse_) {
+        dense_[entryIndex(entry)] = entryRank(entry);
+    }
+    sparse_.clear();
+    sparse_.shrink_to_fit();
+}
+
+void
+HyperLogLog::merge(const HyperLogLog& other) {
+    if (other.isSparse()) {
+        for (auto entry : other.sparse_) {
+            addRank(entryIndex(entry), entryRank(entry));
+        }
+        return;
+    }
+    if (isSparse()) {
+        toDense();
+    }
+    for (uint32_t i = 0; i < kNumRegisters; i++) {
+        dense_[i] = std::max(dense_[i], other.dense_[i]);
+    }
+}
+
+int64_t
+HyperLogLog::cardinality() const {
+    // Ertl's improved estimator ("New cardinality estimation algorithms for
+    // HyperLogLog sketches", 2017). It is unbiased over the whole range
+    // without the empirical bias tables or the switch to linear counting of
+    // the classic estimator.
+    constexpr int32_t kMaxRank = 64 - kPrecision + 1;
+    constexpr double m = kNumRegisters;
+    std::array<uint32_t, kMaxRank + 1> histogram{};
+    if (isSparse()) {
+        histogram[0] = kNumRegisters - sparse_.size();
+        for (auto entry : sparse_) {
+            histogram[entryRank(entry)]++;
+        }
+    } else {
+        for (auto rank : dense_) {
+            histogram[rank]++;
+        }
+    }
+    double z = m * tau(1.0 - histogram[kMaxRank] / m);
+    for (auto k = kMaxRank - 1; k >= 1; k--) {
+        z = 0.5 * (z + histogram[k]);
+    }
+    z += m * sigma(histogram[0] / m);
+    constexpr double kAlphaInf = 0.5 / M_LN2;
+    return std::llround(kAlphaInf * m * m / z);
+}
+
+void
+HyperLogLog::serialize(std::string& out) const {
+    out.push_back(static_cast<char>(kVersion));
+    out.push_back(static_cast<char>(kPrecision));
+    if (isSparse()) {
+        out.push_back(static_cast<char>(kSparseFormat));
+        auto count = static_cast<uint32_t>(sparse_.size());
+        out.append(reinterpret_cast<const char*>(&count), sizeof(count));
+        out.append(reinterpret_cast<const char*>(sparse_.data()),
+                   sparse_.size() * sizeof(uint32_t));
+        return;
+    }
+    out.push_back(static_cast<char>(kDenseFormat));
+    out.append(reinterpret_cast<const char*>(dense_.data()), dense_.size());
+}
+
+HyperLogLog
+HyperLogLog::deserialize(std::string_view data) {
+    AssertInfo(data.size() >= 3, "Truncated HyperLogLog sketch");
+    AssertInfo(static_cast<uint8_t>(data[0]) == kVersion,
+               "Unsupported HyperLogLog sketch version {}",
+               static_cast<int>(data[0]));
+    AssertInfo(static_cast<uint8_t>(data[1]) == kPrecision,
+               "Unsupported HyperLogLog precision {}",
+               static_cast<int>(data[1]));
+    HyperLogLog hll;
+    const auto format = static_cast<uint8_t>(data[2]);
+    data.remove_prefix(3);
+    if (format == kDenseFormat) {
+        AssertInfo(data.size() == kNumRegisters,
+                   "Dense HyperLogLog sketch has {} registers, expected {}",
+                   data.size(),
+                   kNumRegisters);
+        hll.dense_.assign(data.begin(), data.end());
+        return hll;
+    }
+    AssertInfo(format == kSparseFormat,
+               "Unknown HyperLogLog sketch format {}",
+               static_cast<int>(format));
+    uint32_t count = 0;
+    AssertInfo(data.size() >= sizeof(count), "Truncated HyperLogLog sketch");
+    std::memcpy(&count, data.data(), sizeof(count));
+    data.remove_prefix(sizeof(count));
+    AssertInfo(data.size() == count * sizeof(uint32_t) &&
+                   count <= kMaxSparseEntries,
+               "Malformed sparse HyperLogLog sketch of {} entries",
+               count);
+    hll.sparse_.resize(count);
+    std::memcpy(hll.sparse_.data(), data.data(), data.size());
+    for (uint32_t i = 0; i < count; i++) {
+        AssertInfo(entryIndex(hll.sparse_[i]) < kNumRegisters &&
+                       (i == 0 || entryIndex(hll.sparse_[i - 1]) <
+                                      entryIndex(hll.sparse_[i])),
+                   "Malformed sparse HyperLogLog sketch");
+    }
+    return hll;
+}
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,81 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace milvus {
+namespace exec {
+
+// HyperLogLog sketch estimating the number of distinct 64-bit hashes added
+// to it, used by approx_count_distinct.
+//
+// A sketch starts sparse, as a sorted list of (register, rank) entries, and
+// turns into 2^kPrecision dense one-byte registers once the list would take
+// more than a quarter of that. With kPrecision = 12 the standard error is
+// about 1.6%.
+//
+// Serialized layout, also the intermediate state exchanged between
+// partial and final aggregation:
+//   [version (uint8)][precision (uint8)][format (uint8): 0 sparse, 1 dense]
+//   sparse: [count (uint32)][entry (uint32): register << 8 | rank]...
+//   dense:  [rank (uint8)] * 2^precision
+class HyperLogLog {
+ public:
+    static constexpr uint8_t kPrecision = 12;
+    static constexpr uint32_t kNumRegisters = 1u << kPrecision;
+
+    void
+    add(uint64_t hash);
+
+    void
+    merge(const HyperLogLog& other);
+
+    int64_t
+    cardinality() const;
+
+    bool
+    isSparse() const {
+        return dense_.empty();
+    }
+
+    void
+    serialize(std::string& out) const;
+
+    static HyperLogLog
+    deserialize(std::string_view data);
+
+ private:
+    static constexpr uint8_t kVersion = 1;
+    static constexpr size_t kMaxSparseEntries = kNumRegisters / 16;
+
+    void
+    addRank(uint32_t index, uint8_t rank);
+
+    void
+    toDense();
+
+    // Sorted by register, one entry per register.
+    std::vector<uint32_t> sparse_;
+    std::vector<uint8_t> dense_;
+};
+
+}  // namespace exec
+}  // namespace milvus
@@ -21,6 +21,7 @@
 #include <type_traits>
 #include <vector>
 
+#include "AggregateUtil.h"
 #include "SimpleNumericAggregate.h"
 #include "common/Utils.h"
 
@@ -68,6 +69,22 @@ class MaxAggregateBase
             group, input[0], &updateSingleValue<TAccumulator>);
     }
 
+    void
+    addIntermediateResults(char** groups,
+                           char** sources,
+                           int32_t numGroups) override {
+        for (auto i = 0; i < numGroups; i++) {
+            if (BaseAggregate::Aggregate::isNullFlagSet(sources[i])) {
+                continue;
+            }
+            BaseAggregate::template updateNonNullValue<true, TAccumulator>(
+                groups[i],
+                *BaseAggregate::Aggregate::template value<TAccumulator>(
+                    sources[i]),
+                &updateSingleValue<TAccumulator>);
+        }
+    }
+
     void
     initializeNewGroupsInternal(
         char** groups, folly::Range<const vector_size_t*> indices) override {
@@ -179,6 +196,42 @@ class MaxStringAggregate final : public Aggregate {
         }
     }
 
+    void
+    addIntermediateResults(char** groups,
+                           char** sources,
+                           int32_t numGroups) override {
+        for (auto i = 0; i < numGroups; i++) {
+            if (isNullFlagSet(sources[i])) {
+                continue;
+            }
+            auto* candidate = *value<std::string*>(sources[i]);
+            if (candidate != nullptr) {
+                updateOne(groups[i], *candidate);
+            }
+        }
+    }
+
+    void
+    serializeAccumulatorExtra(char* group, std::string& out) override {
+        serializeOwnedString(*value<std::string*>(group), out);
+    }
+
+    size_t
+    deserializeAccumulatorExtra(char* group,
+                                const char* data,
+                                size_t size) override {
+        return deserializeOwnedString(data, size, *value<std::string*>(group));
+    }
+
+    void
+    destroy(folly::Range<char**> groups) override {
+        for (auto* group : groups) {
+            auto& ptr = *value<std::string*>(group);
+            delete ptr;
+            ptr = nullptr;
+        }
+    }
+
     void
     initializeNewGroupsInternal(
         char** groups, folly::Range<const vector_size_t*> indices) override {
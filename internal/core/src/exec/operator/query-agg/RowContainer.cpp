@@ -18,6 +18,8 @@
 
 #include <string.h>
 #include <cstdint>
+#include <cstring>
+#include <string>
 
 #include "common/BitUtil.h"
 #include "common/Vector.h"
@@ -27,7 +29,8 @@ namespace milvus {
 namespace exec {
 
 RowContainer::RowContainer(const std::vector<DataType>& keyTypes,
-                           const std::vector<Accumulator>& accumulators)
+                           const std::vector<Accumulator>& accumulators,
+                           bool hasNormalizedKey)
     : keyTypes_(keyTypes), accumulators_(accumulators) {
     int32_t offset = 0;
     bool isVariableWidth = false;
@@ -65,10 +68,17 @@ RowContainer::RowContainer(const std::vector<DataType>& keyTypes,
     }
     AssertInfo(offsets_.size() == keyTypes_.size() + accumulators.size(),
                "wrong size of offsets in RowContainer");
+    flagsOffset_ = firstAggregateOffset;
+    accumulatorsEnd_ = offset;
     if (isVariableWidth) {
         rowSizeOffset_ = offset;
         offset += sizeof(uint32_t);
     }
+    if (hasNormalizedKey) {
+        offset = milvus::bits::roundUp(offset, sizeof(uint64_t));
+        normalizedKeyOffset_ = offset;
+        offset += sizeof(uint64_t);
+    }
     fixedRowSize_ = milvus::bits::roundUp(offset, alignment_);
     for (auto i = 0; i < offsets_.size(); i++) {
         rowColumns_.emplace_back(offsets_[i], firstAggregateOffset * 8 + i);
@@ -113,6 +123,87 @@ RowContainer::store(const milvus::ColumnVectorPtr& column_data,
                                  rowColumn.nullMask());
 }
 
+uint64_t
+RowContainer::rowMemoryBytes(const char* row) const {
+    uint64_t bytes = fixedRowSize_ + sizeof(char*);
+    for (auto i = 0; i < variable_offsets_.size(); i++) {
+        auto& row_col = columnAt(variable_idxes_[i]);
+        if (isNullAt(row, row_col.nullByte(), row_col.nullMask())) {
+            continue;
+        }
+        auto str = strAt(row, variable_offsets_[i]);
+        if (str != nullptr) {
+            bytes += sizeof(std::string) + str->capacity();
+        }
+    }
+    return bytes;
+}
+
+void
+RowContainer::serializeRow(const char* row, std::string& out) const {
+    for (const auto& accumulator : accumulators_) {
+        AssertInfo(accumulator.isFixedSize(),
+                   "Cannot serialize rows with variable-size accumulators");
+    }
+    out.append(row + flagsOffset_, accumulatorsEnd_ - flagsOffset_);
+    for (auto i = 0; i < keyTypes_.size(); i++) {
+        auto offset = offsets_[i];
+        if (IsFixedSizeType(keyTypes_[i])) {
+            out.append(row + offset, GetDataTypeSize(keyTypes_[i], 1));
+            continue;
+        }
+        auto& row_col = columnAt(i);
+        if (isNullAt(row, row_col.nullByte(), row_col.nullMask())) {
+            continue;
+        }
+        auto str = strAt(row, offset);
+        uint32_t len = str == nullptr ? 0 : static_cast<uint32_t>(str->size());
+        out.append(reinterpret_cast<const char*>(&len), sizeof(len));
+        if (len > 0) {
+            out.append(str->data(), len);
+        }
+    }
+}
+
+size_t
+RowContainer::deserializeRow(const char* data, size_t size, char*& row) {
+    const size_t header = accumulatorsEnd_ - flagsOffset_;
+    AssertInfo(size >= header,
+               "Serialized row too short: {} bytes, need at least {}",
+               size,
+               header);
+    row = newRow();
+    std::memcpy(row + flagsOffset_, data, header);
+    size_t pos = header;
+    for (auto i = 0; i < keyTypes_.size(); i++) {
+        auto offset = offsets_[i];
+        if (IsFixedSizeType(keyTypes_[i])) {
+            auto width = GetDataTypeSize(keyTypes_[i], 1);
+            AssertInfo(pos + width <= size,
+                       "Serialized row truncated at key {}",
+                       i);
+            std::memcpy(row + offset, data + pos, width);
+            pos += width;
+            continue;
+        }
+        auto& row_col = columnAt(i);
+        if (isNullAt(row, row_col.nullByte(), row_col.nullMask())) {
+            continue;
+        }
+        uint32_t len = 0;
+        AssertInfo(pos + sizeof(len) <= size,
+                   "Serialized row truncated at key {}",
+                   i);
+        std::memcpy(&len, data + pos, sizeof(len));
+        pos += sizeof(len);
+        AssertInfo(pos + len <= size, "Serialized row truncated at key {}", i);
+        *reinterpret_cast<std::string**>(row + offset) =
+            new std::string(data + pos, len);
+        pos += len;
+    }
+    return pos;
+}
+
 Accumulator::Accumulator(bool isFixedSize, int32_t fixedSize, int32_t alignment)
     : isFixedSize_(isFixedSize), fixedSize_(fixedSize), alignment_(alignment) {
 }
@@ -15,6 +15,7 @@
 // limitations under the License.
 #pragma once
 
+#include <cstring>
 #include <vector>
 #include <folly/Range.h>
 #include "common/Types.h"
@@ -88,8 +89,11 @@ class RowColumn {
 
 class RowContainer {
  public:
+    /// 'hasNormalizedKey' reserves a uint64_t per row for the packed key of
+    /// the kNormalizedKey hash mode, see HashTable.
     RowContainer(const std::vector<DataType>& keyTypes,
-                 const std::vector<Accumulator>& accumulators);
+                 const std::vector<Accumulator>& accumulators,
+                 bool hasNormalizedKey = false);
 
     ~RowContainer();
 
@@ -123,6 +127,44 @@ class RowContainer {
         return rowSizeOffset_;
     }
 
+    uint32_t
+    fixedRowSize() const {
+        return fixedRowSize_;
+    }
+
+    bool
+    hasNormalizedKey() const {
+        return normalizedKeyOffset_ >= 0;
+    }
+
+    uint64_t
+    normalizedKey(const char* row) const {
+        uint64_t key;
+        std::memcpy(&key, row + normalizedKeyOffset_, sizeof(key));
+        return key;
+    }
+
+    void
+    setNormalizedKey(char* row, uint64_t key) {
+        std::memcpy(row + normalizedKeyOffset_, &key, sizeof(key));
+    }
+
+    /// Approximate memory held by 'row', including out-of-line strings.
+    uint64_t
+    rowMemoryBytes(const char* row) const;
+
+    /// Appends a compact encoding of 'row' to 'out': the flag bytes and the
+    /// fixed-width accumulators verbatim, then the keys, with strings stored
+    /// as (uint32 length, bytes). Used to spill rows to local disk, so all
+    /// accumulators must be fixed-size.
+    void
+    serializeRow(const char* row, std::string& out) const;
+
+    /// Allocates a new row filled from an encoding produced by serializeRow()
+    /// of a container with the same layout. Returns bytes consumed.
+    size_t
+    deserializeRow(const char* data, size_t size, char*& row);
+
     static inline bool
     isNullAt(const char* row, int32_t nullByte, uint8_t nullMask) {
         return (row[nullByte] & nullMask) != 0;
@@ -483,8 +525,14 @@ class RowContainer {
     uint32_t fixedRowSize_;
     uint32_t flagBytes_;
 
+    // [flagsOffset_, accumulatorsEnd_) holds the null flags and accumulators
+    uint32_t flagsOffset_ = 0;
+    uint32_t accumulatorsEnd_ = 0;
+
     // for rows containing variable width fields, we store row size at the end of the row
     uint32_t rowSizeOffset_ = 0;
+    // -1 if rows carry no normalized key
+    int32_t normalizedKeyOffset_ = -1;
     int alignment_ = 1;
     std::vector<Accumulator> accumulators_;
     uint64_t numRows_ = 0;
@@ -0,0 +1,255 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Aggregate.h"
+#include "AggregateUtil.h"
+#include "common/EasyAssert.h"
+#include "common/Types.h"
+#include "common/Vector.h"
+
+namespace milvus {
+namespace exec {
+
+// Which side of a partial/final split a sketch aggregate runs on. The
+// intermediate state is the sketch serialized into a VARCHAR value, so that
+// per-segment partials can be merged by a later step without the raw rows.
+enum class AggregateStep {
+    // Raw input, final value.
+    kSingle,
+    // Raw input, serialized sketch.
+    kPartial,
+    // Serialized sketches, serialized sketch.
+    kIntermediate,
+    // Serialized sketches, final value.
+    kFinal,
+};
+
+// Suffixes of the companion functions registered for each step.
+inline const char* const kPartialSuffix = "_partial";
+inline const char* const kMergeSuffix = "_merge";
+inline const char* const kMergeExtractSuffix = "_merge_extract";
+
+inline bool
+isRawInputStep(AggregateStep step) {
+    return step == AggregateStep::kSingle || step == AggregateStep::kPartial;
+}
+
+inline bool
+isFinalOutputStep(AggregateStep step) {
+    return step == AggregateStep::kSingle || step == AggregateStep::kFinal;
+}
+
+// Accumulator holding an owned heap sketch per group, like the string
+// min/max accumulators. 'Derived' supplies
+//   void addRawValues(const ColumnVectorPtr&, GetSketch getSketch);
+//   void extractFinalValues(char** groups, int32_t, ColumnVectorPtr&);
+// and 'TSketch' supplies merge(), serialize() and deserialize().
+template <typename TSketch, typename Derived>
+class SketchAggregate : public Aggregate {
+ public:
+    SketchAggregate(DataType resultType, AggregateStep step)
+        : Aggregate(resultType), step_(step) {
+    }
+
+    int32_t
+    accumulatorFixedWidthSize() const override {
+        return sizeof(TSketch*);
+    }
+
+    void
+    addRawInput(char** groups,
+                int numGroups,
+                const std::vector<VectorPtr>& input) override {
+        addInput(input,
+                 [&](vector_size_t row) -> TSketch& {
+                     return sketchOf(groups[row]);
+                 });
+    }
+
+    void
+    addSingleGroupRawInput(char* group,
+                           int64_t numRows,
+                           const std::vector<VectorPtr>& input) override {
+        addInput(input, [&](vector_size_t) -> TSketch& {
+            return sketchOf(group);
+        });
+    }
+
+    void
+    addIntermediateResults(char** groups,
+                           char** sources,
+                           int32_t numGroups) override {
+        for (auto i = 0; i < numGroups; i++) {
+            auto* source = *value<TSketch*>(sources[i]);
+            if (isNullFlagSet(sources[i]) || source == nullptr) {
+                continue;
+            }
+            sketchOf(groups[i]).merge(*source);
+        }
+    }
+
+    void
+    extractValues(char** groups,
+                  int32_t numGroups,
+                  VectorPtr* result) override {
+        auto result_column = std::dynamic_pointer_cast<ColumnVector>(*result);
+        AssertInfo(result_column != nullptr,
+                   "input vector for extracting aggregation must be of Type "
+                   "ColumnVector");
+        result_column->resize(numGroups);
+        if (isFinalOutputStep(step_)) {
+            static_cast<Derived*>(this)->extractFinalValues(
+                groups, numGroups, result_column);
+        } else {
+            std::string state;
+            for (auto i = 0; i < numGroups; i++) {
+                auto* sketch = *value<TSketch*>(groups[i]);
+                if (sketch == nullptr) {
+                    result_column->nullAt(i);
+                    continue;
+                }
+                state.clear();
+                sketch->serialize(state);
+                result_column->clearNullAt(i);
+                result_column->SetValueAt<std::string>(i, state);
+            }
+        }
+        destroy(folly::Range<char**>(groups, numGroups));
+    }
+
+    void
+    serializeAccumulatorExtra(char* group, std::string& out) override {
+        auto* sketch = *value<TSketch*>(group);
+        if (sketch == nullptr) {
+            serializeOwnedString(nullptr, out);
+            return;
+        }
+        std::string state;
+        sketch->serialize(state);
+        serializeOwnedString(&state, out);
+    }
+
+    size_t
+    deserializeAccumulatorExtra(char* group,
+                                const char* data,
+                                size_t size) override {
+        std::string* state = nullptr;
+        auto consumed = deserializeOwnedString(data, size, state);
+        auto& sketch = *value<TSketch*>(group);
+        sketch = nullptr;
+        if (state != nullptr) {
+            sketch = new TSketch(TSketch::deserialize(*state));
+            delete state;
+        }
+        return consumed;
+    }
+
+    void
+    destroy(folly::Range<char**> groups) override {
+        for (auto* group : groups) {
+            auto& sketch = *value<TSketch*>(group);
+            delete sketch;
+            sketch = nullptr;
+        }
+    }
+
+ protected:
+    void
+    initializeNewGroupsInternal(
+        char** groups, folly::Range<const vector_size_t*> indices) override {
+        setAllNulls(groups, indices);
+        for (auto i : indices) {
+            *value<TSketch*>(groups[i]) = nullptr;
+        }
+    }
+
+    // The sketch of 'group', created on first use.
+    TSketch&
+    sketchOf(char* group) {
+        auto& sketch = *value<TSketch*>(group);
+        if (sketch == nullptr) {
+            clearNull(group);
+            sketch = new TSketch();
+        }
+        return *sketch;
+    }
+
+    const AggregateStep step_;
+
+ private:
+    template <typename GetSketch>
+    void
+    addInput(const std::vector<VectorPtr>& input, GetSketch getSketch) {
+        AssertInfo(input.size() == 1,
+                   "sketch aggregate expects exactly one input column");
+        auto column = std::dynamic_pointer_cast<ColumnVector>(input[0]);
+        AssertInfo(column != nullptr,
+                   "sketch aggregate input must be of type ColumnVector");
+        if (isRawInputStep(step_)) {
+            static_cast<Derived*>(this)->addRawValues(column, getSketch);
+            return;
+        }
+        auto states = column->RawAsValues<std::string>();
+        for (auto i = 0; i < column->size(); i++) {
+            if (!column->ValidAt(i)) {
+                continue;
+            }
+            getSketch(i).merge(TSketch::deserialize(states[i]));
+        }
+    }
+};
+
+// Registers 'name' for the single step along with its '_partial',
+// '_merge' and '_merge_extract' companions. 'factory' builds the aggregate
+// for a step and the raw input type.
+template <typename Factory>
+void
+registerSketchAggregate(const std::string& name, Factory factory) {
+    const std::vector<std::pair<std::string, AggregateStep>> steps = {
+        {name, AggregateStep::kSingle},
+        {name + kPartialSuffix, AggregateStep::kPartial},
+        {name + kMergeSuffix, AggregateStep::kIntermediate},
+        {name + kMergeExtractSuffix, AggregateStep::kFinal},
+    };
+    for (const auto& [functionName, step] : steps) {
+        registerAggregateFunction(
+            functionName,
+            [functionName = functionName, step = step, factory](
+                const std::vector<DataType>& argumentTypes,
+                const QueryConfig& /*config*/) -> std::unique_ptr<Aggregate> {
+                AssertInfo(argumentTypes.size() == 1,
+                           "function:{} only accept one argument",
+                           functionName);
+                return factory(step, argumentTypes[0]);
+            });
+    }
+}
+
+void
+registerApproxCountDistinctAggregate();
+
+void
+registerApproxPercentileAggregates();
+
+}  // namespace exec
+}  // namespace milvus
@@ -63,6 +63,21 @@ class SumAggregateBase
             group, input[0], &updateSingleValue<TAccumulator>);
     }
 
+    void
+    addIntermediateResults(char** groups,
+                           char** sources,
+                           int32_t numGroups) override {
+        for (auto i = 0; i < numGroups; i++) {
+            if (Aggregate::isNullFlagSet(sources[i])) {
+                continue;
+            }
+            BaseAggregate::template updateNonNullValue<true, TAccumulator>(
+                groups[i],
+                *Aggregate::template value<TAccumulator>(sources[i]),
+                &updateSingleValue<TAccumulator>);
+        }
+    }
+
     void
     initializeNewGroupsInternal(
         char** groups, folly::Range<const vector_size_t*> indices) override {
@@ -0,0 +1,176 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "TDigest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "common/EasyAssert.h"
+
+namespace milvus {
+namespace exec {
+
+void
+TDigest::add(double value) {
+    if (std::isnan(value)) {
+        return;
+    }
+    buffer_.push_back(value);
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    if (buffer_.size() >= kBufferSize) {
+        compress();
+    }
+}
+
+void
+TDigest::merge(const TDigest& other) {
+    for (auto value : other.buffer_) {
+        add(value);
+    }
+    if (other.centroids_.empty()) {
+        return;
+    }
+    compress();
+    centroids_.insert(
+        centroids_.end(), other.centroids_.begin(), other.centroids_.end());
+    totalWeight_ += other.totalWeight_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    compress();
+}
+
+void
+TDigest::compress() {
+    if (buffer_.empty() && centroids_.size() <= 1) {
+        return;
+    }
+    for (auto value : buffer_) {
+        centroids_.push_back({value, 1});
+    }
+    totalWeight_ += buffer_.size();
+    buffer_.clear();
+    std::sort(centroids_.begin(),
+              centroids_.end(),
+              [](const Centroid& a, const Centroid& b) {
+                  return a.mean < b.mean;
+              });
+
+    size_t last = 0;
+    double weightSoFar = 0;
+    for (size_t i = 1; i < centroids_.size(); i++) {
+        auto& current = centroids_[last];
+        const auto& next = centroids_[i];
+        const double proposed = current.weight + next.weight;
+        const double q = (weightSoFar + proposed / 2) / totalWeight_;
+        const double limit = 4 * totalWeight_ * q * (1 - q) / kCompression;
+        if (proposed <= std::max(limit, 1.0)) {
+            current.mean += (next.mean - current.mean) * next.weight / proposed;
+            current.weight = proposed;
+        } else {
+            weightSoFar += current.weight;
+            centroids_[++last] = next;
+        }
+    }
+    centroids_.resize(last + 1);
+}
+
+double
+TDigest::quantile(double fraction) {
+    AssertInfo(fraction >= 0 && fraction <= 1,
+               "Quantile fraction {} is out of [0, 1]",
+               fraction);
+    compress();
+    AssertInfo(!centroids_.empty(), "Quantile of an empty t-digest");
+    if (centroids_.size() == 1) {
+        return centroids_[0].mean;
+    }
+    const double target = fraction * totalWeight_;
+    // Interpolate between centroid centers, treating min and max as the
+    // centers of the outermost halves.
+    const auto& first = centroids_.front();
+    if (target < first.weight / 2) {
+        return min_ + (first.mean - min_) * target / (first.weight / 2);
+    }
+    double cumulative = first.weight / 2;
+    for (size_t i = 1; i < centroids_.size(); i++) {
+        const auto& left = centroids_[i - 1];
+        const auto& right = centroids_[i];
+        const double step = (left.weight + right.weight) / 2;
+        if (target < cumulative + step) {
+            return left.mean +
+                   (right.mean - left.mean) * (target - cumulative) / step;
+        }
+        cumulative += step;
+    }
+    const auto& lastCentroid = centroids_.back();
+    const double tail = lastCentroid.weight / 2;
+    return lastCentroid.mean + (max_ - lastCentroid.mean) *
+                                   std::min(1.0, (target - cumulative) / tail);
+}
+
+void
+TDigest::serialize(std::string& out) {
+    compress();
+    out.push_back(static_cast<char>(kVersion));
+    out.append(reinterpret_cast<const char*>(&min_), sizeof(min_));
+    out.append(reinterpret_cast<const char*>(&max_), sizeof(max_));
+    auto count = static_cast<uint32_t>(centroids_.size());
+    out.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const auto& centroid : centroids_) {
+        out.append(reinterpret_cast<const char*>(&centroid.mean),
+                   sizeof(centroid.mean));
+        out.append(reinterpret_cast<const char*>(&centroid.weight),
+                   sizeof(centroid.weight));
+    }
+}
+
+TDigest
+TDigest::deserialize(std::string_view data) {
+    constexpr size_t kHeaderSize =
+        1 + 2 * sizeof(double) + sizeof(uint32_t);
+    AssertInfo(data.size() >= kHeaderSize, "Truncated t-digest");
+    AssertInfo(static_cast<uint8_t>(data[0]) == kVersion,
+               "Unsupported t-digest version {}",
+               static_cast<int>(data[0]));
+    TDigest digest;
+    size_t pos = 1;
+    std::memcpy(&digest.min_, data.data() + pos, sizeof(double));
+    pos += sizeof(double);
+    std::memcpy(&digest.max_, data.data() + pos, sizeof(double));
+    pos += sizeof(double);
+    uint32_t count = 0;
+    std::memcpy(&count, data.data() + pos, sizeof(count));
+    pos += sizeof(count);
+    AssertInfo(data.size() - pos == count * 2 * sizeof(double),
+               "Malformed t-digest of {} centroids",
+               count);
+    digest.centroids_.resize(count);
+    for (auto& centroid : digest.centroids_) {
+        std::memcpy(&centroid.mean, data.data() + pos, sizeof(double));
+        pos += sizeof(double);
+        std::memcpy(&centroid.weight, data.data() + pos, sizeof(double));
+        pos += sizeof(double);
+        AssertInfo(centroid.weight > 0, "Malformed t-digest centroid weight");
+        digest.totalWeight_ += centroid.weight;
+    }
+    return digest;
+}
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,85 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace milvus {
+namespace exec {
+
+// Merging t-digest estimating quantiles of the values added to it, used by
+// the approx_percentile aggregates.
+//
+// Values are buffered and periodically folded into centroids whose weight
+// is bounded by 4 * n * q * (1 - q) / kCompression, so the digest stays
+// within a few hundred centroids and is most accurate at the tails.
+//
+// Serialized layout, also the intermediate state exchanged between
+// partial and final aggregation:
+//   [version (uint8)][min (double)][max (double)][count (uint32)]
+//   [mean (double)][weight (double)] * count
+class TDigest {
+ public:
+    static constexpr double kCompression = 100;
+
+    void
+    add(double value);
+
+    void
+    merge(const TDigest& other);
+
+    // Returns the estimated value at 'fraction', in [0, 1].
+    double
+    quantile(double fraction);
+
+    double
+    totalWeight() const {
+        return totalWeight_ + buffer_.size();
+    }
+
+    void
+    serialize(std::string& out);
+
+    static TDigest
+    deserialize(std::string_view data);
+
+ private:
+    static constexpr uint8_t kVersion = 1;
+    static constexpr size_t kBufferSize = 5 * static_cast<size_t>(kCompression);
+
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    // Folds the buffered values into the centroids.
+    void
+    compress();
+
+    std::vector<Centroid> centroids_;
+    double totalWeight_{0};
+    std::vector<double> buffer_;
+    double min_{std::numeric_limits<double>::infinity()};
+    double max_{-std::numeric_limits<double>::infinity()};
+};
+
+}  // namespace exec
+}  // namespace milvus
@@ -272,13 +272,13 @@ class SealedDataGetter : public DataGetter<OutputType> {
                     std::is_same_v<OutputType, InnerRawType>,
                     "OutputType and InnerRawType must be the same for "
                     "non-json/string field group by");
-                auto pw = segment_.chunk_data<InnerRawType>(
-                    op_ctx_, field_id_, chunk_id);
+                auto pw = segment_.chunk_rows<InnerRawType>(
+                    op_ctx_, field_id_, chunk_id, inner_offset, 1);
                 auto& span = pw.get();
-                if (span.valid_data() && !span.valid_data()[inner_offset]) {
+                if (span.valid_data() && !span.valid_data()[0]) {
                     return std::nullopt;
                 }
-                auto raw = span.operator[](inner_offset);
+                auto raw = span.operator[](0);
                 return raw;
             }
         } else {
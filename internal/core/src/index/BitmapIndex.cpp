@@ -19,6 +19,8 @@
 #include <boost/algorithm/string.hpp>
 #include <folly/ScopeGuard.h>
 #include <optional>
+#include <tuple>
+#include <vector>
 #include <sys/errno.h>
 #include <unistd.h>
 #include <yaml-cpp/yaml.h>
@@ -398,12 +400,57 @@ TargetBitmap
 BitmapIndex<T>::ConvertRoaringToBitset(const roaring::Roaring& values) {
     AssertInfo(total_num_rows_ != 0, "total num rows should not be 0");
     TargetBitmap res(total_num_rows_, false);
-    for (const auto& val : values) {
-        res.set(val);
+    if (values.isEmpty()) {
+        return res;
     }
+    // Roaring expands its containers into words a whole container at a
+    // time, which is much faster than setting the rows one by one. Its
+    // words have the layout of TargetBitmap's.
+    auto bits = bitset_create_with_capacity(total_num_rows_);
+    AssertInfo(bits != nullptr, "failed to allocate bitset");
+    auto free_bits = folly::makeGuard([bits]() { bitset_free(bits); });
+    AssertInfo(roaring_bitmap_to_bitset(&values.roaring, bits),
+               "failed to convert roaring bitmap to bitset");
+    auto copy_bytes =
+        std::min(bits->arraysize * sizeof(uint64_t), res.size_in_bytes());
+    milvus::fastmem::FastMemcpy(res.data(), bits->array, copy_bytes);
     return res;
 }
 
+template <typename T>
+TargetBitmap
+BitmapIndex<T>::UnionToBitset(
+    const std::vector<const roaring::Roaring*>& postings) {
+    if (postings.empty()) {
+        return TargetBitmap(total_num_rows_, false);
+    }
+    if (postings.size() == 1) {
+        return ConvertRoaringToBitset(*postings[0]);
+    }
+    return ConvertRoaringToBitset(
+        roaring::Roaring::fastunion(postings.size(), postings.data()));
+}
+
+template <typename T>
+TargetBitmap
+BitmapIndex<T>::UnionMmapPostings(size_t begin, size_t end) {
+    std::vector<const roaring::Roaring*> postings;
+    for (auto i = begin; i < end; ++i) {
+        postings.push_back(&mmap_postings_[i]);
+    }
+    return UnionToBitset(postings);
+}
+
+template <typename T>
+size_t
+BitmapIndex<T>::MmapKeyBound(const T& value, bool upper) const {
+    auto it = upper ? std::upper_bound(
+                          mmap_keys_.begin(), mmap_keys_.end(), value)
+                    : std::lower_bound(
+                          mmap_keys_.begin(), mmap_keys_.end(), value);
+    return it - mmap_keys_.begin();
+}
+
 template <typename T>
 std::pair<size_t, size_t>
 BitmapIndex<T>::DeserializeIndexMeta(const uint8_t* data_ptr,
@@ -476,10 +523,9 @@ void
 BitmapIndex<T>::BuildOffsetCache() {
     if (is_mmap_) {
         mmap_offsets_cache_.resize(total_num_rows_);
-        for (auto it = bitmap_info_map_.begin(); it != bitmap_info_map_.end();
-             ++it) {
-            for (const auto& v : it->second) {
-                mmap_offsets_cache_[v] = it;
+        for (size_t i = 0; i < mmap_postings_.size(); ++i) {
+            for (const auto& v : mmap_postings_[i]) {
+                mmap_offsets_cache_[v] = i;
             }
         }
     } else {
@@ -573,7 +619,9 @@ BitmapIndex<T>::MMapIndexData(const std::string& file_name,
         std::filesystem::path(file_name).parent_path());
 
     auto file_offset = 0;
-    std::map<T, std::pair<int32_t, int32_t>> bitmaps;
+    // key, offset and size of each frozen posting in the file
+    std::vector<std::tuple<T, int32_t, int32_t>> bitmaps;
+    bitmaps.reserve(index_length);
     {
         auto file_writer = storage::FileWriter(
             file_name, storage::io::GetPriorityFromLoadPriority(priority));
@@ -597,7 +645,7 @@ BitmapIndex<T>::MMapIndexData(const std::string& file_name,
             value.writeFrozen(reinterpret_cast<char*>(buf.data()));
 
             file_writer.Write(buf.data(), aligned_size);
-            bitmaps[key] = {file_offset, frozen_size};
+            bitmaps.emplace_back(std::move(key), file_offset, frozen_size);
 
             file_offset += aligned_size;
             data_ptr += value.getSizeInBytes();
@@ -618,11 +666,17 @@ BitmapIndex<T>::MMapIndexData(const std::string& file_name,
     mmap_size_ = file_offset;
     this->mmap_file_raii_ = std::make_unique<MmapFileRAII>(file_name);
 
+    // Postings are serialized in key order, so this is only a check.
+    if (!std::is_sorted(bitmaps.begin(), bitmaps.end())) {
+        std::sort(bitmaps.begin(), bitmaps.end());
+    }
     char* ptr = mmap_data_;
-    for (const auto& [key, value] : bitmaps) {
-        const auto& [offset, size] = value;
-        bitmap_info_map_[key] =
-            roaring::Roaring::frozenView(ptr + offset, size);
+    mmap_keys_.reserve(bitmaps.size());
+    mmap_postings_.reserve(bitmaps.size());
+    for (auto& [key, offset, size] : bitmaps) {
+        mmap_keys_.push_back(std::move(key));
+        mmap_postings_.push_back(
+            roaring::Roaring::frozenView(ptr + offset, size));
     }
     is_mmap_ = true;
 }
@@ -727,10 +781,9 @@ BitmapIndex<T>::In(const size_t n, const T* values) {
 
     if (is_mmap_) {
         for (size_t i = 0; i < n; ++i) {
-            const auto& val = values[i];
-            auto it = bitmap_info_map_.find(val);
-            if (it != bitmap_info_map_.end()) {
-                for (const auto& v : it->second) {
+            auto pos = MmapKeyBound(values[i], false);
+            if (pos < mmap_keys_.size() && mmap_keys_[pos] == values[i]) {
+                for (const auto& v : mmap_postings_[pos]) {
                     res.set(v);
                 }
             }
@@ -769,10 +822,9 @@ BitmapIndex<T>::NotIn(const size_t n, const T* values) {
     if (is_mmap_) {
         TargetBitmap res(total_num_rows_, true);
         for (int i = 0; i < n; ++i) {
-            const auto& val = values[i];
-            auto it = bitmap_info_map_.find(val);
-            if (it != bitmap_info_map_.end()) {
-                for (const auto& v : it->second) {
+            auto pos = MmapKeyBound(values[i], false);
+            if (pos < mmap_keys_.size() && mmap_keys_[pos] == values[i]) {
+                for (const auto& v : mmap_postings_[pos]) {
                     res.reset(v);
                 }
             }
@@ -914,48 +966,26 @@ BitmapIndex<T>::RangeForMmap(const T& value, const OpType op) {
     tracer::AutoSpan span("BitmapIndex::RangeForMmap", tracer::GetRootSpan());
 
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmap res(total_num_rows_, false);
     if (ShouldSkip(value, value, op)) {
-        return res;
+        return TargetBitmap(total_num_rows_, false);
     }
-    auto lb = bitmap_info_map_.begin();
-    auto ub = bitmap_info_map_.end();
-
+    size_t lb = 0;
+    size_t ub = mmap_keys_.size();
     switch (op) {
         case OpType::LessThan: {
-            ub = std::lower_bound(bitmap_info_map_.begin(),
-                                  bitmap_info_map_.end(),
-                                  std::make_pair(value, TargetBitmap()),
-                                  [](const auto& lhs, const auto& rhs) {
-                                      return lhs.first < rhs.first;
-                                  });
+            ub = MmapKeyBound(value, false);
             break;
         }
         case OpType::LessEqual: {
-            ub = std::upper_bound(bitmap_info_map_.begin(),
-                                  bitmap_info_map_.end(),
-                                  std::make_pair(value, TargetBitmap()),
-                                  [](const auto& lhs, const auto& rhs) {
-                                      return lhs.first < rhs.first;
-                                  });
+            ub = MmapKeyBound(value, true);
             break;
         }
         case OpType::GreaterThan: {
-            lb = std::upper_bound(bitmap_info_map_.begin(),
-                                  bitmap_info_map_.end(),
-                                  std::make_pair(value, TargetBitmap()),
-                                  [](const auto& lhs, const auto& rhs) {
-                                      return lhs.first < rhs.first;
-                                  });
+            lb = MmapKeyBound(value, true);
             break;
         }
         case OpType::GreaterEqual: {
-            lb = std::lower_bound(bitmap_info_map_.begin(),
-                                  bitmap_info_map_.end(),
-                                  std::make_pair(value, TargetBitmap()),
-                                  [](const auto& lhs, const auto& rhs) {
-                                      return lhs.first < rhs.first;
-                                  });
+            lb = MmapKeyBound(value, false);
             break;
         }
         default: {
@@ -963,13 +993,7 @@ BitmapIndex<T>::RangeForMmap(const T& value, const OpType op) {
                       fmt::format("Invalid OperatorType: {}", op));
         }
     }
-
-    for (; lb != ub; lb++) {
-        for (const auto& v : lb->second) {
-            res.set(v);
-        }
-    }
-    return res;
+    return UnionMmapPostings(lb, ub);
 }
 
 template <typename T>
@@ -1028,12 +1052,11 @@ BitmapIndex<T>::RangeForRoaring(const T& value, const OpType op) {
         }
     }
 
+    std::vector<const roaring::Roaring*> postings;
     for (; lb != ub; lb++) {
-        for (const auto& v : lb->second) {
-            res.set(v);
-        }
+        postings.push_back(&lb->second);
     }
-    return res;
+    return UnionToBitset(postings);
 }
 
 template <typename T>
@@ -1123,56 +1146,17 @@ BitmapIndex<T>::RangeForMmap(const T& lower_value,
     tracer::AutoSpan span("BitmapIndex::RangeForMmap", tracer::GetRootSpan());
 
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmap res(total_num_rows_, false);
     if (lower_value > upper_value ||
         (lower_value == upper_value && !(lb_inclusive && ub_inclusive))) {
-        return res;
+        return TargetBitmap(total_num_rows_, false);
     }
     if (ShouldSkip(lower_value, upper_value, OpType::Range)) {
-        return res;
-    }
-
-    auto lb = bitmap_info_map_.begin();
-    auto ub = bitmap_info_map_.end();
-
-    if (lb_inclusive) {
-        lb = std::lower_bound(bitmap_info_map_.begin(),
-                              bitmap_info_map_.end(),
-                              std::make_pair(lower_value, TargetBitmap()),
-                              [](const auto& lhs, const auto& rhs) {
-                                  return lhs.first < rhs.first;
-                              });
-    } else {
-        lb = std::upper_bound(bitmap_info_map_.begin(),
-                              bitmap_info_map_.end(),
-                              std::make_pair(lower_value, TargetBitmap()),
-                              [](const auto& lhs, const auto& rhs) {
-                                  return lhs.first < rhs.first;
-                              });
+        return TargetBitmap(total_num_rows_, false);
     }
 
-    if (ub_inclusive) {
-        ub = std::upper_bound(bitmap_info_map_.begin(),
-                              bitmap_info_map_.end(),
-                              std::make_pair(upper_value, TargetBitmap()),
-                              [](const auto& lhs, const auto& rhs) {
-                                  return lhs.first < rhs.first;
-                              });
-    } else {
-        ub = std::lower_bound(bitmap_info_map_.begin(),
-                              bitmap_info_map_.end(),
-                              std::make_pair(upper_value, TargetBitmap()),
-                              [](const auto& lhs, const auto& rhs) {
-                                  return lhs.first < rhs.first;
-                              });
-    }
-
-    for (; lb != ub; lb++) {
-        for (const auto& v : lb->second) {
-            res.set(v);
-        }
-    }
-    return res;
+    auto lb = MmapKeyBound(lower_value, !lb_inclusive);
+    auto ub = MmapKeyBound(upper_value, ub_inclusive);
+    return UnionMmapPostings(lb, ub);
 }
 
 template <typename T>
@@ -1229,12 +1213,11 @@ BitmapIndex<T>::RangeForRoaring(const T& lower_value,
                               });
     }
 
+    std::vector<const roaring::Roaring*> postings;
     for (; lb != ub; lb++) {
-        for (const auto& v : lb->second) {
-            res.set(v);
-        }
+        postings.push_back(&lb->second);
     }
-    return res;
+    return UnionToBitset(postings);
 }
 
 template <typename T>
@@ -1242,7 +1225,7 @@ T
 BitmapIndex<T>::Reverse_Lookup_InCache(size_t idx) const {
     if (is_mmap_) {
         Assert(build_mode_ == BitmapIndexBuildMode::ROARING);
-        return mmap_offsets_cache_[idx]->first;
+        return mmap_keys_[mmap_offsets_cache_[idx]];
     }
 
     if (build_mode_ == BitmapIndexBuildMode::ROARING) {
@@ -1268,10 +1251,9 @@ BitmapIndex<T>::Reverse_Lookup(size_t idx) const {
     }
 
     if (is_mmap_) {
-        for (auto it = bitmap_info_map_.begin(); it != bitmap_info_map_.end();
-             it++) {
-            if (it->second.contains(idx)) {
-                return it->first;
+        for (size_t i = 0; i < mmap_postings_.size(); ++i) {
+            if (mmap_postings_[i].contains(idx)) {
+                return mmap_keys_[i];
             }
         }
     } else {
@@ -1340,9 +1322,9 @@ BitmapIndex<T>::ShouldSkip(const T lower_value,
     };
 
     if (is_mmap_) {
-        if (!bitmap_info_map_.empty()) {
-            auto lower_bound = bitmap_info_map_.begin()->first;
-            auto upper_bound = bitmap_info_map_.rbegin()->first;
+        if (!mmap_keys_.empty()) {
+            auto lower_bound = mmap_keys_.front();
+            auto upper_bound = mmap_keys_.back();
             bool should_skip = skip(op, lower_bound, upper_bound);
             return should_skip;
         }
@@ -1382,11 +1364,9 @@ BitmapIndex<std::string>::Query(const DatasetPtr& dataset) {
     auto val = dataset->Get<std::string>(MATCH_VALUE);
     TargetBitmap res(total_num_rows_, false);
     if (is_mmap_) {
-        for (auto it = bitmap_info_map_.begin(); it != bitmap_info_map_.end();
-             ++it) {
-            const auto& key = it->first;
-            if (milvus::query::Match(key, val, op)) {
-                for (const auto& v : it->second) {
+        for (size_t i = 0; i < mmap_keys_.size(); ++i) {
+            if (milvus::query::Match(mmap_keys_[i], val, op)) {
+                for (const auto& v : mmap_postings_[i]) {
                     res.set(v);
                 }
             }
@@ -19,6 +19,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include <roaring/roaring.hh>
 
 #include "common/RegexQuery.h"
@@ -131,17 +132,14 @@ class BitmapIndex : public ScalarIndex<T> {
         if (is_mmap_) {
             // mmap mode
             total += mmap_size_;
-            // bitmap_info_map_ overhead (keys and roaring metadata in memory)
-            size_t num_entries = bitmap_info_map_.size();
+            // flat keys and roaring views into the mapped postings
+            total += mmap_keys_.capacity() * sizeof(T);
             if constexpr (std::is_same_v<T, std::string>) {
-                for (const auto& [key, bitmap] : bitmap_info_map_) {
+                for (const auto& key : mmap_keys_) {
                     total += key.capacity();
                 }
-            } else {
-                total += num_entries * sizeof(T);
             }
-            // roaring metadata + map node overhead per entry
-            total += num_entries * (sizeof(roaring::Roaring) + 40);
+            total += mmap_postings_.capacity() * sizeof(roaring::Roaring);
         } else if (build_mode_ == BitmapIndexBuildMode::ROARING) {
             // data_: map<T, roaring::Roaring>
             for (const auto& [key, bitmap] : data_) {
@@ -237,9 +235,9 @@ class BitmapIndex : public ScalarIndex<T> {
                     PartialRegexMatcher matcher(pattern);
                     TargetBitmap res(total_num_rows_, false);
                     if (is_mmap_) {
-                        for (const auto& [key, bitmap] : bitmap_info_map_) {
-                            if (matcher(key)) {
-                                for (const auto& v : bitmap) {
+                        for (size_t i = 0; i < mmap_keys_.size(); ++i) {
+                            if (matcher(mmap_keys_[i])) {
+                                for (const auto& v : mmap_postings_[i]) {
                                     res.set(v);
                                 }
                             }
@@ -283,9 +281,9 @@ class BitmapIndex : public ScalarIndex<T> {
         LikePatternMatcher matcher(pattern);
         TargetBitmap res(total_num_rows_, false);
         if (is_mmap_) {
-            for (const auto& [key, bitmap] : bitmap_info_map_) {
-                if (matcher(key)) {
-                    for (const auto& v : bitmap) {
+            for (size_t i = 0; i < mmap_keys_.size(); ++i) {
+                if (matcher(mmap_keys_[i])) {
+                    for (const auto& v : mmap_postings_[i]) {
                         res.set(v);
                     }
                 }
@@ -312,7 +310,7 @@ class BitmapIndex : public ScalarIndex<T> {
     int64_t
     Cardinality() {
         if (is_mmap_) {
-            return bitmap_info_map_.size();
+            return mmap_keys_.size();
         }
 
         if (build_mode_ == BitmapIndexBuildMode::ROARING) {
@@ -384,6 +382,19 @@ class BitmapIndex : public ScalarIndex<T> {
     TargetBitmap
     ConvertRoaringToBitset(const roaring::Roaring& values);
 
+    // Rows in any of 'postings', from one roaring union.
+    TargetBitmap
+    UnionToBitset(const std::vector<const roaring::Roaring*>& postings);
+
+    // Rows of the mmap postings in [begin, end), as one union.
+    TargetBitmap
+    UnionMmapPostings(size_t begin, size_t end);
+
+    // Position of the first mmap key not less than (or, with 'upper',
+    // greater than) 'value'.
+    size_t
+    MmapKeyBound(const T& value, bool upper) const;
+
     TargetBitmap
     RangeForRoaring(const T& value, OpType op);
 
@@ -442,7 +453,11 @@ class BitmapIndex : public ScalarIndex<T> {
     bool is_nested_index_{false};
     char* mmap_data_;
     int64_t mmap_size_;
-    std::map<T, roaring::Roaring> bitmap_info_map_;
+    // mmap mode postings: the distinct keys in order, and at the same
+    // positions frozen roaring views into mmap_data_. Flat arrays keep the
+    // per-key overhead to a roaring header, and a key range is a slice.
+    std::vector<T> mmap_keys_;
+    std::vector<roaring::Roaring> mmap_postings_;
     size_t total_num_rows_{0};
     proto::schema::FieldSchema schema_;
     bool use_offset_cache_{false};
@@ -450,8 +465,8 @@ class BitmapIndex : public ScalarIndex<T> {
         data_offsets_cache_;
     std::vector<typename std::map<T, TargetBitmap>::iterator>
         bitsets_offsets_cache_;
-    std::vector<typename std::map<T, roaring::Roaring>::iterator>
-        mmap_offsets_cache_;
+    // position in mmap_keys_ of the key of each row
+    std::vector<uint32_t> mmap_offsets_cache_;
 
     // generate valid_bitset to speed up NotIn and IsNull and IsNotNull operate
     TargetBitmap valid_bitset_;
@@ -17,6 +17,7 @@
 #include <nlohmann/json.hpp>
 #include <stdint.h>
 #include <stdlib.h>
+#include <algorithm>
 #include <cstddef>
 #include <functional>
 #include <memory>
@@ -214,6 +215,8 @@ class BitmapIndexTest : public testing::Test {
         index_ =
             index::IndexFactory::GetInstance().CreateIndex(index_info, ctx);
         index_->LoadUnified(config);
+        ctx_ = ctx;
+        load_config_ = config;
     }
 
     virtual void
@@ -524,6 +527,57 @@ class BitmapIndexTest : public testing::Test {
         }
     }
 
+    // Loads the same index files into memory and checks that the mmapped
+    // index answers every query the same way.
+    void
+    TestMmapMatchesMemory() {
+        ASSERT_TRUE(is_mmap_);
+        auto config = load_config_;
+        config.erase(milvus::index::MMAP_FILE_PATH);
+        config.erase("enable_mmap");
+        index::CreateIndexInfo index_info{};
+        index_info.index_type = milvus::index::BITMAP_INDEX_TYPE;
+        index_info.field_type = type_;
+        auto memory_index =
+            index::IndexFactory::GetInstance().CreateIndex(index_info, ctx_);
+        memory_index->LoadUnified(config);
+
+        auto mmapped = dynamic_cast<index::BitmapIndex<T>*>(index_.get());
+        auto in_memory =
+            dynamic_cast<index::BitmapIndex<T>*>(memory_index.get());
+        ASSERT_EQ(mmapped->Count(), in_memory->Count());
+        auto same = [](TargetBitmap a, TargetBitmap b) { return a == b; };
+
+        boost::container::vector<T> values;
+        for (size_t i = 0; i < 10; i++) {
+            values.push_back(data_[i]);
+        }
+        ASSERT_TRUE(same(mmapped->In(values.size(), values.data()),
+                         in_memory->In(values.size(), values.data())));
+        ASSERT_TRUE(same(mmapped->NotIn(values.size(), values.data()),
+                         in_memory->NotIn(values.size(), values.data())));
+
+        for (auto op : {OpType::GreaterThan,
+                        OpType::GreaterEqual,
+                        OpType::LessThan,
+                        OpType::LessEqual}) {
+            ASSERT_TRUE(same(mmapped->Range(data_[0], op),
+                             in_memory->Range(data_[0], op)))
+                << "op: " << op;
+        }
+        auto lower = std::min(data_[0], data_[1]);
+        auto upper = std::max(data_[0], data_[1]);
+        for (auto lower_inclusive : {false, true}) {
+            for (auto upper_inclusive : {false, true}) {
+                ASSERT_TRUE(same(
+                    mmapped->Range(
+                        lower, lower_inclusive, upper, upper_inclusive),
+                    in_memory->Range(
+                        lower, lower_inclusive, upper, upper_inclusive)));
+            }
+        }
+    }
+
     void
     TestPatternMatchFunc() {
         if constexpr (std::is_same_v<T, std::string>) {
@@ -572,6 +626,8 @@ class BitmapIndexTest : public testing::Test {
     bool has_default_value_{false};
     bool has_lack_binlog_row_{false};
     size_t lack_binlog_row_{100};
+    storage::FileManagerContext ctx_;
+    Config load_config_;
 };
 
 TYPED_TEST_SUITE_P(BitmapIndexTest);
@@ -727,6 +783,10 @@ TYPED_TEST_P(BitmapIndexTestV3, TestRangeCompareFuncTest) {
     this->TestRangeCompareFunc();
 }
 
+TYPED_TEST_P(BitmapIndexTestV3, MmapMatchesMemoryFuncTest) {
+    this->TestMmapMatchesMemory();
+}
+
 TYPED_TEST_P(BitmapIndexTestV3, IsNullFuncTest) {
     this->TestIsNullFunc();
 }
@@ -748,6 +808,7 @@ REGISTER_TYPED_TEST_SUITE_P(BitmapIndexTestV3,
                             NotINFuncTest,
                             CompareValFuncTest,
                             TestRangeCompareFuncTest,
+                            MmapMatchesMemoryFuncTest,
                             IsNullFuncTest,
                             IsNotNullFuncTest,
                             PatternMatchFuncTest);
@@ -867,6 +928,10 @@ TYPED_TEST_P(BitmapIndexTestV5, TestRangeCompareFuncTest) {
     this->TestRangeCompareFunc();
 }
 
+TYPED_TEST_P(BitmapIndexTestV5, MmapMatchesMemoryFuncTest) {
+    this->TestMmapMatchesMemory();
+}
+
 TYPED_TEST_P(BitmapIndexTestV5, IsNullFuncTest) {
     this->TestIsNullFunc();
 }
@@ -884,6 +949,7 @@ REGISTER_TYPED_TEST_SUITE_P(BitmapIndexTestV5,
                             NotINFuncTest,
                             CompareValFuncTest,
                             TestRangeCompareFuncTest,
+                            MmapMatchesMemoryFuncTest,
                             IsNullFuncTest,
                             IsNotNullFuncTest);
 
@@ -24,6 +24,10 @@ const cachinglayer::PinWrapper<const index::FieldChunkMetrics*>
 SkipIndex::GetFieldChunkMetrics(milvus::OpContext* op_ctx,
                                 milvus::FieldId field_id,
                                 int chunk_id) const {
+    if (page_metrics_ != nullptr) {
+        return cachinglayer::PinWrapper<const index::FieldChunkMetrics*>(
+            page_metrics_);
+    }
     // skip index structure must be setup before using, thus we do not lock here.
     auto field_metrics = fieldChunkMetrics_.find(field_id);
     if (field_metrics != fieldChunkMetrics_.end()) {
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 
@@ -456,6 +457,48 @@ class SkipIndex {
         return CanSkipInQuery<T>(nullptr, field_id, chunk_id, values);
     }
 
+    // Splits rows [begin, begin + size) of a chunk into runs of consecutive
+    // pages that 'skip_func' agrees to skip or not, judged on the page-level
+    // zone maps, and calls fn(run_begin, run_size, skipped) on each run in
+    // order. A chunk without pages is a single run that is not skipped.
+    template <typename SkipFunc, typename Fn>
+    void
+    ForEachPageRun(milvus::OpContext* op_ctx,
+                   FieldId field_id,
+                   int64_t chunk_id,
+                   int64_t begin,
+                   int64_t size,
+                   const SkipFunc& skip_func,
+                   Fn fn) const {
+        auto pw = GetFieldChunkMetrics(op_ctx, field_id, chunk_id);
+        auto field_chunk_metrics = pw.get();
+        auto page_rows = field_chunk_metrics->PageRows();
+        auto num_pages = static_cast<int64_t>(field_chunk_metrics->NumPages());
+        if (num_pages == 0 || page_rows <= 0) {
+            fn(begin, size, false);
+            return;
+        }
+        SkipIndex page_view;
+        const auto end = begin + size;
+        auto run_begin = begin;
+        bool run_skipped = false;
+        for (auto pos = begin; pos < end;) {
+            auto page_id = pos / page_rows;
+            bool skipped = false;
+            if (page_id < num_pages) {
+                page_view.page_metrics_ = &field_chunk_metrics->Page(page_id);
+                skipped = skip_func(page_view, field_id, chunk_id);
+            }
+            if (pos != begin && skipped != run_skipped) {
+                fn(run_begin, pos - run_begin, run_skipped);
+                run_begin = pos;
+            }
+            run_skipped = skipped;
+            pos = std::min(end, (page_id + 1) * page_rows);
+        }
+        fn(run_begin, end - run_begin, run_skipped);
+    }
+
     void
     LoadSkip(int64_t segment_id,
              milvus::FieldId field_id,
@@ -521,5 +564,8 @@ class SkipIndex {
         std::shared_ptr<cachinglayer::CacheSlot<index::FieldChunkMetrics>>>
         fieldChunkMetrics_;
     mutable std::shared_mutex mutex_;
+    // Set on the page views of ForEachPageRun, which answer every lookup
+    // with the metrics of one page.
+    const index::FieldChunkMetrics* page_metrics_{nullptr};
 };
 }  // namespace milvus
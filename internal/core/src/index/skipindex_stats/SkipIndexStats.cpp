@@ -17,6 +17,7 @@
 #include "index/skipindex_stats/SkipIndexStats.h"
 
 #include <cstdint>
+#include <memory>
 
 #include "arrow/array/array_primitive.h"
 #include "common/Span.h"
@@ -154,59 +155,80 @@ SkipIndexStatsBuilder::Build(DataType data_type, const Chunk* chunk) const {
     if (chunk == nullptr || chunk->RowNums() == 0) {
         return none_ptr;
     }
+    // Pages only carry min/max, so they are built without bloom filters.
+    const SkipIndexStatsBuilder page_builder;
     if (data_type == DataType::VARCHAR) {
         auto string_chunk = static_cast<const StringChunk*>(chunk);
-        metricsInfo<std::string> info = ProcessStringFieldMetrics(string_chunk);
-        return LoadMetrics<std::string>(info);
+        auto count = string_chunk->RowNums();
+        metricsInfo<std::string> info =
+            ProcessStringFieldMetrics(string_chunk, 0, count);
+        auto metrics = LoadMetrics<std::string>(info);
+        if (metrics->GetMetricsType() != FieldChunkMetricsType::NONE) {
+            metrics->SetPages(
+                page_rows_,
+                BuildPages(count, [&](int64_t begin, int64_t end) {
+                    return page_builder.LoadMetrics<std::string>(
+                        page_builder.ProcessStringFieldMetrics(
+                            string_chunk, begin, end));
+                }));
+        }
+        return metrics;
     }
     auto fixed_chunk = static_cast<const FixedWidthChunk*>(chunk);
-    auto span = fixed_chunk->Span();
-
-    const void* chunk_data = span.data();
-    const bool* valid_data = span.valid_data();
-    int64_t count = span.row_count();
+    const void* chunk_data = nullptr;
+    const bool* valid_data = nullptr;
+    int64_t count = 0;
+    // Decode packed chunks into a temporary buffer, so that building stats
+    // does not keep the chunk decoded.
+    std::unique_ptr<char[]> decoded;
+    if (fixed_chunk->IsPacked()) {
+        count = fixed_chunk->RowNums();
+        auto element_size =
+            data_type == DataType::INT32 ? sizeof(int32_t) : sizeof(int64_t);
+        decoded = std::make_unique<char[]>(count * element_size);
+        fixed_chunk->DecodePacked(0, count, decoded.get());
+        chunk_data = decoded.get();
+        valid_data = fixed_chunk->ValidData();
+    } else {
+        auto span = fixed_chunk->Span();
+        chunk_data = span.data();
+        valid_data = span.valid_data();
+        count = span.row_count();
+    }
+    auto build = [&](auto* typed_data) -> std::unique_ptr<FieldChunkMetrics> {
+        using T =
+            std::remove_const_t<std::remove_pointer_t<decltype(typed_data)>>;
+        auto metrics = LoadMetrics<T>(
+            ProcessFieldMetrics<T>(typed_data, valid_data, count));
+        if (metrics->GetMetricsType() == FieldChunkMetricsType::NONE) {
+            return metrics;
+        }
+        metrics->SetPages(
+            page_rows_,
+            BuildPages(count, [&](int64_t begin, int64_t end) {
+                return page_builder.LoadMetrics<T>(
+                    page_builder.ProcessFieldMetrics<T>(
+                        typed_data + begin,
+                        valid_data == nullptr ? nullptr : valid_data + begin,
+                        end - begin));
+            }));
+        return metrics;
+    };
     switch (data_type) {
-        case DataType::BOOL: {
-            const bool* typedData = static_cast<const bool*>(chunk_data);
-            auto info = ProcessFieldMetrics<bool>(typedData, valid_data, count);
-            return LoadMetrics<bool>(info);
-        }
-        case DataType::INT8: {
-            const int8_t* typedData = static_cast<const int8_t*>(chunk_data);
-            auto info =
-                ProcessFieldMetrics<int8_t>(typedData, valid_data, count);
-            return LoadMetrics<int8_t>(info);
-        }
-        case DataType::INT16: {
-            const int16_t* typedData = static_cast<const int16_t*>(chunk_data);
-            auto info =
-                ProcessFieldMetrics<int16_t>(typedData, valid_data, count);
-            return LoadMetrics<int16_t>(info);
-        }
-        case DataType::INT32: {
-            const int32_t* typedData = static_cast<const int32_t*>(chunk_data);
-            auto info =
-                ProcessFieldMetrics<int32_t>(typedData, valid_data, count);
-            return LoadMetrics<int32_t>(info);
-        }
-        case DataType::INT64: {
-            const int64_t* typedData = static_cast<const int64_t*>(chunk_data);
-            auto info =
-                ProcessFieldMetrics<int64_t>(typedData, valid_data, count);
-            return LoadMetrics<int64_t>(info);
-        }
-        case DataType::FLOAT: {
-            const float* typedData = static_cast<const float*>(chunk_data);
-            auto info =
-                ProcessFieldMetrics<float>(typedData, valid_data, count);
-            return LoadMetrics<float>(info);
-        }
-        case DataType::DOUBLE: {
-            const double* typedData = static_cast<const double*>(chunk_data);
-            auto info =
-                ProcessFieldMetrics<double>(typedData, valid_data, count);
-            return LoadMetrics<double>(info);
-        }
+        case DataType::BOOL:
+            return build(static_cast<const bool*>(chunk_data));
+        case DataType::INT8:
+            return build(static_cast<const int8_t*>(chunk_data));
+        case DataType::INT16:
+            return build(static_cast<const int16_t*>(chunk_data));
+        case DataType::INT32:
+            return build(static_cast<const int32_t*>(chunk_data));
+        case DataType::INT64:
+            return build(static_cast<const int64_t*>(chunk_data));
+        case DataType::FLOAT:
+            return build(static_cast<const float*>(chunk_data));
+        case DataType::DOUBLE:
+            return build(static_cast<const double*>(chunk_data));
         default:
             break;
     }
@@ -204,9 +204,57 @@ class FieldChunkMetrics {
     virtual nlohmann::json
     ToJson() const = 0;
 
+    // Page-level zone maps: the chunk split into consecutive pages of
+    // PageRows() rows (the last one possibly shorter), each with min/max
+    // metrics of its own and no bloom filter. Empty when not built.
+    int64_t
+    PageRows() const {
+        return page_rows_;
+    }
+
+    size_t
+    NumPages() const {
+        return pages_.size();
+    }
+
+    const FieldChunkMetrics&
+    Page(size_t page_id) const {
+        return *pages_[page_id];
+    }
+
+    void
+    SetPages(int64_t page_rows,
+             std::vector<std::shared_ptr<const FieldChunkMetrics>> pages) {
+        page_rows_ = page_rows;
+        pages_ = std::move(pages);
+    }
+
  protected:
+    // Clones share the immutable page metrics.
+    std::unique_ptr<FieldChunkMetrics>
+    WithPages(std::unique_ptr<FieldChunkMetrics> cloned) const {
+        cloned->SetPages(page_rows_, pages_);
+        return cloned;
+    }
+
+    nlohmann::json
+    WithPagesJson(nlohmann::json j) const {
+        if (pages_.empty()) {
+            return j;
+        }
+        j["page_rows"] = page_rows_;
+        auto pages = nlohmann::json::array();
+        for (const auto& page : pages_) {
+            pages.push_back(page->ToJson());
+        }
+        j["pages"] = std::move(pages);
+        return j;
+    }
+
     bool has_value_{false};
     cachinglayer::ResourceUsage cell_size_ = {0, 0};
+    int64_t page_rows_{0};
+    std::vector<std::shared_ptr<const FieldChunkMetrics>> pages_;
 };
 
 class NoneFieldChunkMetrics : public FieldChunkMetrics {
@@ -216,7 +264,7 @@ class NoneFieldChunkMetrics : public FieldChunkMetrics {
 
     std::unique_ptr<FieldChunkMetrics>
     Clone() const override {
-        return std::make_unique<NoneFieldChunkMetrics>();
+        return WithPages(std::make_unique<NoneFieldChunkMetrics>());
     }
 
     FieldChunkMetricsType
@@ -246,7 +294,7 @@ class NoneFieldChunkMetrics : public FieldChunkMetrics {
     ToJson() const override {
         nlohmann::json j;
         j["type"] = FieldChunkMetricsTypeToString(GetMetricsType());
-        return j;
+        return WithPagesJson(std::move(j));
     }
 };
 
@@ -261,10 +309,10 @@ class BooleanFieldChunkMetrics : public FieldChunkMetrics {
     std::unique_ptr<FieldChunkMetrics>
     Clone() const override {
         if (!this->has_value_) {
-            return std::make_unique<NoneFieldChunkMetrics>();
+            return WithPages(std::make_unique<NoneFieldChunkMetrics>());
         }
-        return std::make_unique<BooleanFieldChunkMetrics>(has_true_,
-                                                          has_false_);
+        return WithPages(
+            std::make_unique<BooleanFieldChunkMetrics>(has_true_, has_false_));
     }
 
     bool
@@ -309,7 +357,7 @@ class BooleanFieldChunkMetrics : public FieldChunkMetrics {
         j["has_value"] = this->has_value_;
         j["has_true"] = has_true_;
         j["has_false"] = has_false_;
-        return j;
+        return WithPagesJson(std::move(j));
     }
 
  private:
@@ -328,9 +376,10 @@ class FloatFieldChunkMetrics : public FieldChunkMetrics {
     std::unique_ptr<FieldChunkMetrics>
     Clone() const override {
         if (!this->has_value_) {
-            return std::make_unique<NoneFieldChunkMetrics>();
+            return WithPages(std::make_unique<NoneFieldChunkMetrics>());
         }
-        return std::make_unique<FloatFieldChunkMetrics<T>>(min_, max_);
+        return WithPages(
+            std::make_unique<FloatFieldChunkMetrics<T>>(min_, max_));
     }
 
     bool
@@ -404,7 +453,7 @@ class FloatFieldChunkMetrics : public FieldChunkMetrics {
             j["min"] = min_;
             j["max"] = max_;
         }
-        return j;
+        return WithPagesJson(std::move(j));
     }
 
  private:
@@ -424,10 +473,10 @@ class IntFieldChunkMetrics : public FieldChunkMetrics {
     std::unique_ptr<FieldChunkMetrics>
     Clone() const override {
         if (!this->has_value_) {
-            return std::make_unique<NoneFieldChunkMetrics>();
+            return WithPages(std::make_unique<NoneFieldChunkMetrics>());
         }
-        return std::make_unique<IntFieldChunkMetrics>(
-            min_, max_, bloom_filter_);
+        return WithPages(std::make_unique<IntFieldChunkMetrics>(
+            min_, max_, bloom_filter_));
     }
 
     FieldChunkMetricsType
@@ -524,7 +573,7 @@ class IntFieldChunkMetrics : public FieldChunkMetrics {
             }
         }
 
-        return j;
+        return WithPagesJson(std::move(j));
     }
 
  private:
@@ -549,10 +598,10 @@ class StringFieldChunkMetrics : public FieldChunkMetrics {
     std::unique_ptr<FieldChunkMetrics>
     Clone() const override {
         if (!this->has_value_) {
-            return std::make_unique<NoneFieldChunkMetrics>();
+            return WithPages(std::make_unique<NoneFieldChunkMetrics>());
         }
-        return std::make_unique<StringFieldChunkMetrics>(
-            min_, max_, bloom_filter_, ngram_bloom_filter_);
+        return WithPages(std::make_unique<StringFieldChunkMetrics>(
+            min_, max_, bloom_filter_, ngram_bloom_filter_));
     }
 
     FieldChunkMetricsType
@@ -692,7 +741,7 @@ class StringFieldChunkMetrics : public FieldChunkMetrics {
             }
         }
 
-        return j;
+        return WithPagesJson(std::move(j));
     }
 
     static std::optional<std::string_view>
@@ -714,7 +763,7 @@ class StringFieldChunkMetrics : public FieldChunkMetrics {
 
 template <typename T>
 inline std::unique_ptr<FieldChunkMetrics>
-NewFieldMetrics(const nlohmann::json& data) {
+NewZoneMetrics(const nlohmann::json& data) {
     std::unique_ptr<FieldChunkMetrics> none_metrics =
         std::make_unique<NoneFieldChunkMetrics>();
     if (!data.contains("type")) {
@@ -777,6 +826,20 @@ NewFieldMetrics(const nlohmann::json& data) {
     return none_metrics;
 }
 
+template <typename T>
+inline std::unique_ptr<FieldChunkMetrics>
+NewFieldMetrics(const nlohmann::json& data) {
+    auto metrics = NewZoneMetrics<T>(data);
+    if (data.contains("page_rows") && data.contains("pages")) {
+        std::vector<std::shared_ptr<const FieldChunkMetrics>> pages;
+        for (const auto& page : data["pages"]) {
+            pages.push_back(NewZoneMetrics<T>(page));
+        }
+        metrics->SetPages(data["page_rows"].get<int64_t>(), std::move(pages));
+    }
+    return metrics;
+}
+
 class SkipIndexStatsBuilder {
  public:
     SkipIndexStatsBuilder() = default;
@@ -786,6 +849,10 @@ class SkipIndexStatsBuilder {
         if (enable_bloom_filter.has_value()) {
             enable_bloom_filter_ = *enable_bloom_filter;
         }
+        auto page_rows = GetValueFromConfig<int64_t>(config, "page_rows");
+        if (page_rows.has_value()) {
+            page_rows_ = *page_rows;
+        }
     }
 
     std::unique_ptr<FieldChunkMetrics>
@@ -1010,17 +1077,19 @@ class SkipIndexStatsBuilder {
     }
 
     metricsInfo<std::string>
-    ProcessStringFieldMetrics(const StringChunk* chunk) const {
+    ProcessStringFieldMetrics(const StringChunk* chunk,
+                              int64_t begin,
+                              int64_t end) const {
         // all captured by reference
         bool has_first_valid = false;
-        int64_t total_rows = chunk->RowNums();
+        int64_t total_rows = end - begin;
         int64_t null_count = 0;
         std::string_view min;
         std::string_view max;
         ankerl::unordered_dense::set<std::string_view> unique_values;
         ankerl::unordered_dense::set<std::string> ngram_values;
 
-        for (int64_t i = 0; i < total_rows; ++i) {
+        for (int64_t i = begin; i < end; ++i) {
             bool is_valid = chunk->isValid(i);
             if (!is_valid) {
                 null_count++;
@@ -1124,8 +1193,27 @@ class SkipIndexStatsBuilder {
         }
     }
 
+    // Splits the 'count' rows into pages of page_rows_ rows and returns the
+    // min/max metrics of each, built by 'page_metrics(begin, end)'. Chunks
+    // shorter than two pages get none.
+    template <typename PageMetricsFunc>
+    std::vector<std::shared_ptr<const FieldChunkMetrics>>
+    BuildPages(int64_t count, PageMetricsFunc page_metrics) const {
+        std::vector<std::shared_ptr<const FieldChunkMetrics>> pages;
+        if (page_rows_ <= 0 || count < 2 * page_rows_) {
+            return pages;
+        }
+        pages.reserve((count + page_rows_ - 1) / page_rows_);
+        for (int64_t begin = 0; begin < count; begin += page_rows_) {
+            pages.push_back(
+                page_metrics(begin, std::min(count, begin + page_rows_)));
+        }
+        return pages;
+    }
+
  private:
     bool enable_bloom_filter_ = false;
+    int64_t page_rows_ = DEFAULT_SKIPINDEX_PAGE_ROWS;
 };
 
 }  // namespace milvus::index
@@ -1112,3 +1112,77 @@ TEST_F(SkipIndexStatsBuilderTest,
     ASSERT_TRUE(
         metrics->CanSkipUnaryRange(OpType::PostfixMatch, std::string("xyz")));
 }
+
+TEST_F(SkipIndexStatsBuilderTest, BuildPagesFromChunk) {
+    auto config = milvus::Config();
+    config["enable_bloom_filter"] = true;
+    config["page_rows"] = int64_t{1000};
+    SkipIndexStatsBuilder builder(config);
+
+    // Sorted values, so each page covers a disjoint range.
+    FixedVector<int64_t> data(4500);
+    for (int64_t i = 0; i < data.size(); ++i) {
+        data[i] = i * 2;
+    }
+    auto field_data = milvus::storage::CreateFieldData(
+        storage::DataType::INT64, DataType::NONE);
+    field_data->FillFieldData(data.data(), data.size());
+
+    storage::InsertEventData event_data;
+    auto payload_reader =
+        std::make_shared<milvus::storage::PayloadReader>(field_data);
+    event_data.payload_reader = payload_reader;
+    auto ser_data = event_data.Serialize();
+    auto buffer = std::make_shared<arrow::io::BufferReader>(
+        ser_data.data() + 2 * sizeof(milvus::Timestamp),
+        ser_data.size() - 2 * sizeof(milvus::Timestamp));
+
+    parquet::arrow::FileReaderBuilder reader_builder;
+    ASSERT_TRUE(reader_builder.Open(buffer).ok());
+    std::unique_ptr<parquet::arrow::FileReader> arrow_reader;
+    ASSERT_TRUE(reader_builder.Build(&arrow_reader).ok());
+
+    std::shared_ptr<::arrow::RecordBatchReader> rb_reader;
+    ASSERT_TRUE(arrow_reader->GetRecordBatchReader(&rb_reader).ok());
+
+    FieldMeta field_meta(FieldName("a"),
+                         milvus::FieldId(1),
+                         DataType::INT64,
+                         false,
+                         std::nullopt);
+    arrow::ArrayVector array_vec = read_single_column_batches(rb_reader);
+    auto chunk = create_chunk(field_meta, array_vec);
+
+    auto metrics = builder.Build(DataType::INT64, chunk.get());
+    ASSERT_EQ(metrics->GetMetricsType(), FieldChunkMetricsType::INT);
+    ASSERT_EQ(metrics->PageRows(), 1000);
+    ASSERT_EQ(metrics->NumPages(), 5);
+    // 3000 is in the chunk but only in the page of rows [1000, 2000).
+    EXPECT_FALSE(metrics->CanSkipUnaryRange(OpType::Equal, int64_t{3000}));
+    for (size_t page = 0; page < metrics->NumPages(); ++page) {
+        EXPECT_EQ(metrics->Page(page).CanSkipUnaryRange(OpType::Equal,
+                                                        int64_t{3000}),
+                  page != 1);
+    }
+    // The last page is short.
+    EXPECT_FALSE(
+        metrics->Page(4).CanSkipUnaryRange(OpType::Equal, int64_t{8998}));
+    EXPECT_TRUE(
+        metrics->Page(4).CanSkipUnaryRange(OpType::Equal, int64_t{9000}));
+
+    auto restored = NewFieldMetrics<int64_t>(metrics->ToJson());
+    ASSERT_EQ(restored->PageRows(), 1000);
+    ASSERT_EQ(restored->NumPages(), 5);
+    Metrics lower = int64_t{2000};
+    Metrics upper = int64_t{4000};
+    EXPECT_TRUE(restored->Page(0).CanSkipBinaryRange(lower, upper, true, true));
+    EXPECT_FALSE(
+        restored->Page(1).CanSkipBinaryRange(lower, upper, true, true));
+    EXPECT_EQ(restored->Clone()->NumPages(), 5);
+
+    // Chunks shorter than two pages get none.
+    config["page_rows"] = int64_t{3000};
+    SkipIndexStatsBuilder large_page_builder(config);
+    EXPECT_EQ(
+        large_page_builder.Build(DataType::INT64, chunk.get())->NumPages(), 0);
+}
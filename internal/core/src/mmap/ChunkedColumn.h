@@ -23,6 +23,7 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <math.h>
 
@@ -145,6 +146,12 @@ class ChunkedColumnBase : public ChunkedColumnInterface {
     DataOfChunk(milvus::OpContext* op_ctx, int chunk_id) const override {
         auto ca = SemiInlineGet(slot_->PinCells(op_ctx, {chunk_id}));
         auto chunk = ca->get_cell_of(chunk_id);
+        if (auto packed = AsPackedChunk(data_type_, chunk)) {
+            // decoded for this pin only
+            auto values = packed->DecodePacked();
+            return PinWrapper<const char*>(
+                std::make_pair(std::move(ca), values), values.get());
+        }
         return PinWrapper<const char*>(std::move(ca), chunk->Data());
     }
 
@@ -415,12 +422,19 @@ class ChunkedColumn : public ChunkedColumnBase {
                 int64_t count) override {
         auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(offsets, count);
         auto ca = SemiInlineGet(slot_->PinCells(op_ctx, cids));
+        int64_t decoded;
         for (int64_t i = 0; i < count; i++) {
             auto chunk = ca->get_cell_of(cids[i]);
             auto offset = offsets_in_chunk[i];
             if (nullable_ && IsVectorDataType(data_type_)) {
                 offset = chunk->PhysicalOffsetOf(offset);
             }
+            if (auto packed = AsPackedChunk(data_type_, chunk)) {
+                packed->DecodePacked(
+                    offset, 1, reinterpret_cast<char*>(&decoded));
+                fn(reinterpret_cast<const char*>(&decoded), i);
+                continue;
+            }
             fn(chunk->ValueAt(offset), i);
         }
     }
@@ -437,6 +451,14 @@ class ChunkedColumn : public ChunkedColumnBase {
         auto typed_dst = static_cast<T*>(dst);
         for (int64_t i = 0; i < count; i++) {
             auto chunk = ca->get_cell_of(cids[i]);
+            if (auto packed = AsPackedChunk(data_type_, chunk)) {
+                S decoded;
+                packed->DecodePacked(offsets_in_chunk[i],
+                                     1,
+                                     reinterpret_cast<char*>(&decoded));
+                typed_dst[i] = decoded;
+                continue;
+            }
             auto value = chunk->ValueAt(offsets_in_chunk[i]);
             typed_dst[i] =
                 *static_cast<const S*>(static_cast<const void*>(value));
@@ -535,6 +557,12 @@ class ChunkedColumn : public ChunkedColumnBase {
     Span(milvus::OpContext* op_ctx, int64_t chunk_id) const override {
         auto ca = SemiInlineGet(slot_->PinCells(op_ctx, {chunk_id}));
         auto chunk = ca->get_cell_of(chunk_id);
+        if (auto packed = AsPackedChunk(data_type_, chunk)) {
+            // decoded for this pin only
+            auto values = packed->DecodePacked();
+            return PinWrapper<SpanBase>(std::make_pair(std::move(ca), values),
+                                        packed->Span(values.get()));
+        }
         return PinWrapper<SpanBase>(
             std::move(ca), static_cast<FixedWidthChunk*>(chunk)->Span());
     }
@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <utility>
 #include <vector>
 #include <cmath>
 
@@ -243,6 +244,12 @@ class ProxyChunkColumn : public ChunkedColumnInterface {
     DataOfChunk(milvus::OpContext* op_ctx, int chunk_id) const override {
         auto group_chunk = group_->GetGroupChunk(op_ctx, chunk_id);
         auto chunk = group_chunk.get()->GetChunk(field_id_);
+        if (auto packed = AsPackedChunk(data_type_, chunk.get())) {
+            // decoded for this pin only
+            auto values = packed->DecodePacked();
+            return PinWrapper<const char*>(
+                std::make_pair(std::move(group_chunk), values), values.get());
+        }
         return PinWrapper<const char*>(std::move(group_chunk), chunk->Data());
     }
 
@@ -345,6 +352,13 @@ class ProxyChunkColumn : public ChunkedColumnInterface {
         }
         auto chunk_wrapper = group_->GetGroupChunk(op_ctx, chunk_id);
         auto chunk = chunk_wrapper.get()->GetChunk(field_id_);
+        if (auto packed = AsPackedChunk(data_type_, chunk.get())) {
+            // decoded for this pin only
+            auto values = packed->DecodePacked();
+            return PinWrapper<SpanBase>(
+                std::make_pair(std::move(chunk_wrapper), values),
+                packed->Span(values.get()));
+        }
         return PinWrapper<SpanBase>(
             std::move(chunk_wrapper),
             static_cast<FixedWidthChunk*>(chunk.get())->Span());
@@ -493,6 +507,7 @@ class ProxyChunkColumn : public ChunkedColumnInterface {
                 int64_t count) override {
         auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(offsets, count);
         auto ca = group_->GetGroupChunks(op_ctx, cids);
+        int64_t decoded;
         for (int64_t i = 0; i < count; i++) {
             auto* group_chunk = ca->get_cell_of(cids[i]);
             auto chunk = group_chunk->GetChunk(field_id_);
@@ -500,6 +515,12 @@ class ProxyChunkColumn : public ChunkedColumnInterface {
             if (field_meta_.is_nullable() && IsVectorDataType(data_type_)) {
                 offset = chunk->PhysicalOffsetOf(offset);
             }
+            if (auto packed = AsPackedChunk(data_type_, chunk.get())) {
+                packed->DecodePacked(
+                    offset, 1, reinterpret_cast<char*>(&decoded));
+                fn(reinterpret_cast<const char*>(&decoded), i);
+                continue;
+            }
             fn(chunk->ValueAt(offset), i);
         }
     }
@@ -517,6 +538,14 @@ class ProxyChunkColumn : public ChunkedColumnInterface {
         for (int64_t i = 0; i < count; i++) {
             auto* group_chunk = ca->get_cell_of(cids[i]);
             auto chunk = group_chunk->GetChunk(field_id_);
+            if (auto packed = AsPackedChunk(data_type_, chunk.get())) {
+                S decoded;
+                packed->DecodePacked(offsets_in_chunk[i],
+                                     1,
+                                     reinterpret_cast<char*>(&decoded));
+                typed_dst[i] = decoded;
+                continue;
+            }
             auto value = chunk->ValueAt(offsets_in_chunk[i]);
             typed_dst[i] =
                 *static_cast<const S*>(static_cast<const void*>(value));
@@ -433,6 +433,16 @@ DEFINE_PROMETHEUS_COUNTER(internal_storage_pool_task_completed_total_low,
                           internal_storage_pool_task_completed_total,
                           lowPoolLabel);
 
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_storage_pool_task_borrowed_total,
+    "[cpp]storage thread pool tasks run by lower priority pools");
+DEFINE_PROMETHEUS_COUNTER(internal_storage_pool_task_borrowed_total_high,
+                          internal_storage_pool_task_borrowed_total,
+                          highPoolLabel);
+DEFINE_PROMETHEUS_COUNTER(internal_storage_pool_task_borrowed_total_middle,
+                          internal_storage_pool_task_borrowed_total,
+                          middlePoolLabel);
+
 DEFINE_PROMETHEUS_HISTOGRAM_FAMILY(
     internal_storage_pool_queue_duration_seconds,
     "[cpp]storage thread pool task queue duration");
@@ -471,6 +481,30 @@ DEFINE_PROMETHEUS_HISTOGRAM_WITH_BUCKETS(
     lowPoolLabel,
     secondsBuckets);
 
+std::map<std::string, std::string> diskCacheHitLabel = {{"result", "hit"}};
+std::map<std::string, std::string> diskCacheMissLabel = {{"result", "miss"}};
+
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_storage_disk_cache_requests_total,
+    "[cpp]object reads looked up in the local disk cache");
+DEFINE_PROMETHEUS_COUNTER(internal_storage_disk_cache_requests_total_hit,
+                          internal_storage_disk_cache_requests_total,
+                          diskCacheHitLabel);
+DEFINE_PROMETHEUS_COUNTER(internal_storage_disk_cache_requests_total_miss,
+                          internal_storage_disk_cache_requests_total,
+                          diskCacheMissLabel);
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_storage_disk_cache_saved_bytes_total,
+    "[cpp]bytes read from the local disk cache instead of remote storage");
+DEFINE_PROMETHEUS_COUNTER(internal_storage_disk_cache_saved_bytes_total_all,
+                          internal_storage_disk_cache_saved_bytes_total,
+                          {});
+DEFINE_PROMETHEUS_GAUGE_FAMILY(internal_storage_disk_cache_bytes,
+                               "[cpp]bytes held by the local disk cache");
+DEFINE_PROMETHEUS_GAUGE(internal_storage_disk_cache_bytes_all,
+                        internal_storage_disk_cache_bytes,
+                        {});
+
 DEFINE_PROMETHEUS_GAUGE_FAMILY(internal_arrow_io_pool_capacity,
                                "[cpp]arrow io thread pool capacity");
 DEFINE_PROMETHEUS_GAUGE(internal_arrow_io_pool_capacity_all,
@@ -117,6 +117,9 @@ DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_storage_pool_task_completed_total);
 DECLARE_PROMETHEUS_COUNTER(internal_storage_pool_task_completed_total_high);
 DECLARE_PROMETHEUS_COUNTER(internal_storage_pool_task_completed_total_middle);
 DECLARE_PROMETHEUS_COUNTER(internal_storage_pool_task_completed_total_low);
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_storage_pool_task_borrowed_total);
+DECLARE_PROMETHEUS_COUNTER(internal_storage_pool_task_borrowed_total_high);
+DECLARE_PROMETHEUS_COUNTER(internal_storage_pool_task_borrowed_total_middle);
 DECLARE_PROMETHEUS_HISTOGRAM_FAMILY(
     internal_storage_pool_queue_duration_seconds);
 DECLARE_PROMETHEUS_HISTOGRAM(internal_storage_pool_queue_duration_seconds_high);
@@ -132,6 +135,16 @@ DECLARE_PROMETHEUS_HISTOGRAM(
 DECLARE_PROMETHEUS_HISTOGRAM(
     internal_storage_pool_execute_duration_seconds_low);
 
+// local disk object cache metrics
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_storage_disk_cache_requests_total);
+DECLARE_PROMETHEUS_COUNTER(internal_storage_disk_cache_requests_total_hit);
+DECLARE_PROMETHEUS_COUNTER(internal_storage_disk_cache_requests_total_miss);
+DECLARE_PROMETHEUS_COUNTER_FAMILY(
+    internal_storage_disk_cache_saved_bytes_total);
+DECLARE_PROMETHEUS_COUNTER(internal_storage_disk_cache_saved_bytes_total_all);
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_storage_disk_cache_bytes);
+DECLARE_PROMETHEUS_GAUGE(internal_storage_disk_cache_bytes_all);
+
 // arrow io thread pool metrics
 DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_arrow_io_pool_capacity);
 DECLARE_PROMETHEUS_GAUGE(internal_arrow_io_pool_capacity_all);
@@ -17,7 +17,6 @@
 
 #include "common/Consts.h"
 #include "common/EasyAssert.h"
-#include "common/FastMem.h"
 #include "common/QueryInfo.h"
 #include "common/QueryResult.h"
 #include "common/Utils.h"
@@ -131,13 +130,19 @@ CachedSearchIterator::CachedSearchIterator(
     Init(search_info);
 
     // VECTOR_ARRAY element-level search: growing stores each row as a
-    // separate VectorArray with its own backing allocation, so we must
-    // flatten per-chunk into a contiguous buffer that knowhere can read.
+    // separate VectorArray with its own backing allocation, so knowhere
+    // reads the packed chunks instead.
     // array_offsets_ != nullptr is the element-level signal (multi-search-
     // multi emb-list iterator is rejected upstream, so we don't branch on
     // it here).
     const bool is_element_level = search_info.array_offsets_ != nullptr;
+    const segcore::ConcurrentVector<VectorArray>* vec_array_data = nullptr;
     if (is_element_level) {
+        vec_array_data =
+            dynamic_cast<const segcore::ConcurrentVector<VectorArray>*>(
+                vec_data);
+        AssertInfo(vec_array_data != nullptr,
+                   "element-level search needs a vector array column");
         chunk_buffers_.reserve(num_chunks_);
     }
 
@@ -148,32 +153,21 @@ CachedSearchIterator::CachedSearchIterator(
         index_info,
         bitset,
         data_type,
-        [this, &vec_data, vec_size_per_chunk, row_count, is_element_level](
+        [this, &vec_data, vec_array_data, vec_size_per_chunk, row_count](
             int64_t chunk_id) {
-            const void* chunk_data = vec_data->get_chunk_data(chunk_id);
             // no need to store a PinWrapper for growing, because vec_data is guaranteed to not be evicted.
             int64_t chunk_size = std::min(
                 vec_size_per_chunk, row_count - chunk_id * vec_size_per_chunk);
-            if (!is_element_level) {
-                return std::make_pair(chunk_data, chunk_size);
+            if (vec_array_data == nullptr) {
+                return std::make_pair(vec_data->get_chunk_data(chunk_id),
+                                      chunk_size);
             }
 
-            auto va_ptr = reinterpret_cast<const VectorArray*>(chunk_data);
-            int64_t total_bytes = 0;
-            int64_t total_elements = 0;
-            for (int64_t i = 0; i < chunk_size; ++i) {
-                total_bytes += va_ptr[i].byte_size();
-                total_elements += va_ptr[i].length();
-            }
-            auto buf = std::make_unique<uint8_t[]>(total_bytes);
-            auto* ptr = buf.get();
-            for (int64_t i = 0; i < chunk_size; ++i) {
-                milvus::fastmem::FastMemcpy(
-                    ptr, va_ptr[i].data(), va_ptr[i].byte_size());
-                ptr += va_ptr[i].byte_size();
-            }
-            const void* flat_data = buf.get();
-            chunk_buffers_.emplace_back(std::move(buf));
+            auto packed =
+                vec_array_data->get_packed_chunk(chunk_id, chunk_size);
+            const void* flat_data = packed->data.get();
+            auto total_elements = packed->num_vectors();
+            chunk_buffers_.emplace_back(std::move(packed));
             return std::make_pair(flat_data, total_elements);
         });
 }
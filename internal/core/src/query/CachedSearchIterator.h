@@ -97,9 +97,10 @@ class CachedSearchIterator {
     std::vector<milvus::cachinglayer::PinWrapper<const void*>> pin_wrappers_;
     // used only for growing segment with VECTOR_ARRAY element-level search:
     // knowhere needs a contiguous flat buffer, but growing stores each row as
-    // a separate VectorArray with its own backing allocation, so we flatten
-    // per-chunk here and keep the buffers alive alongside the iterators.
-    std::vector<std::unique_ptr<uint8_t[]>> chunk_buffers_;
+    // a separate VectorArray with its own backing allocation, so the packed
+    // chunks are kept alive alongside the iterators.
+    std::vector<std::shared_ptr<const segcore::PackedVectorArrays>>
+        chunk_buffers_;
     int64_t batch_size_ = 0;
     std::vector<knowhere::IndexNode::IteratorPtr> iterators_;
     int8_t sign_ = 1;
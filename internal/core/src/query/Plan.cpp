@@ -252,7 +252,10 @@ CreateSearchPlanByExpr(SchemaPtr schema,
     // Note: serialized_expr_plan is of binary format
     proto::plan::PlanNode plan_node;
     ParsePlanNodeProto(plan_node, serialized_expr_plan, size);
-    return ProtoParser(std::move(schema)).CreatePlan(plan_node);
+    auto plan = ProtoParser(std::move(schema)).CreatePlan(plan_node);
+    plan->signature_.assign(static_cast<const char*>(serialized_expr_plan),
+                            size);
+    return plan;
 }
 
 std::unique_ptr<Plan>
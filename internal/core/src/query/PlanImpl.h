@@ -64,6 +64,9 @@ struct Plan {
     // collections this drives manifest-column checks, not data readiness.
     std::vector<FieldId> access_entries_;
     std::vector<std::string> target_dynamic_fields_;
+    // Serialized plan this plan was created from, empty for plans built in
+    // memory. Plans with equal signatures search identically.
+    std::string signature_;
     void
     check_identical(Plan& other);
 
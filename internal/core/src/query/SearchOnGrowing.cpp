@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
@@ -24,12 +25,13 @@
 #include "SearchOnGrowing.h"
 #include "cachinglayer/CacheSlot.h"
 #include "common/BitsetView.h"
+#include "common/Common.h"
 #include "common/Consts.h"
 #include "common/EasyAssert.h"
-#include "common/FastMem.h"
 #include "common/FieldMeta.h"
 #include "common/IndexMeta.h"
 #include "common/OffsetMapping.h"
+#include "common/ParallelFor.h"
 #include "common/QueryInfo.h"
 #include "common/QueryResult.h"
 #include "common/Schema.h"
@@ -38,6 +40,7 @@
 #include "common/VectorArray.h"
 #include "common/protobuf_utils.h"
 #include "exec/operator/Utils.h"
+#include "futures/Executor.h"
 #include "index/Index.h"
 #include "index/VectorIndex.h"
 #include "knowhere/comp/index_param.h"
@@ -261,96 +264,114 @@ SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
         // because ArrayOffsets maps global element IDs to row IDs.
         int64_t cumulative_element_offset = 0;
 
-        std::vector<size_t> offsets;
-        for (int chunk_id = current_chunk_id; chunk_id < max_chunk;
-             ++chunk_id) {
-            auto chunk_data = vec_ptr->get_chunk_data(chunk_id);
-
-            auto row_begin = chunk_id * vec_size_per_chunk;
-            auto row_end =
-                std::min(active_count, (chunk_id + 1) * vec_size_per_chunk);
-            auto size_per_chunk = row_end - row_begin;
-
-            query::dataset::RawDataset sub_data;
-            std::unique_ptr<uint8_t[]> buf = nullptr;
-            if (data_type != DataType::VECTOR_ARRAY) {
-                sub_data = query::dataset::RawDataset{
-                    row_begin, dim, size_per_chunk, chunk_data};
-            } else {
-                // TODO(SpadeA): For VectorArray(Embedding List), data is
-                // discreted stored in FixedVector which means we will copy the
-                // data to a contiguous memory buffer. This is inefficient and
-                // will be optimized in the future.
-                auto vec_ptr = reinterpret_cast<const VectorArray*>(chunk_data);
-                auto size = 0;
-                for (int i = 0; i < size_per_chunk; ++i) {
-                    size += vec_ptr[i].byte_size();
+        // Dataset of a chunk. Vector array chunks are searched in their
+        // packed form, which 'packed' keeps alive. Element-level search
+        // advances cumulative_element_offset, so it must go in chunk order.
+        auto vec_array_ptr =
+            data_type == DataType::VECTOR_ARRAY
+                ? dynamic_cast<const segcore::ConcurrentVector<VectorArray>*>(
+                      vec_ptr)
+                : nullptr;
+        auto chunk_dataset =
+            [&](int64_t chunk_id,
+                std::shared_ptr<const segcore::PackedVectorArrays>& packed) {
+                auto row_begin = chunk_id * vec_size_per_chunk;
+                auto row_end = std::min(active_count,
+                                        (chunk_id + 1) * vec_size_per_chunk);
+                auto size_per_chunk = row_end - row_begin;
+
+                if (data_type != DataType::VECTOR_ARRAY) {
+                    return query::dataset::RawDataset{
+                        row_begin,
+                        dim,
+                        size_per_chunk,
+                        vec_ptr->get_chunk_data(chunk_id)};
                 }
-
-                buf = std::make_unique<uint8_t[]>(size);
-
+                AssertInfo(vec_array_ptr != nullptr,
+                           "vector array field is not a vector array column");
+                packed = vec_array_ptr->get_packed_chunk(chunk_id,
+                                                         size_per_chunk);
                 if (is_element_level_search) {
-                    auto count = 0;
-                    auto ptr = buf.get();
-                    for (int i = 0; i < size_per_chunk; ++i) {
-                        milvus::fastmem::FastMemcpy(
-                            ptr, vec_ptr[i].data(), vec_ptr[i].byte_size());
-                        ptr += vec_ptr[i].byte_size();
-                        count += vec_ptr[i].length();
-                    }
-                    sub_data = query::dataset::RawDataset{
-                        cumulative_element_offset, dim, count, buf.get()};
-                    cumulative_element_offset += count;
-                } else {
-                    offsets.clear();
-                    offsets.reserve(size_per_chunk + 1);
-                    offsets.push_back(0);
-
-                    auto offset = 0;
-                    auto ptr = buf.get();
-                    for (int i = 0; i < size_per_chunk; ++i) {
-                        milvus::fastmem::FastMemcpy(
-                            ptr, vec_ptr[i].data(), vec_ptr[i].byte_size());
-                        ptr += vec_ptr[i].byte_size();
-
-                        offset += vec_ptr[i].length();
-                        offsets.push_back(offset);
-                    }
-                    sub_data = query::dataset::RawDataset{row_begin,
-                                                          dim,
-                                                          size_per_chunk,
-                                                          buf.get(),
-                                                          offsets.data()};
+                    query::dataset::RawDataset sub_data{
+                        cumulative_element_offset,
+                        dim,
+                        packed->num_vectors(),
+                        packed->data.get()};
+                    cumulative_element_offset += packed->num_vectors();
+                    return sub_data;
                 }
-            }
-
-            if (use_vector_iterator) {
-                AssertInfo(iter_data_type != DataType::VECTOR_ARRAY,
-                           "vector array(embedding list) is not supported for "
-                           "vector iterator");
-
-                if (buf != nullptr) {
-                    search_result.chunk_buffers_.emplace_back(std::move(buf));
-                }
-
-                auto sub_qr =
-                    PackBruteForceSearchIteratorsIntoSubResult(search_dataset,
+                return query::dataset::RawDataset{row_begin,
+                                                  dim,
+                                                  size_per_chunk,
+                                                  packed->data.get(),
+                                                  packed->offsets.data()};
+            };
+
+        auto parallelism = GROWING_SEARCH_PARALLELISM.load();
+        if (!use_vector_iterator && !is_element_level_search &&
+            parallelism > 1 && max_chunk > 1) {
+            // Each chunk gets its own top-k, merged in chunk order so ties
+            // resolve as in the sequential scan.
+            std::vector<std::optional<SubSearchResult>> sub_results(max_chunk);
+            auto search_chunk = [&](int64_t chunk_id) {
+                std::shared_ptr<const segcore::PackedVectorArrays> packed;
+                auto sub_data = chunk_dataset(chunk_id, packed);
+                sub_results[chunk_id].emplace(BruteForceSearch(search_dataset,
                                                                sub_data,
                                                                info,
                                                                index_info,
                                                                search_bitset,
-                                                               iter_data_type);
-                final_qr.merge(sub_qr);
-            } else {
-                auto sub_qr = BruteForceSearch(search_dataset,
-                                               sub_data,
-                                               info,
-                                               index_info,
-                                               search_bitset,
-                                               iter_data_type,
-                                               element_type,
-                                               op_context);
-                final_qr.merge(sub_qr);
+                                                               iter_data_type,
+                                                               element_type,
+                                                               op_context));
+            };
+            ParallelFor(
+                max_chunk,
+                parallelism,
+                search_chunk,
+                [](std::function<void()> task) {
+                    futures::getSearchCPUExecutor()->addWithPriority(
+                        std::move(task), futures::ExecutePriority::HIGH);
+                });
+            for (auto& sub_qr : sub_results) {
+                final_qr.merge(*sub_qr);
+            }
+        } else {
+            for (int chunk_id = current_chunk_id; chunk_id < max_chunk;
+                 ++chunk_id) {
+                std::shared_ptr<const segcore::PackedVectorArrays> packed;
+                auto sub_data = chunk_dataset(chunk_id, packed);
+
+                if (use_vector_iterator) {
+                    AssertInfo(iter_data_type != DataType::VECTOR_ARRAY,
+                               "vector array(embedding list) is not "
+                               "supported for vector iterator");
+
+                    if (packed != nullptr) {
+                        search_result.resource_pins_.emplace_back(
+                            std::const_pointer_cast<
+                                segcore::PackedVectorArrays>(packed));
+                    }
+
+                    auto sub_qr = PackBruteForceSearchIteratorsIntoSubResult(
+                        search_dataset,
+                        sub_data,
+                        info,
+                        index_info,
+                        search_bitset,
+                        iter_data_type);
+                    final_qr.merge(sub_qr);
+                } else {
+                    auto sub_qr = BruteForceSearch(search_dataset,
+                                                   sub_data,
+                                                   info,
+                                                   index_info,
+                                                   search_bitset,
+                                                   iter_data_type,
+                                                   element_type,
+                                                   op_context);
+                    final_qr.merge(sub_qr);
+                }
             }
         }
         if (use_vector_iterator) {
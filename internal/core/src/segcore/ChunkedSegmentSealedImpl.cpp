@@ -29,6 +29,7 @@
 #include <filesystem>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <optional>
 #include <ratio>
 #include <set>
@@ -45,9 +46,12 @@
 #include "Types.h"
 #include "Utils.h"
 #include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/builder.h"
 #include "arrow/result.h"
 #include "arrow/table.h"
 #include "arrow/type.h"
+#include "arrow/util/bit_util.h"
 #include "bitset/bitset.h"
 #include "cachinglayer/CacheSlot.h"
 #include "cachinglayer/Manager.h"
@@ -81,6 +85,7 @@
 #include "common/VectorArray.h"
 #include "common/resource_c.h"
 #include "common/type_c.h"
+#include "exec/expression/JsonPathCache.h"
 #include "folly/Synchronized.h"
 #include "geos_c.h"
 #include "glog/logging.h"
@@ -3408,6 +3413,54 @@ ChunkedSegmentSealedImpl::chunk_vector_array_view_impl(
               "chunk_vector_array_view_impl only used for chunk column field ");
 }
 
+PinWrapper<StringChunk*>
+ChunkedSegmentSealedImpl::dictionary_string_chunk(milvus::OpContext* op_ctx,
+                                                  FieldId field_id,
+                                                  int64_t chunk_id) const {
+    auto snapshot = CapturePublishedState();
+    if (!get_bit(snapshot->field_data_ready_bitset, field_id)) {
+        return PinWrapper<StringChunk*>(nullptr);
+    }
+    auto data_type = snapshot->schema->operator[](field_id).get_data_type();
+    if (!IsStringDataType(data_type)) {
+        return PinWrapper<StringChunk*>(nullptr);
+    }
+    auto column = get_column(snapshot->runtime, field_id);
+    if (column == nullptr) {
+        return PinWrapper<StringChunk*>(nullptr);
+    }
+    auto pw = column->GetChunk(op_ctx, chunk_id);
+    auto chunk = dynamic_cast<StringChunk*>(pw.get());
+    if (chunk == nullptr || !chunk->IsDictionaryEncoded()) {
+        return PinWrapper<StringChunk*>(nullptr);
+    }
+    return PinWrapper<StringChunk*>(std::move(pw), chunk);
+}
+
+PinWrapper<FixedWidthChunk*>
+ChunkedSegmentSealedImpl::packed_int_chunk(milvus::OpContext* op_ctx,
+                                           FieldId field_id,
+                                           int64_t chunk_id) const {
+    auto snapshot = CapturePublishedState();
+    if (!get_bit(snapshot->field_data_ready_bitset, field_id)) {
+        return PinWrapper<FixedWidthChunk*>(nullptr);
+    }
+    auto data_type = snapshot->schema->operator[](field_id).get_data_type();
+    if (data_type != DataType::INT32 && data_type != DataType::INT64) {
+        return PinWrapper<FixedWidthChunk*>(nullptr);
+    }
+    auto column = get_column(snapshot->runtime, field_id);
+    if (column == nullptr) {
+        return PinWrapper<FixedWidthChunk*>(nullptr);
+    }
+    auto pw = column->GetChunk(op_ctx, chunk_id);
+    auto chunk = dynamic_cast<FixedWidthChunk*>(pw.get());
+    if (chunk == nullptr || !chunk->IsPacked()) {
+        return PinWrapper<FixedWidthChunk*>(nullptr);
+    }
+    return PinWrapper<FixedWidthChunk*>(std::move(pw), chunk);
+}
+
 PinWrapper<std::pair<std::vector<std::string_view>, FixedVector<bool>>>
 ChunkedSegmentSealedImpl::chunk_string_view_impl(
     milvus::OpContext* op_ctx,
@@ -3942,6 +3995,8 @@ ChunkedSegmentSealedImpl::DropFieldData(const FieldId field_id) {
     std::lock_guard<std::mutex> reopen_guard(reopen_mutex_);
     auto current = CapturePublishedState();
     DropFieldData(field_id, current->schema, nullptr, current);
+    milvus::exec::JsonPathCacheManager::Instance().EraseField(
+        get_segment_id(), field_id.get());
 }
 
 void
@@ -4161,13 +4216,8 @@ ChunkedSegmentSealedImpl::search_pks(BitsetType& bitset,
         auto* pk_cell = pk_index.get();
         AssertInfo(pk_cell != nullptr && pk_cell->has_pk2offset(),
                    "primary key index is not ready");
-        for (auto& pk : pks) {
-            pk_cell->pk2offset().find_range(
-                pk,
-                proto::plan::OpType::Equal,
-                bitset_view,
-                [](int64_t offset) { return true; });
-        }
+        pk_cell->pk2offset().find_batch(
+            pks, [&](size_t, int64_t offset) { bitset_view[offset] = true; });
         return;
     }
 
@@ -4249,16 +4299,13 @@ ChunkedSegmentSealedImpl::search_batch_pks(
             include_same_ts
                 ? [](Timestamp lhs, Timestamp rhs) { return lhs <= rhs; }
                 : [](Timestamp lhs, Timestamp rhs) { return lhs < rhs; };
-        for (size_t i = 0; i < pks.size(); i++) {
+        pk_cell->pk2offset().find_batch(pks, [&](size_t i, int64_t offset) {
             auto timestamp = get_timestamp(i);
-            auto offsets = pk_cell->pk2offset().find(pks[i]);
-            for (auto offset : offsets) {
-                auto insert_ts = read_ts(offset);
-                if (timestamp_hit(insert_ts, timestamp)) {
-                    callback(SegOffset(offset), timestamp);
-                }
+            auto insert_ts = read_ts(offset);
+            if (timestamp_hit(insert_ts, timestamp)) {
+                callback(SegOffset(offset), timestamp);
             }
-        }
+        });
         return;
     }
 
@@ -4280,27 +4327,37 @@ ChunkedSegmentSealedImpl::search_batch_pks(
 
     switch (schema_snapshot->get_fields().at(pk_field_id).get_data_type()) {
         case DataType::INT64: {
+            // Probe in pk order so each chunk is walked once, galloping from
+            // one hit to the next.
+            std::vector<size_t> order(pks.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+                return std::get<int64_t>(pks[lhs]) <
+                       std::get<int64_t>(pks[rhs]);
+            });
             auto num_chunk = pk_column->num_chunks();
             for (int i = 0; i < num_chunk; ++i) {
                 const auto& pw = all_chunk_pins[i];
                 auto src =
                     reinterpret_cast<const int64_t*>(pw.get()->RawData());
                 auto chunk_row_num = pk_column->chunk_row_nums(i);
-                for (size_t j = 0; j < pks.size(); j++) {
+                auto num_rows_until_chunk = pk_column->GetNumRowsUntilChunk(i);
+                auto it = src;
+                for (auto j : order) {
                     // get int64 pks
                     auto target = std::get<int64_t>(pks[j]);
                     auto timestamp = get_timestamp(j);
-                    auto it = std::lower_bound(
-                        src,
+                    it = gallop_lower_bound(
+                        it,
                         src + chunk_row_num,
                         target,
                         [](const int64_t& elem, const int64_t& value) {
                             return elem < value;
                         });
-                    auto num_rows_until_chunk =
-                        pk_column->GetNumRowsUntilChunk(i);
-                    for (; it != src + chunk_row_num && *it == target; ++it) {
-                        auto offset = it - src + num_rows_until_chunk;
+                    for (auto hit = it;
+                         hit != src + chunk_row_num && *hit == target;
+                         ++hit) {
+                        auto offset = hit - src + num_rows_until_chunk;
                         auto insert_ts = read_ts(offset);
                         if (timestamp_hit(insert_ts, timestamp)) {
                             callback(SegOffset(offset), timestamp);
@@ -4781,6 +4838,8 @@ ChunkedSegmentSealedImpl::~ChunkedSegmentSealedImpl() {
     // Clean up geometry cache for all fields in this segment
     auto& cache_manager = milvus::exec::SimpleGeometryCacheManager::Instance();
     cache_manager.RemoveSegmentCaches(ctx_, get_segment_id());
+    milvus::exec::JsonPathCacheManager::Instance().EraseSegment(
+        get_segment_id());
 
     if (ctx_) {
         GEOS_finish_r(ctx_);
@@ -5769,6 +5828,284 @@ ChunkedSegmentSealedImpl::FillPrimaryKeys(const query::Plan* plan,
     SegmentInternalInterface::FillPrimaryKeys(plan, results, op_ctx);
 }
 
+namespace {
+
+// Keeps a column and one of its pinned chunks alive for as long as an Arrow
+// buffer pointing into the chunk is referenced.
+template <typename T>
+struct PinnedChunk {
+    std::shared_ptr<ChunkedColumnInterface> column;
+    PinWrapper<T> pin;
+};
+
+class PinnedArrowBuffer : public arrow::Buffer {
+ public:
+    PinnedArrowBuffer(const char* data,
+                      int64_t size,
+                      std::shared_ptr<void> owner)
+        : arrow::Buffer(reinterpret_cast<const uint8_t*>(data), size),
+          owner_(std::move(owner)) {
+    }
+
+ private:
+    std::shared_ptr<void> owner_;
+};
+
+// Returns the chunk holding seg_offsets[0, count) if they are consecutive
+// rows of a single chunk, setting offset_in_chunk to the first one's
+// position in it, and -1 otherwise.
+int64_t
+ContiguousChunkOf(const ChunkedColumnInterface* column,
+                  const int64_t* seg_offsets,
+                  int64_t count,
+                  int64_t& offset_in_chunk) {
+    for (int64_t i = 1; i < count; ++i) {
+        if (seg_offsets[i] != seg_offsets[0] + i) {
+            return -1;
+        }
+    }
+    auto [chunk_id, first] = column->GetChunkIDByOffset(seg_offsets[0]);
+    auto chunk_rows = column->chunk_row_nums(chunk_id);
+    if (static_cast<int64_t>(first) + count > chunk_rows) {
+        return -1;
+    }
+    offset_in_chunk = first;
+    return chunk_id;
+}
+
+std::shared_ptr<arrow::Buffer>
+BuildValidityBitmap(milvus::OpContext* op_ctx,
+                    const ChunkedColumnInterface* column,
+                    const int64_t* seg_offsets,
+                    int64_t count,
+                    int64_t& null_count) {
+    null_count = 0;
+    if (!column->IsNullable()) {
+        return nullptr;
+    }
+    auto bitmap = arrow::AllocateEmptyBitmap(count).ValueOrDie();
+    auto bits = bitmap->mutable_data();
+    column->BulkIsValid(
+        op_ctx,
+        [&](bool is_valid, size_t i) {
+            if (is_valid) {
+                arrow::bit_util::SetBit(bits, i);
+            } else {
+                ++null_count;
+            }
+        },
+        seg_offsets,
+        count);
+    return bitmap;
+}
+
+// S is the type stored in the column and A the Arrow array type. INT8 and
+// INT16 are widened to int32 as in the proto path, so only columns whose
+// stored type is the Arrow type can be exported without copying.
+template <typename S, typename A>
+std::shared_ptr<arrow::Array>
+FixedWidthToArrow(milvus::OpContext* op_ctx,
+                  const std::shared_ptr<ChunkedColumnInterface>& column,
+                  const int64_t* seg_offsets,
+                  int64_t count) {
+    using T = typename A::TypeClass::c_type;
+    int64_t null_count = 0;
+    auto validity = BuildValidityBitmap(
+        op_ctx, column.get(), seg_offsets, count, null_count);
+    if constexpr (std::is_same_v<S, T>) {
+        int64_t offset_in_chunk = 0;
+        auto chunk_id = ContiguousChunkOf(
+            column.get(), seg_offsets, count, offset_in_chunk);
+        // A packed chunk has no plain values to share; DataOfChunk would
+        // decode all of it, so its rows are gathered below instead.
+        auto pw = chunk_id >= 0 ? column->GetChunk(op_ctx, chunk_id)
+                                : PinWrapper<Chunk*>(nullptr);
+        auto chunk = dynamic_cast<FixedWidthChunk*>(pw.get());
+        if (chunk != nullptr && !chunk->IsPacked()) {
+            auto data = chunk->Data() + offset_in_chunk * sizeof(T);
+            auto owner = std::make_shared<PinnedChunk<Chunk*>>(
+                PinnedChunk<Chunk*>{column, std::move(pw)});
+            if (reinterpret_cast<uintptr_t>(data) % alignof(T) == 0) {
+                auto values = std::make_shared<PinnedArrowBuffer>(
+                    data, count * sizeof(T), std::move(owner));
+                return std::make_shared<A>(
+                    count, std::move(values), validity, null_count);
+            }
+        }
+    }
+    std::shared_ptr<arrow::Buffer> values =
+        arrow::AllocateBuffer(count * sizeof(T)).ValueOrDie();
+    column->BulkPrimitiveValueAt(
+        op_ctx, values->mutable_data(), seg_offsets, count, false);
+    return std::make_shared<A>(count, values, validity, null_count);
+}
+
+std::shared_ptr<arrow::Array>
+BoolToArrow(milvus::OpContext* op_ctx,
+            const std::shared_ptr<ChunkedColumnInterface>& column,
+            const int64_t* seg_offsets,
+            int64_t count) {
+    int64_t null_count = 0;
+    auto validity = BuildValidityBitmap(
+        op_ctx, column.get(), seg_offsets, count, null_count);
+    auto bytes = std::make_unique<bool[]>(count);
+    column->BulkPrimitiveValueAt(
+        op_ctx, bytes.get(), seg_offsets, count, false);
+    std::shared_ptr<arrow::Buffer> values =
+        arrow::AllocateEmptyBitmap(count).ValueOrDie();
+    for (int64_t i = 0; i < count; ++i) {
+        if (bytes[i]) {
+            arrow::bit_util::SetBit(values->mutable_data(), i);
+        }
+    }
+    return std::make_shared<arrow::BooleanArray>(
+        count, values, validity, null_count);
+}
+
+// A is arrow::StringArray or arrow::BinaryArray. Consecutive rows of one
+// plain (not dictionary encoded) StringChunk share the chunk's bytes, with
+// only their offsets rebased; other rows are gathered into one builder
+// buffer rather than one std::string per row.
+template <typename A, typename Builder>
+std::shared_ptr<arrow::Array>
+VariableWidthToArrow(milvus::OpContext* op_ctx,
+                     const std::shared_ptr<ChunkedColumnInterface>& column,
+                     const int64_t* seg_offsets,
+                     int64_t count) {
+    int64_t offset_in_chunk = 0;
+    auto chunk_id =
+        ContiguousChunkOf(column.get(), seg_offsets, count, offset_in_chunk);
+    if (chunk_id >= 0) {
+        auto owner = std::make_shared<PinnedChunk<Chunk*>>(
+            PinnedChunk<Chunk*>{column, column->GetChunk(op_ctx, chunk_id)});
+        auto chunk = dynamic_cast<StringChunk*>(owner->pin.get());
+        if (chunk != nullptr && !chunk->IsDictionaryEncoded()) {
+            const uint32_t* src = chunk->Offsets() + offset_in_chunk;
+            auto begin = src[0];
+            auto size = static_cast<int64_t>(src[count]) - begin;
+            if (size <= std::numeric_limits<int32_t>::max()) {
+                std::shared_ptr<arrow::Buffer> offsets =
+                    arrow::AllocateBuffer((count + 1) * sizeof(int32_t))
+                        .ValueOrDie();
+                auto dst = reinterpret_cast<int32_t*>(offsets->mutable_data());
+                for (int64_t i = 0; i <= count; ++i) {
+                    dst[i] = static_cast<int32_t>(src[i] - begin);
+                }
+                int64_t null_count = 0;
+                auto validity = BuildValidityBitmap(
+                    op_ctx, column.get(), seg_offsets, count, null_count);
+                auto values = std::make_shared<PinnedArrowBuffer>(
+                    chunk->RawData() + begin, size, std::move(owner));
+                return std::make_shared<A>(
+                    count, offsets, std::move(values), validity, null_count);
+            }
+        }
+    }
+
+    Builder builder;
+    auto append = [&](std::string_view value, size_t i, bool is_valid) {
+        AssertInfo(static_cast<int64_t>(i) == builder.length(),
+                   "rows must be visited in order, got {} after {}",
+                   i,
+                   builder.length());
+        auto status = is_valid ? builder.Append(value) : builder.AppendNull();
+        AssertInfo(status.ok(),
+                   "failed to append to Arrow array: {}",
+                   status.ToString());
+    };
+    if constexpr (std::is_same_v<A, arrow::BinaryArray>) {
+        column->BulkRawJsonAt(
+            op_ctx,
+            [&](Json json, size_t i, bool is_valid) {
+                append(json.data(), i, is_valid);
+            },
+            seg_offsets,
+            count);
+    } else {
+        column->BulkRawStringAt(op_ctx, append, seg_offsets, count);
+    }
+    std::shared_ptr<arrow::Array> array;
+    auto status = builder.Finish(&array);
+    AssertInfo(
+        status.ok(), "failed to finish Arrow array: {}", status.ToString());
+    return array;
+}
+
+}  // namespace
+
+std::shared_ptr<arrow::Array>
+ChunkedSegmentSealedImpl::bulk_subscript_arrow(milvus::OpContext* op_ctx,
+                                               FieldId field_id,
+                                               const int64_t* seg_offsets,
+                                               int64_t count) const {
+    if (count == 0) {
+        return nullptr;
+    }
+    auto snapshot = CapturePublishedState();
+    auto& field_meta = snapshot->schema->operator[](field_id);
+    auto data_type = field_meta.get_data_type();
+
+    // Fields bulk_subscript serves from the int64 PK index or from a scalar
+    // index with raw data keep going through it.
+    auto pk_field_id = snapshot->schema->get_primary_field_id();
+    if (pk_field_id.has_value() && pk_field_id.value() == field_id &&
+        data_type == DataType::INT64) {
+        auto pk_index = PinPkIndex(snapshot->runtime, op_ctx);
+        if (pk_index.get() != nullptr && pk_index.get()->has_int64_pk_index()) {
+            return nullptr;
+        }
+    }
+    bool use_field_data =
+        SegcoreConfig::default_config()
+            .get_prefer_field_data_when_index_has_raw_data() &&
+        HasFieldData(field_id);
+    if (!use_field_data && IndexHasRawData(field_id)) {
+        return nullptr;
+    }
+
+    auto column = get_column(snapshot->runtime, field_id);
+    if (column == nullptr ||
+        !get_bit_if_present(snapshot->field_data_ready_bitset, field_id)) {
+        return nullptr;
+    }
+    switch (data_type) {
+        case DataType::BOOL:
+            return BoolToArrow(op_ctx, column, seg_offsets, count);
+        case DataType::INT8:
+            return FixedWidthToArrow<int8_t, arrow::Int32Array>(
+                op_ctx, column, seg_offsets, count);
+        case DataType::INT16:
+            return FixedWidthToArrow<int16_t, arrow::Int32Array>(
+                op_ctx, column, seg_offsets, count);
+        case DataType::INT32:
+            return FixedWidthToArrow<int32_t, arrow::Int32Array>(
+                op_ctx, column, seg_offsets, count);
+        case DataType::INT64:
+        case DataType::TIMESTAMPTZ:
+            return FixedWidthToArrow<int64_t, arrow::Int64Array>(
+                op_ctx, column, seg_offsets, count);
+        case DataType::FLOAT:
+            return FixedWidthToArrow<float, arrow::FloatArray>(
+                op_ctx, column, seg_offsets, count);
+        case DataType::DOUBLE:
+            return FixedWidthToArrow<double, arrow::DoubleArray>(
+                op_ctx, column, seg_offsets, count);
+        case DataType::VARCHAR:
+        case DataType::STRING:
+            return VariableWidthToArrow<arrow::StringArray,
+                                        arrow::StringBuilder>(
+                op_ctx, column, seg_offsets, count);
+        case DataType::JSON:
+            return VariableWidthToArrow<arrow::BinaryArray,
+                                        arrow::BinaryBuilder>(
+                op_ctx, column, seg_offsets, count);
+        default:
+            // TEXT lives in LOB files; arrays, geometry and vectors have no
+            // Arrow export yet.
+            return nullptr;
+    }
+}
+
 std::unique_ptr<DataArray>
 ChunkedSegmentSealedImpl::get_raw_data(milvus::OpContext* op_ctx,
                                        FieldId field_id,
@@ -521,6 +521,18 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
         bool fill_ids,
         milvus::OpContext* op_ctx = nullptr) const;
 
+    // Non-virtual helper called via dynamic_cast from the retrieve Arrow
+    // export. Reads a scalar field's column data at seg_offsets straight
+    // into an Arrow array, with the same physical types FieldDataToArrow
+    // gives for the proto path. Consecutive offsets within one chunk are
+    // exported without copying the values. Returns nullptr when the field
+    // would be served from an index or its type is not handled here.
+    std::shared_ptr<arrow::Array>
+    bulk_subscript_arrow(milvus::OpContext* op_ctx,
+                         FieldId field_id,
+                         const int64_t* seg_offsets,
+                         int64_t count) const;
+
     // count of chunk that has raw data
     int64_t
     num_chunk_data(FieldId field_id) const override;
@@ -618,6 +630,16 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
                     FieldId field_id,
                     int64_t chunk_id) const override;
 
+    PinWrapper<StringChunk*>
+    dictionary_string_chunk(milvus::OpContext* op_ctx,
+                            FieldId field_id,
+                            int64_t chunk_id) const override;
+
+    PinWrapper<FixedWidthChunk*>
+    packed_int_chunk(milvus::OpContext* op_ctx,
+                     FieldId field_id,
+                     int64_t chunk_id) const override;
+
     PinWrapper<std::pair<std::vector<std::string_view>, FixedVector<bool>>>
     chunk_string_view_impl(
         milvus::OpContext* op_ctx,
@@ -1390,6 +1390,90 @@ TEST_P(TestChunkSegment, TestPkRange) {
     }
 }
 
+// Sorted pk lookups read the pk chunks as plain arrays, so packing must
+// leave the pk alone while still packing the other integer fields.
+TEST(test_chunk_segment, PackedIntChunkKeepsPkSearchable) {
+    using namespace milvus::segcore;
+    auto packed = ENABLE_PACKED_INT_CHUNK.load();
+    ENABLE_PACKED_INT_CHUNK.store(true);
+
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64, false);
+    auto int_fid = schema->AddDebugField("int", DataType::INT64, false);
+    schema->AddField(FieldName("ts"),
+                     TimestampFieldID,
+                     DataType::INT64,
+                     false,
+                     std::nullopt);
+    schema->set_primary_field_id(pk_fid);
+    ASSERT_TRUE(schema->operator[](pk_fid).is_primary_key());
+    ASSERT_FALSE(schema->operator[](int_fid).is_primary_key());
+
+    auto segment = CreateSealedSegment(
+        schema, nullptr, -1, SegcoreConfig::default_config(), true);
+    auto segment_impl = dynamic_cast<ChunkedSegmentSealedImpl*>(segment.get());
+    ASSERT_NE(segment_impl, nullptr);
+
+    int test_data_count = 100;
+    auto cm = milvus::storage::RemoteChunkManagerSingleton::GetInstance()
+                  .GetRemoteChunkManager();
+    // small spans, which the chunk writer packs into one byte codes
+    std::vector<int64_t> pk_data(test_data_count);
+    std::iota(pk_data.begin(), pk_data.end(), 0);
+    std::vector<int64_t> ts_data(test_data_count, 1);
+    for (auto [fid, data] : {std::make_pair(pk_fid, &pk_data),
+                             std::make_pair(int_fid, &pk_data),
+                             std::make_pair(TimestampFieldID, &ts_data)}) {
+        auto field_data =
+            std::make_shared<FieldData<int64_t>>(DataType::INT64, false);
+        field_data->FillFieldData(data->data(), test_data_count);
+        std::vector<FieldDataPtr> field_datas = {field_data};
+        auto load_info = PrepareSingleFieldInsertBinlog(kCollectionID,
+                                                        kPartitionID,
+                                                        kSegmentID,
+                                                        fid.get(),
+                                                        field_datas,
+                                                        cm);
+        segment->LoadFieldData(load_info);
+    }
+    ENABLE_PACKED_INT_CHUNK.store(packed);
+
+    BitsetType bitset(test_data_count);
+    segment_impl->search_pks(bitset, {PkType(int64_t(7)), PkType(int64_t(99))});
+    EXPECT_EQ(bitset.count(), 2);
+    EXPECT_TRUE(bitset[7]);
+    EXPECT_TRUE(bitset[99]);
+
+    BitsetType range(test_data_count);
+    BitsetTypeView range_view(range);
+    segment_impl->pk_range(nullptr,
+                           proto::plan::OpType::LessEqual,
+                           PkType(int64_t(9)),
+                           range_view);
+    EXPECT_EQ(range_view.count(), 10);
+
+    // the missing pk is filtered out by the pk lookup
+    std::vector<idx_t> pks{1, 3, 5, 1000};
+    auto ids = std::make_unique<IdArray>();
+    ids->mutable_int_id()->mutable_data()->Add(pks.begin(), pks.end());
+    std::vector<Timestamp> timestamps(pks.size(), 10);
+    segment->Delete(pks.size(), ids.get(), timestamps.data());
+    EXPECT_EQ(segment->get_deleted_count(), 3);
+
+    // the packed field still filters correctly
+    proto::plan::GenericValue val;
+    val.set_int64_val(90);
+    auto expr = std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(int_fid, DataType::INT64),
+        proto::plan::OpType::GreaterEqual,
+        val);
+    auto plan =
+        std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+    auto filtered =
+        query::ExecuteQueryExpr(plan, segment.get(), test_data_count, 10);
+    EXPECT_EQ(filtered.count(), 10);
+}
+
 TEST(TestTTLFieldFilter, TestMaskWithTTLField) {
     using namespace milvus::segcore;
 
@@ -14,8 +14,10 @@
 #include <algorithm>
 #include <cstdint>
 
+#include "common/FastMem.h"
 #include "common/Types.h"
 #include "common/Utils.h"
+#include "common/VectorArray.h"
 #include "fmt/core.h"
 #include "pb/schema.pb.h"
 #include "simdjson/padded_string.h"
@@ -184,4 +186,71 @@ VectorBase::set_data_raw(ssize_t element_offset,
     }
 }
 
+std::shared_ptr<const PackedVectorArrays>
+PackedVectorArrays::Pack(const VectorArray* rows, int64_t row_count) {
+    auto packed = std::make_shared<PackedVectorArrays>();
+    size_t total_bytes = 0;
+    packed->offsets.reserve(row_count + 1);
+    packed->offsets.push_back(0);
+    for (int64_t i = 0; i < row_count; ++i) {
+        total_bytes += rows[i].byte_size();
+        packed->offsets.push_back(packed->offsets.back() + rows[i].length());
+    }
+    packed->data = std::make_unique<uint8_t[]>(total_bytes);
+    packed->data_size = total_bytes;
+    auto ptr = packed->data.get();
+    for (int64_t i = 0; i < row_count; ++i) {
+        milvus::fastmem::FastMemcpy(ptr, rows[i].data(), rows[i].byte_size());
+        ptr += rows[i].byte_size();
+    }
+    return packed;
+}
+
+std::shared_ptr<const PackedVectorArrays>
+ConcurrentVector<VectorArray>::get_packed_chunk(ssize_t chunk_id,
+                                                int64_t row_count) const {
+    if (row_count == size_per_chunk_) {
+        std::lock_guard<std::mutex> lck(packed_mutex_);
+        if (chunk_id < static_cast<ssize_t>(packed_chunks_.size()) &&
+            packed_chunks_[chunk_id] != nullptr) {
+            return packed_chunks_[chunk_id];
+        }
+    }
+    auto rows = static_cast<const VectorArray*>(get_chunk_data(chunk_id));
+    return PackedVectorArrays::Pack(rows, row_count);
+}
+
+int64_t
+ConcurrentVector<VectorArray>::pack_complete_chunks(int64_t row_count) {
+    auto complete = std::min<int64_t>(row_count / size_per_chunk_,
+                                      static_cast<int64_t>(num_chunk()));
+    std::vector<int64_t> missing;
+    {
+        std::lock_guard<std::mutex> lck(packed_mutex_);
+        for (int64_t chunk_id = 0; chunk_id < complete; ++chunk_id) {
+            if (chunk_id >= static_cast<int64_t>(packed_chunks_.size()) ||
+                packed_chunks_[chunk_id] == nullptr) {
+                missing.push_back(chunk_id);
+            }
+        }
+    }
+    // Packed outside the lock, so searches are not held up; concurrent
+    // inserts may pack the same chunk, and only one copy is kept.
+    int64_t added = 0;
+    for (auto chunk_id : missing) {
+        auto rows = static_cast<const VectorArray*>(get_chunk_data(chunk_id));
+        auto packed = PackedVectorArrays::Pack(rows, size_per_chunk_);
+        std::lock_guard<std::mutex> lck(packed_mutex_);
+        if (chunk_id >= static_cast<int64_t>(packed_chunks_.size())) {
+            packed_chunks_.resize(chunk_id + 1);
+        }
+        if (packed_chunks_[chunk_id] == nullptr) {
+            added += packed->ByteSize();
+            packed_bytes_ += packed->ByteSize();
+            packed_chunks_[chunk_id] = std::move(packed);
+        }
+    }
+    return added;
+}
+
 }  // namespace milvus::segcore
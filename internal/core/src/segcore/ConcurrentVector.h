@@ -602,6 +602,29 @@ class ConcurrentVector<Array> : public ConcurrentVectorImpl<Array, true> {
     }
 };
 
+// The vectors of consecutive vector array rows stored back to back, as
+// knowhere reads embedding lists. Row i holds the vectors
+// [offsets[i], offsets[i + 1]).
+struct PackedVectorArrays {
+    std::unique_ptr<uint8_t[]> data;
+    std::vector<size_t> offsets;
+
+    static std::shared_ptr<const PackedVectorArrays>
+    Pack(const VectorArray* rows, int64_t row_count);
+
+    int64_t
+    num_vectors() const {
+        return offsets.back();
+    }
+
+    int64_t
+    ByteSize() const {
+        return data_size + offsets.size() * sizeof(size_t);
+    }
+
+    size_t data_size = 0;
+};
+
 template <>
 class ConcurrentVector<VectorArray>
     : public ConcurrentVectorImpl<VectorArray, true> {
@@ -619,6 +642,38 @@ class ConcurrentVector<VectorArray>
               valid_data_ptr,
               use_mapping_storage) {
     }
+
+    // The first row_count rows of a chunk, packed for brute-force search.
+    // Complete chunks come from the copies kept by pack_complete_chunks;
+    // the partial tail, or a chunk not packed yet, is packed per call.
+    std::shared_ptr<const PackedVectorArrays>
+    get_packed_chunk(ssize_t chunk_id, int64_t row_count) const;
+
+    // Packs and keeps every complete chunk within the first row_count rows
+    // that has no packed copy yet. Returns the bytes added.
+    int64_t
+    pack_complete_chunks(int64_t row_count);
+
+    // Bytes held by the kept packed chunks.
+    int64_t
+    packed_byte_size() const {
+        return packed_bytes_.load();
+    }
+
+    void
+    clear() override {
+        {
+            std::lock_guard<std::mutex> lck(packed_mutex_);
+            packed_chunks_.clear();
+            packed_bytes_ = 0;
+        }
+        ConcurrentVectorImpl<VectorArray, true>::clear();
+    }
+
+ private:
+    mutable std::mutex packed_mutex_;
+    std::vector<std::shared_ptr<const PackedVectorArrays>> packed_chunks_;
+    std::atomic<int64_t> packed_bytes_{0};
 };
 
 template <>
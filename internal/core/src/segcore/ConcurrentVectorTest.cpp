@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "common/OffsetMapping.h"
+#include "common/VectorArray.h"
 #include "gtest/gtest.h"
 #include "segcore/AckResponder.h"
 #include "segcore/ConcurrentVector.h"
@@ -117,3 +118,45 @@ TEST(ConcurrentVector, TestAckSingle) {
     }
     EXPECT_EQ(ack.GetAck(), N);
 }
+
+TEST(ConcurrentVector, PackedVectorArrayChunks) {
+    constexpr int64_t dim = 4;
+    constexpr int64_t size_per_chunk = 4;
+    ConcurrentVector<milvus::VectorArray> c_vec(dim, size_per_chunk);
+    std::vector<milvus::VectorArray> rows;
+    std::vector<float> expected;
+    for (int i = 0; i < 6; ++i) {
+        // Row i holds i + 1 vectors.
+        std::vector<float> vectors((i + 1) * dim);
+        for (auto& x : vectors) {
+            x = expected.size();
+            expected.push_back(x);
+        }
+        rows.emplace_back(
+            vectors.data(), i + 1, dim, milvus::DataType::VECTOR_FLOAT);
+    }
+    c_vec.set_data_raw(0, rows.data(), rows.size());
+
+    // Only the complete first chunk is kept.
+    auto packed_bytes = c_vec.pack_complete_chunks(rows.size());
+    ASSERT_GT(packed_bytes, 0);
+    ASSERT_EQ(c_vec.packed_byte_size(), packed_bytes);
+    ASSERT_EQ(c_vec.pack_complete_chunks(rows.size()), 0);
+
+    auto full = c_vec.get_packed_chunk(0, size_per_chunk);
+    ASSERT_EQ(full->ByteSize(), packed_bytes);
+    ASSERT_EQ(full->offsets, std::vector<size_t>({0, 1, 3, 6, 10}));
+    ASSERT_EQ(full->num_vectors(), 10);
+    auto data = reinterpret_cast<const float*>(full->data.get());
+    ASSERT_TRUE(std::equal(data, data + 10 * dim, expected.begin()));
+    ASSERT_EQ(c_vec.get_packed_chunk(0, size_per_chunk), full);
+
+    auto partial = c_vec.get_packed_chunk(1, 2);
+    ASSERT_EQ(partial->offsets, std::vector<size_t>({0, 5, 11}));
+    data = reinterpret_cast<const float*>(partial->data.get());
+    ASSERT_TRUE(std::equal(data, data + 11 * dim, expected.begin() + 40));
+    ASSERT_NE(c_vec.get_packed_chunk(1, 2), partial);
+
+    c_vec.clear();
+    ASSERT_EQ(c_vec.packed_byte_size(), 0);
+}
@@ -0,0 +1,281 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/DeleteEntryStore.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <queue>
+
+#include "common/EasyAssert.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+void
+PutVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t
+GetVarint(const uint8_t* data, size_t& pos) {
+    uint64_t value = 0;
+    int shift = 0;
+    while (data[pos] & 0x80) {
+        value |= static_cast<uint64_t>(data[pos++] & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= static_cast<uint64_t>(data[pos++]) << shift;
+    return value;
+}
+
+}  // namespace
+
+DeleteRun::DeleteRun(const std::vector<DeleteEntry>& entries)
+    : num_entries_(entries.size()) {
+    blocks_.reserve((entries.size() + kBlockSize - 1) / kBlockSize);
+    data_.reserve(entries.size() * 5);
+    for (size_t begin = 0; begin < entries.size(); begin += kBlockSize) {
+        auto end = std::min(entries.size(), begin + kBlockSize);
+        AssertInfo(data_.size() <= std::numeric_limits<uint32_t>::max(),
+                   "delete run of {} entries is too large",
+                   entries.size());
+        blocks_.push_back({entries[begin],
+                           entries[end - 1],
+                           static_cast<uint32_t>(data_.size()),
+                           static_cast<uint32_t>(end - begin)});
+        auto prev_ts = entries[begin].first;
+        for (auto i = begin; i < end; ++i) {
+            PutVarint(data_, entries[i].first - prev_ts);
+            PutVarint(data_, static_cast<uint32_t>(entries[i].second));
+            prev_ts = entries[i].first;
+        }
+    }
+    data_.shrink_to_fit();
+}
+
+std::vector<DeleteEntry>
+DeleteRun::Decode() const {
+    std::vector<DeleteEntry> entries;
+    entries.reserve(num_entries_);
+    for (Cursor cursor(this, kFirstDeleteEntry); cursor.Valid();
+         cursor.Next()) {
+        entries.push_back(cursor.Get());
+    }
+    return entries;
+}
+
+void
+DeleteRun::SetDeletedBits(BitsetTypeView& bitset,
+                          const DeleteEntry& from,
+                          Timestamp ts,
+                          int64_t limit) const {
+    // Blocks entirely before 'from' are skipped by their last entry.
+    auto block = std::partition_point(
+        blocks_.begin(), blocks_.end(), [&](const Block& b) {
+            return b.last < from;
+        });
+    for (; block != blocks_.end() && block->first.first <= ts; ++block) {
+        // Whole-block takes skip the per-entry comparisons.
+        const bool take_all = block->last.first <= ts && from <= block->first;
+        size_t pos = block->data_offset;
+        auto prev_ts = block->first.first;
+        for (uint32_t i = 0; i < block->count; ++i) {
+            DeleteEntry entry;
+            entry.first = prev_ts + GetVarint(data_.data(), pos);
+            entry.second = static_cast<Offset>(GetVarint(data_.data(), pos));
+            prev_ts = entry.first;
+            if (!take_all) {
+                if (entry.first > ts) {
+                    return;
+                }
+                if (entry < from) {
+                    continue;
+                }
+            }
+            if (entry.second < limit) {
+                bitset[entry.second] = true;
+            }
+        }
+    }
+}
+
+DeleteRun::Cursor::Cursor(const DeleteRun* run, const DeleteEntry& from)
+    : run_(run) {
+    auto block = std::partition_point(
+        run_->blocks_.begin(), run_->blocks_.end(), [&](const Block& b) {
+            return b.last < from;
+        });
+    block_ = block - run_->blocks_.begin();
+    if (!Valid()) {
+        return;
+    }
+    pos_ = run_->blocks_[block_].data_offset;
+    current_.first = run_->blocks_[block_].first.first;
+    DecodeCurrent();
+    while (Valid() && current_ < from) {
+        Next();
+    }
+}
+
+void
+DeleteRun::Cursor::DecodeCurrent() {
+    current_.first += GetVarint(run_->data_.data(), pos_);
+    current_.second =
+        static_cast<Offset>(GetVarint(run_->data_.data(), pos_));
+}
+
+void
+DeleteRun::Cursor::Next() {
+    if (++index_in_block_ == run_->blocks_[block_].count) {
+        index_in_block_ = 0;
+        if (++block_ == run_->blocks_.size()) {
+            return;
+        }
+        pos_ = run_->blocks_[block_].data_offset;
+        current_.first = run_->blocks_[block_].first.first;
+    }
+    DecodeCurrent();
+}
+
+void
+DeleteEntryStore::Append(const std::vector<DeleteEntry>& entries) {
+    if (entries.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> write_lck(write_mutex_);
+    std::vector<DeleteEntry> flushed;
+    {
+        std::unique_lock<std::shared_mutex> lck(mutex_);
+        buffer_.insert(buffer_.end(), entries.begin(), entries.end());
+        num_entries_ += entries.size();
+        if (buffer_.size() < kBufferSize) {
+            return;
+        }
+        // Keep serving the buffer to readers until the runs replacing it
+        // are published.
+        flushed = buffer_;
+    }
+
+    // Only writers change runs_, so it can be read without mutex_ here.
+    auto runs = runs_;
+    std::sort(flushed.begin(), flushed.end());
+    auto run = std::make_shared<const DeleteRun>(flushed);
+    while (!runs.empty() && runs.back()->size() <= 2 * run->size()) {
+        auto older = runs.back()->Decode();
+        auto newer = run->Decode();
+        std::vector<DeleteEntry> merged;
+        merged.reserve(older.size() + newer.size());
+        std::merge(older.begin(),
+                   older.end(),
+                   newer.begin(),
+                   newer.end(),
+                   std::back_inserter(merged));
+        run = std::make_shared<const DeleteRun>(merged);
+        runs.pop_back();
+    }
+    runs.push_back(std::move(run));
+
+    std::unique_lock<std::shared_mutex> lck(mutex_);
+    runs_ = std::move(runs);
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+}
+
+size_t
+DeleteEntryStore::memory_size() const {
+    std::shared_lock<std::shared_mutex> lck(mutex_);
+    size_t total = buffer_.capacity() * sizeof(DeleteEntry);
+    for (const auto& run : runs_) {
+        total += run->memory_size();
+    }
+    return total;
+}
+
+void
+DeleteEntryStore::SetDeletedBits(BitsetTypeView& bitset,
+                                 const DeleteEntry& from,
+                                 Timestamp ts,
+                                 int64_t limit) const {
+    std::vector<std::shared_ptr<const DeleteRun>> runs;
+    {
+        std::shared_lock<std::shared_mutex> lck(mutex_);
+        for (const auto& entry : buffer_) {
+            if (entry.first <= ts && !(entry < from) && entry.second < limit) {
+                bitset[entry.second] = true;
+            }
+        }
+        runs = runs_;
+    }
+    for (const auto& run : runs) {
+        run->SetDeletedBits(bitset, from, ts, limit);
+    }
+}
+
+void
+DeleteEntryStore::ForEachFrom(
+    const DeleteEntry& from,
+    const std::function<bool(const DeleteEntry&)>& fn) const {
+    std::vector<std::shared_ptr<const DeleteRun>> runs;
+    std::vector<DeleteEntry> pending;
+    {
+        std::shared_lock<std::shared_mutex> lck(mutex_);
+        std::copy_if(buffer_.begin(),
+                     buffer_.end(),
+                     std::back_inserter(pending),
+                     [&](const DeleteEntry& entry) { return !(entry < from); });
+        runs = runs_;
+    }
+    std::sort(pending.begin(), pending.end());
+
+    // K-way merge of the runs and the sorted buffer entries; the buffer is
+    // source runs.size().
+    std::vector<DeleteRun::Cursor> cursors;
+    cursors.reserve(runs.size());
+    using HeapItem = std::pair<DeleteEntry, size_t>;
+    std::priority_queue<HeapItem, std::vector<HeapItem>, std::greater<>> heap;
+    for (const auto& run : runs) {
+        cursors.emplace_back(run.get(), from);
+        if (cursors.back().Valid()) {
+            heap.emplace(cursors.back().Get(), cursors.size() - 1);
+        }
+    }
+    size_t pending_pos = 0;
+    if (!pending.empty()) {
+        heap.emplace(pending[0], runs.size());
+    }
+    while (!heap.empty()) {
+        auto [entry, source] = heap.top();
+        heap.pop();
+        if (!fn(entry)) {
+            return;
+        }
+        if (source == runs.size()) {
+            if (++pending_pos < pending.size()) {
+                heap.emplace(pending[pending_pos], source);
+            }
+            continue;
+        }
+        auto& cursor = cursors[source];
+        cursor.Next();
+        if (cursor.Valid()) {
+            heap.emplace(cursor.Get(), source);
+        }
+    }
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,163 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include "common/Types.h"
+
+namespace milvus::segcore {
+
+using Offset = int32_t;
+
+// A delete of the row at Offset at Timestamp. Entries are ordered by
+// timestamp, then offset.
+using DeleteEntry = std::pair<Timestamp, Offset>;
+
+// Not greater than any entry.
+constexpr DeleteEntry kFirstDeleteEntry{0, 0};
+
+// Immutable sorted run of delete entries, delta-encoded in blocks.
+//
+// Each block holds up to kBlockSize entries as varint pairs of (timestamp
+// delta to the previous entry, offset), typically 4-5 bytes per entry, and
+// keeps its first and last entry in the header so scans can skip or take
+// whole blocks by timestamp.
+class DeleteRun {
+ public:
+    static constexpr size_t kBlockSize = 1024;
+
+    // 'entries' must be sorted.
+    explicit DeleteRun(const std::vector<DeleteEntry>& entries);
+
+    size_t
+    size() const {
+        return num_entries_;
+    }
+
+    size_t
+    memory_size() const {
+        return data_.capacity() + blocks_.capacity() * sizeof(Block);
+    }
+
+    std::vector<DeleteEntry>
+    Decode() const;
+
+    // Sets bitset[offset] for the entries e with from <= e,
+    // e.first <= ts and offset < limit.
+    void
+    SetDeletedBits(BitsetTypeView& bitset,
+                   const DeleteEntry& from,
+                   Timestamp ts,
+                   int64_t limit) const;
+
+    // Iterates the entries from a position in order.
+    class Cursor {
+     public:
+        Cursor(const DeleteRun* run, const DeleteEntry& from);
+
+        bool
+        Valid() const {
+            return block_ < run_->blocks_.size();
+        }
+
+        const DeleteEntry&
+        Get() const {
+            return current_;
+        }
+
+        void
+        Next();
+
+     private:
+        void
+        DecodeCurrent();
+
+        const DeleteRun* run_;
+        size_t block_{0};
+        size_t index_in_block_{0};
+        size_t pos_{0};
+        DeleteEntry current_{};
+    };
+
+ private:
+    struct Block {
+        DeleteEntry first;
+        DeleteEntry last;
+        uint32_t data_offset;
+        uint32_t count;
+    };
+
+    std::vector<Block> blocks_;
+    std::vector<uint8_t> data_;
+    size_t num_entries_{0};
+};
+
+// Storage of the delete entries of a segment, replacing a skiplist node per
+// entry.
+//
+// New entries go to an unsorted append buffer. Once the buffer holds
+// kBufferSize entries it is sorted into a DeleteRun, and runs are merged
+// LSM-style while a run is not more than twice the size of the one after
+// it. The store therefore has O(log n) runs, and each entry is re-encoded
+// O(log n) times.
+//
+// Writers are serialized. Readers take a shared lock only to scan the
+// buffer and to copy the run list, so they never wait on a merge.
+class DeleteEntryStore {
+ public:
+    static constexpr size_t kBufferSize = 4096;
+
+    // Adds entries, which need not be sorted.
+    void
+    Append(const std::vector<DeleteEntry>& entries);
+
+    int64_t
+    size() const {
+        std::shared_lock<std::shared_mutex> lck(mutex_);
+        return num_entries_;
+    }
+
+    size_t
+    memory_size() const;
+
+    // Sets bitset[offset] for the entries e with from <= e,
+    // e.first <= ts and offset < limit.
+    void
+    SetDeletedBits(BitsetTypeView& bitset,
+                   const DeleteEntry& from,
+                   Timestamp ts,
+                   int64_t limit) const;
+
+    // Calls 'fn' on the entries not less than 'from', in order, until it
+    // returns false.
+    void
+    ForEachFrom(const DeleteEntry& from,
+                const std::function<bool(const DeleteEntry&)>& fn) const;
+
+ private:
+    // Serializes Append.
+    std::mutex write_mutex_;
+    // Guards the members below.
+    mutable std::shared_mutex mutex_;
+    std::vector<DeleteEntry> buffer_;
+    std::vector<std::shared_ptr<const DeleteRun>> runs_;
+    int64_t num_entries_{0};
+};
+
+}  // namespace milvus::segcore
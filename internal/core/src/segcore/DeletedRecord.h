@@ -14,16 +14,17 @@
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <tuple>
 #include <utility>
 #include <vector>
-#include <folly/ConcurrentSkipList.h>
 
 #include "AckResponder.h"
 #include "common/Common.h"
 #include "common/Schema.h"
 #include "common/Types.h"
+#include "segcore/DeleteEntryStore.h"
 #include "segcore/Record.h"
 #include "segcore/InsertRecord.h"
 #include "segcore/SegmentInterface.h"
@@ -31,25 +32,6 @@
 
 namespace milvus::segcore {
 
-using Offset = int32_t;
-
-struct Comparator {
-    bool
-    operator()(const std::pair<Timestamp, Offset>& left,
-               const std::pair<Timestamp, Offset>& right) const {
-        if (left.first == right.first) {
-            return left.second < right.second;
-        }
-        return left.first < right.first;
-    }
-};
-
-// a lock-free list for multi-thread insert && read
-using SortedDeleteList =
-    folly::ConcurrentSkipList<std::pair<Timestamp, Offset>, Comparator>;
-
-static int32_t DELETE_PAIR_SIZE = sizeof(std::pair<Timestamp, Offset>);
-
 // atomic snapshot for fast path query optimization
 // contains a consistent view of (max_timestamp, deleted_bitset)
 struct DeleteSnapshot {
@@ -77,8 +59,7 @@ class DeletedRecord {
                   int64_t segment_id)
         : insert_record_(insert_record),
           search_pk_func_(std::move(search_pk_func)),
-          segment_id_(segment_id),
-          deleted_lists_(SortedDeleteList::createInstance()) {
+          segment_id_(segment_id) {
     }
 
     ~DeletedRecord() {
@@ -134,10 +115,9 @@ class DeletedRecord {
     Timestamp
     InternalPush(const std::vector<PkType>& pks, const Timestamp* timestamps) {
         int64_t removed_num = 0;
-        int64_t mem_add = 0;
         Timestamp max_timestamp = 0;
+        std::vector<DeleteEntry> entries;
 
-        SortedDeleteList::Accessor accessor(deleted_lists_);
         for (size_t i = 0; i < pks.size(); ++i) {
             auto deleted_ts = timestamps[i];
             if (deleted_ts > max_timestamp) {
@@ -168,7 +148,7 @@ class DeletedRecord {
                 if (insert_ts != 0 && delete_ts <= insert_ts) {
                     return;
                 }
-                accessor.insert(std::make_pair(delete_ts, row_id));
+                entries.emplace_back(delete_ts, row_id);
                 if constexpr (is_sealed) {
                     Assert(deleted_mask_.size() > 0);
                     deleted_mask_.set(row_id);
@@ -178,11 +158,11 @@ class DeletedRecord {
                     deleted_mask_.set(row_id);
                 }
                 removed_num++;
-                mem_add += DELETE_PAIR_SIZE;
             });
 
+        deleted_entries_.Append(entries);
         n_.fetch_add(removed_num);
-        mem_size_.fetch_add(mem_add);
+        mem_size_.store(deleted_entries_.memory_size());
 
         if constexpr (is_sealed) {
             // update estimated memory size to caching layer only when the delta is large enough (64KB)
@@ -230,13 +210,12 @@ class DeletedRecord {
           Timestamp query_timestamp) {
         Assert(bitset.size() == insert_barrier);
 
-        SortedDeleteList::Accessor accessor(deleted_lists_);
-        if (accessor.size() == 0) {
+        if (deleted_entries_.size() == 0) {
             return;
         }
 
         // fast path: use atomic snapshot when query_timestamp >= max_delete_timestamp
-        // this avoids traversing the SkipList entirely
+        // this avoids scanning the delete entries entirely
         auto snapshot = std::atomic_load(&latest_snapshot_);
         if (snapshot && snapshot->max_ts > 0 &&
             query_timestamp >= snapshot->max_ts) {
@@ -245,9 +224,8 @@ class DeletedRecord {
             return;
         }
 
-        // slow path: try use snapshot to skip iterations
-        bool hit_snapshot = false;
-        SortedDeleteList::iterator next_iter;
+        // slow path: try use snapshot to skip the entries it covers
+        DeleteEntry next_pos = kFirstDeleteEntry;
         {
             std::shared_lock<std::shared_mutex> lock(snap_lock_);
             // find last meeted snapshot
@@ -257,24 +235,16 @@ class DeletedRecord {
                     loc--;
                 }
                 if (loc >= 0) {
-                    // use lower_bound to relocate the iterator in current accessor
-                    next_iter = accessor.lower_bound(snap_next_pos_[loc]);
+                    next_pos = snap_next_pos_[loc];
                     auto or_size =
                         std::min(snapshots_[loc].second.size(), bitset.size());
                     bitset.inplace_or(snapshots_[loc].second, or_size);
-                    hit_snapshot = true;
                 }
             }
         }
 
-        auto it = hit_snapshot ? next_iter : accessor.begin();
-
-        while (it != accessor.end() && it->first <= query_timestamp) {
-            if (it->second < insert_barrier) {
-                bitset.set(it->second);
-            }
-            it++;
-        }
+        deleted_entries_.SetDeletedBits(
+            bitset, next_pos, query_timestamp, insert_barrier);
     }
 
     size_t
@@ -294,8 +264,7 @@ class DeletedRecord {
 
     void
     DumpSnapshot() {
-        SortedDeleteList::Accessor accessor(deleted_lists_);
-        int total_size = accessor.size();
+        int64_t total_size = deleted_entries_.size();
 
         while (total_size - dumped_entry_count_.load() >
                DELETE_DUMP_BATCH_SIZE) {
@@ -307,49 +276,54 @@ class DeletedRecord {
             }
             BitsetType bitmap(bitsize, false);
 
-            auto it = accessor.begin();
+            DeleteEntry cursor = kFirstDeleteEntry;
             Timestamp last_dump_ts = 0;
             if (!snapshots_.empty()) {
-                it = accessor.lower_bound(snap_next_pos_.back());
+                cursor = snap_next_pos_.back();
                 bitmap.inplace_or(snapshots_.back().second,
                                   snapshots_.back().second.size());
             }
 
             bool need_rebuild = false;
             while (total_size - dumped_entry_count_.load() >
-                       DELETE_DUMP_BATCH_SIZE &&
-                   it != accessor.end()) {
+                   DELETE_DUMP_BATCH_SIZE) {
                 Timestamp dump_ts = 0;
-
-                for (auto size = 0;
-                     size < DELETE_DUMP_BATCH_SIZE && it != accessor.end();
-                     ++it, ++size) {
-                    bitmap.set(it->second);
-                    dump_ts = it->first;
-                }
-
-                if (it == accessor.end() || !it.good()) {
-                    // Iterator exhausted before expected: elements
-                    // were inserted before cursor (same timestamp,
-                    // smaller row_id), making existing snapshots
-                    // incorrect — those deletes are missing from
-                    // the bitmap. Discard all snapshots and rebuild
-                    // from scratch.
+                std::optional<DeleteEntry> next_pos;
+                int64_t size = 0;
+                deleted_entries_.ForEachFrom(
+                    cursor, [&](const DeleteEntry& entry) {
+                        if (size == DELETE_DUMP_BATCH_SIZE) {
+                            next_pos = entry;
+                            return false;
+                        }
+                        bitmap.set(entry.second);
+                        dump_ts = entry.first;
+                        ++size;
+                        return true;
+                    });
+
+                if (!next_pos.has_value()) {
+                    // Entries ran out before expected: elements were
+                    // inserted before cursor (same timestamp, smaller
+                    // row_id), making existing snapshots incorrect —
+                    // those deletes are missing from the bitmap. Discard
+                    // all snapshots and rebuild from scratch.
                     need_rebuild = true;
                     break;
                 }
+                cursor = *next_pos;
 
                 {
                     std::unique_lock<std::shared_mutex> lock(snap_lock_);
                     if (dump_ts == last_dump_ts) {
                         // only update
                         snapshots_.back().second = bitmap.clone();
-                        snap_next_pos_.back() = *it;
+                        snap_next_pos_.back() = cursor;
                     } else {
                         // add new snapshot
                         snapshots_.push_back(
                             std::make_pair(dump_ts, bitmap.clone()));
-                        snap_next_pos_.push_back(*it);
+                        snap_next_pos_.push_back(cursor);
                     }
                 }
 
@@ -383,7 +357,7 @@ class DeletedRecord {
                         segment_id_);
                 }
                 // Continue outer loop — next iteration rebuilds
-                // from accessor.begin() with empty snapshots.
+                // from the first entry with empty snapshots.
                 continue;
             }
         }
@@ -391,8 +365,7 @@ class DeletedRecord {
 
     int64_t
     size() const {
-        SortedDeleteList::Accessor accessor(deleted_lists_);
-        return accessor.size();
+        return deleted_entries_.size();
     }
 
     size_t
@@ -426,7 +399,7 @@ class DeletedRecord {
                        std::function<void(SegOffset offset, Timestamp ts)>)>
         search_pk_func_;
     int64_t segment_id_{0};
-    std::shared_ptr<SortedDeleteList> deleted_lists_;
+    DeleteEntryStore deleted_entries_;
     // max timestamp of deleted records which replayed in load process
     Timestamp max_load_timestamp_{0};
     int32_t sealed_row_count_;
@@ -438,7 +411,7 @@ class DeletedRecord {
     std::vector<std::pair<Timestamp, BitsetType>> snapshots_;
     // next delete record position that follows every snapshot
     // store position (timestamp, offset)
-    std::vector<std::pair<Timestamp, Offset>> snap_next_pos_;
+    std::vector<DeleteEntry> snap_next_pos_;
     // total number of delete entries that have been incorporated into snapshots
     std::atomic<int64_t> dumped_entry_count_{0};
     // estimated memory size of DeletedRecord, only used for sealed segment
@@ -446,7 +419,7 @@ class DeletedRecord {
 
     // atomic snapshot for fast path query optimization
     // when query_timestamp >= snapshot.max_ts, we can directly use the bitset
-    // without traversing the SkipList
+    // without scanning the delete entries
     std::shared_ptr<const DeleteSnapshot> latest_snapshot_;
     mutable std::mutex snapshot_update_mutex_;
 };
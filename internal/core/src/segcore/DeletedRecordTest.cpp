@@ -19,6 +19,7 @@
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -35,6 +36,7 @@
 #include "query/Utils.h"
 #include "segcore/AckResponder.h"
 #include "segcore/ConcurrentVector.h"
+#include "segcore/DeleteEntryStore.h"
 #include "segcore/DeletedRecord.h"
 #include "segcore/InsertRecord.h"
 #include "segcore/Record.h"
@@ -911,3 +913,51 @@ TEST(DeleteMVCC, SnapshotDumpProgress) {
     ASSERT_EQ(2, snapshots.size());
     ASSERT_EQ(20000, snapshots[1].second.count());
 }
+
+TEST(DeleteEntryStore, MatchesSortedEntries) {
+    std::default_random_engine er(42);
+    const int64_t N = 100000;
+    DeleteEntryStore store;
+    std::vector<DeleteEntry> all;
+    for (int batch = 0; batch < 100; ++batch) {
+        // Unordered batches first, as when loading delta logs, then
+        // ascending ones, as when streaming.
+        std::vector<DeleteEntry> entries;
+        for (int i = 0; i < 1000; ++i) {
+            Timestamp ts = batch < 50 ? er() % 100000 : batch * 1000 + i;
+            entries.emplace_back(ts, static_cast<Offset>(er() % N));
+        }
+        store.Append(entries);
+        all.insert(all.end(), entries.begin(), entries.end());
+    }
+    ASSERT_EQ(store.size(), all.size());
+    // Well below the 16 bytes of a bare (Timestamp, Offset) pair.
+    ASSERT_LT(store.memory_size(), all.size() * 8);
+    std::sort(all.begin(), all.end());
+
+    for (int i = 0; i < 20; ++i) {
+        auto from = i == 0 ? kFirstDeleteEntry : all[er() % all.size()];
+        auto ts = all[er() % all.size()].first;
+        int64_t limit = i % 2 == 0 ? N : N / 2;
+
+        BitsetType expected(N, false);
+        for (const auto& entry : all) {
+            if (!(entry < from) && entry.first <= ts && entry.second < limit) {
+                expected.set(entry.second);
+            }
+        }
+        BitsetType bitset(N, false);
+        BitsetTypeView view(bitset);
+        store.SetDeletedBits(view, from, ts, limit);
+        ASSERT_TRUE(bitset == expected);
+
+        std::vector<DeleteEntry> visited;
+        store.ForEachFrom(from, [&](const DeleteEntry& entry) {
+            visited.push_back(entry);
+            return visited.size() < 5000;
+        });
+        auto begin = std::lower_bound(all.begin(), all.end(), from);
+        auto count = std::min<size_t>(5000, all.end() - begin);
+        ASSERT_EQ(visited, std::vector<DeleteEntry>(begin, begin + count));
+    }
+}
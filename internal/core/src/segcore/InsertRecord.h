@@ -12,8 +12,11 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <numeric>
 #include <cstddef>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -23,6 +26,10 @@
 #include <utility>
 #include <vector>
 
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+#include <folly/small_vector.h>
+
 #include "TimestampData.h"
 #include "TimestampIndex.h"
 #include "common/ArrayOffsets.h"
@@ -242,6 +249,21 @@ class CompressedInt64PkArray {
     std::vector<uint8_t> data_;              // Bitpacked deltas
 };
 
+// Lower bound of 'value' in the sorted [first, last), found by doubling the
+// step from 'first'. A result d positions away costs O(log d) comparisons,
+// so probing ascending keys one after another is a single merge-like pass.
+template <typename Iter, typename V, typename Less>
+Iter
+gallop_lower_bound(Iter first, Iter last, const V& value, Less less) {
+    typename std::iterator_traits<Iter>::difference_type step = 1;
+    while (last - first > step && less(first[step], value)) {
+        first += step;
+        step *= 2;
+    }
+    return std::lower_bound(
+        first, last - first > step ? first + step : last, value, less);
+}
+
 class OffsetMap {
  public:
     virtual ~OffsetMap() = default;
@@ -252,6 +274,18 @@ class OffsetMap {
     virtual std::vector<int64_t>
     find(const PkType& pk) const = 0;
 
+    // Calls 'callback(i, offset)' for every offset of pks[i]. The pks may be
+    // visited in any order.
+    virtual void
+    find_batch(const std::vector<PkType>& pks,
+               const std::function<void(size_t, int64_t)>& callback) const {
+        for (size_t i = 0; i < pks.size(); ++i) {
+            for (auto offset : find(pks[i])) {
+                callback(i, offset);
+            }
+        }
+    }
+
     virtual void
     find_range(const PkType& pk,
                proto::plan::OpType op,
@@ -574,19 +608,369 @@ class OffsetOrderedMap : public OffsetMap {
     mutable std::shared_mutex mtx_;
 };
 
+// Primary key index of growing segments.
+//
+// Point lookups (contain, find and Equal find_range), which every delete
+// and upsert issues, go to one of kNumShards hash maps, each behind its own
+// lock, so concurrent inserts and lookups rarely contend. Most pks have a
+// single offset, which is stored inline in the map slot.
+//
+// Ordered operations (range find_range and find_first_n*) run on a sorted
+// (pk, offset) view that is maintained only once one of them is called:
+// from then on inserts also append to a pending log, which the next ordered
+// operation sorts and merges into the view.
 template <typename T>
-class OffsetOrderedArray : public OffsetMap {
+class ConcurrentOffsetMap : public OffsetMap {
  public:
+    using Offsets = folly::small_vector<int64_t, 1>;
+
+    ConcurrentOffsetMap() : shards_(std::make_unique<Shard[]>(kNumShards)) {
+    }
+
     bool
     contain(const PkType& pk) const override {
         const T& target = std::get<T>(pk);
-        auto it =
-            std::lower_bound(array_.begin(),
-                             array_.end(),
-                             target,
-                             [](const std::pair<T, int64_t>& elem,
-                                const T& value) { return elem.first < value; });
+        auto& shard = shard_of(target);
+        std::shared_lock<std::shared_mutex> lck(shard.mtx);
+        return shard.map.find(target) != shard.map.end();
+    }
+
+    std::vector<int64_t>
+    find(const PkType& pk) const override {
+        const T& target = std::get<T>(pk);
+        auto& shard = shard_of(target);
+        std::shared_lock<std::shared_mutex> lck(shard.mtx);
+        auto it = shard.map.find(target);
+        if (it == shard.map.end()) {
+            return {};
+        }
+        return std::vector<int64_t>(it->second.begin(), it->second.end());
+    }
+
+    void
+    find_range(const PkType& pk,
+               proto::plan::OpType op,
+               BitsetTypeView& bitset,
+               Condition condition) const override {
+        const T& target = std::get<T>(pk);
+        auto set_offset = [&](int64_t offset) {
+            if (condition(offset) && offset < bitset.size()) {
+                bitset[offset] = true;
+            }
+        };
+
+        if (op == proto::plan::OpType::Equal) {
+            for (auto offset : find(pk)) {
+                set_offset(offset);
+            }
+            return;
+        }
 
+        std::lock_guard<std::mutex> lck(view_mtx_);
+        refresh_ordered_view();
+        auto lower = std::lower_bound(
+            view_.begin(), view_.end(), target, [](const Entry& e, const T& v) {
+                return e.first < v;
+            });
+        auto upper = std::upper_bound(
+            view_.begin(), view_.end(), target, [](const T& v, const Entry& e) {
+                return v < e.first;
+            });
+        auto begin = view_.begin();
+        auto end = view_.end();
+        if (op == proto::plan::OpType::GreaterEqual) {
+            begin = lower;
+        } else if (op == proto::plan::OpType::GreaterThan) {
+            begin = upper;
+        } else if (op == proto::plan::OpType::LessEqual) {
+            end = upper;
+        } else if (op == proto::plan::OpType::LessThan) {
+            end = lower;
+        } else {
+            ThrowInfo(ErrorCode::Unsupported,
+                      fmt::format("unsupported op type {}", op));
+        }
+        for (auto it = begin; it != end; ++it) {
+            set_offset(it->second);
+        }
+    }
+
+    void
+    insert(const PkType& pk, int64_t offset) override {
+        const T& key = std::get<T>(pk);
+        {
+            auto& shard = shard_of(key);
+            std::unique_lock<std::shared_mutex> lck(shard.mtx);
+            auto [it, inserted] = shard.map.try_emplace(key);
+            auto& offsets = it->second;
+            auto heap_bytes_before = heap_bytes(offsets);
+            offsets.push_back(offset);
+            extra_bytes_ += heap_bytes(offsets) - heap_bytes_before;
+            if (inserted) {
+                num_pks_++;
+                if constexpr (std::is_same_v<T, std::string>) {
+                    extra_bytes_ += key.size();
+                }
+            }
+        }
+        if (ordered_view_enabled_.load()) {
+            std::lock_guard<std::mutex> lck(pending_mtx_);
+            pending_.emplace_back(key, offset);
+        }
+    }
+
+    void
+    seal() override {
+        ThrowInfo(NotImplemented,
+                  "ConcurrentOffsetMap used for growing segment could not be "
+                  "sealed.");
+    }
+
+    bool
+    empty() const override {
+        return num_pks_.load() == 0;
+    }
+
+    std::pair<std::vector<OffsetMap::OffsetType>, bool>
+    find_first_n(int64_t limit, const BitsetTypeView& bitset) const override {
+        std::lock_guard<std::mutex> lck(view_mtx_);
+        refresh_ordered_view();
+
+        if (limit == Unlimited || limit == NoLimit) {
+            limit = num_pks_.load();
+        }
+
+        int64_t hit_num = 0;  // avoid counting the number everytime.
+        auto size = bitset.size();
+        int64_t cnt = size - bitset.count();
+        auto more_hit_than_limit = cnt > limit;
+        limit = std::min(limit, cnt);
+        std::vector<int64_t> seg_offsets;
+        seg_offsets.reserve(limit);
+        size_t group_begin = 0;
+        while (hit_num < limit && group_begin < view_.size()) {
+            auto group_end = next_group(group_begin);
+            // Offsets in the growing segment are ordered by timestamp,
+            // so traverse from back to front to obtain the latest offset.
+            for (auto i = group_end; i-- > group_begin;) {
+                auto seg_offset = view_[i].second;
+                if (seg_offset >= size) {
+                    // Frequently concurrent insert/query will cause this case.
+                    continue;
+                }
+                if (!bitset[seg_offset]) {
+                    seg_offsets.push_back(seg_offset);
+                    hit_num++;
+                    // PK hit, no need to continue traversing offsets with the same PK.
+                    break;
+                }
+            }
+            group_begin = group_end;
+        }
+        return {seg_offsets,
+                more_hit_than_limit && group_begin < view_.size()};
+    }
+
+    std::tuple<std::vector<int64_t>, std::vector<std::vector<int32_t>>, bool>
+    find_first_n_element(
+        int64_t limit,
+        const BitsetTypeView& element_bitset,
+        const IArrayOffsets* array_offsets,
+        const std::optional<QueryIteratorCursor>& cursor) const override {
+        std::lock_guard<std::mutex> lck(view_mtx_);
+        refresh_ordered_view();
+
+        if (limit == Unlimited || limit == NoLimit) {
+            limit = static_cast<int64_t>(element_bitset.size());
+        }
+
+        std::vector<int64_t> doc_offsets;
+        std::vector<std::vector<int32_t>> element_indices;
+        int64_t hit_num = 0;
+        auto element_size = static_cast<int64_t>(element_bitset.size());
+        int64_t cnt = element_size - element_bitset.count();
+        auto more_hit_than_limit = cnt > limit;
+        limit = std::min(limit, cnt);
+
+        std::vector<int32_t> matching_indices;
+        size_t group_begin = 0;
+        while (hit_num < limit && group_begin < view_.size()) {
+            auto group_end = next_group(group_begin);
+            const T& pk = view_[group_begin].first;
+            // Only use the newest offset of the pk that has matching
+            // elements, to avoid returning stale versions.
+            for (auto i = group_end; i-- > group_begin && hit_num < limit;) {
+                auto doc_offset = view_[i].second;
+                auto [first_elem, last_elem] =
+                    array_offsets->ElementIDRangeOfRow(doc_offset);
+
+                matching_indices.clear();
+                for (int64_t elem_id = first_elem;
+                     elem_id < last_elem && hit_num < limit;
+                     ++elem_id) {
+                    if (elem_id >= element_size) {
+                        continue;
+                    }
+                    if (is_cursor_pk(pk, cursor) &&
+                        elem_id - first_elem <= cursor->last_element_offset) {
+                        continue;
+                    }
+                    if (!element_bitset[elem_id]) {  // 0 means pass filter
+                        matching_indices.push_back(
+                            static_cast<int32_t>(elem_id - first_elem));
+                        hit_num++;
+                    }
+                }
+
+                if (!matching_indices.empty()) {
+                    doc_offsets.push_back(doc_offset);
+                    element_indices.push_back(std::move(matching_indices));
+                    break;
+                }
+                if (is_cursor_pk(pk, cursor)) {
+                    // The cursor applies to the newest visible row for this PK.
+                    // Do not fall through to older offsets of the same PK.
+                    break;
+                }
+            }
+            group_begin = group_end;
+        }
+
+        bool has_more = more_hit_than_limit && hit_num >= limit;
+        return {std::move(doc_offsets), std::move(element_indices), has_more};
+    }
+
+    void
+    clear() override {
+        std::lock_guard<std::mutex> view_lck(view_mtx_);
+        for (size_t i = 0; i < kNumShards; ++i) {
+            std::unique_lock<std::shared_mutex> lck(shards_[i].mtx);
+            shards_[i].map.clear();
+        }
+        num_pks_ = 0;
+        extra_bytes_ = 0;
+        ordered_view_enabled_ = false;
+        view_.clear();
+        std::lock_guard<std::mutex> pending_lck(pending_mtx_);
+        pending_.clear();
+    }
+
+    size_t
+    memory_size() const override {
+        size_t total = extra_bytes_.load();
+        for (size_t i = 0; i < kNumShards; ++i) {
+            std::shared_lock<std::shared_mutex> lck(shards_[i].mtx);
+            total += shards_[i].map.getAllocatedMemorySize();
+        }
+        {
+            std::lock_guard<std::mutex> lck(view_mtx_);
+            total += view_.capacity() * sizeof(Entry);
+        }
+        std::lock_guard<std::mutex> lck(pending_mtx_);
+        return total + pending_.capacity() * sizeof(Entry);
+    }
+
+ private:
+    static constexpr int kNumShardBits = 6;
+    static constexpr size_t kNumShards = size_t{1} << kNumShardBits;
+
+    using Entry = std::pair<T, int64_t>;
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mtx;
+        folly::F14FastMap<T, Offsets> map;
+    };
+
+    Shard&
+    shard_of(const T& pk) const {
+        auto hash = folly::hash::twang_mix64(folly::hasher<T>{}(pk));
+        return shards_[hash >> (64 - kNumShardBits)];
+    }
+
+    static int64_t
+    heap_bytes(const Offsets& offsets) {
+        return offsets.capacity() > 1 ? offsets.capacity() * sizeof(int64_t)
+                                      : 0;
+    }
+
+    // End of the run of entries sharing the pk of view_[begin].
+    size_t
+    next_group(size_t begin) const {
+        auto end = begin + 1;
+        while (end < view_.size() && view_[end].first == view_[begin].first) {
+            ++end;
+        }
+        return end;
+    }
+
+    bool
+    is_cursor_pk(const T& pk,
+                 const std::optional<QueryIteratorCursor>& cursor) const {
+        if (!cursor.has_value()) {
+            return false;
+        }
+        auto last_pk = std::get_if<T>(&cursor->last_pk);
+        return last_pk != nullptr && *last_pk == pk;
+    }
+
+    // Brings view_ up to date with every insert that completed before the
+    // call. Requires view_mtx_.
+    void
+    refresh_ordered_view() const {
+        std::vector<Entry> fresh;
+        if (!ordered_view_enabled_.exchange(true)) {
+            // First ordered operation: snapshot the shards. Inserts racing
+            // with the snapshot may also land in the pending log; the
+            // duplicates are dropped below.
+            for (size_t i = 0; i < kNumShards; ++i) {
+                std::shared_lock<std::shared_mutex> lck(shards_[i].mtx);
+                for (const auto& [pk, offsets] : shards_[i].map) {
+                    for (auto offset : offsets) {
+                        fresh.emplace_back(pk, offset);
+                    }
+                }
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lck(pending_mtx_);
+            fresh.insert(fresh.end(),
+                         std::make_move_iterator(pending_.begin()),
+                         std::make_move_iterator(pending_.end()));
+            pending_.clear();
+        }
+        if (fresh.empty()) {
+            return;
+        }
+        std::sort(fresh.begin(), fresh.end());
+        auto middle = static_cast<std::ptrdiff_t>(view_.size());
+        view_.insert(view_.end(),
+                     std::make_move_iterator(fresh.begin()),
+                     std::make_move_iterator(fresh.end()));
+        std::inplace_merge(
+            view_.begin(), view_.begin() + middle, view_.end());
+        view_.erase(std::unique(view_.begin(), view_.end()), view_.end());
+    }
+
+    std::unique_ptr<Shard[]> shards_;
+    std::atomic<int64_t> num_pks_{0};
+    // Heap bytes outside the shard maps: spilled offsets and string keys.
+    std::atomic<int64_t> extra_bytes_{0};
+
+    mutable std::atomic<bool> ordered_view_enabled_{false};
+    mutable std::mutex pending_mtx_;
+    mutable std::vector<Entry> pending_;
+    mutable std::mutex view_mtx_;
+    // Sorted by (pk, offset).
+    mutable std::vector<Entry> view_;
+};
+
+template <typename T>
+class OffsetOrderedArray : public OffsetMap {
+ public:
+    bool
+    contain(const PkType& pk) const override {
+        const T& target = std::get<T>(pk);
+        auto it = lower_bound_of(target);
         return it != array_.end() && it->first == target;
     }
 
@@ -595,13 +979,7 @@ class OffsetOrderedArray : public OffsetMap {
         check_search();
 
         const T& target = std::get<T>(pk);
-        auto it =
-            std::lower_bound(array_.begin(),
-                             array_.end(),
-                             target,
-                             [](const std::pair<T, int64_t>& elem,
-                                const T& value) { return elem.first < value; });
-
+        auto it = lower_bound_of(target);
         std::vector<int64_t> offset_vector;
         for (; it != array_.end() && it->first == target; ++it) {
             offset_vector.push_back(it->second);
@@ -610,16 +988,41 @@ class OffsetOrderedArray : public OffsetMap {
         return offset_vector;
     }
 
+    // Sorts the probes and walks array_ once, galloping from each hit to the
+    // next, instead of one independent binary search per pk.
+    void
+    find_batch(const std::vector<PkType>& pks,
+               const std::function<void(size_t, int64_t)>& callback)
+        const override {
+        check_search();
+        std::vector<size_t> order(pks.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+            return std::get<T>(pks[lhs]) < std::get<T>(pks[rhs]);
+        });
+        auto it = array_.begin();
+        for (auto i : order) {
+            const T& target = std::get<T>(pks[i]);
+            it = gallop_lower_bound(
+                it,
+                array_.end(),
+                target,
+                [](const std::pair<T, int32_t>& elem, const T& value) {
+                    return elem.first < value;
+                });
+            for (auto hit = it; hit != array_.end() && hit->first == target;
+                 ++hit) {
+                callback(i, hit->second);
+            }
+        }
+    }
+
     void
     find_range(const PkType& pk,
                proto::plan::OpType op,
                BitsetTypeView& bitset,
                Condition condition) const override {
         check_search();
-        auto lower_bound_comp = [](const std::pair<T, int64_t>& elem,
-                                   const T& value) {
-            return elem.first < value;
-        };
         auto upper_bound_comp = [](const T& value,
                                    const std::pair<T, int64_t>& elem) {
             return value < elem.first;
@@ -627,16 +1030,14 @@ class OffsetOrderedArray : public OffsetMap {
 
         const T& target = std::get<T>(pk);
         if (op == proto::plan::OpType::Equal) {
-            auto it = std::lower_bound(
-                array_.begin(), array_.end(), target, lower_bound_comp);
+            auto it = lower_bound_of(target);
             for (; it != array_.end() && it->first == target; ++it) {
                 if (condition(it->second)) {
                     bitset[it->second] = true;
                 }
             }
         } else if (op == proto::plan::OpType::GreaterEqual) {
-            auto it = std::lower_bound(
-                array_.begin(), array_.end(), target, lower_bound_comp);
+            auto it = lower_bound_of(target);
             for (; it < array_.end(); ++it) {
                 if (condition(it->second)) {
                     bitset[it->second] = true;
@@ -659,8 +1060,7 @@ class OffsetOrderedArray : public OffsetMap {
                 }
             }
         } else if (op == proto::plan::OpType::LessThan) {
-            auto it = std::lower_bound(
-                array_.begin(), array_.end(), target, lower_bound_comp);
+            auto it = lower_bound_of(target);
             for (auto ptr = array_.begin(); ptr < it; ++ptr) {
                 if (condition(ptr->second)) {
                     bitset[ptr->second] = true;
@@ -685,6 +1085,7 @@ class OffsetOrderedArray : public OffsetMap {
     void
     seal() override {
         sort(array_.begin(), array_.end());
+        build_block_index();
         is_sealed = true;
     }
 
@@ -725,15 +1126,91 @@ class OffsetOrderedArray : public OffsetMap {
     void
     clear() override {
         array_.clear();
+        block_keys_.clear();
+        block_ids_.clear();
         is_sealed = false;
     }
 
     size_t
     memory_size() const override {
-        return sizeof(std::pair<T, int32_t>) * array_.capacity();
+        return sizeof(std::pair<T, int32_t>) * array_.capacity() +
+               sizeof(T) * block_keys_.capacity() +
+               sizeof(int32_t) * block_ids_.capacity();
     }
 
  private:
+    // Entries of array_ per block of the sampled search tree.
+    static constexpr size_t kBlockSize = 8;
+    // Tree nodes prefetched ahead of the search: 16 slots are the
+    // descendants four levels down.
+    static constexpr size_t kPrefetchFanout = 16;
+
+    using ConstIterator =
+        typename std::vector<std::pair<T, int32_t>>::const_iterator;
+
+    // Samples the first pk of every kBlockSize entries of the sorted array_
+    // into block_keys_, laid out in Eytzinger (BFS) order: the top levels of
+    // the search share cache lines, and the slots four levels down are
+    // contiguous, so they can be prefetched while the current level is
+    // compared.
+    void
+    build_block_index() {
+        block_keys_.clear();
+        block_ids_.clear();
+        const size_t num_blocks = (array_.size() + kBlockSize - 1) / kBlockSize;
+        if (num_blocks < 2) {
+            return;
+        }
+        block_keys_.resize(num_blocks + 1);
+        block_ids_.resize(num_blocks + 1);
+        // Slot 0 stands for "every sample is less than the target".
+        block_ids_[0] = static_cast<int32_t>(num_blocks);
+        size_t next_block = 0;
+        fill_block_index(1, next_block);
+    }
+
+    // In-order traversal of the implicit tree visits the blocks in order.
+    void
+    fill_block_index(size_t slot, size_t& next_block) {
+        if (slot >= block_keys_.size()) {
+            return;
+        }
+        fill_block_index(2 * slot, next_block);
+        block_keys_[slot] = array_[next_block * kBlockSize].first;
+        block_ids_[slot] = static_cast<int32_t>(next_block);
+        ++next_block;
+        fill_block_index(2 * slot + 1, next_block);
+    }
+
+    // std::lower_bound over array_, through the block index when built.
+    ConstIterator
+    lower_bound_of(const T& target) const {
+        auto less = [](const std::pair<T, int32_t>& elem, const T& value) {
+            return elem.first < value;
+        };
+        if (block_keys_.empty()) {
+            return std::lower_bound(array_.begin(), array_.end(), target, less);
+        }
+        const size_t num_slots = block_keys_.size() - 1;
+        size_t slot = 1;
+        while (slot <= num_slots) {
+            if (slot * kPrefetchFanout <= num_slots) {
+                __builtin_prefetch(block_keys_.data() + slot * kPrefetchFanout);
+            }
+            slot = 2 * slot + (block_keys_[slot] < target);
+        }
+        // Drop the trailing right turns: the last left turn is the first
+        // sample not less than the target, or slot 0 if there is none.
+        slot >>= __builtin_ffsll(~static_cast<long long>(slot));
+        // The first pk not less than the target lies between the start of
+        // the previous block and the start of that block.
+        const size_t block = block_ids_[slot];
+        const size_t first = block == 0 ? 0 : (block - 1) * kBlockSize;
+        const size_t last = std::min(array_.size(), block * kBlockSize + 1);
+        return std::lower_bound(
+            array_.begin() + first, array_.begin() + last, target, less);
+    }
+
     std::pair<std::vector<OffsetMap::OffsetType>, bool>
     find_first_n_by_index(int64_t limit, const BitsetTypeView& bitset) const {
         int64_t hit_num = 0;  // avoid counting the number everytime.
@@ -838,6 +1315,10 @@ class OffsetOrderedArray : public OffsetMap {
  private:
     bool is_sealed = false;
     std::vector<std::pair<T, int32_t>> array_;
+    // 1-based Eytzinger-ordered block samples and their block numbers,
+    // empty when array_ spans fewer than two blocks.
+    std::vector<T> block_keys_;
+    std::vector<int32_t> block_ids_;
 };
 
 // VirtualPKOffsetMap is a zero-storage OffsetMap for external collections.
@@ -1390,12 +1871,12 @@ class InsertRecordGrowing {
                 switch (field_meta.get_data_type()) {
                     case DataType::INT64: {
                         pk2offset_ =
-                            std::make_unique<OffsetOrderedMap<int64_t>>();
+                            std::make_unique<ConcurrentOffsetMap<int64_t>>();
                         break;
                     }
                     case DataType::VARCHAR: {
-                        pk2offset_ =
-                            std::make_unique<OffsetOrderedMap<std::string>>();
+                        pk2offset_ = std::make_unique<
+                            ConcurrentOffsetMap<std::string>>();
                         break;
                     }
                     default: {
@@ -1419,7 +1900,7 @@ class InsertRecordGrowing {
     search_pk(const PkType& pk,
               Timestamp timestamp,
               bool include_same_ts = true) const {
-        std::shared_lock<std::shared_mutex> lck(shared_mutex_);
+        // pk2offset_ is a ConcurrentOffsetMap, safe without shared_mutex_.
         std::vector<SegOffset> res_offsets;
         auto offset_iter = pk2offset_->find(pk);
         auto timestamp_hit =
@@ -1686,7 +2167,6 @@ class InsertRecordGrowing {
 
     void
     insert_pk(const PkType& pk, int64_t offset) {
-        std::lock_guard lck(shared_mutex_);
         pk2offset_->insert(pk, offset);
     }
 
@@ -0,0 +1,174 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/ArrayOffsets.h"
+#include "common/Types.h"
+#include "segcore/InsertRecord.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+template <typename T>
+class TypedConcurrentOffsetMapTest : public testing::Test {
+ protected:
+    static T
+    make_pk(uint64_t i) {
+        if constexpr (std::is_same_v<std::string, T>) {
+            return std::to_string(i);
+        } else {
+            return static_cast<T>(i);
+        }
+    }
+};
+
+using TypeOfPks = testing::Types<int64_t, std::string>;
+TYPED_TEST_SUITE_P(TypedConcurrentOffsetMapTest);
+
+// Checks every operation against OffsetOrderedMap, with inserts between
+// ordered operations so the ordered view is merged incrementally.
+TYPED_TEST_P(TypedConcurrentOffsetMapTest, matches_ordered_map) {
+    std::default_random_engine er(42);
+    OffsetOrderedMap<TypeParam> expected;
+    ConcurrentOffsetMap<TypeParam> map;
+    int64_t offset = 0;
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < 2000; i++) {
+            auto pk = this->make_pk(er() % 1000);
+            expected.insert(pk, offset);
+            map.insert(pk, offset);
+            offset++;
+        }
+
+        for (int i = 0; i < 20; i++) {
+            auto pk = this->make_pk(er() % 1000);
+            ASSERT_EQ(map.contain(pk), expected.contain(pk));
+            ASSERT_EQ(map.find(pk), expected.find(pk));
+            for (auto op : {proto::plan::OpType::Equal,
+                            proto::plan::OpType::GreaterThan,
+                            proto::plan::OpType::GreaterEqual,
+                            proto::plan::OpType::LessThan,
+                            proto::plan::OpType::LessEqual}) {
+                BitsetType expected_bitset(offset);
+                BitsetType bitset(offset);
+                expected_bitset.reset();
+                bitset.reset();
+                BitsetTypeView expected_view(expected_bitset.data(), offset);
+                BitsetTypeView view(bitset.data(), offset);
+                auto condition = [](int64_t o) { return o % 7 != 0; };
+                expected.find_range(pk, op, expected_view, condition);
+                map.find_range(pk, op, view, condition);
+                ASSERT_TRUE(bitset == expected_bitset);
+            }
+        }
+
+        BitsetType bitset(offset);
+        bitset.reset();
+        for (int64_t i = 0; i < offset; i++) {
+            if (er() % 3 == 0) {
+                bitset.set(i);
+            }
+        }
+        BitsetTypeView view(bitset.data(), bitset.size());
+        for (int64_t limit : {Unlimited, int64_t{10}, int64_t{500}}) {
+            ASSERT_EQ(map.find_first_n(limit, view),
+                      expected.find_first_n(limit, view));
+        }
+
+        constexpr int array_len = 3;
+        std::vector<int32_t> row_to_element_start = {0};
+        for (int64_t doc = 0; doc < offset; doc++) {
+            row_to_element_start.push_back(
+                static_cast<int32_t>((doc + 1) * array_len));
+        }
+        auto array_offsets = std::make_shared<ArrayOffsetsSealed>(
+            std::move(row_to_element_start));
+        BitsetType element_bitset(offset * array_len);
+        element_bitset.reset();
+        for (int64_t i = 0; i < offset * array_len; i++) {
+            if (er() % 2 == 0) {
+                element_bitset.set(i);
+            }
+        }
+        BitsetTypeView element_view(element_bitset.data(),
+                                    element_bitset.size());
+        QueryIteratorCursor cursor;
+        cursor.last_pk = this->make_pk(5);
+        cursor.last_element_offset = 1;
+        for (int64_t limit : {Unlimited, int64_t{7}, int64_t{300}}) {
+            for (auto c : {std::optional<QueryIteratorCursor>{},
+                           std::optional<QueryIteratorCursor>{cursor}}) {
+                ASSERT_EQ(map.find_first_n_element(
+                              limit, element_view, array_offsets.get(), c),
+                          expected.find_first_n_element(
+                              limit, element_view, array_offsets.get(), c));
+            }
+        }
+    }
+
+    map.clear();
+    ASSERT_TRUE(map.empty());
+    ASSERT_FALSE(map.contain(this->make_pk(0)));
+}
+
+TYPED_TEST_P(TypedConcurrentOffsetMapTest, concurrent_insert_and_lookup) {
+    constexpr int kNumWriters = 4;
+    constexpr int64_t kRowsPerWriter = 20000;
+    constexpr int64_t kNumPks = 5000;
+    ConcurrentOffsetMap<TypeParam> map;
+    std::atomic<int64_t> next_offset{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kNumWriters; t++) {
+        threads.emplace_back([&]() {
+            for (int64_t i = 0; i < kRowsPerWriter; i++) {
+                auto offset = next_offset++;
+                map.insert(this->make_pk(offset % kNumPks), offset);
+            }
+        });
+    }
+    threads.emplace_back([&]() {
+        BitsetType bitset(1000);
+        bitset.reset();
+        BitsetTypeView view(bitset.data(), bitset.size());
+        for (int i = 0; i < 200; i++) {
+            map.find_first_n(10, view);
+            map.find(this->make_pk(i));
+        }
+    });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    constexpr int64_t kNumRows = kNumWriters * kRowsPerWriter;
+    for (int64_t i = 0; i < kNumPks; i += 97) {
+        ASSERT_EQ(map.find(this->make_pk(i)).size(), kNumRows / kNumPks);
+    }
+    BitsetType bitset(kNumRows);
+    bitset.reset();
+    BitsetTypeView view(bitset.data(), bitset.size());
+    auto [offsets, has_more] = map.find_first_n(Unlimited, view);
+    ASSERT_EQ(offsets.size(), kNumPks);
+    ASSERT_FALSE(has_more);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(TypedConcurrentOffsetMapTest,
+                            matches_ordered_map,
+                            concurrent_insert_and_lookup);
+INSTANTIATE_TYPED_TEST_SUITE_P(Prefix,
+                               TypedConcurrentOffsetMapTest,
+                               TypeOfPks);
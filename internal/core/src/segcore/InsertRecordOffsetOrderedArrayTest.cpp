@@ -391,11 +391,50 @@ TYPED_TEST_P(TypedOffsetOrderedArrayTest,
     ASSERT_TRUE(limited_has_more);
 }
 
+TYPED_TEST_P(TypedOffsetOrderedArrayTest, find_and_find_batch) {
+    // Enough rows for a multi-level block index, with duplicate pks.
+    int num = 10000;
+    auto data = this->random_generate(num / 2);
+    for (int i = 0; i < num; i++) {
+        this->map_.insert(data[i % data.size()], i);
+    }
+    this->seal();
+
+    std::vector<PkType> probes;
+    for (int i = 0; i < 500; i++) {
+        probes.push_back(data[this->er() % data.size()]);
+    }
+    for (const auto& pk : this->random_generate(100)) {
+        probes.push_back(pk);
+    }
+
+    std::vector<std::vector<int64_t>> batch_offsets(probes.size());
+    this->map_.find_batch(probes, [&](size_t i, int64_t offset) {
+        batch_offsets[i].push_back(offset);
+    });
+    for (size_t i = 0; i < probes.size(); i++) {
+        const auto& pk = std::get<TypeParam>(probes[i]);
+        std::vector<int64_t> expected;
+        for (int j = 0; j < num; j++) {
+            if (data[j % data.size()] == pk) {
+                expected.push_back(j);
+            }
+        }
+        auto offsets = this->map_.find(probes[i]);
+        std::sort(offsets.begin(), offsets.end());
+        std::sort(batch_offsets[i].begin(), batch_offsets[i].end());
+        ASSERT_EQ(offsets, expected);
+        ASSERT_EQ(batch_offsets[i], expected);
+        ASSERT_EQ(this->map_.contain(probes[i]), !expected.empty());
+    }
+}
+
 REGISTER_TYPED_TEST_SUITE_P(TypedOffsetOrderedArrayTest,
                             find_first_n,
                             find_first_n_element,
                             find_first_n_element_has_more,
-                            find_first_n_element_with_iterator_cursor);
+                            find_first_n_element_with_iterator_cursor,
+                            find_and_find_batch);
 INSTANTIATE_TYPED_TEST_SUITE_P(Prefix, TypedOffsetOrderedArrayTest, TypeOfPks);
 
 // =====================================================================
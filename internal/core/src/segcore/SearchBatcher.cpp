@@ -0,0 +1,240 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/SearchBatcher.h"
+
+#include <chrono>
+#include <exception>
+#include <future>
+#include <numeric>
+#include <utility>
+
+#include "common/Common.h"
+#include "common/EasyAssert.h"
+#include "folly/futures/Future.h"
+#include "query/Plan.h"
+
+namespace milvus::segcore {
+
+struct SearchBatcher::Batch {
+    std::vector<const query::PlaceholderGroup*> groups;
+    std::vector<int64_t> nqs;
+    int64_t total_nq{0};
+    std::vector<std::unique_ptr<SearchResult>> results;
+    std::exception_ptr error;
+    std::promise<void> done;
+    std::shared_future<void> finished{done.get_future().share()};
+};
+
+bool
+SearchBatcher::CanBatch(const query::Plan* plan,
+                        const query::PlaceholderGroup* placeholder_group) {
+    if (plan->signature_.empty() || placeholder_group->size() != 1) {
+        return false;
+    }
+    const auto& search_info = plan->plan_node_->search_info_;
+    if (search_info.has_group_by() || search_info.element_level() ||
+        search_info.iterator_v2_info_.has_value() ||
+        search_info.iterative_filter_execution) {
+        return false;
+    }
+    const auto& placeholder = placeholder_group->at(0);
+    return placeholder.num_of_queries_ > 0 && !placeholder.blob_.empty() &&
+           placeholder.sparse_matrix_ == nullptr &&
+           placeholder.offsets_.empty() && !placeholder.element_level_;
+}
+
+std::unique_ptr<query::PlaceholderGroup>
+SearchBatcher::MergePlaceholderGroups(
+    const std::vector<const query::PlaceholderGroup*>& groups) {
+    AssertInfo(!groups.empty(), "no placeholder group to merge");
+    query::Placeholder merged;
+    merged.tag_ = groups[0]->at(0).tag_;
+    merged.num_of_queries_ = 0;
+    size_t blob_size = 0;
+    for (auto group : groups) {
+        blob_size += group->at(0).blob_.size();
+    }
+    merged.blob_.reserve(blob_size);
+    for (auto group : groups) {
+        const auto& placeholder = group->at(0);
+        merged.num_of_queries_ += placeholder.num_of_queries_;
+        merged.blob_.insert(merged.blob_.end(),
+                            placeholder.blob_.begin(),
+                            placeholder.blob_.end());
+    }
+    auto result = std::make_unique<query::PlaceholderGroup>();
+    result->push_back(std::move(merged));
+    return result;
+}
+
+std::vector<std::unique_ptr<SearchResult>>
+SearchBatcher::SplitSearchResult(SearchResult&& merged,
+                                 const std::vector<int64_t>& nqs) {
+    auto total_nq = std::accumulate(nqs.begin(), nqs.end(), int64_t{0});
+    auto topk = merged.unity_topK_;
+    AssertInfo(merged.total_nq_ == total_nq,
+               "merged search has nq {}, expected {}",
+               merged.total_nq_,
+               total_nq);
+    auto size = static_cast<size_t>(total_nq * topk);
+    AssertInfo(merged.distances_.size() == size &&
+                   merged.seg_offsets_.size() == size,
+               "merged search result size mismatch");
+    AssertInfo(!merged.HasGroupBy() && !merged.HasIterators() &&
+                   !merged.element_level_,
+               "merged search result can not be split");
+
+    std::vector<std::unique_ptr<SearchResult>> results;
+    results.reserve(nqs.size());
+    int64_t begin = 0;
+    for (auto nq : nqs) {
+        auto result = std::make_unique<SearchResult>();
+        result->total_nq_ = nq;
+        result->unity_topK_ = topk;
+        result->total_data_cnt_ = merged.total_data_cnt_;
+        result->segment_ = merged.segment_;
+        result->resource_pins_ = merged.resource_pins_;
+        result->pk_type_ = merged.pk_type_;
+        result->valid_count_ = merged.valid_count_;
+        result->distances_.assign(
+            merged.distances_.begin() + begin * topk,
+            merged.distances_.begin() + (begin + nq) * topk);
+        result->seg_offsets_.assign(
+            merged.seg_offsets_.begin() + begin * topk,
+            merged.seg_offsets_.begin() + (begin + nq) * topk);
+        // Storage is read once for all queries; charge it by nq.
+        result->search_storage_cost_ =
+            merged.search_storage_cost_ * (static_cast<double>(nq) / total_nq);
+        results.push_back(std::move(result));
+        begin += nq;
+    }
+    // Buffers pinned by the search only need to outlive one of the results.
+    results[0]->chunk_buffers_ = std::move(merged.chunk_buffers_);
+    results[0]->pinned_bitsets_ = std::move(merged.pinned_bitsets_);
+    return results;
+}
+
+std::unique_ptr<SearchResult>
+SearchBatcher::Search(const SegmentInterface* segment,
+                      const query::Plan* plan,
+                      const query::PlaceholderGroup* placeholder_group,
+                      Timestamp timestamp,
+                      const folly::CancellationToken& cancel_token,
+                      int32_t consistency_level,
+                      Timestamp collection_ttl,
+                      int64_t entity_ttl_physical_time_us,
+                      bool enable_expr_cache,
+                      milvus::tracer::SpanPtr trace_span) {
+    auto window_us = SEARCH_BATCH_WINDOW_US.load();
+    auto max_nq = SEARCH_BATCH_MAX_NQ.load();
+    auto search = [&](const query::PlaceholderGroup* group,
+                      const folly::CancellationToken& token) {
+        return segment->Search(plan,
+                               group,
+                               timestamp,
+                               token,
+                               consistency_level,
+                               collection_ttl,
+                               entity_ttl_physical_time_us,
+                               false,
+                               enable_expr_cache,
+                               trace_span);
+    };
+    if (window_us <= 0 || !CanBatch(plan, placeholder_group)) {
+        return search(placeholder_group, cancel_token);
+    }
+    auto nq = query::GetNumOfQueries(placeholder_group);
+    if (nq >= max_nq) {
+        return search(placeholder_group, cancel_token);
+    }
+
+    // Vectors of another size belong to another field type or dim, so the
+    // per-query blob size is part of the key.
+    BatchKey key{segment,
+                 plan->schema_.get(),
+                 plan->signature_,
+                 timestamp,
+                 consistency_level,
+                 collection_ttl,
+                 entity_ttl_physical_time_us,
+                 enable_expr_cache,
+                 placeholder_group->at(0).blob_.size() / nq};
+    std::shared_ptr<Batch> batch;
+    size_t index = 0;
+    {
+        std::lock_guard<std::mutex> lck(mutex_);
+        auto it = open_batches_.find(key);
+        if (it != open_batches_.end() &&
+            it->second->total_nq + nq <= max_nq) {
+            batch = it->second;
+            index = batch->groups.size();
+            batch->groups.push_back(placeholder_group);
+            batch->nqs.push_back(nq);
+            batch->total_nq += nq;
+            if (batch->total_nq == max_nq) {
+                open_batches_.erase(it);
+                batch_full_.notify_all();
+            }
+        } else {
+            batch = std::make_shared<Batch>();
+            batch->groups.push_back(placeholder_group);
+            batch->nqs.push_back(nq);
+            batch->total_nq = nq;
+            open_batches_.insert_or_assign(key, batch);
+        }
+    }
+
+    if (index > 0) {
+        batch->finished.wait();
+        if (batch->error) {
+            std::rethrow_exception(batch->error);
+        }
+        if (cancel_token.isCancellationRequested()) {
+            throw folly::FutureCancellation();
+        }
+        return std::move(batch->results[index]);
+    }
+
+    {
+        std::unique_lock<std::mutex> lck(mutex_);
+        batch_full_.wait_for(lck, std::chrono::microseconds(window_us), [&] {
+            return batch->total_nq >= max_nq;
+        });
+        auto it = open_batches_.find(key);
+        if (it != open_batches_.end() && it->second == batch) {
+            open_batches_.erase(it);
+        }
+    }
+
+    // The batch is closed, so its members no longer change.
+    try {
+        if (batch->groups.size() == 1) {
+            batch->results.push_back(search(placeholder_group, cancel_token));
+        } else {
+            auto merged = MergePlaceholderGroups(batch->groups);
+            auto result = search(merged.get(), folly::CancellationToken());
+            batch->results = SplitSearchResult(std::move(*result), batch->nqs);
+        }
+    } catch (...) {
+        batch->error = std::current_exception();
+    }
+    batch->done.set_value();
+    if (batch->error) {
+        std::rethrow_exception(batch->error);
+    }
+    if (cancel_token.isCancellationRequested()) {
+        throw folly::FutureCancellation();
+    }
+    return std::move(batch->results[0]);
+}
+
+}  // namespace milvus::segcore
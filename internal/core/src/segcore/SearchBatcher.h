@@ -0,0 +1,100 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "common/QueryResult.h"
+#include "common/Tracer.h"
+#include "common/Types.h"
+#include "folly/CancellationToken.h"
+#include "query/PlanImpl.h"
+#include "segcore/SegmentInterface.h"
+
+namespace milvus::segcore {
+
+// Coalesces concurrent searches on one segment into one multi-nq search.
+//
+// The first search of a batch waits up to SEARCH_BATCH_WINDOW_US for
+// compatible searches, then runs them all with their query vectors
+// concatenated and splits the result back per search. Searches are
+// compatible when they have the same segment, plan signature, timestamp
+// and consistency parameters, and a single dense placeholder of the same
+// vector size. The shared search does not observe the callers'
+// cancellation tokens; each caller checks its own once the result is back.
+class SearchBatcher {
+ public:
+    static SearchBatcher&
+    GetInstance() {
+        static SearchBatcher instance;
+        return instance;
+    }
+
+    // Same as segment->Search with filter_only unset.
+    std::unique_ptr<SearchResult>
+    Search(const SegmentInterface* segment,
+           const query::Plan* plan,
+           const query::PlaceholderGroup* placeholder_group,
+           Timestamp timestamp,
+           const folly::CancellationToken& cancel_token,
+           int32_t consistency_level,
+           Timestamp collection_ttl,
+           int64_t entity_ttl_physical_time_us,
+           bool enable_expr_cache,
+           milvus::tracer::SpanPtr trace_span);
+
+    // Whether the search of 'plan' may share its execution. Plans without
+    // a signature, with group by, iterators or element-level search, and
+    // sparse or embedding list queries are never batched.
+    static bool
+    CanBatch(const query::Plan* plan,
+             const query::PlaceholderGroup* placeholder_group);
+
+    // One placeholder holding the queries of 'groups' in order.
+    static std::unique_ptr<query::PlaceholderGroup>
+    MergePlaceholderGroups(
+        const std::vector<const query::PlaceholderGroup*>& groups);
+
+    // Splits the result of a merged search into results of 'nqs' queries.
+    static std::vector<std::unique_ptr<SearchResult>>
+    SplitSearchResult(SearchResult&& merged, const std::vector<int64_t>& nqs);
+
+ private:
+    using BatchKey = std::tuple<const SegmentInterface*,
+                                const Schema*,
+                                std::string,
+                                Timestamp,
+                                int32_t,
+                                Timestamp,
+                                int64_t,
+                                bool,
+                                size_t>;
+
+    struct Batch;
+
+    SearchBatcher() = default;
+
+    std::mutex mutex_;
+    // Signaled when a batch is full.
+    std::condition_variable batch_full_;
+    // Batches still accepting searches.
+    std::map<BatchKey, std::shared_ptr<Batch>> open_batches_;
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,125 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/Common.h"
+#include "common/QueryResult.h"
+#include "common/Schema.h"
+#include "folly/ScopeGuard.h"
+#include "knowhere/comp/index_param.h"
+#include "query/Plan.h"
+#include "query/PlanImpl.h"
+#include "segcore/SearchBatcher.h"
+#include "segcore/SegmentGrowing.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+TEST(SearchBatcher, SplitSearchResult) {
+    SearchResult merged;
+    merged.total_nq_ = 3;
+    merged.unity_topK_ = 2;
+    merged.total_data_cnt_ = 100;
+    merged.distances_ = {0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f};
+    merged.seg_offsets_ = {1, 2, 3, 4, 5, 6};
+    merged.search_storage_cost_ = StorageCost(30, 300);
+
+    auto results = SearchBatcher::SplitSearchResult(std::move(merged), {1, 2});
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0]->total_nq_, 1);
+    EXPECT_EQ(results[0]->unity_topK_, 2);
+    EXPECT_EQ(results[0]->total_data_cnt_, 100);
+    EXPECT_EQ(results[0]->distances_, std::vector<float>({0.1f, 0.2f}));
+    EXPECT_EQ(results[0]->seg_offsets_, std::vector<int64_t>({1, 2}));
+    EXPECT_EQ(results[0]->search_storage_cost_.scanned_total_bytes, 100);
+    EXPECT_EQ(results[1]->total_nq_, 2);
+    EXPECT_EQ(results[1]->distances_,
+              std::vector<float>({0.3f, 0.4f, 0.5f, 0.6f}));
+    EXPECT_EQ(results[1]->seg_offsets_, std::vector<int64_t>({3, 4, 5, 6}));
+    EXPECT_EQ(results[1]->search_storage_cost_.scanned_total_bytes, 200);
+}
+
+TEST(SearchBatcher, ConcurrentSearchesMatchSingleSearches) {
+    constexpr int dim = 16;
+    constexpr int num_searches = 4;
+    constexpr int64_t num_rows = 2000;
+    auto schema = std::make_shared<Schema>();
+    auto vec = schema->AddDebugField(
+        "vec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto segment = CreateGrowingSegment(schema, empty_index_meta);
+    auto dataset = DataGen(schema, num_rows);
+    segment->PreInsert(num_rows);
+    segment->Insert(0,
+                    num_rows,
+                    dataset.row_ids_.data(),
+                    dataset.timestamps_.data(),
+                    dataset.raw_);
+
+    ScopedSchemaHandle schema_handle(*schema);
+    auto plan_str = schema_handle.ParseSearch(
+        "pk >= 0", "vec", 10, knowhere::metric::L2, R"({"nprobe": 10})", 3);
+    std::vector<std::unique_ptr<Plan>> plans;
+    std::vector<std::unique_ptr<PlaceholderGroup>> groups;
+    for (int i = 0; i < num_searches; i++) {
+        plans.push_back(
+            CreateSearchPlanByExpr(schema, plan_str.data(), plan_str.size()));
+        auto raw_group = CreatePlaceholderGroup(1, dim, 100 + i);
+        groups.push_back(ParsePlaceholderGroup(
+            plans.back().get(), raw_group.SerializeAsString()));
+        ASSERT_TRUE(SearchBatcher::CanBatch(plans.back().get(),
+                                            groups.back().get()));
+    }
+    Timestamp timestamp = 1L << 62;
+
+    SetDefaultSearchBatchWindow(1000000);
+    SetDefaultSearchBatchMaxNq(num_searches);
+    auto restore = folly::makeGuard([] {
+        SetDefaultSearchBatchWindow(DEFAULT_SEARCH_BATCH_WINDOW_US);
+        SetDefaultSearchBatchMaxNq(DEFAULT_SEARCH_BATCH_MAX_NQ);
+    });
+    std::vector<std::unique_ptr<SearchResult>> results(num_searches);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_searches; i++) {
+        threads.emplace_back([&, i]() {
+            results[i] = SearchBatcher::GetInstance().Search(
+                segment.get(),
+                plans[i].get(),
+                groups[i].get(),
+                timestamp,
+                folly::CancellationToken(),
+                0,
+                0,
+                0,
+                false,
+                nullptr);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < num_searches; i++) {
+        auto expected =
+            segment->Search(plans[i].get(), groups[i].get(), timestamp);
+        ASSERT_EQ(results[i]->total_nq_, 1);
+        ASSERT_EQ(results[i]->unity_topK_, expected->unity_topK_);
+        EXPECT_EQ(results[i]->seg_offsets_, expected->seg_offsets_);
+        EXPECT_EQ(results[i]->distances_, expected->distances_);
+    }
+}
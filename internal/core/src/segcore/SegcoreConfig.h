@@ -218,6 +218,28 @@ class SegcoreConfig {
         max_group_by_groups_ = v;
     }
 
+    // Memory budget for blocking query operators before they spill to
+    // local disk; <= 0 disables spilling.
+    int64_t
+    get_query_spill_memory_budget() const {
+        return query_spill_memory_budget_;
+    }
+
+    void
+    set_query_spill_memory_budget(int64_t v) {
+        query_spill_memory_budget_ = v;
+    }
+
+    std::string
+    get_query_spill_dir() const {
+        return query_spill_dir_;
+    }
+
+    void
+    set_query_spill_dir(const std::string& dir) {
+        query_spill_dir_ = dir;
+    }
+
     void
     set_interim_index_mem_expansion_rate(float rate) {
         interim_index_mem_expansion_rate_ = rate;
@@ -254,6 +276,8 @@ class SegcoreConfig {
     inline static bool reject_remote_vector_output_ = false;
     inline static float interim_index_mem_expansion_rate_ = 1.15f;
     inline static int64_t max_group_by_groups_ = kDefaultMaxGroupByGroups;
+    inline static int64_t query_spill_memory_budget_ = 0;
+    inline static std::string query_spill_dir_;
 };
 
 }  // namespace milvus::segcore
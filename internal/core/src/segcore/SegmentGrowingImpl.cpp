@@ -415,6 +415,43 @@ SegmentGrowingImpl::try_remove_chunks(FieldId fieldId) {
     }
 }
 
+void
+SegmentGrowingImpl::pack_complete_vector_array_chunks() {
+    auto acked_rows = insert_record_.ack_responder_.GetAck();
+    int64_t added = 0;
+    for (const auto& [field_id, field_meta] : schema_->get_fields()) {
+        if (field_meta.get_data_type() != DataType::VECTOR_ARRAY ||
+            !insert_record_.is_data_exist(field_id)) {
+            continue;
+        }
+        auto vec = dynamic_cast<ConcurrentVector<VectorArray>*>(
+            insert_record_.get_data_base(field_id));
+        if (vec != nullptr) {
+            added += vec->pack_complete_chunks(acked_rows);
+        }
+    }
+    if (added > 0) {
+        UpdateResourceTracking();
+    }
+}
+
+int64_t
+SegmentGrowingImpl::packed_vector_array_bytes() const {
+    int64_t bytes = 0;
+    for (const auto& [field_id, field_meta] : schema_->get_fields()) {
+        if (field_meta.get_data_type() != DataType::VECTOR_ARRAY ||
+            !insert_record_.is_data_exist(field_id)) {
+            continue;
+        }
+        auto vec = dynamic_cast<const ConcurrentVector<VectorArray>*>(
+            insert_record_.get_data_base(field_id));
+        if (vec != nullptr) {
+            bytes += vec->packed_byte_size();
+        }
+    }
+    return bytes;
+}
+
 ResourceUsage
 SegmentGrowingImpl::EstimateSegmentResourceUsage() const {
     int64_t num_rows = get_row_count();
@@ -600,6 +637,9 @@ SegmentGrowingImpl::EstimateSegmentResourceUsage() const {
     // 5. Deleted records overhead
     memory_bytes += deleted_record_.mem_size();
 
+    // 6. Packed copies of complete vector array chunks
+    memory_bytes += packed_vector_array_bytes();
+
     // Apply safety margin
     constexpr double kResourceSafetyMargin = 1.2;
     memory_bytes = static_cast<int64_t>(memory_bytes * kResourceSafetyMargin);
@@ -849,6 +889,7 @@ SegmentGrowingImpl::Insert(int64_t reserved_offset,
     // step 6: update small indexes
     insert_record_.ack_responder_.AddSegment(reserved_offset,
                                              reserved_offset + num_rows);
+    pack_complete_vector_array_chunks();
 }
 
 void
@@ -942,6 +983,7 @@ SegmentGrowingImpl::load_field_data_internal(const LoadFieldDataInfo& infos) {
     // step 5: update small indexes
     insert_record_.ack_responder_.AddSegment(reserved_offset,
                                              reserved_offset + num_rows);
+    pack_complete_vector_array_chunks();
 }
 
 void
@@ -1223,6 +1265,7 @@ SegmentGrowingImpl::load_column_group_data_internal(
     // step 5: update small indexes
     insert_record_.ack_responder_.AddSegment(reserved_offset,
                                              reserved_offset + num_rows);
+    pack_complete_vector_array_chunks();
 }
 
 SegcoreError
@@ -2866,6 +2909,7 @@ SegmentGrowingImpl::LoadColumnsGroups(std::string manifest_path) {
 
     insert_record_.ack_responder_.AddSegment(reserved_offset,
                                              reserved_offset + num_rows);
+    pack_complete_vector_array_chunks();
 }
 
 std::unordered_map<FieldId, std::vector<FieldDataPtr>>
@@ -3073,6 +3117,8 @@ SegmentGrowingImpl::BuildGeometryCacheForInsert(FieldId field_id,
         auto& geometry_cache =
             milvus::exec::SimpleGeometryCacheManager::Instance()
                 .GetOrCreateCache(get_segment_id(), field_id);
+        // growing rows arrive in small batches, keep them in an R-tree
+        geometry_cache.EnableSpatialIndex();
 
         // Process geometry data from DataArray
         const auto& geometry_data = data_array->scalars().geometry_data();
@@ -3117,6 +3163,8 @@ SegmentGrowingImpl::BuildGeometryCacheForLoad(
         auto& geometry_cache =
             milvus::exec::SimpleGeometryCacheManager::Instance()
                 .GetOrCreateCache(get_segment_id(), field_id);
+        // growing rows arrive in small batches, keep them in an R-tree
+        geometry_cache.EnableSpatialIndex();
 
         // Process each field data chunk
         for (const auto& data : field_data) {
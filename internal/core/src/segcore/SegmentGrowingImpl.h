@@ -274,6 +274,14 @@ class SegmentGrowingImpl : public SegmentGrowing {
     void
     try_remove_chunks(FieldId fieldId);
 
+    // Packs the vector array chunks completed by acked rows, so growing
+    // search reads them in place, and charges the copies to the segment.
+    void
+    pack_complete_vector_array_chunks();
+
+    int64_t
+    packed_vector_array_bytes() const;
+
     void
     search_batch_pks(
         const std::vector<PkType>& pks,
@@ -285,7 +293,8 @@ class SegmentGrowingImpl : public SegmentGrowing {
  public:
     size_t
     GetMemoryUsageInBytes() const override {
-        return stats_.mem_size.load() + deleted_record_.mem_size();
+        return stats_.mem_size.load() + deleted_record_.mem_size() +
+               packed_vector_array_bytes();
     }
 
     // Returns the total disk usage of TEXT LOB spillover files in bytes.
@@ -32,6 +32,7 @@
 #include "bitset/bitset.h"
 #include "bitset/detail/element_vectorized.h"
 #include "cachinglayer/Utils.h"
+#include "common/Common.h"
 #include "common/Consts.h"
 #include "common/EasyAssert.h"
 #include "common/IndexMeta.h"
@@ -1779,6 +1780,47 @@ TEST(Growing, FilterOnlySearchUsesEntityTTLPhysicalTime) {
     EXPECT_EQ(search_result->valid_count_, expected_valid_count);
 }
 
+TEST(Growing, ParallelChunkSearchMatchesSequential) {
+    auto schema = std::make_shared<Schema>();
+    constexpr int64_t dim = 16;
+    constexpr int64_t num_rows = 2000;
+    auto metric_type = knowhere::metric::L2;
+    schema->AddDebugField("vec", DataType::VECTOR_FLOAT, dim, metric_type);
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto config = SegcoreConfig::default_config();
+    config.set_chunk_rows(256);
+    config.set_enable_interim_segment_index(false);
+    auto segment = CreateGrowingSegment(schema, empty_index_meta, 1, config);
+    auto dataset = DataGen(schema, num_rows);
+    segment->PreInsert(num_rows);
+    segment->Insert(0,
+                    num_rows,
+                    dataset.row_ids_.data(),
+                    dataset.timestamps_.data(),
+                    dataset.raw_);
+
+    milvus::segcore::ScopedSchemaHandle schema_handle(*schema);
+    auto plan_str = schema_handle.ParseSearch(
+        "pk % 3 != 0", "vec", 10, metric_type, R"({"nprobe": 10})", 3);
+    auto plan =
+        CreateSearchPlanByExpr(schema, plan_str.data(), plan_str.size());
+    auto ph_group_raw = CreatePlaceholderGroup(3, dim);
+    auto ph_group =
+        ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    Timestamp timestamp = 1L << 62;
+
+    auto sequential = segment->Search(plan.get(), ph_group.get(), timestamp);
+    SetDefaultGrowingSearchParallelism(4);
+    auto parallel = segment->Search(plan.get(), ph_group.get(), timestamp);
+    SetDefaultGrowingSearchParallelism(DEFAULT_GROWING_SEARCH_PARALLELISM);
+
+    ASSERT_EQ(parallel->total_nq_, 3);
+    ASSERT_EQ(parallel->unity_topK_, 10);
+    EXPECT_EQ(parallel->seg_offsets_, sequential->seg_offsets_);
+    EXPECT_EQ(parallel->distances_, sequential->distances_);
+}
+
 // Resource tracking tests for growing segments
 TEST(Growing, EmptySegmentResourceEstimation) {
     auto schema = std::make_shared<Schema>();
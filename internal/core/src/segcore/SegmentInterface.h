@@ -37,6 +37,7 @@
 #include "common/Array.h"
 #include "common/ArrayOffsets.h"
 #include "common/BitsetView.h"
+#include "common/Chunk.h"
 #include "common/EasyAssert.h"
 #include "common/FieldMeta.h"
 #include "common/Json.h"
@@ -394,6 +395,40 @@ class SegmentInternalInterface : public SegmentInterface {
             });
     }
 
+    // Rows [offset, offset + length) of a chunk. Unlike chunk_data(), a
+    // packed integer chunk has only these rows decoded, into a buffer owned
+    // by the returned pin.
+    template <typename T>
+    PinWrapper<Span<T>>
+    chunk_rows(milvus::OpContext* op_ctx,
+               FieldId field_id,
+               int64_t chunk_id,
+               int64_t offset,
+               int64_t length) const {
+        if constexpr (std::is_same_v<T, int32_t> ||
+                      std::is_same_v<T, int64_t>) {
+            auto pw = packed_int_chunk(op_ctx, field_id, chunk_id);
+            if (auto chunk = pw.get()) {
+                std::shared_ptr<T[]> values(new T[length]);
+                chunk->DecodePacked(
+                    offset, length, reinterpret_cast<char*>(values.get()));
+                auto valid_data = chunk->ValidData();
+                Span<T> rows(values.get(),
+                             valid_data ? valid_data + offset : nullptr,
+                             length);
+                return PinWrapper<Span<T>>(
+                    std::make_pair(std::move(pw), std::move(values)), rows);
+            }
+        }
+        return chunk_data<T>(op_ctx, field_id, chunk_id)
+            .template transform<Span<T>>([=](Span<T>&& span) {
+                auto valid_data = span.valid_data();
+                return Span<T>(span.data() + offset,
+                               valid_data ? valid_data + offset : nullptr,
+                               length);
+            });
+    }
+
     template <typename ViewType>
     PinWrapper<std::pair<std::vector<ViewType>, FixedVector<bool>>>
     chunk_view(milvus::OpContext* op_ctx,
@@ -442,6 +477,24 @@ class SegmentInternalInterface : public SegmentInterface {
             op_ctx, field_id, chunk_id, std::make_pair(start_offset, length));
     }
 
+    // The chunk of a sealed string field if it is dictionary encoded, so that
+    // filters can evaluate predicates on its codes, otherwise nullptr.
+    virtual PinWrapper<StringChunk*>
+    dictionary_string_chunk(milvus::OpContext* op_ctx,
+                            FieldId field_id,
+                            int64_t chunk_id) const {
+        return PinWrapper<StringChunk*>(nullptr);
+    }
+
+    // The chunk of a sealed integer field if it is frame-of-reference packed,
+    // so that filters can compare on its codes, otherwise nullptr.
+    virtual PinWrapper<FixedWidthChunk*>
+    packed_int_chunk(milvus::OpContext* op_ctx,
+                     FieldId field_id,
+                     int64_t chunk_id) const {
+        return PinWrapper<FixedWidthChunk*>(nullptr);
+    }
+
     template <typename ViewType>
     PinWrapper<std::pair<std::vector<ViewType>, FixedVector<bool>>>
     get_views_by_offsets(milvus::OpContext* op_ctx,
@@ -0,0 +1,100 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace milvus::segcore {
+
+// Tournament tree of losers over k sorted sources, for k-way merges.
+//
+// Each internal node keeps the source that lost the match played there,
+// so replacing the head of the winning source replays only its path to
+// the root: one comparison per level, against a heap's two.
+//
+// 'Better(a, b)' tells whether the head of source a goes before the head
+// of source b. It is never called on an exhausted source, and every
+// source must have a head when the tree is built.
+template <typename Better>
+class LoserTree {
+ public:
+    LoserTree(size_t k, Better better)
+        : k_(k),
+          better_(std::move(better)),
+          tree_(k == 0 ? 1 : k),
+          exhausted_(k, false) {
+        if (k_ == 0) {
+            return;
+        }
+        // Nodes 1..k-1 are internal, with children 2n and 2n + 1; source
+        // i is leaf k + i.
+        std::vector<size_t> winners(k_);
+        for (auto n = k_ - 1; n >= 1; --n) {
+            auto left = Winner(winners, 2 * n);
+            auto right = Winner(winners, 2 * n + 1);
+            if (Beats(right, left)) {
+                std::swap(left, right);
+            }
+            winners[n] = left;
+            tree_[n] = right;
+        }
+        tree_[0] = k_ == 1 ? 0 : winners[1];
+    }
+
+    bool
+    Empty() const {
+        return k_ == 0 || exhausted_[tree_[0]];
+    }
+
+    // The source whose head goes first.
+    size_t
+    Top() const {
+        return tree_[0];
+    }
+
+    // Call after the head of Top() moved on, with whether it ran out.
+    void
+    Replay(bool exhausted) {
+        auto winner = tree_[0];
+        exhausted_[winner] = exhausted;
+        for (auto n = (k_ + winner) / 2; n >= 1; n /= 2) {
+            if (Beats(tree_[n], winner)) {
+                std::swap(tree_[n], winner);
+            }
+        }
+        tree_[0] = winner;
+    }
+
+ private:
+    size_t
+    Winner(const std::vector<size_t>& winners, size_t node) const {
+        return node >= k_ ? node - k_ : winners[node];
+    }
+
+    bool
+    Beats(size_t a, size_t b) const {
+        if (exhausted_[a]) {
+            return false;
+        }
+        return exhausted_[b] || better_(a, b);
+    }
+
+    size_t k_;
+    Better better_;
+    // tree_[0] is the winner, tree_[n] the loser at internal node n.
+    std::vector<size_t> tree_;
+    std::vector<bool> exhausted_;
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,58 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "segcore/reduce/LoserTree.h"
+
+using milvus::segcore::LoserTree;
+
+TEST(LoserTree, MergesLikeStableSort) {
+    std::default_random_engine e(42);
+    for (size_t k = 0; k <= 9; ++k) {
+        std::vector<std::vector<int>> sources(k);
+        std::vector<std::pair<int, size_t>> expected;
+        for (size_t i = 0; i < k; ++i) {
+            sources[i].resize(1 + e() % 6);
+            for (auto& x : sources[i]) {
+                x = e() % 10;
+            }
+            std::sort(sources[i].rbegin(), sources[i].rend());
+            for (auto x : sources[i]) {
+                expected.emplace_back(x, i);
+            }
+        }
+        std::stable_sort(
+            expected.begin(), expected.end(), [](auto& a, auto& b) {
+                return a.first != b.first ? a.first > b.first
+                                          : a.second < b.second;
+            });
+
+        std::vector<size_t> heads(k, 0);
+        auto better = [&](size_t a, size_t b) {
+            auto x = sources[a][heads[a]];
+            auto y = sources[b][heads[b]];
+            return x != y ? x > y : a < b;
+        };
+        LoserTree<decltype(better)> tree(k, better);
+        std::vector<std::pair<int, size_t>> merged;
+        while (!tree.Empty()) {
+            auto source = tree.Top();
+            merged.emplace_back(sources[source][heads[source]], source);
+            tree.Replay(++heads[source] == sources[source].size());
+        }
+        ASSERT_EQ(merged, expected) << "k = " << k;
+    }
+}
@@ -17,7 +17,6 @@
 #include <future>
 #include <numeric>
 #include <optional>
-#include <queue>
 #include <vector>
 
 #include "common/Consts.h"
@@ -34,10 +33,19 @@
 #include "log/Log.h"
 #include "query/PlanImpl.h"
 #include "segcore/SegmentInterface.h"
+#include "segcore/reduce/LoserTree.h"
 #include "storage/ThreadPools.h"
 
 namespace milvus::segcore {
 
+namespace {
+
+// Merge sources (segments times queries) below which truncating in
+// parallel costs more than it saves.
+constexpr int64_t kMinMergeSourcesPerTask = 4096;
+
+}  // namespace
+
 void
 ReduceHelper::Initialize() {
     AssertInfo(search_results_.size() > 0, "empty search result");
@@ -253,15 +261,55 @@ ReduceHelper::TruncateToRefineTopk() {
     // Iterate per slice/per NQ with a distance-only merge (no PKs available
     // at this stage).
     // Record selected offsets in final_search_records_, then compact.
+    std::vector<int64_t> refine_topks(total_nq_);
     for (int64_t slice_index = 0; slice_index < num_slices_; ++slice_index) {
         auto refine_topk = static_cast<int64_t>(
             std::ceil(refine_topk_ratio *
                       std::max(slice_topKs_[slice_index], search_range)));
         auto nq_begin = slice_nqs_prefix_sum_[slice_index];
         auto nq_end = slice_nqs_prefix_sum_[slice_index + 1];
+        for (int64_t qi = nq_begin; qi < nq_end; ++qi) {
+            refine_topks[qi] = refine_topk;
+        }
+    }
 
+    // Queries write disjoint records, so ranges of them merge in parallel
+    // once there is enough work to pay for the tasks.
+    auto truncate = [this, &refine_topks](int64_t nq_begin, int64_t nq_end) {
         for (int64_t qi = nq_begin; qi < nq_end; ++qi) {
-            TruncateSearchResultForOneNQ(qi, refine_topk);
+            TruncateSearchResultForOneNQ(qi, refine_topks[qi]);
+        }
+    };
+    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::MIDDLE);
+    auto num_tasks = std::min<int64_t>(
+        {total_nq_,
+         static_cast<int64_t>(pool.GetMaxThreadNum()),
+         total_nq_ * num_segments_ / kMinMergeSourcesPerTask});
+    if (num_tasks <= 1) {
+        truncate(0, total_nq_);
+    } else {
+        // The caller merges the first range itself rather than idling on
+        // the futures.
+        std::vector<std::future<void>> futures;
+        futures.reserve(num_tasks - 1);
+        for (int64_t task = 1; task < num_tasks; ++task) {
+            auto nq_begin = total_nq_ * task / num_tasks;
+            auto nq_end = total_nq_ * (task + 1) / num_tasks;
+            futures.emplace_back(pool.Submit(truncate, nq_begin, nq_end));
+        }
+        auto futures_guard = folly::makeGuard([&futures]() {
+            for (auto& f : futures) {
+                if (f.valid()) {
+                    try {
+                        f.get();
+                    } catch (...) {
+                    }
+                }
+            }
+        });
+        truncate(0, total_nq_ / num_tasks);
+        for (auto& future : futures) {
+            future.get();
         }
     }
 
@@ -299,24 +347,11 @@ ReduceHelper::TruncateToRefineTopk() {
 
 void
 ReduceHelper::TruncateSearchResultForOneNQ(int64_t qi, int64_t topk) {
-    // Lightweight cursor for distance-only merge (no PKs needed)
-    struct Cursor {
-        SearchResult* search_result_;
-        int64_t segment_index_;
-        int64_t offset_;
-        int64_t offset_end_;
-        float distance_;
-
-        bool
-        operator<(const Cursor& rhs) const {
-            if (std::fabs(distance_ - rhs.distance_) >= EPSILON) {
-                return distance_ < rhs.distance_;
-            }
-            return segment_index_ > rhs.segment_index_;
-        }
-    };
-
-    std::priority_queue<Cursor> heap;
+    // Distance-only merge (no PKs needed) of the segments with results
+    // for qi. Offsets of the segments hold their current heads.
+    std::vector<int64_t> segments;
+    std::vector<int64_t> offsets;
+    std::vector<int64_t> offset_ends;
     for (int i = 0; i < num_segments_; i++) {
         auto search_result = search_results_[i];
         auto offset_beg = search_result->topk_per_nq_prefix_sum_[qi];
@@ -324,28 +359,29 @@ ReduceHelper::TruncateSearchResultForOneNQ(int64_t qi, int64_t topk) {
         if (offset_beg == offset_end) {
             continue;
         }
-        heap.push({search_result,
-                   i,
-                   static_cast<int64_t>(offset_beg),
-                   static_cast<int64_t>(offset_end),
-                   search_result->distances_[offset_beg]});
+        segments.push_back(i);
+        offsets.push_back(static_cast<int64_t>(offset_beg));
+        offset_ends.push_back(static_cast<int64_t>(offset_end));
     }
 
-    int64_t selected = 0;
-    while (selected < topk && !heap.empty()) {
-        auto cursor = heap.top();
-        heap.pop();
+    // Larger distances go first; ties go to the lower segment index.
+    auto better = [&](size_t a, size_t b) {
+        auto distance_a = search_results_[segments[a]]->distances_[offsets[a]];
+        auto distance_b = search_results_[segments[b]]->distances_[offsets[b]];
+        if (std::fabs(distance_a - distance_b) >= EPSILON) {
+            return distance_a > distance_b;
+        }
+        return segments[a] < segments[b];
+    };
+    LoserTree<decltype(better)> tree(segments.size(), better);
 
-        final_search_records_[cursor.segment_index_][qi].push_back(
-            cursor.offset_);
+    int64_t selected = 0;
+    while (selected < topk && !tree.Empty()) {
+        auto source = tree.Top();
+        final_search_records_[segments[source]][qi].push_back(
+            offsets[source]);
         ++selected;
-
-        auto next = cursor.offset_ + 1;
-        if (next < cursor.offset_end_) {
-            cursor.offset_ = next;
-            cursor.distance_ = cursor.search_result_->distances_[next];
-            heap.push(cursor);
-        }
+        tree.Replay(++offsets[source] == offset_ends[source]);
     }
 }
 
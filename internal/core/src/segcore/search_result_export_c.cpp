@@ -30,14 +30,17 @@
 
 #include "common/EasyAssert.h"
 #include "common/FieldMeta.h"
+#include "common/OpContext.h"
 #include "log/Log.h"
 #include "common/QueryResult.h"
+#include "common/SystemProperty.h"
 #include "common/Types.h"
 #include "futures/Future.h"
 #include "monitor/Monitor.h"
 #include "monitor/scope_metric.h"
 #include "prometheus/histogram.h"
 #include "query/PlanImpl.h"
+#include "segcore/ChunkedSegmentSealedImpl.h"
 #include "segcore/SegmentInterface.h"
 #include "segcore/SegmentReadLease.h"
 #include "segcore/Utils.h"
@@ -817,6 +820,87 @@ BuildSearchResultFullBatch(CSearchResult c_search_result,
     return export_chunk_sizes();
 }
 
+// Converts one retrieve output column to Arrow. Loaded scalar columns of
+// sealed segments are read directly; everything else goes through the
+// DataArray that FillTargetEntry would have added to the proto result.
+arrow::Result<std::shared_ptr<arrow::Array>>
+RetrieveColumnAsArrow(milvus::segcore::SegmentInternalInterface* segment,
+                      const milvus::query::RetrievePlan* plan,
+                      milvus::FieldId field_id,
+                      const int64_t* offsets,
+                      int64_t len,
+                      milvus::OpContext* op_ctx) {
+    auto& schema = plan->schema_;
+    if (milvus::SystemProperty::Instance().IsSystem(field_id)) {
+        auto system_type =
+            milvus::SystemProperty::Instance().GetSystemFieldType(field_id);
+        std::shared_ptr<arrow::Buffer> values;
+        ARROW_ASSIGN_OR_RAISE(values,
+                              arrow::AllocateBuffer(len * sizeof(int64_t)));
+        segment->bulk_subscript(
+            op_ctx, system_type, offsets, len, values->mutable_data());
+        return std::make_shared<arrow::Int64Array>(len, values);
+    }
+
+    std::unique_ptr<milvus::DataArray> field_data;
+    auto dynamic_field_id = schema->get_dynamic_field_id();
+    if (dynamic_field_id.has_value() && dynamic_field_id.value() == field_id &&
+        !plan->target_dynamic_fields_.empty()) {
+        field_data = segment->bulk_subscript(
+            op_ctx, field_id, offsets, len, plan->target_dynamic_fields_);
+    } else if (!segment->is_field_exist(field_id)) {
+        field_data = segment->bulk_subscript_not_exist_field(
+            schema->operator[](field_id), len);
+    } else {
+        auto sealed =
+            dynamic_cast<const milvus::segcore::ChunkedSegmentSealedImpl*>(
+                segment);
+        if (sealed != nullptr) {
+            auto array =
+                sealed->bulk_subscript_arrow(op_ctx, field_id, offsets, len);
+            if (array != nullptr) {
+                return array;
+            }
+        }
+        field_data = segment->bulk_subscript(op_ctx, field_id, offsets, len);
+    }
+    ARROW_ASSIGN_OR_RAISE(auto converted,
+                          FieldDataToArrow("", *field_data, len));
+    return converted.second;
+}
+
+// Build the retrieve-by-offsets RecordBatch, one column per output field.
+arrow::Result<std::shared_ptr<arrow::RecordBatch>>
+BuildRetrieveBatch(milvus::segcore::SegmentInternalInterface* segment,
+                   const milvus::query::RetrievePlan* plan,
+                   const int64_t* offsets,
+                   int64_t len,
+                   milvus::OpContext* op_ctx) {
+    auto& schema = plan->schema_;
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    std::vector<std::shared_ptr<arrow::Array>> arrays;
+    for (auto field_id : plan->field_ids_) {
+        milvus::futures::throwIfCancelled(op_ctx->cancellation_token);
+        ARROW_ASSIGN_OR_RAISE(
+            auto array,
+            RetrieveColumnAsArrow(
+                segment, plan, field_id, offsets, len, op_ctx));
+        auto name = std::to_string(field_id.get());
+        auto data_type = milvus::DataType::INT64;
+        auto nullable = false;
+        if (schema->has_field(field_id)) {
+            auto& field_meta = schema->operator[](field_id);
+            name = field_meta.get_name().get();
+            data_type = field_meta.get_data_type();
+            nullable = field_meta.is_nullable();
+        }
+        fields.push_back(
+            MilvusField(name, array->type(), nullable, field_id, data_type));
+        arrays.push_back(std::move(array));
+    }
+    return arrow::RecordBatch::Make(arrow::schema(fields), len, arrays);
+}
+
 }  // namespace
 
 CStatus
@@ -881,6 +965,96 @@ ExportSearchResultAsArrowRecordBatch(CSearchResult c_search_result,
     }
 }
 
+CStatus
+ExportRetrieveByOffsetsAsArrowRecordBatch(CSegmentInterface c_segment,
+                                          CRetrievePlan c_plan,
+                                          const int64_t* offsets,
+                                          int64_t len,
+                                          ArrowSchema* out_schema,
+                                          ArrowArray* out_array,
+                                          int64_t* scanned_remote_bytes,
+                                          int64_t* scanned_total_bytes,
+                                          void* cancellation_source) {
+    SCOPE_CGO_CALL_METRIC();
+
+    try {
+        auto segment =
+            static_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto plan = static_cast<const milvus::query::RetrievePlan*>(c_plan);
+        AssertInfo(segment != nullptr, "null segment");
+        AssertInfo(plan != nullptr, "null retrieve plan");
+        AssertInfo(offsets != nullptr || len == 0, "null offsets");
+        AssertInfo(out_schema != nullptr, "null ArrowSchema output");
+        AssertInfo(out_array != nullptr, "null ArrowArray output");
+        AssertInfo(out_schema->release == nullptr,
+                   "ArrowSchema output must be empty before export");
+        AssertInfo(out_array->release == nullptr,
+                   "ArrowArray output must be empty before export");
+        if (plan->schema_->is_external_collection()) {
+            return milvus::FailureCStatus(
+                milvus::ErrorCode::NotImplemented,
+                "Arrow retrieve export does not support external "
+                "collections");
+        }
+        auto cancel_token = folly::CancellationToken();
+        if (cancellation_source != nullptr) {
+            auto source =
+                static_cast<folly::CancellationSource*>(cancellation_source);
+            cancel_token = source->getToken();
+        }
+
+        milvus::OpContext op_ctx(cancel_token);
+        segment->LazyCheckSchema(plan->schema_, &op_ctx);
+        std::shared_ptr<milvus::segcore::SegmentReadLease> read_lease;
+        if (segment->type() == SegmentType::Sealed) {
+            auto sealed =
+                dynamic_cast<milvus::segcore::ChunkedSegmentSealedImpl*>(
+                    segment);
+            AssertInfo(sealed != nullptr,
+                       "sealed segment {} does not support request read "
+                       "leases",
+                       segment->get_segment_id());
+            read_lease = sealed->AcquireReadLease(cancel_token);
+            sealed->ValidateSchemaCompatibility(plan->schema_);
+        }
+
+        auto batch_result = BuildRetrieveBatch(
+            static_cast<milvus::segcore::SegmentInternalInterface*>(segment),
+            plan,
+            offsets,
+            len,
+            &op_ctx);
+        if (!batch_result.ok()) {
+            return milvus::FailureCStatus(
+                batch_result.status().IsNotImplemented()
+                    ? milvus::ErrorCode::NotImplemented
+                    : milvus::ErrorCode::UnexpectedError,
+                batch_result.status().ToString());
+        }
+        auto export_status =
+            arrow::ExportRecordBatch(**batch_result, out_array, out_schema);
+        if (!export_status.ok()) {
+            ReleaseArrowArrayIfNeeded(out_array);
+            ReleaseArrowSchemaIfNeeded(out_schema);
+            return milvus::FailureCStatus(milvus::ErrorCode::UnexpectedError,
+                                          export_status.ToString());
+        }
+        if (scanned_remote_bytes != nullptr) {
+            *scanned_remote_bytes =
+                op_ctx.storage_usage.scanned_cold_bytes.load();
+        }
+        if (scanned_total_bytes != nullptr) {
+            *scanned_total_bytes =
+                op_ctx.storage_usage.scanned_total_bytes.load();
+        }
+        return milvus::SuccessCStatus();
+    } catch (folly::FutureCancellation& e) {
+        return milvus::FailureCStatus(milvus::ErrorCode::FollyCancel, e.what());
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
 CStatus
 FillOutputFieldsOrderedImpl(CSearchResult* search_results,
                             int64_t num_search_results,
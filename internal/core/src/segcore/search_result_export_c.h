@@ -42,6 +42,30 @@ ExportSearchResultAsArrowRecordBatch(CSearchResult c_search_result,
                                      int64_t* out_num_chunks,
                                      void* cancellation_source);
 
+// Export the retrieve plan's output fields at the given segment offsets as
+// one Arrow RecordBatch, the Arrow counterpart of AsyncRetrieveByOffsets.
+// Columns follow the plan's output field order and carry the same field
+// metadata as search result extra fields. On sealed segments loaded scalar
+// columns are read straight from chunk memory: rows at consecutive offsets
+// of one chunk are exported without copying, and the exported array keeps
+// those chunks pinned until it is released. Other fields are converted from
+// bulk_subscript output. Fields with no Arrow mapping yet (arrays, geometry,
+// vectors) and external collections fail with NotImplemented; the caller
+// should fall back to AsyncRetrieveByOffsets then.
+// Caller owns out_schema/out_array. The storage cost outputs may be null.
+// cancellation_source may be null; otherwise it must point to a
+// folly::CancellationSource created by NewLoadCancellationSource().
+CStatus
+ExportRetrieveByOffsetsAsArrowRecordBatch(CSegmentInterface c_segment,
+                                          CRetrievePlan c_plan,
+                                          const int64_t* offsets,
+                                          int64_t len,
+                                          struct ArrowSchema* out_schema,
+                                          struct ArrowArray* out_array,
+                                          int64_t* scanned_remote_bytes,
+                                          int64_t* scanned_total_bytes,
+                                          void* cancellation_source);
+
 // Fill output fields for multiple segments in a single call, producing
 // results in the specified output order.
 //
@@ -21,6 +21,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "common/Chunk.h"
+#include "common/Common.h"
 #include "common/Consts.h"
 #include "common/IndexMeta.h"
 #include "common/QueryResult.h"
@@ -1197,6 +1199,111 @@ TEST(SearchResultExport, FillOutputFieldsOrdered_Basic) {
     free(const_cast<void*>(c_proto.proto_blob));
 }
 
+TEST(SearchResultExport, ExportRetrieveByOffsetsAsArrowRecordBatch) {
+    using namespace milvus;
+    using namespace milvus::segcore;
+
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    auto i8_fid = schema->AddDebugField("i8", DataType::INT8);
+    auto f64_fid =
+        schema->AddDebugField("nullable_f64", DataType::DOUBLE, true);
+    auto str_fid = schema->AddDebugField("str", DataType::VARCHAR);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    auto packed_fid = schema->AddDebugField("packed_i64", DataType::INT64);
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+
+    // The small values of packed_i64 are stored as packed chunks, which
+    // have no plain values to export without copying.
+    auto packed = ENABLE_PACKED_INT_CHUNK.load();
+    ENABLE_PACKED_INT_CHUNK.store(true);
+    auto raw_data = DataGen(schema, 8, /*seed=*/1);
+    auto segment = CreateSealedWithFieldDataLoaded(schema, raw_data);
+    ENABLE_PACKED_INT_CHUNK.store(packed);
+    auto segment_impl =
+        dynamic_cast<ChunkedSegmentSealedImpl*>(segment.get());
+    ASSERT_NE(segment_impl, nullptr);
+    auto [packed_column, packed_loaded] =
+        segment_impl->GetFieldDataIfExist(packed_fid);
+    ASSERT_TRUE(packed_loaded);
+    auto packed_chunk = packed_column->GetChunk(nullptr, 0);
+    ASSERT_TRUE(
+        static_cast<FixedWidthChunk*>(packed_chunk.get())->IsPacked());
+
+    auto plan = std::make_unique<milvus::query::RetrievePlan>(schema);
+    plan->field_ids_ = {
+        pk_fid, i8_fid, f64_fid, str_fid, json_fid, packed_fid};
+
+    // Consecutive offsets are exported from chunk memory and the others are
+    // gathered; both must match the proto retrieve output.
+    std::vector<std::vector<int64_t>> offset_sets = {{2, 3, 4, 5},
+                                                     {6, 0, 3}};
+    for (const auto& offsets : offset_sets) {
+        int64_t len = offsets.size();
+        ArrowSchema c_schema{};
+        ArrowArray c_array{};
+        auto status = ExportRetrieveByOffsetsAsArrowRecordBatch(
+            segment.get(),
+            plan.get(),
+            offsets.data(),
+            len,
+            &c_schema,
+            &c_array,
+            nullptr,
+            nullptr,
+            nullptr);
+        ASSERT_EQ(status.error_code, 0) << status.error_msg;
+        auto batch_result = ImportExportedRecordBatch(&c_array, &c_schema);
+        ASSERT_TRUE(batch_result.ok()) << batch_result.status().ToString();
+        auto batch = *batch_result;
+        ASSERT_EQ(batch->num_rows(), len);
+        ASSERT_EQ(batch->num_columns(), 6);
+        EXPECT_EQ(batch->schema()->field(1)->name(), "i8");
+        auto field_id_result =
+            batch->schema()->field(2)->metadata()->Get("milvus.field_id");
+        ASSERT_TRUE(field_id_result.ok());
+        EXPECT_EQ(*field_id_result, std::to_string(f64_fid.get()));
+        EXPECT_TRUE(batch->schema()->field(2)->nullable());
+
+        auto expected =
+            segment->Retrieve(nullptr, plan.get(), offsets.data(), len);
+        ASSERT_EQ(expected->fields_data_size(), 6);
+        auto pks =
+            std::static_pointer_cast<arrow::Int64Array>(batch->column(0));
+        auto i8s =
+            std::static_pointer_cast<arrow::Int32Array>(batch->column(1));
+        auto f64s =
+            std::static_pointer_cast<arrow::DoubleArray>(batch->column(2));
+        auto strs =
+            std::static_pointer_cast<arrow::StringArray>(batch->column(3));
+        auto jsons =
+            std::static_pointer_cast<arrow::BinaryArray>(batch->column(4));
+        auto packed_i64s =
+            std::static_pointer_cast<arrow::Int64Array>(batch->column(5));
+        const auto& f64_data = expected->fields_data(2);
+        for (int64_t i = 0; i < len; ++i) {
+            EXPECT_EQ(pks->Value(i),
+                      expected->fields_data(0).scalars().long_data().data(i));
+            EXPECT_EQ(i8s->Value(i),
+                      expected->fields_data(1).scalars().int_data().data(i));
+            EXPECT_EQ(f64s->IsValid(i), f64_data.valid_data(i));
+            if (f64_data.valid_data(i)) {
+                EXPECT_EQ(f64s->Value(i),
+                          f64_data.scalars().double_data().data(i));
+            }
+            EXPECT_EQ(
+                strs->GetView(i),
+                expected->fields_data(3).scalars().string_data().data(i));
+            EXPECT_EQ(jsons->GetView(i),
+                      expected->fields_data(4).scalars().json_data().data(i));
+            EXPECT_EQ(packed_i64s->Value(i),
+                      expected->fields_data(5).scalars().long_data().data(i));
+        }
+    }
+}
+
 TEST(SearchResultExport, HasTargetEntries) {
     using namespace milvus;
 
@@ -151,6 +151,15 @@ SegcoreSetMaxGroupByGroups(const int64_t value) {
     config.set_max_group_by_groups(value);
 }
 
+extern "C" void
+SegcoreSetQuerySpillConfig(const int64_t memory_budget_bytes,
+                           const char* spill_dir) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_query_spill_memory_budget(memory_budget_bytes);
+    config.set_query_spill_dir(spill_dir == nullptr ? "" : spill_dir);
+}
+
 extern "C" void
 SegcoreSetSubDim(const int64_t value) {
     milvus::segcore::SegcoreConfig& config =
@@ -71,6 +71,10 @@ SegcoreSetInterimIndexMemExpansionRate(const float);
 void
 SegcoreSetMaxGroupByGroups(const int64_t);
 
+void
+SegcoreSetQuerySpillConfig(const int64_t memory_budget_bytes,
+                           const char* spill_dir);
+
 // return value must be freed by the caller
 char*
 SegcoreSetSimdType(const char*);
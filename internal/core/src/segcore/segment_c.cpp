@@ -64,6 +64,7 @@
 #include "query/PlanNode.h"
 #include "segcore/ChunkedSegmentSealedImpl.h"
 #include "segcore/Collection.h"
+#include "segcore/SearchBatcher.h"
 #include "segcore/SegcoreConfig.h"
 #include "segcore/SegmentGrowing.h"
 #include "segcore/SegmentGrowingImpl.h"
@@ -509,7 +510,7 @@ AsyncSearch(CTraceContext c_trace,
                 search_result->unity_topK_ = 0;
                 search_result->total_data_cnt_ = 0;
                 search_result->segment_ = internal_segment;
-            } else {
+            } else if (filter_only) {
                 search_result = segment->Search(plan,
                                                 phg_ptr,
                                                 timestamp,
@@ -520,6 +521,19 @@ AsyncSearch(CTraceContext c_trace,
                                                 filter_only,
                                                 enable_expr_cache,
                                                 span);
+            } else {
+                search_result =
+                    milvus::segcore::SearchBatcher::GetInstance().Search(
+                        segment,
+                        plan,
+                        phg_ptr,
+                        timestamp,
+                        cancel_token,
+                        consistency_level,
+                        collection_ttl,
+                        entity_ttl_physical_time_us,
+                        enable_expr_cache,
+                        span);
             }
             search_result->read_lease_ = std::move(read_lease);
             if (!filter_only &&
@@ -0,0 +1,505 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/CachingChunkManager.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <boost/system/error_code.hpp>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <string_view>
+#include <tuple>
+
+#include "common/EasyAssert.h"
+#include "folly/ScopeGuard.h"
+#include "log/Log.h"
+#include "monitor/Monitor.h"
+
+namespace milvus::storage {
+
+namespace {
+
+// Downloads are streamed to disk in pieces of at most this many bytes.
+constexpr uint64_t kDownloadPieceBytes = 8 << 20;
+
+// The cache key of filepath, or "" if it may not name a file under the
+// cache dir.
+std::string
+CacheKey(const std::string& filepath) {
+    auto begin = filepath.find_first_not_of('/');
+    if (begin == std::string::npos) {
+        return "";
+    }
+    auto key = filepath.substr(begin);
+    size_t pos = 0;
+    while (pos <= key.size()) {
+        auto end = std::min(key.find('/', pos), key.size());
+        auto part = std::string_view(key).substr(pos, end - pos);
+        if (part.empty() || part == "." || part == "..") {
+            return "";
+        }
+        pos = end + 1;
+    }
+    return key;
+}
+
+}  // namespace
+
+CachingChunkManager::CachingChunkManager(ChunkManagerPtr remote,
+                                         const std::string& cache_dir,
+                                         uint64_t capacity_bytes)
+    : remote_(std::move(remote)),
+      cache_dir_(cache_dir),
+      capacity_bytes_(capacity_bytes) {
+    AssertInfo(remote_ != nullptr, "caching chunk manager needs a remote");
+    boost::filesystem::create_directories(cache_dir_);
+    LoadExisting();
+}
+
+bool
+CachingChunkManager::Exist(const std::string& filepath) {
+    return remote_->Exist(filepath);
+}
+
+uint64_t
+CachingChunkManager::Size(const std::string& filepath) {
+    return remote_->Size(filepath);
+}
+
+uint64_t
+CachingChunkManager::Read(const std::string& filepath,
+                          void* buf,
+                          uint64_t len) {
+    uint64_t read = 0;
+    if (ReadLocal(filepath, 0, buf, len, read)) {
+        return read;
+    }
+    return remote_->Read(filepath, buf, len);
+}
+
+uint64_t
+CachingChunkManager::Read(const std::string& filepath,
+                          uint64_t offset,
+                          void* buf,
+                          uint64_t len) {
+    uint64_t read = 0;
+    if (ReadLocal(filepath, offset, buf, len, read)) {
+        return read;
+    }
+    return remote_->Read(filepath, offset, buf, len);
+}
+
+void
+CachingChunkManager::Write(const std::string& filepath,
+                           void* buf,
+                           uint64_t len) {
+    auto key = BeginWrite(filepath);
+    auto end_write = folly::makeGuard([this, &key]() { EndWrite(key); });
+    remote_->Write(filepath, buf, len);
+}
+
+void
+CachingChunkManager::Write(const std::string& filepath,
+                           uint64_t offset,
+                           void* buf,
+                           uint64_t len) {
+    auto key = BeginWrite(filepath);
+    auto end_write = folly::makeGuard([this, &key]() { EndWrite(key); });
+    remote_->Write(filepath, offset, buf, len);
+}
+
+std::vector<std::string>
+CachingChunkManager::ListWithPrefix(const std::string& filepath) {
+    return remote_->ListWithPrefix(filepath);
+}
+
+void
+CachingChunkManager::Remove(const std::string& filepath) {
+    auto key = BeginWrite(filepath);
+    auto end_write = folly::makeGuard([this, &key]() { EndWrite(key); });
+    remote_->Remove(filepath);
+}
+
+CachingChunkManager::Stats
+CachingChunkManager::GetStats() const {
+    std::lock_guard<std::mutex> lck(mutex_);
+    return stats_;
+}
+
+bool
+CachingChunkManager::ReadLocal(const std::string& filepath,
+                               uint64_t offset,
+                               void* buf,
+                               uint64_t len,
+                               uint64_t& read) {
+    bool hit = false;
+    auto fd = OpenCached(filepath, hit);
+    if (fd < 0) {
+        return false;
+    }
+    auto close_fd = folly::makeGuard([fd]() { ::close(fd); });
+    auto dst = static_cast<char*>(buf);
+    read = 0;
+    while (read < len) {
+        auto n = ::pread(fd, dst + read, len - read, offset + read);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ThrowInfo(FileReadFailed,
+                      fmt::format("read cached copy of {} failed, error: {}",
+                                  filepath,
+                                  strerror(errno)));
+        }
+        if (n == 0) {
+            break;
+        }
+        read += n;
+    }
+    if (hit) {
+        std::lock_guard<std::mutex> lck(mutex_);
+        stats_.bytes_saved += read;
+        milvus::monitor::internal_storage_disk_cache_saved_bytes_total_all
+            .Increment(read);
+    }
+    return true;
+}
+
+int
+CachingChunkManager::OpenCached(const std::string& filepath, bool& hit) {
+    auto key = CacheKey(filepath);
+    if (key.empty()) {
+        return -1;
+    }
+    {
+        std::lock_guard<std::mutex> lck(mutex_);
+        if (writing_.count(key) > 0) {
+            return -1;
+        }
+    }
+    auto size = remote_->Size(filepath);
+    bool downloaded = false;
+    for (bool waited = false;; waited = true) {
+        std::shared_future<bool> pending;
+        std::promise<bool> promise;
+        bool leader = false;
+        {
+            std::lock_guard<std::mutex> lck(mutex_);
+            if (writing_.count(key) > 0) {
+                return -1;
+            }
+            // A copy of another size is stale; the download replaces it.
+            auto it = entries_.find(key);
+            if (it != entries_.end() && it->second.size == size) {
+                auto local = LocalPath(key, size);
+                auto fd = ::open(local.c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd >= 0) {
+                    lru_.splice(lru_.begin(), lru_, it->second.lru_pos);
+                    hit = !downloaded;
+                    if (hit) {
+                        stats_.hits++;
+                        milvus::monitor::
+                            internal_storage_disk_cache_requests_total_hit
+                                .Increment();
+                    }
+                    return fd;
+                }
+                // The copy was removed behind our back.
+                LOG_WARN("cached copy {} of {} is gone: {}",
+                         local,
+                         filepath,
+                         strerror(errno));
+                DropEntry(key);
+            }
+            if (waited) {
+                return -1;
+            }
+            auto download = downloads_.find(key);
+            if (download != downloads_.end()) {
+                if (download->second.size != size) {
+                    return -1;
+                }
+                pending = download->second.cached;
+            } else {
+                leader = true;
+                pending = promise.get_future().share();
+                downloads_.emplace(key, PendingDownload{size, pending});
+                stats_.misses++;
+                milvus::monitor::internal_storage_disk_cache_requests_total_miss
+                    .Increment();
+            }
+        }
+
+        if (!leader) {
+            if (!pending.get()) {
+                return -1;
+            }
+            continue;
+        }
+        auto finish = [&](bool cached) {
+            {
+                std::lock_guard<std::mutex> lck(mutex_);
+                downloads_.erase(key);
+            }
+            promise.set_value(cached);
+        };
+        bool cached = false;
+        try {
+            cached = Download(filepath, key, size);
+        } catch (...) {
+            finish(false);
+            throw;
+        }
+        finish(cached);
+        if (!cached) {
+            return -1;
+        }
+        downloaded = true;
+    }
+}
+
+bool
+CachingChunkManager::Download(const std::string& filepath,
+                              const std::string& key,
+                              uint64_t size) {
+    if (size > capacity_bytes_) {
+        return false;
+    }
+    auto local = LocalPath(key, size);
+    std::string tmp;
+    {
+        std::lock_guard<std::mutex> lck(mutex_);
+        tmp = local + ".tmp." + std::to_string(download_seq_++);
+    }
+    auto remove_tmp = folly::makeGuard([&tmp]() {
+        boost::system::error_code err;
+        boost::filesystem::remove(tmp, err);
+    });
+    // The cache is best effort; on failure the caller reads the remote.
+    boost::system::error_code err;
+    boost::filesystem::create_directories(
+        boost::filesystem::path(local).parent_path(), err);
+    if (err) {
+        LOG_WARN(
+            "failed to cache {} at {}: {}", filepath, local, err.message());
+        return false;
+    }
+    {
+        std::ofstream out(tmp, std::ios_base::binary | std::ios_base::trunc);
+        std::vector<char> piece(std::min(size, kDownloadPieceBytes));
+        for (uint64_t offset = 0; offset < size && out;) {
+            auto len = std::min(size - offset, kDownloadPieceBytes);
+            auto read = remote_->Read(filepath, offset, piece.data(), len);
+            if (read != len) {
+                LOG_WARN(
+                    "read {} bytes of {} at offset {}, expected {}, not "
+                    "caching it",
+                    read,
+                    filepath,
+                    offset,
+                    len);
+                return false;
+            }
+            out.write(piece.data(), len);
+            offset += len;
+        }
+        out.close();
+        if (out.fail()) {
+            LOG_WARN("failed to cache {} at {}: {}",
+                     filepath,
+                     tmp,
+                     strerror(errno));
+            return false;
+        }
+    }
+
+    {
+        // Checked and installed under the lock, so a write starting now
+        // drops the copy.
+        std::lock_guard<std::mutex> lck(mutex_);
+        auto download = downloads_.find(key);
+        if (writing_.count(key) > 0 ||
+            (download != downloads_.end() && download->second.stale)) {
+            return false;
+        }
+        boost::filesystem::rename(tmp, local, err);
+        if (err) {
+            LOG_WARN(
+                "failed to cache {} at {}: {}", filepath, local, err.message());
+            return false;
+        }
+        remove_tmp.dismiss();
+        AddEntry(key, size);
+    }
+    DeleteDropped();
+    return true;
+}
+
+void
+CachingChunkManager::AddEntry(const std::string& key, uint64_t size) {
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        if (it->second.size == size) {
+            lru_.splice(lru_.begin(), lru_, it->second.lru_pos);
+            return;
+        }
+        DropEntry(key);
+    }
+    lru_.push_front(key);
+    entries_.emplace(key, Entry{size, lru_.begin()});
+    stats_.cached_bytes += size;
+    while (stats_.cached_bytes > capacity_bytes_ && lru_.size() > 1) {
+        auto victim = entries_.find(lru_.back());
+        to_delete_.push_back(LocalPath(victim->first, victim->second.size));
+        stats_.cached_bytes -= victim->second.size;
+        entries_.erase(victim);
+        lru_.pop_back();
+    }
+    milvus::monitor::internal_storage_disk_cache_bytes_all.Set(
+        stats_.cached_bytes);
+}
+
+void
+CachingChunkManager::DropEntry(const std::string& key) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return;
+    }
+    to_delete_.push_back(LocalPath(key, it->second.size));
+    stats_.cached_bytes -= it->second.size;
+    lru_.erase(it->second.lru_pos);
+    entries_.erase(it);
+    milvus::monitor::internal_storage_disk_cache_bytes_all.Set(
+        stats_.cached_bytes);
+}
+
+std::string
+CachingChunkManager::BeginWrite(const std::string& filepath) {
+    auto key = CacheKey(filepath);
+    if (key.empty()) {
+        return key;
+    }
+    {
+        std::lock_guard<std::mutex> lck(mutex_);
+        writing_[key]++;
+        DropEntry(key);
+        auto download = downloads_.find(key);
+        if (download != downloads_.end()) {
+            download->second.stale = true;
+        }
+    }
+    DeleteDropped();
+    return key;
+}
+
+void
+CachingChunkManager::EndWrite(const std::string& key) {
+    if (key.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lck(mutex_);
+    auto it = writing_.find(key);
+    if (--it->second == 0) {
+        writing_.erase(it);
+    }
+}
+
+void
+CachingChunkManager::DeleteDropped() {
+    std::vector<std::string> paths;
+    {
+        std::lock_guard<std::mutex> lck(mutex_);
+        paths.swap(to_delete_);
+    }
+    // Readers holding a dropped copy open keep reading it after the unlink.
+    for (const auto& path : paths) {
+        boost::system::error_code err;
+        boost::filesystem::remove(path, err);
+        if (err) {
+            LOG_WARN("failed to remove cached copy {}: {}",
+                     path,
+                     err.message());
+        }
+    }
+}
+
+void
+CachingChunkManager::LoadExisting() {
+    namespace fs = boost::filesystem;
+    // (mtime, key, size) of the complete copies found
+    std::vector<std::tuple<std::time_t, std::string, uint64_t>> found;
+    std::vector<fs::path> partial;
+    fs::path root(cache_dir_);
+    for (fs::recursive_directory_iterator it(root), end; it != end; ++it) {
+        if (!fs::is_regular_file(it->status())) {
+            continue;
+        }
+        auto path = it->path();
+        auto rel = path.lexically_relative(root).generic_string();
+        auto at = rel.rfind('@');
+        auto digits = at == std::string::npos ? "" : rel.substr(at + 1);
+        boost::system::error_code err;
+        auto actual = fs::file_size(path, err);
+        if (digits.empty() || digits.size() > 19 ||
+            digits.find_first_not_of("0123456789") != std::string::npos ||
+            err || std::stoull(digits) != actual ||
+            CacheKey(rel.substr(0, at)) != rel.substr(0, at)) {
+            // Interrupted downloads, and files the cache did not write.
+            partial.push_back(path);
+            continue;
+        }
+        found.emplace_back(
+            fs::last_write_time(path, err), rel.substr(0, at), actual);
+    }
+    for (const auto& path : partial) {
+        boost::system::error_code err;
+        fs::remove(path, err);
+    }
+
+    std::sort(found.begin(), found.end());
+    {
+        std::lock_guard<std::mutex> lck(mutex_);
+        for (const auto& [mtime, key, size] : found) {
+            if (size <= capacity_bytes_) {
+                AddEntry(key, size);
+            } else {
+                to_delete_.push_back(LocalPath(key, size));
+            }
+        }
+        if (!found.empty()) {
+            LOG_INFO("adopted {} cached objects of {} bytes in {}",
+                     entries_.size(),
+                     stats_.cached_bytes,
+                     cache_dir_);
+        }
+        milvus::monitor::internal_storage_disk_cache_bytes_all.Set(
+            stats_.cached_bytes);
+    }
+    DeleteDropped();
+}
+
+std::string
+CachingChunkManager::LocalPath(const std::string& key, uint64_t size) const {
+    return cache_dir_ + "/" + key + "@" + std::to_string(size);
+}
+
+}  // namespace milvus::storage
@@ -0,0 +1,196 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "storage/ChunkManager.h"
+
+namespace milvus::storage {
+
+/**
+ * @brief CachingChunkManager keeps a bounded local-disk LRU of the objects
+ * read through it, in front of another (usually remote) ChunkManager.
+ *
+ * An object is streamed to <cache_dir>/<path>@<size> on its first read,
+ * and later full or ranged reads of it are served from the copy.
+ * Concurrent misses on one object share a single download. A copy only
+ * serves reads while the wrapped manager reports the same size for the
+ * object, so a rewritten object of another size is fetched again. While
+ * Write or Remove runs on an object, reads of it go to the wrapped manager
+ * and a download of it in flight is discarded, so no copy predating the
+ * write outlives it. Copies left in cache_dir by a previous process are
+ * kept, so a restarted node reads them locally.
+ */
+class CachingChunkManager : public ChunkManager {
+ public:
+    CachingChunkManager(ChunkManagerPtr remote,
+                        const std::string& cache_dir,
+                        uint64_t capacity_bytes);
+
+    CachingChunkManager(const CachingChunkManager&) = delete;
+    CachingChunkManager&
+    operator=(const CachingChunkManager&) = delete;
+
+    bool
+    Exist(const std::string& filepath) override;
+
+    uint64_t
+    Size(const std::string& filepath) override;
+
+    uint64_t
+    Read(const std::string& filepath, void* buf, uint64_t len) override;
+
+    void
+    Write(const std::string& filepath, void* buf, uint64_t len) override;
+
+    uint64_t
+    Read(const std::string& filepath,
+         uint64_t offset,
+         void* buf,
+         uint64_t len) override;
+
+    void
+    Write(const std::string& filepath,
+          uint64_t offset,
+          void* buf,
+          uint64_t len) override;
+
+    std::vector<std::string>
+    ListWithPrefix(const std::string& filepath) override;
+
+    void
+    Remove(const std::string& filepath) override;
+
+    std::string
+    GetName() const override {
+        return "CachingChunkManager";
+    }
+
+    std::string
+    GetRootPath() const override {
+        return remote_->GetRootPath();
+    }
+
+    std::string
+    GetBucketName() const override {
+        return remote_->GetBucketName();
+    }
+
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        // bytes read from local copies instead of the wrapped manager
+        uint64_t bytes_saved{0};
+        uint64_t cached_bytes{0};
+    };
+
+    Stats
+    GetStats() const;
+
+ private:
+    struct Entry {
+        uint64_t size;
+        std::list<std::string>::iterator lru_pos;
+    };
+
+    struct PendingDownload {
+        uint64_t size;
+        // tells whether the object got cached
+        std::shared_future<bool> cached;
+        // set when the object is written while it downloads
+        bool stale{false};
+    };
+
+    // Reads from the local copy of filepath, downloading it on a miss.
+    // Returns false if the object can not be cached.
+    bool
+    ReadLocal(const std::string& filepath,
+              uint64_t offset,
+              void* buf,
+              uint64_t len,
+              uint64_t& read);
+
+    // Opens the local copy of filepath, downloading it on a miss. Returns
+    // -1 if the object can not be cached, and sets 'hit' unless this call
+    // downloaded it.
+    int
+    OpenCached(const std::string& filepath, bool& hit);
+
+    // Streams the 'size' bytes of filepath into the cache under 'key'.
+    // Returns whether it got cached.
+    bool
+    Download(const std::string& filepath,
+             const std::string& key,
+             uint64_t size);
+
+    // Adds a copy of 'size' bytes, evicting least recently used copies.
+    // Caller holds mutex_.
+    void
+    AddEntry(const std::string& key, uint64_t size);
+
+    // Queues the local copy under 'key', if any, for deletion. Caller
+    // holds mutex_.
+    void
+    DropEntry(const std::string& key);
+
+    // Marks filepath as being written until EndWrite: its copy is dropped
+    // and a download of it in flight is discarded. Returns its key.
+    std::string
+    BeginWrite(const std::string& filepath);
+
+    void
+    EndWrite(const std::string& key);
+
+    // Deletes the local copies queued in to_delete_.
+    void
+    DeleteDropped();
+
+    // Adopts the copies found in cache_dir_ and deletes partial ones.
+    void
+    LoadExisting();
+
+    std::string
+    LocalPath(const std::string& key, uint64_t size) const;
+
+    ChunkManagerPtr remote_;
+    std::string cache_dir_;
+    uint64_t capacity_bytes_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    // most recently used first
+    std::list<std::string> lru_;
+    // downloads in progress
+    std::unordered_map<std::string, PendingDownload> downloads_;
+    // number of writes and removes in progress on each key
+    std::unordered_map<std::string, int> writing_;
+    // local copies evicted or dropped, deleted outside mutex_
+    std::vector<std::string> to_delete_;
+    uint64_t download_seq_{0};
+    Stats stats_;
+};
+
+}  // namespace milvus::storage
@@ -0,0 +1,238 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "storage/CachingChunkManager.h"
+#include "storage/LocalChunkManager.h"
+#include "test_utils/Constants.h"
+
+using namespace milvus::storage;
+
+namespace {
+
+// Records the ranged reads the cache makes, and runs a hook before each.
+class ObservedChunkManager : public LocalChunkManager {
+ public:
+    using LocalChunkManager::LocalChunkManager;
+    using LocalChunkManager::Read;
+
+    uint64_t
+    Read(const std::string& filepath,
+         uint64_t offset,
+         void* buf,
+         uint64_t len) override {
+        max_read_len = std::max(max_read_len, len);
+        if (before_read) {
+            before_read();
+        }
+        return LocalChunkManager::Read(filepath, offset, buf, len);
+    }
+
+    uint64_t max_read_len{0};
+    std::function<void()> before_read;
+};
+
+}  // namespace
+
+class CachingChunkManagerTest : public testing::Test {
+ protected:
+    void
+    SetUp() override {
+        root_ = TestLocalPath + "/caching-chunk-manager-test";
+        boost::filesystem::remove_all(root_);
+        remote_ = std::make_shared<ObservedChunkManager>(root_ + "/remote");
+        cache_dir_ = root_ + "/cache";
+        data_.resize(1000);
+        for (size_t i = 0; i < data_.size(); i++) {
+            data_[i] = static_cast<uint8_t>(i * 7);
+        }
+    }
+
+    void
+    TearDown() override {
+        boost::filesystem::remove_all(root_);
+    }
+
+    std::string
+    Put(const std::string& name, const std::vector<uint8_t>& data) {
+        auto path = root_ + "/remote/" + name;
+        remote_->Write(path, const_cast<uint8_t*>(data.data()), data.size());
+        return path;
+    }
+
+    std::string root_;
+    std::string cache_dir_;
+    std::shared_ptr<ObservedChunkManager> remote_;
+    std::vector<uint8_t> data_;
+};
+
+TEST_F(CachingChunkManagerTest, ReadThroughCache) {
+    auto path = Put("seg/1", data_);
+    CachingChunkManager cache(remote_, cache_dir_, 4096);
+
+    std::vector<uint8_t> out(data_.size());
+    ASSERT_EQ(cache.Read(path, out.data(), out.size()), data_.size());
+    EXPECT_EQ(out, data_);
+    EXPECT_EQ(cache.GetStats().misses, 1);
+    EXPECT_EQ(cache.GetStats().hits, 0);
+    EXPECT_EQ(cache.GetStats().cached_bytes, data_.size());
+
+    std::vector<uint8_t> part(10);
+    ASSERT_EQ(cache.Read(path, 995, part.data(), part.size()), 5);
+    EXPECT_EQ(part[0], data_[995]);
+    EXPECT_EQ(part[4], data_[999]);
+    EXPECT_EQ(cache.GetStats().hits, 1);
+    EXPECT_EQ(cache.GetStats().bytes_saved, 5);
+    EXPECT_EQ(cache.Size(path), data_.size());
+    EXPECT_TRUE(cache.Exist(path));
+
+    cache.Remove(path);
+    EXPECT_FALSE(cache.Exist(path));
+    EXPECT_EQ(cache.GetStats().cached_bytes, 0);
+}
+
+TEST_F(CachingChunkManagerTest, ConcurrentMissesShareDownload) {
+    auto path = Put("seg/2", data_);
+    CachingChunkManager cache(remote_, cache_dir_, 4096);
+
+    constexpr int num_threads = 8;
+    std::vector<std::vector<uint8_t>> outs(num_threads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; i++) {
+        threads.emplace_back([&, i]() {
+            outs[i].resize(data_.size());
+            cache.Read(path, outs[i].data(), outs[i].size());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& out : outs) {
+        EXPECT_EQ(out, data_);
+    }
+    EXPECT_EQ(cache.GetStats().misses, 1);
+    EXPECT_EQ(cache.GetStats().hits, num_threads - 1);
+}
+
+TEST_F(CachingChunkManagerTest, EvictLeastRecentlyUsed) {
+    auto a = Put("a", data_);
+    auto b = Put("b", data_);
+    auto c = Put("c", data_);
+    std::vector<uint8_t> big(3000, 1);
+    auto d = Put("d", big);
+    CachingChunkManager cache(remote_, cache_dir_, 2500);
+
+    std::vector<uint8_t> out(big.size());
+    cache.Read(a, out.data(), data_.size());
+    cache.Read(b, out.data(), data_.size());
+    cache.Read(a, out.data(), data_.size());
+    cache.Read(c, out.data(), data_.size());
+    EXPECT_EQ(cache.GetStats().cached_bytes, 2 * data_.size());
+
+    // b was the least recently used, so it is fetched again.
+    auto misses = cache.GetStats().misses;
+    cache.Read(a, out.data(), data_.size());
+    EXPECT_EQ(cache.GetStats().misses, misses);
+    cache.Read(b, out.data(), data_.size());
+    EXPECT_EQ(cache.GetStats().misses, misses + 1);
+
+    // Objects larger than the cache are read from the remote.
+    ASSERT_EQ(cache.Read(d, out.data(), out.size()), big.size());
+    EXPECT_EQ(out, big);
+    EXPECT_EQ(cache.GetStats().cached_bytes, 2 * data_.size());
+}
+
+TEST_F(CachingChunkManagerTest, AdoptCopiesAfterRestart) {
+    auto path = Put("seg/3", data_);
+    {
+        CachingChunkManager cache(remote_, cache_dir_, 4096);
+        std::vector<uint8_t> out(data_.size());
+        cache.Read(path, out.data(), out.size());
+    }
+    // An interrupted download is dropped.
+    auto partial = cache_dir_ + "/partial@1000.tmp.0";
+    remote_->Write(partial, data_.data(), 10);
+
+    CachingChunkManager cache(remote_, cache_dir_, 4096);
+    EXPECT_EQ(cache.GetStats().cached_bytes, data_.size());
+    EXPECT_FALSE(boost::filesystem::exists(partial));
+
+    std::vector<uint8_t> out(data_.size());
+    ASSERT_EQ(cache.Read(path, out.data(), out.size()), data_.size());
+    EXPECT_EQ(out, data_);
+    EXPECT_EQ(cache.GetStats().hits, 1);
+    EXPECT_EQ(cache.GetStats().misses, 0);
+}
+
+TEST_F(CachingChunkManagerTest, StreamLargeObject) {
+    std::vector<uint8_t> big((20 << 20) + 3);
+    for (size_t i = 0; i < big.size(); i++) {
+        big[i] = static_cast<uint8_t>(i * 13 + i / 4096);
+    }
+    auto path = Put("seg/big", big);
+    CachingChunkManager cache(remote_, cache_dir_, 64 << 20);
+
+    std::vector<uint8_t> out(big.size());
+    ASSERT_EQ(cache.Read(path, out.data(), out.size()), big.size());
+    EXPECT_EQ(out, big);
+    EXPECT_EQ(cache.GetStats().cached_bytes, big.size());
+    // The download went through bounded ranged reads.
+    EXPECT_GT(remote_->max_read_len, 0);
+    EXPECT_LT(remote_->max_read_len, big.size() / 2);
+}
+
+TEST_F(CachingChunkManagerTest, ObjectOfOtherSizeIsFetchedAgain) {
+    auto path = Put("seg/4", data_);
+    CachingChunkManager cache(remote_, cache_dir_, 4096);
+    std::vector<uint8_t> out(data_.size());
+    cache.Read(path, out.data(), out.size());
+
+    // Rewritten behind the cache's back.
+    std::vector<uint8_t> shorter(data_.begin(), data_.begin() + 600);
+    std::reverse(shorter.begin(), shorter.end());
+    Put("seg/4", shorter);
+
+    out.assign(data_.size(), 0);
+    ASSERT_EQ(cache.Read(path, out.data(), out.size()), shorter.size());
+    out.resize(shorter.size());
+    EXPECT_EQ(out, shorter);
+    EXPECT_EQ(cache.GetStats().misses, 2);
+    EXPECT_EQ(cache.GetStats().cached_bytes, shorter.size());
+}
+
+TEST_F(CachingChunkManagerTest, WriteDuringDownloadDiscardsCopy) {
+    auto path = Put("seg/5", data_);
+    CachingChunkManager cache(remote_, cache_dir_, 4096);
+
+    // Same size, so only the write itself can tell the copy is stale.
+    std::vector<uint8_t> updated(data_.rbegin(), data_.rend());
+    remote_->before_read = [&]() {
+        remote_->before_read = nullptr;
+        cache.Write(path, updated.data(), updated.size());
+    };
+    std::vector<uint8_t> out(data_.size());
+    ASSERT_EQ(cache.Read(path, out.data(), out.size()), data_.size());
+    EXPECT_EQ(out, updated);
+    EXPECT_EQ(cache.GetStats().cached_bytes, 0);
+
+    ASSERT_EQ(cache.Read(path, out.data(), out.size()), data_.size());
+    EXPECT_EQ(out, updated);
+    EXPECT_EQ(cache.GetStats().cached_bytes, updated.size());
+}
@@ -24,6 +24,27 @@
 
 namespace milvus::storage {
 
+// One range of a ReadRanges call: 'len' bytes at 'offset' go to 'buf'.
+struct ReadRange {
+    uint64_t offset;
+    uint64_t len;
+    void* buf;
+};
+
+// A request serving the ReadRanges ranges 'members', in offset order.
+struct CoalescedRange {
+    uint64_t offset;
+    uint64_t len;
+    std::vector<size_t> members;
+};
+
+// Groups 'ranges' into requests, merging ranges apart by at most 'max_gap'
+// bytes as long as the merged request stays within 'max_len' bytes.
+std::vector<CoalescedRange>
+CoalesceReadRanges(const std::vector<ReadRange>& ranges,
+                   uint64_t max_gap,
+                   uint64_t max_len);
+
 /**
  * @brief This ChunkManager is abstract interface for milvus that
  * used to manager operation and interaction with storage
@@ -91,6 +112,18 @@ class ChunkManager {
           void* buf,
           uint64_t len) = 0;
 
+    /**
+     * @brief Read many ranges of a file, each into its own buffer
+     * Ranges closer than READ_RANGES_MAX_GAP are fetched by one ranged
+     * Read, and up to READ_RANGES_PARALLELISM of those run concurrently.
+     * Throws if a range can not be read in full.
+     * @param filepath
+     * @param ranges
+     */
+    virtual void
+    ReadRanges(const std::string& filepath,
+               const std::vector<ReadRange>& ranges);
+
     /**
      * @brief List files with same prefix
      * @param filepath
@@ -431,34 +431,23 @@ DiskFileManagerImpl::AddBatchIndexFiles(
     const std::vector<int64_t>& remote_file_sizes) {
     auto local_chunk_manager =
         LocalChunkManagerSingleton::GetInstance().GetChunkManager();
-    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
-
-    std::vector<std::future<std::shared_ptr<uint8_t[]>>> futures;
-    futures.reserve(remote_file_sizes.size());
     AssertInfo(local_file_offsets.size() == remote_files.size(),
                "inconsistent size of offset slices with file slices");
     AssertInfo(remote_files.size() == remote_file_sizes.size(),
                "inconsistent size of file slices with size slices");
 
-    for (int64_t i = 0; i < remote_files.size(); ++i) {
-        futures.push_back(pool.Submit(
-            [local_chunk_manager](
-                const std::string& file,
-                const int64_t offset,
-                const int64_t data_size) -> std::shared_ptr<uint8_t[]> {
-                auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[data_size]);
-                local_chunk_manager->Read(file, offset, buf.get(), data_size);
-                return buf;
-            },
-            local_file_name,
-            local_file_offsets[i],
-            remote_file_sizes[i]));
-    }
-
     // hold index data util upload index file done.
-    // WaitAllFutures drains every task before rethrowing, so a failed read
-    // cannot unwind this frame while remaining tasks are still running.
-    auto index_datas = WaitAllFutures(std::move(futures));
+    std::vector<std::unique_ptr<uint8_t[]>> index_datas;
+    std::vector<ReadRange> ranges;
+    index_datas.reserve(remote_file_sizes.size());
+    ranges.reserve(remote_file_sizes.size());
+    for (size_t i = 0; i < remote_files.size(); ++i) {
+        index_datas.emplace_back(new uint8_t[remote_file_sizes[i]]);
+        ranges.push_back({static_cast<uint64_t>(local_file_offsets[i]),
+                          static_cast<uint64_t>(remote_file_sizes[i]),
+                          index_datas.back().get()});
+    }
+    local_chunk_manager->ReadRanges(local_file_name, ranges);
     std::vector<const uint8_t*> data_slices;
     data_slices.reserve(index_datas.size());
     for (auto& index_data : index_datas) {
@@ -0,0 +1,110 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "common/Common.h"
+#include "common/Consts.h"
+#include "common/EasyAssert.h"
+#include "common/ParallelFor.h"
+#include "storage/ChunkManager.h"
+#include "storage/ThreadPools.h"
+
+namespace milvus::storage {
+
+std::vector<CoalescedRange>
+CoalesceReadRanges(const std::vector<ReadRange>& ranges,
+                   uint64_t max_gap,
+                   uint64_t max_len) {
+    std::vector<size_t> order;
+    order.reserve(ranges.size());
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        if (ranges[i].len > 0) {
+            order.push_back(i);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return ranges[a].offset < ranges[b].offset;
+    });
+
+    std::vector<CoalescedRange> requests;
+    for (auto i : order) {
+        const auto& range = ranges[i];
+        auto end = range.offset + range.len;
+        if (!requests.empty()) {
+            auto& last = requests.back();
+            auto last_end = last.offset + last.len;
+            auto merged_end = std::max(last_end, end);
+            if (range.offset <= last_end + max_gap &&
+                merged_end - last.offset <= max_len) {
+                last.len = merged_end - last.offset;
+                last.members.push_back(i);
+                continue;
+            }
+        }
+        requests.push_back({range.offset, range.len, {i}});
+    }
+    return requests;
+}
+
+void
+ChunkManager::ReadRanges(const std::string& filepath,
+                         const std::vector<ReadRange>& ranges) {
+    auto requests = CoalesceReadRanges(
+        ranges,
+        std::max<int64_t>(READ_RANGES_MAX_GAP.load(), 0),
+        DEFAULT_READ_RANGES_MAX_MERGED_SIZE);
+    auto fetch = [&](int64_t index) {
+        const auto& request = requests[index];
+        // A lone range is read straight into its buffer.
+        std::unique_ptr<uint8_t[]> merged;
+        void* dst = ranges[request.members[0]].buf;
+        if (request.members.size() > 1) {
+            merged = std::make_unique<uint8_t[]>(request.len);
+            dst = merged.get();
+        }
+        auto read = Read(filepath, request.offset, dst, request.len);
+        if (read != request.len) {
+            ThrowInfo(FileReadFailed,
+                      "read {} bytes at offset {} of {}, expected {}",
+                      read,
+                      request.offset,
+                      filepath,
+                      request.len);
+        }
+        if (merged != nullptr) {
+            for (auto i : request.members) {
+                std::memcpy(ranges[i].buf,
+                            merged.get() + (ranges[i].offset - request.offset),
+                            ranges[i].len);
+            }
+        }
+    };
+
+    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+    ParallelFor(static_cast<int64_t>(requests.size()),
+                READ_RANGES_PARALLELISM.load(),
+                fetch,
+                [&pool](std::function<void()> task) {
+                    pool.Submit(std::move(task));
+                });
+}
+
+}  // namespace milvus::storage
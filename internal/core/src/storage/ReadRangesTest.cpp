@@ -0,0 +1,123 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/Common.h"
+#include "common/Consts.h"
+#include "folly/ScopeGuard.h"
+#include "storage/ChunkManager.h"
+#include "storage/LocalChunkManager.h"
+#include "test_utils/Constants.h"
+
+using namespace milvus;
+using namespace milvus::storage;
+
+namespace {
+
+class CountingChunkManager : public LocalChunkManager {
+ public:
+    using LocalChunkManager::LocalChunkManager;
+    using LocalChunkManager::Read;
+
+    uint64_t
+    Read(const std::string& filepath,
+         uint64_t offset,
+         void* buf,
+         uint64_t len) override {
+        reads_++;
+        return LocalChunkManager::Read(filepath, offset, buf, len);
+    }
+
+    std::atomic<int> reads_{0};
+};
+
+}  // namespace
+
+TEST(ReadRanges, Coalesce) {
+    std::vector<ReadRange> ranges = {{300, 10, nullptr},
+                                     {0, 10, nullptr},
+                                     {15, 10, nullptr},
+                                     {5, 10, nullptr},
+                                     {100, 0, nullptr},
+                                     {40, 30, nullptr}};
+    auto requests = CoalesceReadRanges(ranges, 5, 50);
+    ASSERT_EQ(requests.size(), 3);
+    // 0..10, 5..15 and 15..25 overlap or touch.
+    EXPECT_EQ(requests[0].offset, 0);
+    EXPECT_EQ(requests[0].len, 25);
+    EXPECT_EQ(requests[0].members, std::vector<size_t>({1, 3, 2}));
+    // 40..70 is 15 bytes past the previous request.
+    EXPECT_EQ(requests[1].offset, 40);
+    EXPECT_EQ(requests[1].len, 30);
+    EXPECT_EQ(requests[1].members, std::vector<size_t>({5}));
+    EXPECT_EQ(requests[2].offset, 300);
+    EXPECT_EQ(requests[2].members, std::vector<size_t>({0}));
+
+    // A large gap merges everything that fits in max_len.
+    requests = CoalesceReadRanges(ranges, 1000, 70);
+    ASSERT_EQ(requests.size(), 2);
+    EXPECT_EQ(requests[0].len, 70);
+    EXPECT_EQ(requests[0].members.size(), 4);
+}
+
+TEST(ReadRanges, ScatterIntoBuffers) {
+    auto root = TestLocalPath + "/read-ranges-test";
+    boost::filesystem::remove_all(root);
+    auto cleanup =
+        folly::makeGuard([&]() { boost::filesystem::remove_all(root); });
+    CountingChunkManager cm(root);
+    auto path = root + "/object";
+    std::vector<uint8_t> data(1 << 16);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    cm.Write(path, data.data(), data.size());
+
+    SetDefaultReadRangesMaxGap(64);
+    SetDefaultReadRangesParallelism(4);
+    auto restore = folly::makeGuard([] {
+        SetDefaultReadRangesMaxGap(DEFAULT_READ_RANGES_MAX_GAP);
+        SetDefaultReadRangesParallelism(DEFAULT_READ_RANGES_PARALLELISM);
+    });
+
+    // Ten clusters of ranges 32 bytes apart, the clusters 4 KiB apart.
+    std::vector<std::vector<uint8_t>> bufs;
+    std::vector<ReadRange> ranges;
+    for (uint64_t cluster = 0; cluster < 10; cluster++) {
+        for (uint64_t i = 0; i < 8; i++) {
+            bufs.emplace_back(16 + i);
+        }
+    }
+    for (uint64_t cluster = 0; cluster < 10; cluster++) {
+        for (uint64_t i = 0; i < 8; i++) {
+            auto& buf = bufs[cluster * 8 + i];
+            ranges.push_back(
+                {cluster * 4096 + i * 64, buf.size(), buf.data()});
+        }
+    }
+    cm.ReadRanges(path, ranges);
+    EXPECT_EQ(cm.reads_, 10);
+    for (const auto& range : ranges) {
+        auto out = static_cast<uint8_t*>(range.buf);
+        EXPECT_TRUE(std::equal(out, out + range.len, &data[range.offset]));
+    }
+
+    // Reading past the end of the file throws.
+    std::vector<uint8_t> tail(32);
+    EXPECT_ANY_THROW(cm.ReadRanges(
+        path, {{data.size() - 16, tail.size(), tail.data()}}));
+}
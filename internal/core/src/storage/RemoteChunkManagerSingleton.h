@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include "common/EasyAssert.h"
+#include "storage/CachingChunkManager.h"
 #include "storage/ChunkManager.h"
 #include "storage/Util.h"
 
@@ -44,6 +46,18 @@ class RemoteChunkManagerSingleton {
         }
     }
 
+    // Puts a local-disk cache of capacity_bytes in cache_dir in front of
+    // the remote chunk manager. Must follow Init; later calls are no-ops.
+    void
+    EnableDiskCache(const std::string& cache_dir, uint64_t capacity_bytes) {
+        AssertInfo(rcm_ != nullptr,
+                   "remote chunk manager is not initialized");
+        if (std::dynamic_pointer_cast<CachingChunkManager>(rcm_) == nullptr) {
+            rcm_ = std::make_shared<CachingChunkManager>(
+                rcm_, cache_dir, capacity_bytes);
+        }
+    }
+
     void
     Release() {
     }
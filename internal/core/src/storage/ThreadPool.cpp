@@ -16,6 +16,7 @@
 
 #include "ThreadPool.h"
 
+#include <algorithm>
 #include <chrono>
 
 #include "log/Log.h"
@@ -23,6 +24,12 @@
 
 namespace milvus {
 
+namespace {
+// The pool and home queue of the current worker thread, if any.
+thread_local ThreadPool* current_pool = nullptr;
+thread_local size_t current_home_queue = 0;
+}  // namespace
+
 int CPU_NUM = DEFAULT_CPU_NUM;
 std::atomic<int> THREAD_POOL_MAX_THREADS_SIZE(
     DEFAULT_THREAD_POOL_MAX_THREADS_SIZE);
@@ -66,20 +73,68 @@ SetThreadPoolMaxThreadsSize(const int size) {
     LOG_INFO("set thread pool max threads size: {}", size);
 }
 
+ThreadPool::ThreadPool(const float thread_core_coefficient,
+                       std::string name,
+                       std::vector<ThreadPool*> borrow_sources)
+    : min_threads_size_(1),
+      idle_threads_size_(0),
+      current_threads_size_(0),
+      shutdown_(false),
+      name_(std::move(name)),
+      borrow_sources_(std::move(borrow_sources)) {
+    max_threads_size_.store(std::max(
+        1, static_cast<int>(std::round(CPU_NUM * thread_core_coefficient))));
+
+    int max_limit = THREAD_POOL_MAX_THREADS_SIZE.load();
+    if (max_limit > 0 && max_threads_size_.load() > max_limit) {
+        max_threads_size_.store(max_limit);
+    }
+    auto queue_num = std::clamp<size_t>(
+        std::max(CPU_NUM, max_threads_size_.load()), 1, MAX_QUEUE_NUM);
+    queues_.reserve(queue_num);
+    for (size_t i = 0; i < queue_num; i++) {
+        queues_.push_back(std::make_unique<TaskQueue>());
+    }
+    for (auto* source : borrow_sources_) {
+        std::lock_guard<std::mutex> lock(source->mutex_);
+        source->borrowers_.push_back(this);
+    }
+    LOG_INFO("Init thread pool:{}", name_)
+        << " with min worker num:" << min_threads_size_
+        << " and max worker num:" << max_threads_size_.load()
+        << " and queue num:" << queue_num
+        << " and borrow source num:" << borrow_sources_.size();
+    Init();
+}
+
 void
 ThreadPool::Init() {
     std::lock_guard<std::mutex> lock(mutex_);
     for (int i = 0; i < min_threads_size_; i++) {
-        std::thread t(&ThreadPool::Worker, this);
-        assert(threads_.find(t.get_id()) == threads_.end());
-        threads_[t.get_id()] = std::move(t);
-        current_threads_size_++;
+        StartWorker();
     }
 }
 
+void
+ThreadPool::StartWorker() {
+    auto home_queue = next_home_queue_++ % queues_.size();
+    std::thread t(&ThreadPool::Worker, this, home_queue);
+    assert(threads_.find(t.get_id()) == threads_.end());
+    threads_[t.get_id()] = std::move(t);
+    current_threads_size_++;
+}
+
 void
 ThreadPool::ShutDown() {
     LOG_INFO("Start shutting down {}", name_);
+    // Stop being woken by the source lanes, which may outlive this pool.
+    for (auto* source : borrow_sources_) {
+        std::lock_guard<std::mutex> lock(source->mutex_);
+        auto& borrowers = source->borrowers_;
+        borrowers.erase(
+            std::remove(borrowers.begin(), borrowers.end(), this),
+            borrowers.end());
+    }
     {
         std::lock_guard<std::mutex> lock(mutex_);
         shutdown_ = true;
@@ -110,66 +165,167 @@ ThreadPool::FinishThreads() {
 }
 
 void
-ThreadPool::Worker() {
-    std::function<void()> func;
-    bool dequeue;
+ThreadPool::Enqueue(std::function<void()> task) {
+    auto queue_idx =
+        current_pool == this
+            ? current_home_queue
+            : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                  queues_.size();
+    {
+        auto& queue = *queues_[queue_idx];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    // Counted after the push, so a worker seeing the count finds the task.
+    auto pending = ++pending_tasks_;
+    if (metric_submitted_) {
+        metric_submitted_->Increment();
+    }
+    if (metric_queue_depth_) {
+        metric_queue_depth_->Set(pending);
+    }
+
+    // pending_tasks_ is bumped before reading idle_threads_size_, and a
+    // worker bumps idle_threads_size_ before checking pending_tasks_ under
+    // mutex_, so one of the two always sees the other.
+    auto idle = idle_threads_size_.load();
+    if (idle > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        condition_lock_.notify_one();
+    }
+    if (pending > idle && current_threads_size_ < max_threads_size_.load()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Dynamic increase thread number
+        if (!shutdown_ && current_threads_size_ < max_threads_size_.load()) {
+            StartWorker();
+        }
+        return;
+    }
+    if (idle == 0) {
+        // Saturated, let an idle worker of a borrowing lane help. mutex_ is
+        // held throughout, so a borrower cannot unregister and go away
+        // while it is being woken.
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto* borrower : borrowers_) {
+            if (borrower->idle_threads_size_.load() > 0) {
+                std::lock_guard<std::mutex> lock(borrower->mutex_);
+                borrower->condition_lock_.notify_one();
+                break;
+            }
+        }
+    }
+}
+
+bool
+ThreadPool::TryTake(size_t start, std::function<void()>& task) {
+    // A first pass skips contended queues, the second one waits for them so
+    // a queued task is never missed.
+    for (bool blocking : {false, true}) {
+        for (size_t i = 0; i < queues_.size(); i++) {
+            auto& queue = *queues_[(start + i) % queues_.size()];
+            std::unique_lock<std::mutex> lock(queue.mutex, std::defer_lock);
+            if (blocking) {
+                lock.lock();
+            } else if (!lock.try_lock()) {
+                continue;
+            }
+            if (queue.tasks.empty()) {
+                continue;
+            }
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            lock.unlock();
+            auto pending = --pending_tasks_;
+            if (metric_queue_depth_) {
+                metric_queue_depth_->Set(std::max<int64_t>(0, pending));
+            }
+            return true;
+        }
+        if (pending_tasks_.load() <= 0) {
+            return false;
+        }
+    }
+    return false;
+}
+
+bool
+ThreadPool::CanBorrow() const {
+    for (auto* source : borrow_sources_) {
+        if (source->pending_tasks_.load() > 0 &&
+            source->idle_threads_size_.load() == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+ThreadPool::TryBorrow(std::function<void()>& task) {
+    for (auto* source : borrow_sources_) {
+        if (source->pending_tasks_.load() <= 0 ||
+            source->idle_threads_size_.load() > 0) {
+            continue;
+        }
+        auto start = next_queue_.fetch_add(1, std::memory_order_relaxed);
+        if (source->TryTake(start, task)) {
+            if (source->metric_borrowed_) {
+                source->metric_borrowed_->Increment();
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+ThreadPool::UpdateThreadMetrics() {
+    if (metric_idle_) {
+        metric_idle_->Set(idle_threads_size_);
+    }
+    if (metric_active_) {
+        metric_active_->Set(current_threads_size_ - idle_threads_size_);
+    }
+}
+
+void
+ThreadPool::Worker(size_t home_queue) {
     SetThreadName(name_);
-    while (!shutdown_) {
-        std::unique_lock<std::mutex> lock(mutex_);
-        idle_threads_size_++;
-        if (metric_idle_) {
-            metric_idle_->Set(idle_threads_size_);
+    current_pool = this;
+    current_home_queue = home_queue;
+    std::function<void()> func;
+    while (true) {
+        // Own lane first, then help a saturated higher-priority lane.
+        if (TryTake(home_queue, func) || TryBorrow(func)) {
+            func();
+            func = nullptr;
+            continue;
         }
-        if (metric_active_) {
-            metric_active_->Set(current_threads_size_ - idle_threads_size_);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (shutdown_ && pending_tasks_.load() <= 0) {
+            current_threads_size_--;
+            UpdateThreadMetrics();
+            return;
         }
+        idle_threads_size_++;
+        UpdateThreadMetrics();
         auto is_timeout = !condition_lock_.wait_for(
             lock, std::chrono::seconds(WAIT_SECONDS), [this]() {
-                return shutdown_ || !work_queue_.empty();
+                return shutdown_ || pending_tasks_.load() > 0 || CanBorrow();
             });
         idle_threads_size_--;
-        if (metric_idle_) {
-            metric_idle_->Set(idle_threads_size_);
-        }
-        if (metric_active_) {
-            metric_active_->Set(current_threads_size_ - idle_threads_size_);
-        }
-        if (work_queue_.empty()) {
+        UpdateThreadMetrics();
+        if (is_timeout) {
             // Dynamic reduce thread number
-            if (shutdown_) {
+            FinishThreads();
+            if (current_threads_size_ > min_threads_size_) {
+                need_finish_threads_.enqueue(std::this_thread::get_id());
                 current_threads_size_--;
-                if (metric_active_) {
-                    metric_active_->Set(current_threads_size_ -
-                                        idle_threads_size_);
-                }
+                UpdateThreadMetrics();
                 return;
             }
-            if (is_timeout) {
-                FinishThreads();
-                if (current_threads_size_ > min_threads_size_) {
-                    need_finish_threads_.enqueue(std::this_thread::get_id());
-                    current_threads_size_--;
-                    if (metric_active_) {
-                        metric_active_->Set(current_threads_size_ -
-                                            idle_threads_size_);
-                    }
-                    return;
-                }
-                continue;
-            }
-        }
-        dequeue = work_queue_.dequeue(func);
-        if (metric_queue_depth_) {
-            metric_queue_depth_->Set(work_queue_.size());
-        }
-        lock.unlock();
-        if (dequeue) {
-            func();
-            func = nullptr;
-            if (metric_completed_) {
-                metric_completed_->Increment();
-            }
         }
     }
 }
+
 };  // namespace milvus
@@ -21,8 +21,10 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <cmath>
 #include <condition_variable>
 #include <chrono>
+#include <deque>
 #include <functional>
 #include <future>
 #include <memory>
@@ -32,6 +34,7 @@
 #include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <prometheus/counter.h>
 #include <prometheus/gauge.h>
@@ -73,26 +76,34 @@ InitCpuNum(const int core);
 void
 SetThreadPoolMaxThreadsSize(const int size);
 
+// A priority lane of the segcore storage executor.
+//
+// Tasks are spread over a fixed set of queues rather than one shared queue,
+// so concurrent submitters and workers rarely contend on the same lock. A
+// worker drains its home queue and steals from the others when it runs dry;
+// a task submitted from a worker of the same lane goes to that worker's home
+// queue. Each queue is FIFO, both for its owner and for thieves.
+//
+// A lane may also borrow from higher-priority lanes: once its own queues are
+// empty, an idle worker runs queued tasks of a source lane that has no idle
+// worker left, so idle LOW threads can help a saturated HIGH lane. Borrowing
+// only flows towards higher priority, so long low-priority tasks never take
+// over high-priority workers.
+//
+// Workers are started on demand up to the max thread number, and those idle
+// for WAIT_SECONDS are stopped down to min_threads_size_.
 class ThreadPool {
  public:
-    explicit ThreadPool(const float thread_core_coefficient, std::string name)
-        : shutdown_(false), name_(std::move(name)) {
-        idle_threads_size_ = 0;
-        current_threads_size_ = 0;
-        min_threads_size_ = 1;
-        max_threads_size_.store(std::max(
-            1,
-            static_cast<int>(std::round(CPU_NUM * thread_core_coefficient))));
+    // Queue count cap, so that very large max thread sizes do not make
+    // stealing scans long.
+    static constexpr size_t MAX_QUEUE_NUM = 64;
+    static constexpr size_t WAIT_SECONDS = 2;
 
-        int max_limit = THREAD_POOL_MAX_THREADS_SIZE.load();
-        if (max_limit > 0 && max_threads_size_.load() > max_limit) {
-            max_threads_size_.store(max_limit);
-        }
-        LOG_INFO("Init thread pool:{}", name_)
-            << " with min worker num:" << min_threads_size_
-            << " and max worker num:" << max_threads_size_.load();
-        Init();
-    }
+    // 'borrow_sources' are higher-priority lanes whose queued tasks idle
+    // workers of this lane may run; they must outlive this pool's workers.
+    explicit ThreadPool(const float thread_core_coefficient,
+                        std::string name,
+                        std::vector<ThreadPool*> borrow_sources = {});
 
     ~ThreadPool() {
         ShutDown();
@@ -122,6 +133,12 @@ class ThreadPool {
         return max_threads_size_.load();
     }
 
+    // Number of queued tasks not yet picked up by a worker.
+    int64_t
+    GetQueueDepth() const {
+        return std::max<int64_t>(0, pending_tasks_.load());
+    }
+
     template <typename F, typename... Args>
     auto
     Submit(F&& f, Args&&... args) -> std::future<decltype(f(args...))> {
@@ -133,10 +150,14 @@ class ThreadPool {
         auto enqueue_time = std::chrono::steady_clock::now();
         auto* queue_metric = metric_queue_duration_;
         auto* execute_metric = metric_execute_duration_;
+        auto* completed_metric = metric_completed_;
+        // The metrics are those of this lane even if a worker of another
+        // lane borrows the task.
         std::function<void()> wrap_func = [task_ptr,
                                            enqueue_time,
                                            queue_metric,
-                                           execute_metric]() {
+                                           execute_metric,
+                                           completed_metric]() {
             auto execute_start = std::chrono::steady_clock::now();
             if (queue_metric) {
                 queue_metric->Observe(
@@ -150,6 +171,9 @@ class ThreadPool {
                             std::chrono::steady_clock::now() - execute_start)
                             .count());
                 }
+                if (completed_metric) {
+                    completed_metric->Increment();
+                }
             };
             try {
                 (*task_ptr)();
@@ -160,33 +184,12 @@ class ThreadPool {
             observe_execute();
         };
 
-        work_queue_.enqueue(wrap_func);
-        if (metric_submitted_) {
-            metric_submitted_->Increment();
-        }
-        if (metric_queue_depth_) {
-            metric_queue_depth_->Set(work_queue_.size());
-        }
-
-        std::lock_guard<std::mutex> lock(mutex_);
-
-        if (idle_threads_size_ > 0) {
-            condition_lock_.notify_one();
-        }
-        if (work_queue_.size() > static_cast<size_t>(idle_threads_size_) &&
-            current_threads_size_ < max_threads_size_.load()) {
-            // Dynamic increase thread number
-            std::thread t(&ThreadPool::Worker, this);
-            assert(threads_.find(t.get_id()) == threads_.end());
-            threads_[t.get_id()] = std::move(t);
-            current_threads_size_++;
-        }
-
+        Enqueue(std::move(wrap_func));
         return task_ptr->get_future();
     }
 
     void
-    Worker();
+    Worker(size_t home_queue);
 
     void
     FinishThreads();
@@ -214,7 +217,8 @@ class ThreadPool {
                prometheus::Counter* submitted,
                prometheus::Counter* completed,
                prometheus::Histogram* queue_duration,
-               prometheus::Histogram* execute_duration) {
+               prometheus::Histogram* execute_duration,
+               prometheus::Counter* borrowed = nullptr) {
         std::lock_guard<std::mutex> lock(mutex_);
         metric_capacity_ = capacity;
         metric_active_ = active;
@@ -224,6 +228,7 @@ class ThreadPool {
         metric_completed_ = completed;
         metric_queue_duration_ = queue_duration;
         metric_execute_duration_ = execute_duration;
+        metric_borrowed_ = borrowed;
         if (metric_capacity_) {
             metric_capacity_->Set(max_threads_size_.load());
         }
@@ -234,24 +239,60 @@ class ThreadPool {
             metric_idle_->Set(idle_threads_size_);
         }
         if (metric_queue_depth_) {
-            metric_queue_depth_->Set(work_queue_.size());
+            metric_queue_depth_->Set(GetQueueDepth());
         }
     }
 
- public:
+ private:
+    struct alignas(64) TaskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void
+    Enqueue(std::function<void()> task);
+
+    // Starts a worker; must hold mutex_.
+    void
+    StartWorker();
+
+    // Takes a queued task, scanning the queues from 'start'.
+    bool
+    TryTake(size_t start, std::function<void()>& task);
+
+    // Takes a queued task of a borrow source lacking idle workers.
+    bool
+    TryBorrow(std::function<void()>& task);
+
+    bool
+    CanBorrow() const;
+
+    void
+    UpdateThreadMetrics();
+
     int min_threads_size_;
-    int idle_threads_size_;
-    int current_threads_size_;
+    std::atomic<int> idle_threads_size_;
+    std::atomic<int> current_threads_size_;
     std::atomic<int> max_threads_size_;
-    bool shutdown_;
-    static constexpr size_t WAIT_SECONDS = 2;
-    SafeQueue<std::function<void()>> work_queue_;
+    std::atomic<bool> shutdown_;
     std::unordered_map<std::thread::id, std::thread> threads_;
     SafeQueue<std::thread::id> need_finish_threads_;
     std::mutex mutex_;
     std::condition_variable condition_lock_;
     std::string name_;
 
+    std::vector<std::unique_ptr<TaskQueue>> queues_;
+    std::atomic<size_t> next_queue_{0};
+    size_t next_home_queue_{0};
+    // Tasks pushed and not yet taken. Pushes count after the task is in its
+    // queue, so this may briefly dip below zero.
+    std::atomic<int64_t> pending_tasks_{0};
+
+    const std::vector<ThreadPool*> borrow_sources_;
+    // Lanes borrowing from this one, woken when it is saturated. Guarded by
+    // mutex_.
+    std::vector<ThreadPool*> borrowers_;
+
     // Prometheus metrics (set via SetMetrics, nullptr if not wired)
     prometheus::Gauge* metric_capacity_{nullptr};
     prometheus::Gauge* metric_active_{nullptr};
@@ -261,6 +302,8 @@ class ThreadPool {
     prometheus::Counter* metric_completed_{nullptr};
     prometheus::Histogram* metric_queue_duration_{nullptr};
     prometheus::Histogram* metric_execute_duration_{nullptr};
+    // Tasks of this lane run by workers of a borrowing lane.
+    prometheus::Counter* metric_borrowed_{nullptr};
 };
 
 }  // namespace milvus
@@ -15,7 +15,12 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "storage/ThreadPool.h"
@@ -138,4 +143,81 @@ TEST_F(ThreadPoolTest, DynamicMaxThreadsSizeUpdate) {
     EXPECT_EQ(pool.GetMaxThreadNum(), 8);
 }
 
+TEST_F(ThreadPoolTest, BorrowFromSaturatedLane) {
+    // CPU_NUM=4, coefficient=0.25, so a single worker.
+    ThreadPool high(0.25, "test_high");
+    ThreadPool low(1.0, "test_low", {&high});
+    ASSERT_EQ(high.GetMaxThreadNum(), 1);
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    auto blocker = high.Submit([released]() {
+        released.wait();
+        return 0;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // The only high worker is busy, an idle low worker runs the task.
+    auto borrowed = high.Submit([]() { return 42; });
+    ASSERT_EQ(borrowed.wait_for(std::chrono::seconds(10)),
+              std::future_status::ready);
+    EXPECT_EQ(borrowed.get(), 42);
+
+    release.set_value();
+    EXPECT_EQ(blocker.get(), 0);
+}
+
+TEST_F(ThreadPoolTest, BorrowerDestroyedBeforeSource) {
+    ThreadPool high(0.25, "test_high");
+    {
+        ThreadPool low(1.0, "test_low", {&high});
+    }
+
+    // The saturated lane must not wake the destroyed borrower.
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    auto blocker = high.Submit([released]() {
+        released.wait();
+        return 0;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto queued = high.Submit([]() { return 42; });
+
+    release.set_value();
+    EXPECT_EQ(blocker.get(), 0);
+    EXPECT_EQ(queued.get(), 42);
+}
+
+TEST_F(ThreadPoolTest, ConcurrentSubmit) {
+    ThreadPool high(2.0, "test_high");
+    ThreadPool low(1.0, "test_low", {&high});
+    constexpr int kSubmitters = 8;
+    constexpr int kTasksPerSubmitter = 2000;
+    std::atomic<int64_t> sum{0};
+    std::vector<std::thread> submitters;
+    for (int t = 0; t < kSubmitters; t++) {
+        submitters.emplace_back([&]() {
+            std::vector<std::future<int>> futures;
+            for (int i = 0; i < kTasksPerSubmitter; i++) {
+                auto& pool = i % 2 == 0 ? high : low;
+                futures.push_back(pool.Submit([&sum, i]() {
+                    sum += i;
+                    return i;
+                }));
+            }
+            for (int i = 0; i < kTasksPerSubmitter; i++) {
+                EXPECT_EQ(futures[i].get(), i);
+            }
+        });
+    }
+    for (auto& submitter : submitters) {
+        submitter.join();
+    }
+    EXPECT_EQ(sum.load(),
+              int64_t{kSubmitters} * kTasksPerSubmitter *
+                  (kTasksPerSubmitter - 1) / 2);
+    EXPECT_EQ(high.GetQueueDepth(), 0);
+    EXPECT_EQ(low.GetQueueDepth(), 0);
+}
+
 }  // namespace milvus
@@ -19,10 +19,12 @@
 #include <atomic>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 #include "glog/logging.h"
 #include "log/Log.h"
 #include "monitor/Monitor.h"
+#include "common/EasyAssert.h"
 #include "storage/ThreadPool.h"
 
 namespace milvus {
@@ -40,70 +42,93 @@ ThreadPools::ShutDown() {
     }
 }
 
+namespace {
+
+float
+CoefficientOf(ThreadPoolPriority priority) {
+    switch (priority) {
+        case milvus::ThreadPoolPriority::HIGH:
+            return HIGH_PRIORITY_THREAD_CORE_COEFFICIENT.load();
+        case milvus::ThreadPoolPriority::MIDDLE:
+            return MIDDLE_PRIORITY_THREAD_CORE_COEFFICIENT.load();
+        default:
+            return LOW_PRIORITY_THREAD_CORE_COEFFICIENT.load();
+    }
+}
+
+void
+SetPoolMetrics(ThreadPoolPriority priority, ThreadPool& pool) {
+    switch (priority) {
+        case HIGH:
+            pool.SetMetrics(
+                &monitor::internal_storage_pool_capacity_high,
+                &monitor::internal_storage_pool_active_threads_high,
+                &monitor::internal_storage_pool_idle_threads_high,
+                &monitor::internal_storage_pool_queue_depth_high,
+                &monitor::internal_storage_pool_task_submitted_total_high,
+                &monitor::internal_storage_pool_task_completed_total_high,
+                &monitor::internal_storage_pool_queue_duration_seconds_high,
+                &monitor::internal_storage_pool_execute_duration_seconds_high,
+                &monitor::internal_storage_pool_task_borrowed_total_high);
+            break;
+        case MIDDLE:
+            pool.SetMetrics(
+                &monitor::internal_storage_pool_capacity_middle,
+                &monitor::internal_storage_pool_active_threads_middle,
+                &monitor::internal_storage_pool_idle_threads_middle,
+                &monitor::internal_storage_pool_queue_depth_middle,
+                &monitor::internal_storage_pool_task_submitted_total_middle,
+                &monitor::internal_storage_pool_task_completed_total_middle,
+                &monitor::internal_storage_pool_queue_duration_seconds_middle,
+                &monitor::
+                    internal_storage_pool_execute_duration_seconds_middle,
+                &monitor::internal_storage_pool_task_borrowed_total_middle);
+            break;
+        case LOW:
+            pool.SetMetrics(
+                &monitor::internal_storage_pool_capacity_low,
+                &monitor::internal_storage_pool_active_threads_low,
+                &monitor::internal_storage_pool_idle_threads_low,
+                &monitor::internal_storage_pool_queue_depth_low,
+                &monitor::internal_storage_pool_task_submitted_total_low,
+                &monitor::internal_storage_pool_task_completed_total_low,
+                &monitor::internal_storage_pool_queue_duration_seconds_low,
+                &monitor::internal_storage_pool_execute_duration_seconds_low);
+            break;
+    }
+}
+
+// Destroyed before thread_pool_map, as it is defined after it. Workers of a
+// lane may be borrowing tasks from another lane, so every lane is stopped
+// before any of them is freed.
+struct ShutDownOnExit {
+    ~ShutDownOnExit() {
+        ThreadPools::ShutDown();
+    }
+} shut_down_on_exit;
+
+}  // namespace
+
 ThreadPool&
 ThreadPools::GetThreadPool(milvus::ThreadPoolPriority priority) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    auto iter = thread_pool_map.find(priority);
-    if (iter != thread_pool_map.end()) {
-        return *(iter->second);
-    } else {
-        float coefficient = 1.0;
-        switch (priority) {
-            case milvus::ThreadPoolPriority::HIGH:
-                coefficient = HIGH_PRIORITY_THREAD_CORE_COEFFICIENT.load();
-                break;
-            case milvus::ThreadPoolPriority::MIDDLE:
-                coefficient = MIDDLE_PRIORITY_THREAD_CORE_COEFFICIENT.load();
-                break;
-            default:
-                coefficient = LOW_PRIORITY_THREAD_CORE_COEFFICIENT.load();
-                break;
-        }
-        std::string name = name_map()[priority];
-        auto result = thread_pool_map.emplace(
-            priority, std::make_unique<ThreadPool>(coefficient, name));
-        auto& pool = *(result.first->second);
-        switch (priority) {
-            case HIGH:
-                pool.SetMetrics(
-                    &monitor::internal_storage_pool_capacity_high,
-                    &monitor::internal_storage_pool_active_threads_high,
-                    &monitor::internal_storage_pool_idle_threads_high,
-                    &monitor::internal_storage_pool_queue_depth_high,
-                    &monitor::internal_storage_pool_task_submitted_total_high,
-                    &monitor::internal_storage_pool_task_completed_total_high,
-                    &monitor::internal_storage_pool_queue_duration_seconds_high,
-                    &monitor::
-                        internal_storage_pool_execute_duration_seconds_high);
-                break;
-            case MIDDLE:
-                pool.SetMetrics(
-                    &monitor::internal_storage_pool_capacity_middle,
-                    &monitor::internal_storage_pool_active_threads_middle,
-                    &monitor::internal_storage_pool_idle_threads_middle,
-                    &monitor::internal_storage_pool_queue_depth_middle,
-                    &monitor::internal_storage_pool_task_submitted_total_middle,
-                    &monitor::internal_storage_pool_task_completed_total_middle,
-                    &monitor::
-                        internal_storage_pool_queue_duration_seconds_middle,
-                    &monitor::
-                        internal_storage_pool_execute_duration_seconds_middle);
-                break;
-            case LOW:
-                pool.SetMetrics(
-                    &monitor::internal_storage_pool_capacity_low,
-                    &monitor::internal_storage_pool_active_threads_low,
-                    &monitor::internal_storage_pool_idle_threads_low,
-                    &monitor::internal_storage_pool_queue_depth_low,
-                    &monitor::internal_storage_pool_task_submitted_total_low,
-                    &monitor::internal_storage_pool_task_completed_total_low,
-                    &monitor::internal_storage_pool_queue_duration_seconds_low,
-                    &monitor::
-                        internal_storage_pool_execute_duration_seconds_low);
-                break;
+    if (thread_pool_map.empty()) {
+        // The lanes are created together, in priority order, so that each
+        // one can borrow from the higher-priority lanes created before it.
+        std::vector<ThreadPool*> borrow_sources;
+        for (auto lane : {HIGH, MIDDLE, LOW}) {
+            auto pool = std::make_unique<ThreadPool>(
+                CoefficientOf(lane), name_map()[lane], borrow_sources);
+            SetPoolMetrics(lane, *pool);
+            borrow_sources.push_back(pool.get());
+            thread_pool_map.emplace(lane, std::move(pool));
         }
-        return pool;
     }
+    auto iter = thread_pool_map.find(priority);
+    AssertInfo(iter != thread_pool_map.end(),
+               "unknown thread pool priority: {}",
+               static_cast<int>(priority));
+    return *(iter->second);
 }
 
 void
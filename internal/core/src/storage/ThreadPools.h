@@ -52,6 +52,10 @@ class ThreadPools {
     static void
     ResizeThreadPool(ThreadPoolPriority priority, float ratio);
 
+    // Stops the workers of every lane, draining their queued tasks.
+    static void
+    ShutDown();
+
     ~ThreadPools() {
         ShutDown();
     }
@@ -59,8 +63,6 @@ class ThreadPools {
  private:
     ThreadPools() {
     }
-    void
-    ShutDown();
 
     static std::map<ThreadPoolPriority, std::string>
     name_map() {
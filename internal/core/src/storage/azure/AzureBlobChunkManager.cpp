@@ -286,10 +286,11 @@ uint64_t
 AzureBlobChunkManager::GetObjectBuffer(const std::string& bucket_name,
                                        const std::string& object_name,
                                        void* buf,
-                                       uint64_t size) {
+                                       uint64_t size,
+                                       uint64_t offset) {
     Azure::Storage::Blobs::DownloadBlobOptions downloadOptions;
     downloadOptions.Range = Azure::Core::Http::HttpRange();
-    downloadOptions.Range.Value().Offset = 0;
+    downloadOptions.Range.Value().Offset = offset;
     downloadOptions.Range.Value().Length = size;
     Azure::Core::Context context;
     if (requestTimeoutMs_ > 0) {
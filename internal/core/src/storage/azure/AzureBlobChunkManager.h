@@ -74,7 +74,8 @@ class AzureBlobChunkManager {
     GetObjectBuffer(const std::string& bucket_name,
                     const std::string& object_name,
                     void* buf,
-                    uint64_t size);
+                    uint64_t size,
+                    uint64_t offset = 0);
     std::vector<std::string>
     ListObjects(const std::string& bucket_name,
                 const std::string& prefix = nullptr);
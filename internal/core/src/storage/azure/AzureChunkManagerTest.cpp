@@ -109,7 +109,7 @@ TEST_F(AzureChunkManagerTest, BasicFunctions) {
     try {
         chunk_manager_->Read(path, 0, readdata, sizeof(readdata));
     } catch (SegcoreError& e) {
-        EXPECT_TRUE(string(e.what()).find("Read") != string::npos);
+        EXPECT_TRUE(string(e.what()).find("GetObjectBuffer") != string::npos);
     }
     try {
         chunk_manager_->Write(path, 0, readdata, sizeof(readdata));
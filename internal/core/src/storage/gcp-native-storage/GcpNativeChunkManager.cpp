@@ -74,6 +74,14 @@ GcpNativeChunkManager::Read(const std::string& filepath,
     return GetObjectBuffer(default_bucket_name_, filepath, buf, size);
 }
 
+uint64_t
+GcpNativeChunkManager::Read(const std::string& filepath,
+                            uint64_t offset,
+                            void* buf,
+                            uint64_t size) {
+    return GetObjectBuffer(default_bucket_name_, filepath, buf, size, offset);
+}
+
 void
 GcpNativeChunkManager::Write(const std::string& filepath,
                              void* buf,
@@ -227,11 +235,13 @@ uint64_t
 GcpNativeChunkManager::GetObjectBuffer(const std::string& bucket_name,
                                        const std::string& object_name,
                                        void* buf,
-                                       uint64_t size) {
+                                       uint64_t size,
+                                       uint64_t offset) {
     uint64_t res;
     try {
         auto start = std::chrono::system_clock::now();
-        res = client_->GetObjectBuffer(bucket_name, object_name, buf, size);
+        res = client_->GetObjectBuffer(
+            bucket_name, object_name, buf, size, offset);
         milvus::monitor::internal_storage_request_latency_get.Observe(
             std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::system_clock::now() - start)
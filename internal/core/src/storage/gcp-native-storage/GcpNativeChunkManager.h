@@ -73,9 +73,7 @@ class GcpNativeChunkManager : public ChunkManager {
     Read(const std::string& filepath,
          uint64_t offset,
          void* buf,
-         uint64_t len) override {
-        ThrowInfo(NotImplemented, GetName() + "Read with offset not implement");
-    }
+         uint64_t len) override;
 
     void
     Write(const std::string& filepath,
@@ -149,7 +147,8 @@ class GcpNativeChunkManager : public ChunkManager {
     GetObjectBuffer(const std::string& bucket_name,
                     const std::string& object_name,
                     void* buf,
-                    uint64_t size);
+                    uint64_t size,
+                    uint64_t offset = 0);
     std::vector<std::string>
     ListObjects(const std::string& bucket_name,
                 const std::string& prefix = nullptr);
@@ -175,8 +175,13 @@ uint64_t
 GcpNativeClientManager::GetObjectBuffer(const std::string& bucket_name,
                                         const std::string& object_name,
                                         void* buf,
-                                        uint64_t size) {
-    auto stream = client_->ReadObject(bucket_name, object_name);
+                                        uint64_t size,
+                                        uint64_t offset) {
+    auto stream = size > 0 ? client_->ReadObject(
+                                 bucket_name,
+                                 object_name,
+                                 gcs::ReadRange(offset, offset + size))
+                           : client_->ReadObject(bucket_name, object_name);
     if (stream.bad()) {
         throw std::runtime_error(GetGcpNativeError(stream.status()));
     }
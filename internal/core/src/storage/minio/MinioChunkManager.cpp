@@ -489,6 +489,14 @@ MinioChunkManager::Read(const std::string& filepath, void* buf, uint64_t size) {
     return GetObjectBuffer(default_bucket_name_, filepath, buf, size);
 }
 
+uint64_t
+MinioChunkManager::Read(const std::string& filepath,
+                        uint64_t offset,
+                        void* buf,
+                        uint64_t size) {
+    return GetObjectBuffer(default_bucket_name_, filepath, buf, size, offset);
+}
+
 void
 MinioChunkManager::Write(const std::string& filepath,
                          void* buf,
@@ -739,10 +747,15 @@ uint64_t
 MinioChunkManager::GetObjectBuffer(const std::string& bucket_name,
                                    const std::string& object_name,
                                    void* buf,
-                                   uint64_t size) {
+                                   uint64_t size,
+                                   uint64_t offset) {
     Aws::S3::Model::GetObjectRequest request;
     request.SetBucket(bucket_name.c_str());
     request.SetKey(object_name.c_str());
+    if (size > 0) {
+        request.SetRange(
+            fmt::format("bytes={}-{}", offset, offset + size - 1).c_str());
+    }
 
     request.SetResponseStreamFactory([buf, size]() {
     // For macOs, pubsetbuf interface not implemented
@@ -774,7 +787,8 @@ MinioChunkManager::GetObjectBuffer(const std::string& bucket_name,
                      object_name);
     }
     milvus::monitor::internal_storage_op_count_get_suc.Increment();
-    return size;
+    // A range running past the end of the object comes back short.
+    return std::min<uint64_t>(outcome.GetResult().GetContentLength(), size);
 }
 
 std::vector<std::string>
@@ -150,9 +150,7 @@ class MinioChunkManager : public ChunkManager {
     Read(const std::string& filepath,
          uint64_t offset,
          void* buf,
-         uint64_t len) {
-        ThrowInfo(NotImplemented, GetName() + "Read with offset not implement");
-    }
+         uint64_t len);
 
     virtual void
     Write(const std::string& filepath,
@@ -227,7 +225,8 @@ class MinioChunkManager : public ChunkManager {
     GetObjectBuffer(const std::string& bucket_name,
                     const std::string& object_name,
                     void* buf,
-                    uint64_t size);
+                    uint64_t size,
+                    uint64_t offset = 0);
 
     std::vector<std::string>
     ListObjects(const std::string& bucket_name, const std::string& prefix = "");
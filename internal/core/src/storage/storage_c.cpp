@@ -110,6 +110,17 @@ InitRemoteChunkManagerSingleton(CStorageConfig c_storage_config) {
     }
 }
 
+CStatus
+InitRemoteChunkManagerDiskCache(const char* cache_dir, int64_t capacity_bytes) {
+    try {
+        milvus::storage::RemoteChunkManagerSingleton::GetInstance()
+            .EnableDiskCache(std::string(cache_dir), capacity_bytes);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
 CStatus
 InitMmapManager(CMmapConfig c_mmap_config) {
     try {
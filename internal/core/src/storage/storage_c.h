@@ -33,6 +33,9 @@ InitLocalChunkManagerSingleton(const char* path);
 CStatus
 InitRemoteChunkManagerSingleton(CStorageConfig c_storage_config);
 
+CStatus
+InitRemoteChunkManagerDiskCache(const char* cache_dir, int64_t capacity_bytes);
+
 CStatus
 InitMmapManager(CMmapConfig c_mmap_config);
 
@@ -0,0 +1,305 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/Types.h"
+#include "common/Vector.h"
+#include "exec/QueryContext.h"
+#include "exec/VectorHasher.h"
+#include "exec/expression/function/FunctionFactory.h"
+#include "exec/operator/query-agg/Aggregate.h"
+#include "exec/operator/query-agg/AggregateInfo.h"
+#include "exec/operator/query-agg/GroupingSet.h"
+#include "segcore/SegcoreConfig.h"
+
+using namespace milvus;
+using namespace milvus::exec;
+
+class GroupingSetSpillTest : public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        milvus::exec::expression::FunctionFactory::Instance().Initialize();
+        auto& config = segcore::SegcoreConfig::default_config();
+        saved_max_groups_ = config.get_max_group_by_groups();
+        saved_budget_ = config.get_query_spill_memory_budget();
+        saved_dir_ = config.get_query_spill_dir();
+        spill_dir_ =
+            std::filesystem::temp_directory_path() / "grouping_set_spill_test";
+    }
+
+    void
+    TearDown() override {
+        auto& config = segcore::SegcoreConfig::default_config();
+        config.set_max_group_by_groups(saved_max_groups_);
+        config.set_query_spill_memory_budget(saved_budget_);
+        config.set_query_spill_dir(saved_dir_);
+        std::error_code ec;
+        std::filesystem::remove_all(spill_dir_, ec);
+    }
+
+    void
+    EnableSpill(int64_t max_groups, int64_t budget) {
+        auto& config = segcore::SegcoreConfig::default_config();
+        config.set_max_group_by_groups(max_groups);
+        config.set_query_spill_memory_budget(budget);
+        config.set_query_spill_dir(spill_dir_.string());
+    }
+
+    static AggregateInfo
+    MakeAggregate(const std::string& name,
+                  DataType input_type,
+                  column_index_t input_column,
+                  column_index_t output) {
+        AggregateInfo info;
+        info.function_ = Aggregate::create(name, {input_type}, QueryConfig{});
+        info.input_column_idxes_ = {input_column};
+        info.output_ = output;
+        return info;
+    }
+
+    template <typename T>
+    static ColumnVectorPtr
+    MakeColumn(DataType type, const std::vector<T>& values) {
+        auto col = std::make_shared<ColumnVector>(type, values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            col->SetValueAt<T>(i, values[i]);
+        }
+        return col;
+    }
+
+    // Drains 'set' the way PhyAggregationNode does, one batch per call.
+    static std::vector<RowVectorPtr>
+    DrainOutput(GroupingSet& set, const RowTypePtr& output_type) {
+        std::vector<RowVectorPtr> batches;
+        do {
+            auto result = std::make_shared<RowVector>(output_type, 0);
+            if (set.getOutput(result)) {
+                batches.push_back(result);
+            }
+        } while (set.hasRemainingOutput());
+        return batches;
+    }
+
+    int64_t saved_max_groups_{0};
+    int64_t saved_budget_{0};
+    std::string saved_dir_;
+    std::filesystem::path spill_dir_;
+};
+
+TEST_F(GroupingSetSpillTest, GroupCapTriggersSpillInsteadOfError) {
+    // Without spilling the 1000 group cap would fail this query; with it the
+    // table spills to partitions and merges them back with exact results.
+    EnableSpill(1000, 1L << 30);
+    auto input_type = std::make_shared<RowType>(
+        std::vector<std::string>{"key", "val"},
+        std::vector<DataType>{DataType::INT64, DataType::INT64});
+    auto output_type = std::make_shared<RowType>(
+        std::vector<std::string>{"key", "cnt", "sum"},
+        std::vector<DataType>{
+            DataType::INT64, DataType::INT64, DataType::INT64});
+
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    hashers.emplace_back(VectorHasher::create(DataType::INT64, 0));
+    std::vector<AggregateInfo> aggregates;
+    aggregates.emplace_back(MakeAggregate("count", DataType::INT64, 1, 1));
+    aggregates.emplace_back(MakeAggregate("sum", DataType::INT64, 1, 2));
+    GroupingSet set(input_type, std::move(hashers), std::move(aggregates));
+
+    constexpr int64_t kNumKeys = 10000;
+    constexpr int64_t kBatchRows = 500;
+    // Every key shows up twice, in batches far apart, so that its two halves
+    // land in different spill rounds.
+    for (int round = 0; round < 2; ++round) {
+        for (int64_t start = 0; start < kNumKeys; start += kBatchRows) {
+            std::vector<int64_t> keys;
+            std::vector<int64_t> vals;
+            for (int64_t k = start; k < start + kBatchRows; ++k) {
+                keys.push_back(k);
+                vals.push_back(k * 10 + round);
+            }
+            auto input = std::make_shared<RowVector>(std::vector<VectorPtr>{
+                MakeColumn(DataType::INT64, keys),
+                MakeColumn(DataType::INT64, vals)});
+            set.addInput(input);
+        }
+    }
+    EXPECT_GT(set.numSpills(), 1);
+
+    auto batches = DrainOutput(set, output_type);
+    EXPECT_GT(batches.size(), 1);
+    std::map<int64_t, std::pair<int64_t, int64_t>> results;
+    for (auto& batch : batches) {
+        auto keys = std::dynamic_pointer_cast<ColumnVector>(batch->child(0));
+        auto cnts = std::dynamic_pointer_cast<ColumnVector>(batch->child(1));
+        auto sums = std::dynamic_pointer_cast<ColumnVector>(batch->child(2));
+        for (size_t i = 0; i < keys->size(); ++i) {
+            auto inserted = results.emplace(
+                keys->ValueAt<int64_t>(i),
+                std::make_pair(cnts->ValueAt<int64_t>(i),
+                               sums->ValueAt<int64_t>(i)));
+            EXPECT_TRUE(inserted.second) << "duplicate group";
+        }
+    }
+    ASSERT_EQ(results.size(), kNumKeys);
+    for (auto& [key, agg] : results) {
+        EXPECT_EQ(agg.first, 2);
+        EXPECT_EQ(agg.second, key * 20 + 1);
+    }
+}
+
+TEST_F(GroupingSetSpillTest, MemoryBudgetSpillsStringAccumulators) {
+    EnableSpill(segcore::SegcoreConfig::kDefaultMaxGroupByGroups, 16 << 10);
+    auto input_type = std::make_shared<RowType>(
+        std::vector<std::string>{"key", "val"},
+        std::vector<DataType>{DataType::VARCHAR, DataType::VARCHAR});
+    auto output_type = std::make_shared<RowType>(
+        std::vector<std::string>{"key", "min", "max"},
+        std::vector<DataType>{
+            DataType::VARCHAR, DataType::VARCHAR, DataType::VARCHAR});
+
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    hashers.emplace_back(VectorHasher::create(DataType::VARCHAR, 0));
+    std::vector<AggregateInfo> aggregates;
+    aggregates.emplace_back(MakeAggregate("min", DataType::VARCHAR, 1, 1));
+    aggregates.emplace_back(MakeAggregate("max", DataType::VARCHAR, 1, 2));
+    GroupingSet set(input_type, std::move(hashers), std::move(aggregates));
+
+    constexpr int kNumKeys = 2000;
+    for (int round = 0; round < 3; ++round) {
+        std::vector<std::string> keys;
+        std::vector<std::string> vals;
+        for (int k = 0; k < kNumKeys; ++k) {
+            keys.push_back("key_" + std::to_string(k));
+            vals.push_back("v" + std::to_string(round) + "_" +
+                           std::to_string(k));
+        }
+        auto input = std::make_shared<RowVector>(
+            std::vector<VectorPtr>{MakeColumn(DataType::VARCHAR, keys),
+                                   MakeColumn(DataType::VARCHAR, vals)});
+        set.addInput(input);
+    }
+    EXPECT_GT(set.numSpills(), 0);
+
+    size_t total = 0;
+    for (auto& batch : DrainOutput(set, output_type)) {
+        auto keys = std::dynamic_pointer_cast<ColumnVector>(batch->child(0));
+        auto mins = std::dynamic_pointer_cast<ColumnVector>(batch->child(1));
+        auto maxs = std::dynamic_pointer_cast<ColumnVector>(batch->child(2));
+        for (size_t i = 0; i < keys->size(); ++i) {
+            auto suffix = keys->ValueAt<std::string>(i).substr(4);
+            EXPECT_EQ(mins->ValueAt<std::string>(i), "v0_" + suffix);
+            EXPECT_EQ(maxs->ValueAt<std::string>(i), "v2_" + suffix);
+        }
+        total += keys->size();
+    }
+    EXPECT_EQ(total, kNumKeys);
+}
+
+TEST_F(GroupingSetSpillTest, MergePartialGroupingSets) {
+    auto input_type = std::make_shared<RowType>(
+        std::vector<std::string>{"key", "val"},
+        std::vector<DataType>{DataType::INT64, DataType::VARCHAR});
+    auto output_type = std::make_shared<RowType>(
+        std::vector<std::string>{"key", "cnt", "max"},
+        std::vector<DataType>{
+            DataType::INT64, DataType::INT64, DataType::VARCHAR});
+    auto make_set = [&]() {
+        std::vector<std::unique_ptr<VectorHasher>> hashers;
+        hashers.emplace_back(VectorHasher::create(DataType::INT64, 0));
+        std::vector<AggregateInfo> aggregates;
+        aggregates.emplace_back(
+            MakeAggregate("count", DataType::VARCHAR, 1, 1));
+        aggregates.emplace_back(MakeAggregate("max", DataType::VARCHAR, 1, 2));
+        return std::make_unique<GroupingSet>(
+            input_type, std::move(hashers), std::move(aggregates));
+    };
+
+    // Each partial sees every key once, with its own value, the way the row
+    // ranges of one input batch would.
+    constexpr int kNumPartials = 4;
+    constexpr int64_t kNumKeys = 3000;
+    auto final_set = make_set();
+    for (int p = 0; p < kNumPartials; ++p) {
+        auto partial = make_set();
+        std::vector<int64_t> keys;
+        std::vector<std::string> vals;
+        for (int64_t k = 0; k < kNumKeys; ++k) {
+            keys.push_back(k);
+            vals.push_back("v" + std::to_string(p) + "_" + std::to_string(k));
+        }
+        partial->addInput(std::make_shared<RowVector>(
+            std::vector<VectorPtr>{MakeColumn(DataType::INT64, keys),
+                                   MakeColumn(DataType::VARCHAR, vals)}));
+        final_set->mergePartial(*partial);
+    }
+
+    size_t total = 0;
+    for (auto& batch : DrainOutput(*final_set, output_type)) {
+        auto keys = std::dynamic_pointer_cast<ColumnVector>(batch->child(0));
+        auto cnts = std::dynamic_pointer_cast<ColumnVector>(batch->child(1));
+        auto maxs = std::dynamic_pointer_cast<ColumnVector>(batch->child(2));
+        for (size_t i = 0; i < keys->size(); ++i) {
+            auto key = keys->ValueAt<int64_t>(i);
+            EXPECT_EQ(cnts->ValueAt<int64_t>(i), kNumPartials);
+            EXPECT_EQ(maxs->ValueAt<std::string>(i),
+                      "v" + std::to_string(kNumPartials - 1) + "_" +
+                          std::to_string(key));
+        }
+        total += keys->size();
+    }
+    EXPECT_EQ(total, kNumKeys);
+}
+
+TEST_F(GroupingSetSpillTest, MergePartialGlobalAggregation) {
+    auto input_type = std::make_shared<RowType>(
+        std::vector<std::string>{"val"},
+        std::vector<DataType>{DataType::INT64});
+    auto output_type = std::make_shared<RowType>(
+        std::vector<std::string>{"cnt", "sum"},
+        std::vector<DataType>{DataType::INT64, DataType::INT64});
+    auto make_set = [&]() {
+        std::vector<AggregateInfo> aggregates;
+        aggregates.emplace_back(MakeAggregate("count", DataType::INT64, 0, 0));
+        aggregates.emplace_back(MakeAggregate("sum", DataType::INT64, 0, 1));
+        return std::make_unique<GroupingSet>(
+            input_type,
+            std::vector<std::unique_ptr<VectorHasher>>{},
+            std::move(aggregates));
+    };
+
+    auto final_set = make_set();
+    for (int p = 0; p < 3; ++p) {
+        auto partial = make_set();
+        std::vector<int64_t> vals(100, p + 1);
+        partial->addInput(std::make_shared<RowVector>(
+            std::vector<VectorPtr>{MakeColumn(DataType::INT64, vals)}));
+        final_set->mergePartial(*partial);
+    }
+    // A partial that saw no input leaves the result untouched.
+    auto empty = make_set();
+    final_set->mergePartial(*empty);
+
+    auto result = std::make_shared<RowVector>(output_type, 1);
+    ASSERT_TRUE(final_set->getOutput(result));
+    auto cnt = std::dynamic_pointer_cast<ColumnVector>(result->child(0));
+    auto sum = std::dynamic_pointer_cast<ColumnVector>(result->child(1));
+    EXPECT_EQ(cnt->ValueAt<int64_t>(0), 300);
+    EXPECT_EQ(sum->ValueAt<int64_t>(0), 600);
+}
@@ -10,6 +10,8 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
 #include <map>
 #include <set>
 #include <vector>
@@ -1396,6 +1398,8 @@ createAndInsertGroups(int64_t numGroups,
         milvus::exec::VectorHasher::create(milvus::DataType::INT64, 0));
     auto table = std::make_unique<milvus::exec::HashTable>(
         std::move(hashers), accumulators, maxNumGroups);
+    // Dense INT64 keys would otherwise run in kArray mode without rehashing.
+    table->forceGenericHashMode();
 
     int64_t inserted = 0;
     while (inserted < numGroups) {
@@ -1440,6 +1444,7 @@ TEST(HashTableRehashTest, TestHashTableRehashCorrectness) {
         milvus::exec::VectorHasher::create(milvus::DataType::INT64, 0));
     auto table = std::make_unique<milvus::exec::HashTable>(
         std::move(hashers), accumulators, 1000000);
+    table->forceGenericHashMode();
 
     // Insert numGroups distinct values
     auto col = std::make_shared<milvus::ColumnVector>(milvus::DataType::INT64,
@@ -1532,3 +1537,94 @@ TEST(HashTableRehashTest, TestHashTableRehashMultipleRounds) {
             << "Group " << i << " not found after multiple rehashes";
     }
 }
+
+namespace {
+using HashMode = milvus::exec::BaseHashTable::HashMode;
+
+milvus::ColumnVectorPtr
+makeInt64Column(const std::vector<int64_t>& values) {
+    auto col = std::make_shared<milvus::ColumnVector>(milvus::DataType::INT64,
+                                                      values.size());
+    auto* data = reinterpret_cast<int64_t*>(col->GetRawData());
+    std::copy(values.begin(), values.end(), data);
+    return col;
+}
+
+std::vector<char*>
+probe(milvus::exec::HashTable& table,
+      const std::vector<milvus::VectorPtr>& columns) {
+    auto input = std::make_shared<milvus::RowVector>(columns);
+    milvus::exec::HashLookup lookup(table.hashers());
+    table.prepareForGroupProbe(lookup, input);
+    table.groupProbe(lookup);
+    return lookup.hits_;
+}
+
+std::unique_ptr<milvus::exec::HashTable>
+createInt64KeyTable(int numKeys) {
+    std::vector<milvus::exec::Accumulator> accumulators;
+    std::vector<std::unique_ptr<milvus::exec::VectorHasher>> hashers;
+    for (int i = 0; i < numKeys; i++) {
+        hashers.push_back(
+            milvus::exec::VectorHasher::create(milvus::DataType::INT64, i));
+    }
+    return std::make_unique<milvus::exec::HashTable>(
+        std::move(hashers), accumulators, 1000000);
+}
+}  // namespace
+
+TEST(HashTableHashModeTest, SmallRangeKeysUseArrayMode) {
+    auto table = createInt64KeyTable(1);
+    std::vector<int64_t> keys;
+    for (int64_t i = 0; i < 1000; i++) {
+        keys.push_back(i % 20 + 100);
+    }
+    auto hits = probe(*table, {makeInt64Column(keys)});
+    EXPECT_EQ(table->hashMode(), HashMode::kArray);
+    EXPECT_EQ(table->numDistinct(), 20);
+    for (size_t i = 20; i < keys.size(); i++) {
+        EXPECT_EQ(hits[i], hits[i % 20]);
+    }
+
+    // Keys just outside the first range widen it and keep the old groups.
+    auto wider = probe(*table, {makeInt64Column({119, 100, 150, 60})});
+    EXPECT_EQ(table->hashMode(), HashMode::kArray);
+    EXPECT_EQ(wider[0], hits[19]);
+    EXPECT_EQ(wider[1], hits[0]);
+    EXPECT_EQ(table->numDistinct(), 22);
+}
+
+TEST(HashTableHashModeTest, MultipleKeysUseNormalizedKeyMode) {
+    auto table = createInt64KeyTable(2);
+    std::vector<int64_t> k0;
+    std::vector<int64_t> k1;
+    for (int64_t i = 0; i < 4000; i++) {
+        k0.push_back(i * 5000);
+        k1.push_back(i % 1000);
+    }
+    auto hits = probe(*table, {makeInt64Column(k0), makeInt64Column(k1)});
+    EXPECT_EQ(table->hashMode(), HashMode::kNormalizedKey);
+    EXPECT_EQ(table->numDistinct(), 4000);
+
+    auto again = probe(*table, {makeInt64Column(k0), makeInt64Column(k1)});
+    EXPECT_EQ(again, hits);
+    EXPECT_EQ(table->numDistinct(), 4000);
+}
+
+TEST(HashTableHashModeTest, WideKeysFallBackToHashMode) {
+    auto table = createInt64KeyTable(2);
+    auto hits = probe(
+        *table, {makeInt64Column({1, 2, 3}), makeInt64Column({4, 5, 6})});
+    EXPECT_EQ(table->hashMode(), HashMode::kArray);
+
+    // Two full-width INT64 ranges cannot be packed into 64 bits.
+    constexpr int64_t kMax = std::numeric_limits<int64_t>::max();
+    constexpr int64_t kMin = std::numeric_limits<int64_t>::min();
+    auto wide = probe(*table,
+                      {makeInt64Column({kMin, 2, kMax, 1}),
+                       makeInt64Column({kMax, 5, kMin, 4})});
+    EXPECT_EQ(table->hashMode(), HashMode::kHash);
+    EXPECT_EQ(wide[1], hits[1]);
+    EXPECT_EQ(wide[3], hits[0]);
+    EXPECT_EQ(table->numDistinct(), 5);
+}
@@ -0,0 +1,244 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/Types.h"
+#include "common/Utils.h"
+#include "common/Vector.h"
+#include "exec/QueryContext.h"
+#include "exec/VectorHasher.h"
+#include "exec/expression/function/FunctionFactory.h"
+#include "exec/operator/query-agg/Aggregate.h"
+#include "exec/operator/query-agg/AggregateInfo.h"
+#include "exec/operator/query-agg/GroupingSet.h"
+#include "exec/operator/query-agg/HyperLogLog.h"
+#include "exec/operator/query-agg/TDigest.h"
+#include "folly/hash/Hash.h"
+
+using namespace milvus;
+using namespace milvus::exec;
+
+TEST(HyperLogLogTest, EstimateWithinErrorBound) {
+    for (int64_t n : {0, 10, 1000, 100000}) {
+        HyperLogLog hll;
+        for (int64_t i = 0; i < n; ++i) {
+            hll.add(folly::hash::twang_mix64(i));
+            // Duplicates do not change the estimate.
+            hll.add(folly::hash::twang_mix64(i));
+        }
+        EXPECT_NEAR(hll.cardinality(), n, std::max<double>(1, n * 0.05));
+    }
+}
+
+TEST(HyperLogLogTest, MergeAndSerialize) {
+    HyperLogLog sparse;
+    HyperLogLog dense;
+    for (int64_t i = 0; i < 50; ++i) {
+        sparse.add(folly::hash::twang_mix64(i));
+    }
+    for (int64_t i = 0; i < 20000; ++i) {
+        dense.add(folly::hash::twang_mix64(i + 10));
+    }
+    ASSERT_TRUE(sparse.isSparse());
+    ASSERT_FALSE(dense.isSparse());
+
+    for (auto* hll : {&sparse, &dense}) {
+        std::string state;
+        hll->serialize(state);
+        EXPECT_EQ(HyperLogLog::deserialize(state).cardinality(),
+                  hll->cardinality());
+    }
+
+    sparse.merge(dense);
+    EXPECT_NEAR(sparse.cardinality(), 20010, 20010 * 0.05);
+    EXPECT_ANY_THROW(HyperLogLog::deserialize("\x01"));
+}
+
+TEST(TDigestTest, QuantilesAndMerge) {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> dist(0, 1000);
+    TDigest left;
+    TDigest right;
+    for (int i = 0; i < 100000; ++i) {
+        (i % 2 == 0 ? left : right).add(dist(rng));
+    }
+    std::string state;
+    right.serialize(state);
+    left.merge(TDigest::deserialize(state));
+    EXPECT_EQ(left.totalWeight(), 100000);
+    for (double q : {0.01, 0.5, 0.9, 0.99}) {
+        EXPECT_NEAR(left.quantile(q), q * 1000, 10) << "quantile " << q;
+    }
+    EXPECT_GE(left.quantile(0), 0);
+    EXPECT_LE(left.quantile(1), 1000);
+}
+
+class SketchAggregateTest : public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        milvus::exec::expression::FunctionFactory::Instance().Initialize();
+    }
+
+    static AggregateInfo
+    MakeAggregate(const std::string& name,
+                  DataType input_type,
+                  column_index_t input_column,
+                  column_index_t output) {
+        AggregateInfo info;
+        info.function_ = Aggregate::create(name, {input_type}, QueryConfig{});
+        info.input_column_idxes_ = {input_column};
+        info.output_ = output;
+        return info;
+    }
+
+    template <typename T>
+    static ColumnVectorPtr
+    MakeColumn(DataType type, const std::vector<T>& values) {
+        auto col = std::make_shared<ColumnVector>(type, values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            col->SetValueAt<T>(i, values[i]);
+        }
+        return col;
+    }
+
+    // Runs a global aggregation of 'name' over 'input' and returns its only
+    // output row.
+    static ColumnVectorPtr
+    RunGlobal(const std::string& name,
+              DataType input_type,
+              DataType output_type,
+              const ColumnVectorPtr& input) {
+        auto row_type = std::make_shared<RowType>(
+            std::vector<std::string>{"val"},
+            std::vector<DataType>{input_type});
+        std::vector<AggregateInfo> aggregates;
+        aggregates.emplace_back(MakeAggregate(name, input_type, 0, 0));
+        GroupingSet set(row_type,
+                        std::vector<std::unique_ptr<VectorHasher>>{},
+                        std::move(aggregates));
+        set.addInput(
+            std::make_shared<RowVector>(std::vector<VectorPtr>{input}));
+        auto result = std::make_shared<RowVector>(
+            std::make_shared<RowType>(std::vector<std::string>{"out"},
+                                      std::vector<DataType>{output_type}),
+            1);
+        EXPECT_TRUE(set.getOutput(result));
+        return std::dynamic_pointer_cast<ColumnVector>(result->child(0));
+    }
+};
+
+TEST_F(SketchAggregateTest, ResultTypes) {
+    EXPECT_EQ(GetAggResultType("approx_count_distinct", DataType::VARCHAR),
+              DataType::INT64);
+    EXPECT_EQ(GetAggResultType("approx_p99", DataType::INT32),
+              DataType::DOUBLE);
+    EXPECT_EQ(GetAggResultType("approx_p50_partial", DataType::INT32),
+              DataType::VARCHAR);
+    EXPECT_EQ(GetAggResultType("approx_count_distinct_merge",
+                               DataType::VARCHAR),
+              DataType::VARCHAR);
+    EXPECT_EQ(GetAggResultType("approx_p90_merge_extract", DataType::VARCHAR),
+              DataType::DOUBLE);
+    EXPECT_ANY_THROW(GetAggResultType("approx_p42", DataType::INT32));
+}
+
+TEST_F(SketchAggregateTest, GroupedCountDistinct) {
+    auto input_type = std::make_shared<RowType>(
+        std::vector<std::string>{"key", "val"},
+        std::vector<DataType>{DataType::INT64, DataType::VARCHAR});
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    hashers.emplace_back(VectorHasher::create(DataType::INT64, 0));
+    std::vector<AggregateInfo> aggregates;
+    aggregates.emplace_back(
+        MakeAggregate("approx_count_distinct", DataType::VARCHAR, 1, 1));
+    GroupingSet set(input_type, std::move(hashers), std::move(aggregates));
+
+    // Key k sees (k + 1) * 1000 distinct values, each twice.
+    constexpr int64_t kNumKeys = 4;
+    std::vector<int64_t> keys;
+    std::vector<std::string> vals;
+    for (int64_t k = 0; k < kNumKeys; ++k) {
+        for (int64_t v = 0; v < (k + 1) * 1000; ++v) {
+            for (int rep = 0; rep < 2; ++rep) {
+                keys.push_back(k);
+                vals.push_back("value_" + std::to_string(v));
+            }
+        }
+    }
+    set.addInput(std::make_shared<RowVector>(
+        std::vector<VectorPtr>{MakeColumn(DataType::INT64, keys),
+                               MakeColumn(DataType::VARCHAR, vals)}));
+
+    auto output_type = std::make_shared<RowType>(
+        std::vector<std::string>{"key", "ndv"},
+        std::vector<DataType>{DataType::INT64, DataType::INT64});
+    auto result = std::make_shared<RowVector>(output_type, 0);
+    ASSERT_TRUE(set.getOutput(result));
+    auto out_keys = std::dynamic_pointer_cast<ColumnVector>(result->child(0));
+    auto out_ndv = std::dynamic_pointer_cast<ColumnVector>(result->child(1));
+    ASSERT_EQ(out_keys->size(), kNumKeys);
+    for (size_t i = 0; i < out_keys->size(); ++i) {
+        double expected = (out_keys->ValueAt<int64_t>(i) + 1) * 1000;
+        EXPECT_NEAR(out_ndv->ValueAt<int64_t>(i), expected, expected * 0.05);
+    }
+}
+
+TEST_F(SketchAggregateTest, PartialMergeExtractRoundTrip) {
+    // Partials over disjoint slices, merged from their serialized states,
+    // estimate the same as a single aggregation over all rows.
+    std::vector<std::string> states;
+    for (int p = 0; p < 3; ++p) {
+        std::vector<int64_t> vals;
+        for (int64_t v = 0; v < 10000; ++v) {
+            vals.push_back(p * 10000 + v);
+        }
+        auto state = RunGlobal("approx_count_distinct_partial",
+                               DataType::INT64,
+                               DataType::VARCHAR,
+                               MakeColumn(DataType::INT64, vals));
+        ASSERT_TRUE(state->ValidAt(0));
+        states.push_back(state->ValueAt<std::string>(0));
+    }
+    auto merged = RunGlobal("approx_count_distinct_merge_extract",
+                            DataType::VARCHAR,
+                            DataType::INT64,
+                            MakeColumn(DataType::VARCHAR, states));
+    EXPECT_NEAR(merged->ValueAt<int64_t>(0), 30000, 30000 * 0.05);
+}
+
+TEST_F(SketchAggregateTest, Percentiles) {
+    std::vector<int32_t> vals;
+    for (int32_t v = 1; v <= 10000; ++v) {
+        vals.push_back(v);
+    }
+    auto column = MakeColumn(DataType::INT32, vals);
+    auto p50 =
+        RunGlobal("approx_p50", DataType::INT32, DataType::DOUBLE, column);
+    auto p99 =
+        RunGlobal("approx_p99", DataType::INT32, DataType::DOUBLE, column);
+    EXPECT_NEAR(p50->ValueAt<double>(0), 5000, 100);
+    EXPECT_NEAR(p99->ValueAt<double>(0), 9900, 20);
+
+    // No input rows gives a null percentile.
+    auto empty = RunGlobal("approx_p90",
+                           DataType::INT32,
+                           DataType::DOUBLE,
+                           MakeColumn(DataType::INT32, std::vector<int32_t>{}));
+    EXPECT_FALSE(empty->ValidAt(0));
+}
@@ -12,7 +12,12 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <random>
 #include <vector>
 
@@ -1151,3 +1156,169 @@ TEST_F(SortBufferTest, NonSortColumnPreserved) {
     EXPECT_EQ(raw[1], "two");
     EXPECT_EQ(raw[2], "three");
 }
+
+TEST_F(SortBufferTest, SpillAndMergeRuns) {
+    // A tiny memory budget forces several sorted runs onto disk; the k-way
+    // merge must return the same order as an in-memory sort.
+    auto spill_dir =
+        std::filesystem::temp_directory_path() / "sort_buffer_spill_test";
+    std::vector<DataType> column_types = {DataType::INT64, DataType::VARCHAR};
+    std::vector<SortKeyInfo> sort_keys = {SortKeyInfo(0, false)};
+
+    SortSpillConfig spill_config;
+    spill_config.memory_budget_bytes = 4096;
+    spill_config.spill_directory = spill_dir.string();
+    SortBuffer buffer(column_types, sort_keys, -1, spill_config);
+
+    std::vector<int64_t> all_values;
+    std::mt19937 rng(42);
+    for (int batch = 0; batch < 20; ++batch) {
+        std::vector<int64_t> values(100);
+        std::vector<std::string> strs(100);
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = static_cast<int64_t>(rng() % 100000);
+            strs[i] = "v" + std::to_string(values[i]);
+        }
+        all_values.insert(all_values.end(), values.begin(), values.end());
+        std::vector<ColumnVectorPtr> columns = {CreateInt64Column(values),
+                                                CreateStringColumn(strs)};
+        buffer.AddRows(columns, values.size());
+    }
+    buffer.NoMoreInput();
+    EXPECT_GT(buffer.NumSpilledRuns(), 1);
+    EXPECT_GT(buffer.NumSpilledRows(), 0);
+
+    std::sort(all_values.begin(), all_values.end(), std::greater<>());
+    std::vector<int64_t> sorted;
+    while (buffer.HasOutput()) {
+        auto output = buffer.GetOutput(333);
+        auto values = ExtractInt64Values(output, 0);
+        auto out_str = std::dynamic_pointer_cast<ColumnVector>(output[1]);
+        auto* raw = reinterpret_cast<std::string*>(out_str->GetRawData());
+        for (size_t i = 0; i < values.size(); ++i) {
+            EXPECT_EQ(raw[i], "v" + std::to_string(values[i]));
+        }
+        sorted.insert(sorted.end(), values.begin(), values.end());
+    }
+    EXPECT_EQ(sorted, all_values);
+}
+
+TEST_F(SortBufferTest, SpillWithLimitAndNulls) {
+    auto spill_dir =
+        std::filesystem::temp_directory_path() / "sort_buffer_spill_test";
+    std::vector<DataType> column_types = {DataType::INT64};
+    std::vector<SortKeyInfo> sort_keys = {SortKeyInfo(0, true, true)};
+
+    SortSpillConfig spill_config;
+    spill_config.memory_budget_bytes = 512;
+    spill_config.spill_directory = spill_dir.string();
+    SortBuffer buffer(column_types, sort_keys, 5, spill_config);
+
+    for (int batch = 0; batch < 10; ++batch) {
+        auto col = std::make_shared<ColumnVector>(DataType::INT64, 10);
+        for (int i = 0; i < 10; ++i) {
+            if (batch == 7 && i == 3) {
+                col->nullAt(i);
+            } else {
+                col->SetValueAt<int64_t>(i, 1000 - batch * 10 - i);
+            }
+        }
+        std::vector<ColumnVectorPtr> columns = {col};
+        buffer.AddRows(columns, 10);
+    }
+    buffer.NoMoreInput();
+    EXPECT_GT(buffer.NumSpilledRuns(), 0);
+
+    auto output = buffer.GetOutput(100);
+    auto out_col = std::dynamic_pointer_cast<ColumnVector>(output[0]);
+    ASSERT_EQ(out_col->size(), 5);
+    EXPECT_FALSE(out_col->ValidAt(0));
+    EXPECT_EQ(out_col->ValueAt<int64_t>(1), 901);
+    EXPECT_EQ(out_col->ValueAt<int64_t>(2), 902);
+    EXPECT_EQ(out_col->ValueAt<int64_t>(3), 903);
+    EXPECT_EQ(out_col->ValueAt<int64_t>(4), 904);
+    EXPECT_FALSE(buffer.HasOutput());
+}
+
+TEST_F(SortBufferTest, NormalizedKeyFloatSpecialValues) {
+    // NaN sorts above +inf and -0.0 ties with 0.0, matching the comparator
+    std::vector<DataType> column_types = {DataType::DOUBLE};
+    std::vector<SortKeyInfo> sort_keys = {SortKeyInfo(0, false)};
+
+    SortBuffer buffer(column_types, sort_keys);
+
+    std::vector<double> data = {1.5,
+                                std::numeric_limits<double>::quiet_NaN(),
+                                -std::numeric_limits<double>::infinity(),
+                                -0.0,
+                                std::numeric_limits<double>::infinity(),
+                                -2.25};
+    auto col = CreateDoubleColumn(data);
+    std::vector<ColumnVectorPtr> columns = {col};
+    buffer.AddRows(columns, data.size());
+    buffer.NoMoreInput();
+
+    auto output = buffer.GetOutput(100);
+    auto out_col = std::dynamic_pointer_cast<ColumnVector>(output[0]);
+    ASSERT_EQ(out_col->size(), 6);
+    EXPECT_TRUE(std::isnan(out_col->ValueAt<double>(0)));
+    EXPECT_EQ(out_col->ValueAt<double>(1),
+              std::numeric_limits<double>::infinity());
+    EXPECT_EQ(out_col->ValueAt<double>(2), 1.5);
+    EXPECT_EQ(out_col->ValueAt<double>(3), 0.0);
+    EXPECT_EQ(out_col->ValueAt<double>(4), -2.25);
+    EXPECT_EQ(out_col->ValueAt<double>(5),
+              -std::numeric_limits<double>::infinity());
+}
+
+TEST_F(SortBufferTest, NormalizedKeyRadixSortTwoKeys) {
+    // Enough rows to take the radix path: INT32 DESC NULLS LAST, INT64 ASC
+    const int n = 20000;
+    std::vector<DataType> column_types = {DataType::INT32, DataType::INT64};
+    std::vector<SortKeyInfo> sort_keys = {SortKeyInfo(0, false, false),
+                                          SortKeyInfo(1, true, false)};
+
+    SortBuffer buffer(column_types, sort_keys);
+
+    std::mt19937 rng(7);
+    auto col0 = std::make_shared<ColumnVector>(DataType::INT32, n);
+    auto col1 = std::make_shared<ColumnVector>(DataType::INT64, n);
+    std::vector<std::pair<std::optional<int32_t>, int64_t>> expected;
+    for (int i = 0; i < n; ++i) {
+        int64_t v1 = static_cast<int64_t>(rng()) - (1LL << 31);
+        col1->SetValueAt<int64_t>(i, v1);
+        if (rng() % 10 == 0) {
+            col0->nullAt(i);
+            expected.emplace_back(std::nullopt, v1);
+        } else {
+            int32_t v0 = static_cast<int32_t>(rng() % 200) - 100;
+            col0->SetValueAt<int32_t>(i, v0);
+            expected.emplace_back(v0, v1);
+        }
+    }
+    std::vector<ColumnVectorPtr> columns = {col0, col1};
+    buffer.AddRows(columns, n);
+    buffer.NoMoreInput();
+
+    std::sort(expected.begin(), expected.end(), [](auto& lhs, auto& rhs) {
+        if (lhs.first.has_value() != rhs.first.has_value()) {
+            return lhs.first.has_value();
+        }
+        if (lhs.first.has_value() && *lhs.first != *rhs.first) {
+            return *lhs.first > *rhs.first;
+        }
+        return lhs.second < rhs.second;
+    });
+
+    auto output = buffer.GetOutput(n);
+    auto out0 = std::dynamic_pointer_cast<ColumnVector>(output[0]);
+    auto out1 = ExtractInt64Values(output, 1);
+    ASSERT_EQ(out1.size(), static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(out0->ValidAt(i), expected[i].first.has_value()) << i;
+        if (expected[i].first.has_value()) {
+            ASSERT_EQ(out0->ValueAt<int32_t>(i), *expected[i].first) << i;
+        }
+        ASSERT_EQ(out1[i], expected[i].second) << i;
+    }
+}
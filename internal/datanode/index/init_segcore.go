@@ -59,6 +59,7 @@ func InitSegcore(nodeID int64) error {
 	C.SetIndexSliceSize(cIndexSliceSize)
 	cLoadTransientBudgetBytes := C.int64_t(paramtable.Get().CommonCfg.LoadTransientBudgetBytes.GetAsInt64())
 	C.SetLoadTransientBudgetBytes(cLoadTransientBudgetBytes)
+	initcore.InitReadRangesConfig(paramtable.Get())
 
 	// set up thread pool for different priorities
 	cHighPriorityThreadCoreCoefficient := C.float(paramtable.Get().CommonCfg.HighPriorityThreadCoreCoefficient.GetAsFloat())
@@ -275,6 +275,22 @@ func InitRemoteChunkManager(params *paramtable.ComponentParam) error {
 	return HandleCStatus(&status, "InitRemoteChunkManagerSingleton failed")
 }
 
+// InitRemoteChunkManagerDiskCache puts a local disk cache of capacityBytes
+// in path in front of the remote chunk manager.
+func InitRemoteChunkManagerDiskCache(path string, capacityBytes int64) error {
+	cPath := C.CString(path)
+	defer C.free(unsafe.Pointer(cPath))
+	status := C.InitRemoteChunkManagerDiskCache(cPath, C.int64_t(capacityBytes))
+	return HandleCStatus(&status, "InitRemoteChunkManagerDiskCache failed")
+}
+
+// InitReadRangesConfig applies how segcore coalesces and parallelizes the
+// reads of several ranges of one file.
+func InitReadRangesConfig(params *paramtable.ComponentParam) {
+	C.SetDefaultReadRangesMaxGap(C.int64_t(params.CommonCfg.ReadRangesMaxGapBytes.GetAsInt64()))
+	C.SetDefaultReadRangesParallelism(C.int64_t(params.CommonCfg.ReadRangesParallelism.GetAsInt64()))
+}
+
 func InitMmapManager(params *paramtable.ComponentParam, nodeID int64) error {
 	growingMMapDir := pathutil.GetPath(pathutil.GrowingMMapPath, nodeID)
 	cGrowingMMapDir := C.CString(growingMMapDir)
@@ -698,6 +714,15 @@ func SetupCoreConfigChangelCallback() {
 		paramtable.Get().QueryNodeCfg.ExprResCacheDiskMaxBytes.RegisterCallback(updateExprResCacheConfigCallback)
 		paramtable.Get().QueryNodeCfg.ExprResCacheDiskMaxFileSizeBytes.RegisterCallback(updateExprResCacheConfigCallback)
 
+		paramtable.Get().QueryNodeCfg.JSONPathCacheCapacityBytes.RegisterCallback(func(ctx context.Context, key, oldValue, newValue string) error {
+			bytes, err := strconv.ParseInt(newValue, 10, 64)
+			if err != nil {
+				return err
+			}
+			UpdateJSONPathCacheCapacity(bytes)
+			return nil
+		})
+
 		updateTieredStorageConfigCallback := func(ctx context.Context, key, oldValue, newValue string) error {
 			return UpdateTieredStorageConfig(paramtable.Get())
 		}
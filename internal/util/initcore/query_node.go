@@ -75,6 +75,10 @@ func doInitQueryNodeOnce(ctx context.Context) error {
 	cMaxGroupByGroups := C.int64_t(paramtable.Get().CommonCfg.GroupByMaxGroups.GetAsInt64())
 	C.SegcoreSetMaxGroupByGroups(cMaxGroupByGroups)
 
+	cQuerySpillDir := C.CString(pathutil.GetPath(pathutil.QuerySpillPath, nodeID))
+	C.SegcoreSetQuerySpillConfig(C.int64_t(paramtable.Get().QueryNodeCfg.QuerySpillMemoryBudget.GetAsInt64()), cQuerySpillDir)
+	C.free(unsafe.Pointer(cQuerySpillDir))
+
 	visibilityEnabled := paramtable.Get().CommonCfg.VisibilityFilterEnabled.GetAsBool()
 	bloomEnabled := paramtable.Get().CommonCfg.BloomFilterEnabled.GetAsBool()
 	C.SegcoreSetVisibilityFilterEnabled(C.bool(visibilityEnabled))
@@ -134,6 +138,15 @@ func doInitQueryNodeOnce(ctx context.Context) error {
 	cDeleteDumpBatchSize := C.int64_t(paramtable.Get().QueryNodeCfg.DeleteDumpBatchSize.GetAsInt64())
 	C.SetDefaultDeleteDumpBatchSize(cDeleteDumpBatchSize)
 
+	cSearchBatchWindowUs := C.int64_t(paramtable.Get().QueryNodeCfg.SearchBatchWindowUs.GetAsInt64())
+	C.SetDefaultSearchBatchWindow(cSearchBatchWindowUs)
+
+	cSearchBatchMaxNq := C.int64_t(paramtable.Get().QueryNodeCfg.SearchBatchMaxNq.GetAsInt64())
+	C.SetDefaultSearchBatchMaxNq(cSearchBatchMaxNq)
+
+	cGrowingSearchParallelism := C.int64_t(paramtable.Get().QueryNodeCfg.GrowingSearchParallelism.GetAsInt64())
+	C.SetDefaultGrowingSearchParallelism(cGrowingSearchParallelism)
+
 	cEnableLatestDeleteSnapshotOptimization := C.bool(paramtable.Get().QueryNodeCfg.EnableLatestDeleteSnapshotOptimization.GetAsBool())
 	C.SetEnableLatestDeleteSnapshotOptimization(cEnableLatestDeleteSnapshotOptimization)
 
@@ -165,6 +178,8 @@ func doInitQueryNodeOnce(ctx context.Context) error {
 		UpdateExprResCacheConfig()
 	}
 
+	UpdateJSONPathCacheCapacity(paramtable.Get().QueryNodeCfg.JSONPathCacheCapacityBytes.GetAsInt64())
+
 	C.SetArrowIOThreadPoolCapacity(C.int(ResolveArrowIOThreadPoolCapacity()))
 
 	cStorageV2CellTargetSizeBytes := C.int64_t(paramtable.Get().QueryNodeCfg.StorageV2CellTargetSizeBytes.GetAsInt64())
@@ -172,6 +187,11 @@ func doInitQueryNodeOnce(ctx context.Context) error {
 	enableParquetStatsSkipIndex := paramtable.Get().CommonCfg.ParquetStatsSkipIndex.GetAsBool()
 	C.SetDefaultEnableParquetStatsSkipIndex(C.bool(enableParquetStatsSkipIndex))
 
+	cPackedIntChunkEnabled := C.bool(paramtable.Get().QueryNodeCfg.PackedIntChunkEnabled.GetAsBool())
+	C.SetDefaultPackedIntChunkEnable(cPackedIntChunkEnabled)
+
+	InitReadRangesConfig(paramtable.Get())
+
 	err := InitArrowReaderConfig(paramtable.Get())
 	if err != nil {
 		return err
@@ -188,6 +208,13 @@ func doInitQueryNodeOnce(ctx context.Context) error {
 		return err
 	}
 
+	if capacity := paramtable.Get().QueryNodeCfg.RemoteObjectCacheCapacityBytes.GetAsInt64(); capacity > 0 {
+		err = InitRemoteChunkManagerDiskCache(pathutil.GetPath(pathutil.RemoteObjectCachePath, nodeID), capacity)
+		if err != nil {
+			return err
+		}
+	}
+
 	err = InitDiskFileWriterConfig(paramtable.Get())
 	if err != nil {
 		return err
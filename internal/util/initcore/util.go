@@ -113,6 +113,10 @@ func UpdateExprResCacheConfig() {
 		C.int64_t(params.QueryNodeCfg.ExprResCacheMinEvalDurationUs.GetAsInt64()))
 }
 
+func UpdateJSONPathCacheCapacity(bytes int64) {
+	C.SetJsonPathCacheCapacity(C.int64_t(bytes))
+}
+
 func UpdateArrowIOThreadPoolCapacity(threads int) {
 	C.SetArrowIOThreadPoolCapacity(C.int(threads))
 }
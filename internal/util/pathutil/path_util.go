@@ -18,6 +18,8 @@ const (
 	RootCachePath
 	FileResourcePath
 	ExprCachePath
+	QuerySpillPath
+	RemoteObjectCachePath
 )
 
 const (
@@ -27,6 +29,9 @@ const (
 	BM25PathPrefix         = "bm25"
 	FileResourcePathPrefix = "file_resource"
 	ExprCachePathPrefix    = "expr_cache"
+	QuerySpillPathPrefix   = "query_spill"
+
+	RemoteObjectCachePathPrefix = "remote_object_cache"
 )
 
 func GetPath(pathType PathType, nodeID int64) string {
@@ -44,6 +49,10 @@ func GetPath(pathType PathType, nodeID int64) string {
 		path = filepath.Join(path, fmt.Sprintf("%d", nodeID), FileResourcePathPrefix)
 	case ExprCachePath:
 		path = filepath.Join(path, fmt.Sprintf("%d", nodeID), ExprCachePathPrefix)
+	case QuerySpillPath:
+		path = filepath.Join(path, fmt.Sprintf("%d", nodeID), QuerySpillPathPrefix)
+	case RemoteObjectCachePath:
+		path = filepath.Join(path, fmt.Sprintf("%d", nodeID), RemoteObjectCachePathPrefix)
 	case RootCachePath:
 	}
 	mlog.Info(context.TODO(), "Get path for", mlog.Any("pathType", pathType), mlog.FieldNodeID(nodeID), mlog.String("path", path))
@@ -232,6 +232,8 @@ type commonConfig struct {
 
 	IndexSliceSize                      ParamItem `refreshable:"false"`
 	LoadTransientBudgetBytes            ParamItem `refreshable:"true"`
+	ReadRangesMaxGapBytes               ParamItem `refreshable:"false"`
+	ReadRangesParallelism               ParamItem `refreshable:"false"`
 	HighPriorityThreadCoreCoefficient   ParamItem `refreshable:"true"`
 	MiddlePriorityThreadCoreCoefficient ParamItem `refreshable:"true"`
 	LowPriorityThreadCoreCoefficient    ParamItem `refreshable:"true"`
@@ -579,6 +581,24 @@ This configuration is only used by querynode and indexnode, it selects CPU instr
 	}
 	p.LoadTransientBudgetBytes.Init(base.mgr)
 
+	p.ReadRangesMaxGapBytes = ParamItem{
+		Key:          "common.readRanges.maxGapBytes",
+		Version:      "3.0.0",
+		DefaultValue: "1048576",
+		Doc:          "ranges of one file at most this many bytes apart are fetched by one read when segcore reads several ranges of it",
+		Export:       true,
+	}
+	p.ReadRangesMaxGapBytes.Init(base.mgr)
+
+	p.ReadRangesParallelism = ParamItem{
+		Key:          "common.readRanges.parallelism",
+		Version:      "3.0.0",
+		DefaultValue: "8",
+		Doc:          "max reads one multi-range read of a file runs concurrently, 1 reads the ranges sequentially",
+		Export:       true,
+	}
+	p.ReadRangesParallelism.Init(base.mgr)
+
 	p.EnableMaterializedView = ParamItem{
 		Key:          "common.materializedView.enabled",
 		Version:      "2.4.6",
@@ -3712,6 +3732,25 @@ type queryNodeConfig struct {
 	ExprResCacheDiskMaxBytes          ParamItem `refreshable:"true"`
 	ExprResCacheDiskMaxFileSizeBytes  ParamItem `refreshable:"true"`
 
+	// json path cache
+	JSONPathCacheCapacityBytes ParamItem `refreshable:"true"`
+
+	// query spill
+	QuerySpillMemoryBudget ParamItem `refreshable:"false"`
+
+	// packed int chunk
+	PackedIntChunkEnabled ParamItem `refreshable:"false"`
+
+	// search batching
+	SearchBatchWindowUs ParamItem `refreshable:"false"`
+	SearchBatchMaxNq    ParamItem `refreshable:"false"`
+
+	// growing segment brute-force search
+	GrowingSearchParallelism ParamItem `refreshable:"false"`
+
+	// local disk cache of remote objects
+	RemoteObjectCacheCapacityBytes ParamItem `refreshable:"false"`
+
 	// pipeline
 	CleanExcludeSegInterval ParamItem `refreshable:"false"`
 	FlowGraphMaxQueueLength ParamItem `refreshable:"false"`
@@ -5030,6 +5069,69 @@ user-task-polling:
 	}
 	p.ExprResCacheDiskMaxFileSizeBytes.Init(base.mgr)
 
+	p.JSONPathCacheCapacityBytes = ParamItem{
+		Key:          "queryNode.jsonPathCache.capacityBytes",
+		Version:      "3.0.0",
+		DefaultValue: "0",
+		Doc:          "memory budget in bytes of the values JSON filters extract from sealed segment chunks per path, 0 disables the cache",
+		Export:       true,
+	}
+	p.JSONPathCacheCapacityBytes.Init(base.mgr)
+
+	p.QuerySpillMemoryBudget = ParamItem{
+		Key:          "queryNode.querySpill.memoryBudget",
+		Version:      "3.0.0",
+		DefaultValue: "0",
+		Doc:          "memory budget in bytes for a blocking query operator (ORDER BY) on one segment before it spills sorted runs to local disk, 0 disables spilling",
+		Export:       true,
+	}
+	p.QuerySpillMemoryBudget.Init(base.mgr)
+
+	p.PackedIntChunkEnabled = ParamItem{
+		Key:          "queryNode.packedIntChunk.enabled",
+		Version:      "3.0.0",
+		DefaultValue: "false",
+		Doc:          "store sealed INT32/INT64 fields, except the primary key, as frame-of-reference packed chunks when their value span fits 1, 2 or 4 byte codes",
+		Export:       true,
+	}
+	p.PackedIntChunkEnabled.Init(base.mgr)
+
+	p.SearchBatchWindowUs = ParamItem{
+		Key:          "queryNode.searchBatch.windowUs",
+		Version:      "3.0.0",
+		DefaultValue: "0",
+		Doc:          "how long in microseconds the first search on a segment waits for compatible concurrent searches to run with it as one batch, 0 disables batching",
+		Export:       true,
+	}
+	p.SearchBatchWindowUs.Init(base.mgr)
+
+	p.SearchBatchMaxNq = ParamItem{
+		Key:          "queryNode.searchBatch.maxNq",
+		Version:      "3.0.0",
+		DefaultValue: "64",
+		Doc:          "total nq at which a search batch closes before its window ends",
+		Export:       true,
+	}
+	p.SearchBatchMaxNq.Init(base.mgr)
+
+	p.GrowingSearchParallelism = ParamItem{
+		Key:          "queryNode.growingSearch.parallelism",
+		Version:      "3.0.0",
+		DefaultValue: "1",
+		Doc:          "max threads that search the chunks of a growing segment for one brute-force search request, 1 keeps the sequential scan",
+		Export:       true,
+	}
+	p.GrowingSearchParallelism.Init(base.mgr)
+
+	p.RemoteObjectCacheCapacityBytes = ParamItem{
+		Key:          "queryNode.remoteObjectCache.capacityBytes",
+		Version:      "3.0.0",
+		DefaultValue: "0",
+		Doc:          "local disk budget in bytes for copies of the objects segcore reads from remote storage, 0 disables the cache",
+		Export:       true,
+	}
+	p.RemoteObjectCacheCapacityBytes.Init(base.mgr)
+
 	p.CleanExcludeSegInterval = ParamItem{
 		Key:          "queryCoord.cleanExcludeSegmentInterval",
 		Version:      "2.4.0",